@@ -1,5 +1,6 @@
 #include "Behaviors/EnemyBehavior.h"
 #include "Units/Unit.h"
+#include "Units/UnitHotStreams.h"
 #include "Towers/Tower.h"
 #include "Combat/FrameEvents.h"
 #include "Combat/CombatSystem.h"
@@ -8,6 +9,7 @@
 #include "Pathfinding/PathProgressMonitor.h"
 #include "Simulation/SimulatorCore.h"
 #include "Pathfinding/AStarPathfinder.h"
+#include "Simulation/ParallelCollect.h"
 
 // ============================================================================
 // Main Update
@@ -32,40 +34,104 @@ void FEnemyBehavior::UpdateEnemySquad(
 		if (!T.IsDestroyed()) { bAnyLivingTower = true; break; }
 	}
 
+	// Hot streams mirror the squads; the enemy streams are republished after the commit
+	FUnitHotStreams& EnemyStreams = Sim.GetHotStreams(EUnitFaction::Enemy);
+	const FUnitHotStreams& FriendlyStreams = Sim.GetHotStreams(EUnitFaction::Friendly);
+
 	if (!bAnyLivingFriendly && !bAnyLivingTower)
 	{
 		// No targets: stop all enemies
-		for (FUnit& Enemy : Enemies)
+		for (int32 i = 0; i < Enemies.Num(); i++)
 		{
-			Enemy.Velocity = FVector2D::ZeroVector;
-			Enemy.ClearMovementPath();
+			Enemies[i].Velocity = FVector2D::ZeroVector;
+			Enemies[i].ClearMovementPath();
+			EnemyStreams.Sync(i, Enemies[i]);
 		}
 		return;
 	}
 
+	// Every enemy decides and moves against the frame-start streams and slots, so
+	// each task writes only its own enemy, its PendingOps entry and its batch events
+	PendingOps.SetNum(Enemies.Num());
+
+	ParallelCollect::ForEachOrdered(Enemies.Num(), BatchEvents, Events, Sim.GetParallelPhase1(),
+		[&](int32 i, FFrameEvents& UnitEvents)
+		{
+			PendingOps[i].Reset();
+
+			FUnit& Enemy = Enemies[i];
+			if (Enemy.bIsDead) return;
+
+			Enemy.AttackCooldown = FMath::Max(0.f, Enemy.AttackCooldown - 1.f);
+
+			if (Enemy.HP <= 0)
+			{
+				Enemy.bIsDead = true;
+				Enemy.Velocity = FVector2D::ZeroVector;
+				QueueSlotRelease(i, Enemy.Target.Resolve(Friendlies), Enemy.TakenSlotIndex);
+				return;
+			}
+
+			UpdateEnemyTarget(Enemy, i, Friendlies, FriendlyStreams, FriendlyTowers);
+			UpdateEnemyMovement(Sim, Enemy, i, Enemies, Friendlies, FriendlyTowers, UnitEvents);
+
+			Enemy.Position += Enemy.Velocity;
+			Enemy.UpdateRotation();
+		});
+
+	CommitPendingOps(Sim, Enemies, Friendlies);
+	EnemyStreams.Build(Enemies);
+}
+
+// ============================================================================
+// Deferred Shared Writes
+// ============================================================================
+
+void FEnemyBehavior::QueueSlotRelease(int32 EnemyIndex, int32 TargetIndex, int32 SlotIndex)
+{
+	if (TargetIndex == INDEX_NONE) return;
+
+	FPendingSlotOp& Op = PendingOps[EnemyIndex].SlotOps.AddDefaulted_GetRef();
+	Op.TargetIndex = TargetIndex;
+	Op.SlotIndex = SlotIndex;
+}
+
+int32 FEnemyBehavior::QueueSlotClaim(int32 EnemyIndex, const FUnit& Enemy, const FUnit& Target, int32 TargetIndex)
+{
+	FPendingSlotOp& Op = PendingOps[EnemyIndex].SlotOps.AddDefaulted_GetRef();
+	Op.TargetIndex = TargetIndex;
+	Op.bClaim = true;
+	Op.Position = Enemy.Position;
+	Op.Radius = Enemy.Radius;
+
+	return Target.FindBestSlot(Enemy.Id, Enemy.Position, Enemy.Radius);
+}
+
+void FEnemyBehavior::CommitPendingOps(FSimulatorCore& Sim, TArray<FUnit>& Enemies, TArray<FUnit>& Friendlies)
+{
 	for (int32 i = 0; i < Enemies.Num(); i++)
 	{
 		FUnit& Enemy = Enemies[i];
-		if (Enemy.bIsDead) continue;
-
-		Enemy.AttackCooldown = FMath::Max(0.f, Enemy.AttackCooldown - 1.f);
+		const FPendingOps& Ops = PendingOps[i];
 
-		if (Enemy.HP <= 0)
+		for (const FPendingSlotOp& Op : Ops.SlotOps)
 		{
-			Enemy.bIsDead = true;
-			Enemy.Velocity = FVector2D::ZeroVector;
-			if (Enemy.TargetIndex >= 0 && Enemy.TargetIndex < Friendlies.Num())
+			FUnit& Target = Friendlies[Op.TargetIndex];
+			if (Op.bClaim)
 			{
-				Friendlies[Enemy.TargetIndex].ReleaseSlot(i, Enemy.TakenSlotIndex);
+				// Lower-indexed enemies have already committed, so this is the arbitrated slot
+				Enemy.TakenSlotIndex = Target.ClaimBestSlot(Enemy.Id, Op.Position, Op.Radius);
+			}
+			else
+			{
+				Target.ReleaseSlot(Enemy.Id, Op.SlotIndex);
 			}
-			continue;
 		}
 
-		UpdateEnemyTarget(Enemy, i, Friendlies, FriendlyTowers);
-		UpdateEnemyMovement(Sim, Enemy, i, Enemies, Friendlies, FriendlyTowers, Events);
-
-		Enemy.Position += Enemy.Velocity;
-		Enemy.UpdateRotation();
+		if (Ops.bPathRequested)
+		{
+			Sim.RequestPath(Ops.PathRequest);
+		}
 	}
 }
 
@@ -77,9 +143,11 @@ void FEnemyBehavior::UpdateEnemyTarget(
 	FUnit& Enemy,
 	int32 EnemyIndex,
 	TArray<FUnit>& LivingFriendlies,
+	const FUnitHotStreams& FriendlyStreams,
 	TArray<FTower>& FriendlyTowers)
 {
-	const int32 PreviousTargetIndex = Enemy.TargetIndex;
+	const FUnitHandle PreviousTarget = Enemy.Target;
+	int32 TargetIndex = Enemy.Target.Resolve(LivingFriendlies);
 	Enemy.FramesSinceTargetEvaluation++;
 
 	// Clear destroyed tower target
@@ -94,16 +162,13 @@ void FEnemyBehavior::UpdateEnemyTarget(
 	// Use TowerTargetingRules for selection
 	int32 NewUnitTarget = -1;
 	int32 NewTowerTarget = -1;
-	TowerTargetingRules::SelectTarget(Enemy, LivingFriendlies, FriendlyTowers, NewUnitTarget, NewTowerTarget);
+	TowerTargetingRules::SelectTarget(Enemy, FriendlyStreams, FriendlyTowers, NewUnitTarget, NewTowerTarget);
 
 	// If tower target found, use it
 	if (NewTowerTarget >= 0)
 	{
-		if (Enemy.TargetIndex >= 0 && Enemy.TargetIndex < LivingFriendlies.Num())
-		{
-			LivingFriendlies[Enemy.TargetIndex].ReleaseSlot(EnemyIndex, Enemy.TakenSlotIndex);
-		}
-		Enemy.TargetIndex = -1;
+		QueueSlotRelease(EnemyIndex, TargetIndex, Enemy.TakenSlotIndex);
+		Enemy.Target.Reset();
 		Enemy.TakenSlotIndex = -1;
 		Enemy.TargetTowerIndex = NewTowerTarget;
 		Enemy.FramesSinceTargetEvaluation = 0;
@@ -115,64 +180,52 @@ void FEnemyBehavior::UpdateEnemyTarget(
 		Enemy.TargetTowerIndex = -1;
 	}
 
-	// Check if current target is invalid
-	bool bNeedsTarget = Enemy.TargetIndex < 0;
-	if (!bNeedsTarget && Enemy.TargetIndex < LivingFriendlies.Num())
+	// Check if current target is invalid (stale handles resolve to INDEX_NONE)
+	bool bNeedsTarget = TargetIndex == INDEX_NONE;
+	if (!bNeedsTarget)
 	{
-		const FUnit& Current = LivingFriendlies[Enemy.TargetIndex];
+		const FUnit& Current = LivingFriendlies[TargetIndex];
 		if (Current.bIsDead || !Enemy.CanAttackUnit(Current))
 		{
 			bNeedsTarget = true;
 		}
 	}
-	else if (Enemy.TargetIndex >= LivingFriendlies.Num())
-	{
-		bNeedsTarget = true;
-	}
 
 	if (bNeedsTarget)
 	{
-		if (Enemy.TargetIndex >= 0 && Enemy.TargetIndex < LivingFriendlies.Num())
-		{
-			LivingFriendlies[Enemy.TargetIndex].ReleaseSlot(EnemyIndex, Enemy.TakenSlotIndex);
-		}
-		Enemy.TargetIndex = SelectBestTarget(Enemy, LivingFriendlies);
+		QueueSlotRelease(EnemyIndex, TargetIndex, Enemy.TakenSlotIndex);
+		TargetIndex = SelectBestTarget(Enemy, LivingFriendlies, FriendlyStreams);
+		Enemy.Target = FUnitHandle::Make(LivingFriendlies, TargetIndex);
 		Enemy.FramesSinceTargetEvaluation = 0;
 	}
 	else
 	{
 		// Re-evaluate: see if there's a clearly better target
-		const int32 BestIdx = SelectBestTarget(Enemy, LivingFriendlies);
-		if (BestIdx >= 0 && BestIdx != Enemy.TargetIndex)
+		const int32 BestIdx = SelectBestTarget(Enemy, LivingFriendlies, FriendlyStreams);
+		if (BestIdx >= 0 && BestIdx != TargetIndex)
 		{
-			const float CurrentScore = (Enemy.TargetIndex >= 0 && Enemy.TargetIndex < LivingFriendlies.Num())
-				? EvaluateTargetScore(Enemy, LivingFriendlies[Enemy.TargetIndex])
-				: TNumericLimits<float>::Max();
+			const float CurrentScore = EvaluateTargetScore(Enemy, LivingFriendlies[TargetIndex]);
 			const float BestScore = EvaluateTargetScore(Enemy, LivingFriendlies[BestIdx]);
 			const bool bIntervalElapsed = Enemy.FramesSinceTargetEvaluation >= UnitSimConstants::TARGET_REEVALUATE_INTERVAL_FRAMES;
 			const bool bClearlyBetter = (BestScore + UnitSimConstants::TARGET_SWITCH_MARGIN) < CurrentScore;
 
 			if (bIntervalElapsed || bClearlyBetter)
 			{
-				if (Enemy.TargetIndex >= 0 && Enemy.TargetIndex < LivingFriendlies.Num())
-				{
-					LivingFriendlies[Enemy.TargetIndex].ReleaseSlot(EnemyIndex, Enemy.TakenSlotIndex);
-				}
-				Enemy.TargetIndex = BestIdx;
+				QueueSlotRelease(EnemyIndex, TargetIndex, Enemy.TakenSlotIndex);
+				TargetIndex = BestIdx;
+				Enemy.Target = FUnitHandle::Make(LivingFriendlies, TargetIndex);
 				Enemy.FramesSinceTargetEvaluation = 0;
 			}
 		}
 	}
 
 	// Claim slot on new target
-	if (Enemy.TargetIndex >= 0 && Enemy.TargetIndex != PreviousTargetIndex &&
-		Enemy.TargetIndex < LivingFriendlies.Num())
+	if (TargetIndex != INDEX_NONE && Enemy.Target != PreviousTarget)
 	{
-		Enemy.TakenSlotIndex = LivingFriendlies[Enemy.TargetIndex].ClaimBestSlot(
-			EnemyIndex, Enemy.Position, Enemy.Radius);
+		Enemy.TakenSlotIndex = QueueSlotClaim(EnemyIndex, Enemy, LivingFriendlies[TargetIndex], TargetIndex);
 		Enemy.FramesSinceSlotEvaluation = 0;
 	}
-	else if (Enemy.TargetIndex < 0)
+	else if (TargetIndex == INDEX_NONE)
 	{
 		Enemy.FramesSinceSlotEvaluation = 0;
 	}
@@ -180,17 +233,22 @@ void FEnemyBehavior::UpdateEnemyTarget(
 
 int32 FEnemyBehavior::SelectBestTarget(
 	const FUnit& Enemy,
-	const TArray<FUnit>& Candidates)
+	const TArray<FUnit>& Candidates,
+	const FUnitHotStreams& CandidateStreams)
 {
 	int32 BestIdx = -1;
 	float BestScore = TNumericLimits<float>::Max();
 
-	for (int32 i = 0; i < Candidates.Num(); i++)
+	for (int32 i = 0; i < CandidateStreams.Num(); i++)
 	{
-		const FUnit& Candidate = Candidates[i];
-		if (Candidate.bIsDead || !Enemy.CanAttackUnit(Candidate)) continue;
+		if (!CandidateStreams.IsTargetableBy(i, Enemy.CanTarget)) continue;
+
+		// The crowd penalty is never negative: only read the candidate's slots
+		// when distance alone could still beat the best score
+		const float Distance = CandidateStreams.DistanceTo(i, Enemy.Position);
+		if (Distance >= BestScore) continue;
 
-		const float Score = EvaluateTargetScore(Enemy, Candidate);
+		const float Score = Distance + GetCrowdPenalty(Candidates[i]);
 		if (Score < BestScore)
 		{
 			BestScore = Score;
@@ -205,13 +263,17 @@ float FEnemyBehavior::EvaluateTargetScore(
 	const FUnit& Candidate)
 {
 	const float Distance = FVector2D::Distance(Enemy.Position, Candidate.Position);
+	return Distance + GetCrowdPenalty(Candidate);
+}
+
+float FEnemyBehavior::GetCrowdPenalty(const FUnit& Candidate)
+{
 	int32 Occupied = 0;
 	for (int32 Slot : Candidate.AttackSlots)
 	{
 		if (Slot >= 0) Occupied++;
 	}
-	const float CrowdPenalty = Occupied * UnitSimConstants::TARGET_CROWD_PENALTY_PER_ATTACKER;
-	return Distance + CrowdPenalty;
+	return Occupied * UnitSimConstants::TARGET_CROWD_PENALTY_PER_ATTACKER;
 }
 
 // ============================================================================
@@ -236,7 +298,8 @@ void FEnemyBehavior::UpdateEnemyMovement(
 	}
 
 	// No unit target
-	if (Enemy.TargetIndex < 0 || Enemy.TargetIndex >= LivingFriendlies.Num())
+	const int32 TargetIndex = Enemy.Target.Resolve(LivingFriendlies);
+	if (TargetIndex == INDEX_NONE)
 	{
 		Enemy.ClearMovementPath();
 		Enemy.CurrentDestination = Enemy.Position;
@@ -245,11 +308,11 @@ void FEnemyBehavior::UpdateEnemyMovement(
 		return;
 	}
 
-	FUnit& Target = LivingFriendlies[Enemy.TargetIndex];
+	FUnit& Target = LivingFriendlies[TargetIndex];
 
 	// Update charge state
 	FCombatSystem CombatSys;
-	CombatSys.UpdateChargeState(Enemy, Enemy.TargetIndex, LivingFriendlies);
+	CombatSys.UpdateChargeState(Enemy, TargetIndex, LivingFriendlies);
 
 	// Slot refresh logic
 	Enemy.FramesSinceSlotEvaluation++;
@@ -268,7 +331,7 @@ void FEnemyBehavior::UpdateEnemyMovement(
 
 	if (bNeedsSlotRefresh)
 	{
-		Enemy.TakenSlotIndex = Target.ClaimBestSlot(EnemyIndex, Enemy.Position, Enemy.Radius);
+		Enemy.TakenSlotIndex = QueueSlotClaim(EnemyIndex, Enemy, Target, TargetIndex);
 		Enemy.FramesSinceSlotEvaluation = 0;
 		SlotIndex = Enemy.TakenSlotIndex;
 	}
@@ -290,7 +353,7 @@ void FEnemyBehavior::UpdateEnemyMovement(
 	{
 		Enemy.Velocity = FVector2D::ZeroVector;
 		Enemy.ClearMovementPath();
-		TryAttack(Enemy, EnemyIndex, Target, Enemy.TargetIndex, LivingFriendlies, Events);
+		TryAttack(Enemy, EnemyIndex, Target, TargetIndex, LivingFriendlies, Events);
 	}
 	else
 	{
@@ -365,32 +428,45 @@ void FEnemyBehavior::MoveUnit(
 
 	// Path replanning
 	const bool bDestChanged = FVector2D::Distance(Unit.CurrentDestination, AdjustedDest) > UnitSimConstants::DESTINATION_THRESHOLD;
-	const bool bShouldReplan = PathProgressMonitor::ShouldReplan(Unit, Sim.GetCurrentFrame());
-	const bool bNeedsNewPath = bDestChanged || bShouldReplan;
+	const EReplanReason ReplanReason = PathProgressMonitor::GetReplanReason(Unit, Sim.GetCurrentFrame());
+	const bool bNeedsNewPath = bDestChanged || ReplanReason != EReplanReason::None;
 
 	if (bNeedsNewPath)
 	{
-		TArray<FVector2D> Path;
-		if (Sim.GetPathfinder() && Sim.GetPathfinder()->FindPath(Unit.Position, AdjustedDest, Path))
-		{
-			Unit.SetMovementPath(Path);
-		}
-		Unit.CurrentDestination = AdjustedDest;
-		PathProgressMonitor::OnReplan(Unit, Sim.GetCurrentFrame());
+		// The request service is shared: submit in the serial commit. The path (and the
+		// replan bookkeeping) lands at the end of the step, or the enemy asks again next frame.
+		FPendingOps& Ops = PendingOps[UnitIndex];
+		Ops.bPathRequested = true;
+		Ops.PathRequest.Faction = Unit.Faction;
+		Ops.PathRequest.UnitId = Unit.Id;
+		Ops.PathRequest.Start = Unit.Position;
+		Ops.PathRequest.Goal = AdjustedDest;
+		Ops.PathRequest.Layer = Unit.Layer;
+		Ops.PathRequest.Priority = FPathRequest::GetPriority(bDestChanged, ReplanReason);
+		Ops.PathRequest.LastReplanFrame = Unit.LastReplanFrame;
 	}
 
 	FVector2D Waypoint;
-	if (Unit.TryGetNextMovementWaypoint(Waypoint))
+	bool bHasWaypoint = Unit.TryGetNextMovementWaypoint(Waypoint);
+	if (!bHasWaypoint && PendingOps[UnitIndex].bPathRequested)
+	{
+		// Nothing to follow until the requested path lands: head straight for the goal
+		Waypoint = AdjustedDest;
+		bHasWaypoint = true;
+	}
+
+	if (bHasWaypoint)
 	{
 		const FVector2D DesiredDirection = Waypoint - Unit.Position;
 		const FVector2D DesiredForward = AvoidanceSystem::SafeNormalize(DesiredDirection);
+		const FUnitHotStreams& AllyStreams = Sim.GetHotStreams(Unit.Faction);
 
 		// Separation from allies
 		FVector2D SeparationVector = FVector2D::ZeroVector;
-		for (int32 j = 0; j < Allies.Num(); j++)
+		for (int32 j = 0; j < AllyStreams.Num(); j++)
 		{
-			if (j == UnitIndex || Allies[j].bIsDead) continue;
-			const FVector2D Delta = Unit.Position - Allies[j].Position;
+			if (j == UnitIndex || AllyStreams.IsDead(j)) continue;
+			const FVector2D Delta = Unit.Position - AllyStreams.GetPosition(j);
 			const double Dist = Delta.Size();
 			if (Dist > KINDA_SMALL_NUMBER && Dist < UnitSimConstants::SEPARATION_RADIUS)
 			{
@@ -403,9 +479,11 @@ void FEnemyBehavior::MoveUnit(
 		FVector2D AvoidTarget;
 		bool bIsDetouring;
 		int32 AvoidanceThreatIdx;
+		int32 RisksEvaluated = 0;
 		const FVector2D Avoidance = AvoidanceSystem::PredictiveAvoidanceVector(
-			Unit, UnitIndex, Allies.GetData(), Allies.Num(),
-			DesiredForward, AvoidTarget, bIsDetouring, AvoidanceThreatIdx);
+			Unit, UnitIndex, AllyStreams,
+			DesiredForward, AvoidTarget, bIsDetouring, AvoidanceThreatIdx, PendingOps[UnitIndex].AvoidanceRisks, &RisksEvaluated);
+		Sim.GetProfiler().AddCount(ESimCounter::AvoidanceRisks, RisksEvaluated);
 
 		FVector2D AvoidanceWaypoint;
 		const bool bHasAvoidWP = Unit.TryGetNextAvoidanceWaypoint(AvoidanceWaypoint);
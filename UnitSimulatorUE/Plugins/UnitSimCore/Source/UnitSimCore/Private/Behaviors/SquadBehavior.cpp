@@ -1,13 +1,17 @@
 #include "Behaviors/SquadBehavior.h"
 #include "Units/Unit.h"
+#include "Units/UnitHotStreams.h"
+#include "Units/UnitIdIndex.h"
 #include "Towers/Tower.h"
 #include "Combat/FrameEvents.h"
 #include "Combat/CombatSystem.h"
 #include "Combat/AvoidanceSystem.h"
 #include "Targeting/TowerTargetingRules.h"
 #include "Pathfinding/PathProgressMonitor.h"
+#include "Pathfinding/PathRequestService.h"
 #include "Simulation/SimulatorCore.h"
 #include "Pathfinding/AStarPathfinder.h"
+#include "Math/SimMath.h"
 
 // ============================================================================
 // Formation Offsets
@@ -36,46 +40,47 @@ void FSquadBehavior::UpdateFriendlySquad(
 	const FVector2D& MainTarget,
 	FFrameEvents& Events)
 {
-	// Filter living enemies
-	TArray<FUnit*> LivingEnemyPtrs;
-	TArray<int32> LivingEnemyOrigIndices;
-	for (int32 i = 0; i < Enemies.Num(); i++)
+	bool bAnyLivingEnemy = false;
+	for (const FUnit& Enemy : Enemies)
 	{
-		if (!Enemies[i].bIsDead)
+		if (!Enemy.bIsDead)
 		{
-			LivingEnemyPtrs.Add(&Enemies[i]);
-			LivingEnemyOrigIndices.Add(i);
+			bAnyLivingEnemy = true;
+			break;
 		}
 	}
 
-	if (LivingEnemyPtrs.Num() > 0)
+	const FUnitHotStreams& EnemyStreams = Sim.GetHotStreams(EUnitFaction::Enemy);
+
+	if (bAnyLivingEnemy)
 	{
-		UpdateSquadTargetAndRallyPoint(Friendlies, Enemies);
-		TSet<int32> EngagedIndices = DetermineEngagedUnits(Friendlies, Enemies);
+		UpdateSquadTargetAndRallyPoint(Friendlies, Enemies, EnemyStreams);
+		DetermineEngagedUnits(Friendlies, EnemyStreams, EngagedUnitIndices);
 
-		if (EngagedIndices.Num() > 0)
+		if (EngagedUnitIndices.Num() > 0)
 		{
-			UpdateCombatBehavior(Sim, Friendlies, Enemies, EnemyTowers, EngagedIndices, Events);
+			UpdateCombatBehavior(Sim, Friendlies, Enemies, EnemyTowers, EngagedUnitIndices, Events);
 		}
 
-		if (EngagedIndices.Num() < Friendlies.Num())
+		if (EngagedUnitIndices.Num() < Friendlies.Num())
 		{
-			UpdateFormation(Sim, Friendlies, &EngagedIndices);
+			UpdateFormation(Sim, Friendlies, &EngagedUnitIndices);
 		}
 	}
 	else
 	{
 		// No living enemies - check for towers
-		TArray<int32> LivingTowerIndices;
-		for (int32 i = 0; i < EnemyTowers.Num(); i++)
+		bool bAnyLivingTower = false;
+		for (const FTower& Tower : EnemyTowers)
 		{
-			if (!EnemyTowers[i].IsDestroyed())
+			if (!Tower.IsDestroyed())
 			{
-				LivingTowerIndices.Add(i);
+				bAnyLivingTower = true;
+				break;
 			}
 		}
 
-		if (LivingTowerIndices.Num() > 0)
+		if (bAnyLivingTower)
 		{
 			UpdateTowerAssault(Sim, Friendlies, EnemyTowers, Events);
 		}
@@ -93,30 +98,31 @@ void FSquadBehavior::UpdateFriendlySquad(
 
 void FSquadBehavior::UpdateSquadTargetAndRallyPoint(
 	TArray<FUnit>& Friendlies,
-	TArray<FUnit>& LivingEnemies)
+	TArray<FUnit>& LivingEnemies,
+	const FUnitHotStreams& EnemyStreams)
 {
 	// Validate current target
-	if (SquadTargetIndex >= 0)
+	if (SquadTarget.IsSet())
 	{
-		if (SquadTargetIndex >= LivingEnemies.Num() || LivingEnemies[SquadTargetIndex].bIsDead)
+		const int32 SquadTargetIndex = SquadTarget.Resolve(LivingEnemies);
+		if (SquadTargetIndex == INDEX_NONE || LivingEnemies[SquadTargetIndex].bIsDead)
 		{
-			SquadTargetIndex = -1;
+			SquadTarget.Reset();
 		}
 	}
 
-	if (SquadTargetIndex < 0 && Friendlies.Num() > 0)
+	if (!SquadTarget.IsSet() && Friendlies.Num() > 0)
 	{
 		const FUnit& Leader = Friendlies[0];
 
 		float BestDist = TNumericLimits<float>::Max();
 		int32 BestIdx = -1;
 
-		for (int32 i = 0; i < LivingEnemies.Num(); i++)
+		for (int32 i = 0; i < EnemyStreams.Num(); i++)
 		{
-			if (LivingEnemies[i].bIsDead) continue;
-			if (!Leader.CanAttackUnit(LivingEnemies[i])) continue;
+			if (!EnemyStreams.IsTargetableBy(i, Leader.CanTarget)) continue;
 
-			const float Dist = FVector2D::Distance(Leader.Position, LivingEnemies[i].Position);
+			const float Dist = EnemyStreams.DistanceTo(i, Leader.Position);
 			if (Dist < BestDist)
 			{
 				BestDist = Dist;
@@ -126,7 +132,7 @@ void FSquadBehavior::UpdateSquadTargetAndRallyPoint(
 
 		if (BestIdx >= 0)
 		{
-			SquadTargetIndex = BestIdx;
+			SquadTarget = FUnitHandle::Make(LivingEnemies, BestIdx);
 			FVector2D DirToTarget = LivingEnemies[BestIdx].Position - Leader.Position;
 			const double Len = DirToTarget.Size();
 			if (Len > KINDA_SMALL_NUMBER)
@@ -167,9 +173,9 @@ void FSquadBehavior::UpdateFormation(
 		FUnit& Follower = Friendlies[i];
 
 		// Rotate offset by leader's facing direction
-		const float Angle = FMath::Atan2(Leader.Forward.Y, Leader.Forward.X);
-		const float CosA = FMath::Cos(Angle);
-		const float SinA = FMath::Sin(Angle);
+		const float Angle = SimMath::Atan2(Leader.Forward.Y, Leader.Forward.X);
+		const float CosA = SimMath::Cos(Angle);
+		const float SinA = SimMath::Sin(Angle);
 
 		const int32 OffsetIdx = FMath::Min(i, Offsets.Num() - 1);
 		const FVector2D& Offset = Offsets[OffsetIdx];
@@ -187,45 +193,44 @@ void FSquadBehavior::UpdateFormation(
 // Engagement Detection
 // ============================================================================
 
-TSet<int32> FSquadBehavior::DetermineEngagedUnits(
+void FSquadBehavior::DetermineEngagedUnits(
 	TArray<FUnit>& Friendlies,
-	TArray<FUnit>& LivingEnemies)
+	const FUnitHotStreams& EnemyStreams,
+	TSet<int32>& OutEngaged)
 {
-	TSet<int32> Engaged;
+	OutEngaged.Reset();
 	for (int32 i = 0; i < Friendlies.Num(); i++)
 	{
-		if (IsUnitReadyToEngage(Friendlies[i], LivingEnemies))
+		if (IsUnitReadyToEngage(Friendlies[i], EnemyStreams))
 		{
-			Engaged.Add(i);
+			OutEngaged.Add(i);
 		}
 	}
-	return Engaged;
 }
 
 bool FSquadBehavior::IsUnitReadyToEngage(
 	const FUnit& Friendly,
-	const TArray<FUnit>& LivingEnemies)
+	const FUnitHotStreams& EnemyStreams)
 {
 	bool bAnyLiving = false;
-	for (const FUnit& E : LivingEnemies)
+	for (int32 i = 0; i < EnemyStreams.Num(); i++)
 	{
-		if (!E.bIsDead) { bAnyLiving = true; break; }
+		if (!EnemyStreams.IsDead(i)) { bAnyLiving = true; break; }
 	}
 	if (!bAnyLiving) return false;
 
 	// Already has a valid target
-	if (Friendly.TargetIndex >= 0 && Friendly.TargetIndex < LivingEnemies.Num())
+	const int32 TargetIndex = Friendly.Target.Resolve(EnemyStreams);
+	if (TargetIndex != INDEX_NONE && EnemyStreams.IsTargetableBy(TargetIndex, Friendly.CanTarget))
 	{
-		const FUnit& Target = LivingEnemies[Friendly.TargetIndex];
-		if (!Target.bIsDead && Friendly.CanAttackUnit(Target)) return true;
+		return true;
 	}
 
 	const float TriggerDistance = Friendly.AttackRange * UnitSimConstants::ENGAGEMENT_TRIGGER_DISTANCE_MULTIPLIER;
-	for (const FUnit& Enemy : LivingEnemies)
+	for (int32 i = 0; i < EnemyStreams.Num(); i++)
 	{
-		if (Enemy.bIsDead) continue;
-		if (Friendly.CanAttackUnit(Enemy) &&
-			FVector2D::Distance(Friendly.Position, Enemy.Position) <= TriggerDistance)
+		if (EnemyStreams.IsTargetableBy(i, Friendly.CanTarget) &&
+			EnemyStreams.DistanceTo(i, Friendly.Position) <= TriggerDistance)
 		{
 			return true;
 		}
@@ -245,15 +250,19 @@ void FSquadBehavior::UpdateCombatBehavior(
 	const TSet<int32>& EngagedIndices,
 	FFrameEvents& Events)
 {
+	FUnitHotStreams& FriendlyStreams = Sim.GetHotStreams(EUnitFaction::Friendly);
+	const FUnitHotStreams& EnemyStreams = Sim.GetHotStreams(EUnitFaction::Enemy);
+
 	for (int32 i = 0; i < Friendlies.Num(); i++)
 	{
 		if (!EngagedIndices.Contains(i)) continue;
 
 		FUnit& Friendly = Friendlies[i];
-		UpdateUnitTarget(Friendly, i, LivingEnemies, EnemyTowers);
+		UpdateUnitTarget(Friendly, i, LivingEnemies, EnemyStreams, EnemyTowers);
 		UpdateCombat(Sim, Friendly, i, LivingEnemies, EnemyTowers, Friendlies, Events);
 		Friendly.Position += Friendly.Velocity;
 		Friendly.UpdateRotation();
+		FriendlyStreams.Sync(i, Friendly);
 	}
 }
 
@@ -261,16 +270,18 @@ void FSquadBehavior::UpdateUnitTarget(
 	FUnit& Friendly,
 	int32 FriendlyIndex,
 	TArray<FUnit>& LivingEnemies,
+	const FUnitHotStreams& EnemyStreams,
 	TArray<FTower>& EnemyTowers)
 {
 	// Invalidate dead/unattackable target
-	if (Friendly.TargetIndex >= 0 && Friendly.TargetIndex < LivingEnemies.Num())
+	const int32 CurrentTargetIndex = Friendly.Target.Resolve(LivingEnemies);
+	if (CurrentTargetIndex != INDEX_NONE)
 	{
-		FUnit& Target = LivingEnemies[Friendly.TargetIndex];
+		FUnit& Target = LivingEnemies[CurrentTargetIndex];
 		if (Target.bIsDead || !Friendly.CanAttackUnit(Target))
 		{
-			Target.ReleaseSlot(FriendlyIndex, Friendly.TakenSlotIndex);
-			Friendly.TargetIndex = -1;
+			Target.ReleaseSlot(Friendly.Id, Friendly.TakenSlotIndex);
+			Friendly.Target.Reset();
 			Friendly.TakenSlotIndex = -1;
 		}
 	}
@@ -284,30 +295,29 @@ void FSquadBehavior::UpdateUnitTarget(
 	}
 
 	Friendly.AttackCooldown = FMath::Max(0.f, Friendly.AttackCooldown - 1.f);
-	const int32 PreviousTargetIndex = Friendly.TargetIndex;
+	const int32 PreviousTargetIndex = Friendly.Target.Resolve(LivingEnemies);
 
 	// Select new target
 	int32 NewUnitTarget = -1;
 	int32 NewTowerTarget = -1;
-	TowerTargetingRules::SelectTarget(Friendly, LivingEnemies, EnemyTowers, NewUnitTarget, NewTowerTarget);
+	TowerTargetingRules::SelectTarget(Friendly, EnemyStreams, EnemyTowers, NewUnitTarget, NewTowerTarget);
 
-	Friendly.TargetIndex = NewUnitTarget;
+	Friendly.Target = FUnitHandle::Make(LivingEnemies, NewUnitTarget);
 	Friendly.TargetTowerIndex = NewTowerTarget;
 
 	// Release previous target's slot if changed
-	if (PreviousTargetIndex >= 0 && PreviousTargetIndex != Friendly.TargetIndex &&
-		PreviousTargetIndex < LivingEnemies.Num())
+	if (PreviousTargetIndex != INDEX_NONE && PreviousTargetIndex != NewUnitTarget)
 	{
-		LivingEnemies[PreviousTargetIndex].ReleaseSlot(FriendlyIndex, Friendly.TakenSlotIndex);
+		LivingEnemies[PreviousTargetIndex].ReleaseSlot(Friendly.Id, Friendly.TakenSlotIndex);
 	}
 
 	// Claim slot on new target
-	if (Friendly.TargetIndex >= 0 && Friendly.TargetIndex < LivingEnemies.Num())
+	if (Friendly.Target.IsSet())
 	{
-		Friendly.TakenSlotIndex = LivingEnemies[Friendly.TargetIndex].ClaimBestSlot(
-			FriendlyIndex, Friendly.Position, Friendly.Radius);
+		Friendly.TakenSlotIndex = LivingEnemies[NewUnitTarget].ClaimBestSlot(
+			Friendly.Id, Friendly.Position, Friendly.Radius);
 	}
-	else if (PreviousTargetIndex >= 0)
+	else if (PreviousTargetIndex != INDEX_NONE)
 	{
 		Friendly.TakenSlotIndex = -1;
 	}
@@ -330,7 +340,8 @@ void FSquadBehavior::UpdateCombat(
 		return;
 	}
 
-	if (Friendly.TargetIndex < 0 || Friendly.TargetIndex >= LivingEnemies.Num())
+	const int32 TargetIndex = Friendly.Target.Resolve(LivingEnemies);
+	if (TargetIndex == INDEX_NONE)
 	{
 		Friendly.ClearMovementPath();
 		Friendly.CurrentDestination = Friendly.Position;
@@ -339,11 +350,11 @@ void FSquadBehavior::UpdateCombat(
 		return;
 	}
 
-	FUnit& Target = LivingEnemies[Friendly.TargetIndex];
+	FUnit& Target = LivingEnemies[TargetIndex];
 
 	// Update charge state
 	FCombatSystem CombatSys;
-	CombatSys.UpdateChargeState(Friendly, Friendly.TargetIndex, LivingEnemies);
+	CombatSys.UpdateChargeState(Friendly, TargetIndex, LivingEnemies);
 
 	const int32 SlotIndex = Friendly.TakenSlotIndex;
 	const FVector2D AttackPosition = (SlotIndex != -1)
@@ -361,7 +372,7 @@ void FSquadBehavior::UpdateCombat(
 		Friendly.CurrentDestination = Friendly.Position;
 		if (Friendly.AttackCooldown <= 0.f)
 		{
-			CombatSys.CollectAttackEvents(Friendly, FriendlyIndex, Target, Friendly.TargetIndex,
+			CombatSys.CollectAttackEvents(Friendly, FriendlyIndex, Target, TargetIndex,
 				LivingEnemies, Events);
 			Friendly.AttackCooldown = UnitSimConstants::ATTACK_COOLDOWN;
 		}
@@ -384,19 +395,22 @@ void FSquadBehavior::UpdateTowerAssault(
 {
 	// Create empty enemies list for target selection
 	TArray<FUnit> EmptyEnemies;
+	FUnitHotStreams EmptyEnemyStreams;
+	FUnitHotStreams& FriendlyStreams = Sim.GetHotStreams(EUnitFaction::Friendly);
 
 	for (int32 i = 0; i < Friendlies.Num(); i++)
 	{
 		FUnit& Friendly = Friendlies[i];
 		if (Friendly.bIsDead) continue;
 
-		UpdateUnitTarget(Friendly, i, EmptyEnemies, EnemyTowers);
+		UpdateUnitTarget(Friendly, i, EmptyEnemies, EmptyEnemyStreams, EnemyTowers);
 		if (Friendly.TargetTowerIndex >= 0 && Friendly.TargetTowerIndex < EnemyTowers.Num())
 		{
 			UpdateTowerCombat(Sim, Friendly, i, EnemyTowers[Friendly.TargetTowerIndex],
 				Friendlies, Events);
 			Friendly.Position += Friendly.Velocity;
 			Friendly.UpdateRotation();
+			FriendlyStreams.Sync(i, Friendly);
 		}
 	}
 }
@@ -443,36 +457,49 @@ void FSquadBehavior::MoveUnit(
 	TArray<FUnit>& Allies,
 	TArray<FUnit>* Opponents)
 {
+	FUnitHotStreams& AllyStreams = Sim.GetHotStreams(Unit.Faction);
 	const FVector2D AdjustedDest = Sim.GetTerrainSystem().GetAdjustedDestination(Unit, Destination);
 
 	// Path replanning
 	const bool bDestChanged = FVector2D::Distance(Unit.CurrentDestination, AdjustedDest) > UnitSimConstants::DESTINATION_THRESHOLD;
-	const bool bShouldReplan = PathProgressMonitor::ShouldReplan(Unit, Sim.GetCurrentFrame());
-	const bool bNeedsNewPath = bDestChanged || bShouldReplan;
+	const EReplanReason ReplanReason = PathProgressMonitor::GetReplanReason(Unit, Sim.GetCurrentFrame());
+	const bool bNeedsNewPath = bDestChanged || ReplanReason != EReplanReason::None;
 
 	if (bNeedsNewPath)
 	{
-		TArray<FVector2D> Path;
-		if (Sim.GetPathfinder() && Sim.GetPathfinder()->FindPath(Unit.Position, AdjustedDest, Path))
-		{
-			Unit.SetMovementPath(Path);
-		}
-		Unit.CurrentDestination = AdjustedDest;
-		PathProgressMonitor::OnReplan(Unit, Sim.GetCurrentFrame());
+		// Searched under the frame's budget; the path (and the replan bookkeeping) lands at
+		// the end of the step, or the unit asks again next frame
+		FPathRequest Request;
+		Request.Faction = Unit.Faction;
+		Request.UnitId = Unit.Id;
+		Request.Start = Unit.Position;
+		Request.Goal = AdjustedDest;
+		Request.Layer = Unit.Layer;
+		Request.Priority = FPathRequest::GetPriority(bDestChanged, ReplanReason);
+		Request.LastReplanFrame = Unit.LastReplanFrame;
+		Sim.RequestPath(Request);
 	}
 
 	FVector2D Waypoint;
-	if (Unit.TryGetNextMovementWaypoint(Waypoint))
+	bool bHasWaypoint = Unit.TryGetNextMovementWaypoint(Waypoint);
+	if (!bHasWaypoint && bNeedsNewPath)
+	{
+		// Nothing to follow until the requested path lands: head straight for the goal
+		Waypoint = AdjustedDest;
+		bHasWaypoint = true;
+	}
+
+	if (bHasWaypoint)
 	{
 		FVector2D DesiredDirection = Waypoint - Unit.Position;
 		FVector2D DesiredForward = AvoidanceSystem::SafeNormalize(DesiredDirection);
 
 		// Separation from allies
 		FVector2D SeparationVector = FVector2D::ZeroVector;
-		for (int32 j = 0; j < Allies.Num(); j++)
+		for (int32 j = 0; j < AllyStreams.Num(); j++)
 		{
-			if (j == UnitIndex || Allies[j].bIsDead) continue;
-			const FVector2D Delta = Unit.Position - Allies[j].Position;
+			if (j == UnitIndex || AllyStreams.IsDead(j)) continue;
+			const FVector2D Delta = Unit.Position - AllyStreams.GetPosition(j);
 			const double Dist = Delta.Size();
 			if (Dist > KINDA_SMALL_NUMBER && Dist < UnitSimConstants::FRIENDLY_SEPARATION_RADIUS)
 			{
@@ -484,9 +511,11 @@ void FSquadBehavior::MoveUnit(
 		FVector2D AvoidTarget;
 		bool bIsDetouring;
 		int32 AvoidanceThreatIdx;
+		int32 RisksEvaluated = 0;
 		const FVector2D Avoidance = AvoidanceSystem::PredictiveAvoidanceVector(
-			Unit, UnitIndex, Allies.GetData(), Allies.Num(),
-			DesiredForward, AvoidTarget, bIsDetouring, AvoidanceThreatIdx);
+			Unit, UnitIndex, AllyStreams,
+			DesiredForward, AvoidTarget, bIsDetouring, AvoidanceThreatIdx, AvoidanceRisks, &RisksEvaluated);
+		Sim.GetProfiler().AddCount(ESimCounter::AvoidanceRisks, RisksEvaluated);
 
 		FVector2D AvoidanceWaypoint;
 		const bool bHasAvoidWP = Unit.TryGetNextAvoidanceWaypoint(AvoidanceWaypoint);
@@ -517,24 +546,38 @@ void FSquadBehavior::MoveUnit(
 
 	Unit.Position += Unit.Velocity;
 	Unit.UpdateRotation();
+
+	// Formation followers steer off the leader right after it moves
+	AllyStreams.Sync(UnitIndex, Unit);
 }
 
 // ============================================================================
 // Helpers
 // ============================================================================
 
+void FSquadBehavior::RebindSquadTarget(const FUnitIdIndex& EnemyIds, const TArray<FUnit>& Enemies)
+{
+	EnemyIds.Rebind(SquadTarget, Enemies);
+}
+
+void FSquadBehavior::Serialize(FArchive& Ar)
+{
+	Ar << SquadTarget.Index << SquadTarget.Generation;
+	Ar << RallyPoint;
+}
+
 void FSquadBehavior::ResetSquadState(TArray<FUnit>& Friendlies)
 {
-	SquadTargetIndex = -1;
+	SquadTarget.Reset();
 
 	for (int32 i = 0; i < Friendlies.Num(); i++)
 	{
 		FUnit& F = Friendlies[i];
-		if (F.TargetIndex >= 0)
+		if (F.Target.IsSet())
 		{
 			// Can't release slot on enemy without the array, but we clear our own state
 			F.TakenSlotIndex = -1;
-			F.TargetIndex = -1;
+			F.Target.Reset();
 		}
 		F.ClearMovementPath();
 		F.ClearAvoidancePath();
@@ -558,9 +601,9 @@ void FSquadBehavior::MoveToMainTarget(
 	{
 		FUnit& Follower = Friendlies[i];
 
-		const float Angle = FMath::Atan2(Leader.Forward.Y, Leader.Forward.X);
-		const float CosA = FMath::Cos(Angle);
-		const float SinA = FMath::Sin(Angle);
+		const float Angle = SimMath::Atan2(Leader.Forward.Y, Leader.Forward.X);
+		const float CosA = SimMath::Cos(Angle);
+		const float SinA = SimMath::Sin(Angle);
 
 		const int32 OffsetIdx = FMath::Min(i, Offsets.Num() - 1);
 		const FVector2D& Offset = Offsets[OffsetIdx];
@@ -1,30 +1,40 @@
 #include "Combat/AvoidanceSystem.h"
 #include "Units/Unit.h"
+#include "Units/UnitHotStreams.h"
+#include "Math/SimMath.h"
 
 FVector2D AvoidanceSystem::SafeNormalize(const FVector2D& V)
 {
-	const float LenSq = V.SizeSquared();
-	if (LenSq < KINDA_SMALL_NUMBER)
-	{
-		return FVector2D::ZeroVector;
-	}
-	return V / FMath::Sqrt(LenSq);
+	return SimMath::SafeNormal(V, KINDA_SMALL_NUMBER);
 }
 
 FVector2D AvoidanceSystem::Rotate(const FVector2D& V, float Angle)
 {
-	const float Cos = FMath::Cos(Angle);
-	const float Sin = FMath::Sin(Angle);
+	const float Cos = SimMath::Cos(Angle);
+	const float Sin = SimMath::Sin(Angle);
 	return FVector2D(V.X * Cos - V.Y * Sin, V.X * Sin + V.Y * Cos);
 }
 
 bool AvoidanceSystem::TryGetFirstCollision(const FUnit& A, const FUnit& B, float& OutT, float& OutDistance)
 {
-	const float CombinedRadius = A.Radius * UnitSimConstants::COLLISION_RADIUS_SCALE
-		+ B.Radius * UnitSimConstants::COLLISION_RADIUS_SCALE;
+	return TryGetFirstCollision(A.Position, A.Velocity, A.Radius, B.Position, B.Velocity, B.Radius, OutT, OutDistance);
+}
+
+bool AvoidanceSystem::TryGetFirstCollision(
+	const FVector2D& PositionA,
+	const FVector2D& VelocityA,
+	float RadiusA,
+	const FVector2D& PositionB,
+	const FVector2D& VelocityB,
+	float RadiusB,
+	float& OutT,
+	float& OutDistance)
+{
+	const float CombinedRadius = RadiusA * UnitSimConstants::COLLISION_RADIUS_SCALE
+		+ RadiusB * UnitSimConstants::COLLISION_RADIUS_SCALE;
 
-	const FVector2D RelPos = B.Position - A.Position;
-	const FVector2D RelVel = B.Velocity - A.Velocity;
+	const FVector2D RelPos = PositionB - PositionA;
+	const FVector2D RelVel = VelocityB - VelocityA;
 	const float RelSpeedSq = RelVel.SizeSquared();
 
 	if (RelSpeedSq < KINDA_SMALL_NUMBER)
@@ -65,12 +75,13 @@ bool AvoidanceSystem::TryGetFirstCollision(const FUnit& A, const FUnit& B, float
 FVector2D AvoidanceSystem::PredictiveAvoidanceVector(
 	FUnit& Mover,
 	int32 MoverIndex,
-	const FUnit* Others,
-	int32 OtherCount,
+	const FUnitHotStreams& Others,
 	const FVector2D& DesiredDirection,
 	FVector2D& OutAvoidanceTarget,
 	bool& bOutIsDetouring,
-	int32& OutThreatIndex)
+	int32& OutThreatIndex,
+	TArray<FAvoidanceRisk>& Risks,
+	int32* OutRisksEvaluated)
 {
 	OutAvoidanceTarget = FVector2D::ZeroVector;
 	OutThreatIndex = -1;
@@ -83,28 +94,34 @@ FVector2D AvoidanceSystem::PredictiveAvoidanceVector(
 		? SafeNormalize(DesiredDirection)
 		: (Mover.Velocity.SizeSquared() > 0.0001f ? SafeNormalize(Mover.Velocity) : Mover.Forward);
 
-	TArray<FAvoidanceRisk> Risks;
+	Risks.Reset();
+	int32 NumEvaluated = 0;
 
-	for (int32 i = 0; i < OtherCount; ++i)
+	for (int32 i = 0; i < Others.Num(); ++i)
 	{
 		if (i == MoverIndex) continue;
-		const FUnit& Other = Others[i];
-		if (Other.bIsDead) continue;
-		if (!Mover.IsSameLayer(Other)) continue;
+		if (Others.IsDead(i)) continue;
+		if (Others.GetLayer(i) != Mover.Layer) continue;
+		NumEvaluated++;
 
-		const float CombinedRadius = MoverRadius + Other.Radius * UnitSimConstants::COLLISION_RADIUS_SCALE;
-		const FVector2D RelativePos = Other.Position - Mover.Position;
-		const FVector2D RelativeVel = Other.Velocity - Mover.Velocity;
+		const FVector2D OtherPosition = Others.GetPosition(i);
+		const FVector2D OtherVelocity = Others.GetVelocity(i);
+		const float OtherRadius = Others.GetRadius(i);
+
+		const float CombinedRadius = MoverRadius + OtherRadius * UnitSimConstants::COLLISION_RADIUS_SCALE;
+		const FVector2D RelativePos = OtherPosition - Mover.Position;
+		const FVector2D RelativeVel = OtherVelocity - Mover.Velocity;
 		const float RelativeSpeedSq = RelativeVel.SizeSquared();
 
 		// Check predicted collision
 		float TCollision, CollisionDist;
-		if (TryGetFirstCollision(Mover, Other, TCollision, CollisionDist))
+		if (TryGetFirstCollision(Mover.Position, Mover.Velocity, Mover.Radius,
+			OtherPosition, OtherVelocity, OtherRadius, TCollision, CollisionDist))
 		{
 			const float CollisionWindow = FMath::Min((CombinedRadius * 2.f) / MinSpeed, UnitSimConstants::AVOIDANCE_MAX_LOOKAHEAD);
 			if (TCollision <= CollisionWindow)
 			{
-				const FVector2D RelAtCollision = (Other.Position + Other.Velocity * TCollision)
+				const FVector2D RelAtCollision = (OtherPosition + OtherVelocity * TCollision)
 					- (Mover.Position + Mover.Velocity * TCollision);
 				const float DistanceAtCollision = RelAtCollision.Size();
 				if (DistanceAtCollision > 0.0001f)
@@ -157,6 +174,11 @@ FVector2D AvoidanceSystem::PredictiveAvoidanceVector(
 		}
 	}
 
+	if (OutRisksEvaluated)
+	{
+		*OutRisksEvaluated = NumEvaluated;
+	}
+
 	if (Risks.Num() == 0)
 	{
 		Mover.ClearAvoidancePath();
@@ -180,11 +202,11 @@ FVector2D AvoidanceSystem::PredictiveAvoidanceVector(
 	float MinDistance = MinDist;
 	const float DesiredWeight = FMath::Clamp(MinDistance / (MoverRadius + 0.001f), 1.f, 3.f);
 
-	// Try segmented avoidance path
-	TArray<FVector2D> Path = BuildSegmentedAvoidancePath(Mover, BaseDesiredDir, PrimaryRisk);
-	if (Path.Num() > 0)
+	// Try segmented avoidance path, built straight into the mover's buffer
+	BuildSegmentedAvoidancePath(Mover, BaseDesiredDir, PrimaryRisk, Mover.AvoidancePath);
+	Mover.AvoidancePathIndex = 0;
+	if (Mover.AvoidancePath.Num() > 0)
 	{
-		Mover.SetAvoidancePath(Path);
 		FVector2D Waypoint;
 		if (Mover.TryGetNextAvoidanceWaypoint(Waypoint))
 		{
@@ -237,14 +259,15 @@ FVector2D AvoidanceSystem::PredictiveAvoidanceVector(
 	return Away * DesiredWeight;
 }
 
-TArray<FVector2D> AvoidanceSystem::BuildSegmentedAvoidancePath(
+void AvoidanceSystem::BuildSegmentedAvoidancePath(
 	const FUnit& Mover,
 	const FVector2D& BaseDir,
-	const FAvoidanceRisk& PrimaryRisk)
+	const FAvoidanceRisk& PrimaryRisk,
+	TArray<FVector2D>& OutPath)
 {
-	TArray<FVector2D> Path;
+	OutPath.Reset();
 	const int32 SegmentCount = UnitSimConstants::AVOIDANCE_SEGMENT_COUNT;
-	if (SegmentCount <= 0) return Path;
+	if (SegmentCount <= 0) return;
 
 	FVector2D Forward = BaseDir.SizeSquared() > 0.0001f ? BaseDir : Mover.Forward;
 	if (Forward.SizeSquared() < 0.0001f) Forward = FVector2D(1.0, 0.0);
@@ -260,7 +283,7 @@ TArray<FVector2D> AvoidanceSystem::BuildSegmentedAvoidancePath(
 	const float ParallelDistance = FMath::Max(PrimaryRisk.Distance, Mover.Radius * 2.f) * UnitSimConstants::AVOIDANCE_PARALLEL_DISTANCE_MULTIPLIER;
 
 	FVector2D Current = Mover.Position + Forward * StartDistance;
-	Path.Add(Current);
+	OutPath.Add(Current);
 
 	for (int32 Segment = 0; Segment < SegmentCount; ++Segment)
 	{
@@ -277,10 +300,8 @@ TArray<FVector2D> AvoidanceSystem::BuildSegmentedAvoidancePath(
 			Current -= Lateral * LateralDistance;
 			break;
 		}
-		Path.Add(Current);
+		OutPath.Add(Current);
 	}
-
-	return Path;
 }
 
 bool AvoidanceSystem::IsDirectionClear(
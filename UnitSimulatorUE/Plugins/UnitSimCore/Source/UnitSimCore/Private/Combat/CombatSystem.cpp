@@ -1,6 +1,7 @@
 #include "Combat/CombatSystem.h"
 #include "Units/Unit.h"
 #include "Abilities/AbilityTypes.h"
+#include "Math/SimMath.h"
 
 void FCombatSystem::CollectAttackEvents(
 	FUnit& Attacker,
@@ -15,7 +16,7 @@ void FCombatSystem::CollectAttackEvents(
 	const int32 Damage = Attacker.GetEffectiveDamage();
 
 	// Primary target damage event
-	Events.AddDamage(AttackerIndex, TargetIndex, Damage, EDamageType::Normal);
+	Events.AddDamage(AttackerIndex, Target.Faction, FUnitHandle::Make(AllEnemies, TargetIndex), Damage, EDamageType::Normal);
 
 	// Splash damage events
 	if (Attacker.bHasSplashDamage)
@@ -45,7 +46,7 @@ void FCombatSystem::CollectSplashDamage(
 		if (i == MainTargetIndex || Enemy.bIsDead) continue;
 		if (!Attacker.CanAttackUnit(Enemy)) continue;
 
-		const float Distance = FVector2D::Distance(MainTargetPosition, Enemy.Position);
+		const float Distance = SimMath::Distance(MainTargetPosition, Enemy.Position);
 		if (Distance > SplashData.Radius) continue;
 
 		// Distance-based damage falloff
@@ -58,46 +59,44 @@ void FCombatSystem::CollectSplashDamage(
 
 		if (SplashDamage > 0)
 		{
-			Events.AddDamage(AttackerIndex, i, SplashDamage, EDamageType::Splash);
+			Events.AddDamage(AttackerIndex, Enemy.Faction, FUnitHandle::Make(AllEnemies, i), SplashDamage, EDamageType::Splash);
 		}
 	}
 }
 
-TArray<FUnitSpawnRequest> FCombatSystem::CreateDeathSpawnRequests(const FUnit& DeadUnit)
+void FCombatSystem::CreateDeathSpawnRequests(const FUnit& DeadUnit, TArray<FUnitSpawnRequest>& OutSpawns)
 {
-	TArray<FUnitSpawnRequest> Spawns;
+	OutSpawns.Reset();
 
-	if (!DeadUnit.bHasDeathSpawn) return Spawns;
+	if (!DeadUnit.bHasDeathSpawn) return;
 
 	const FDeathSpawnData& SpawnData = DeadUnit.DeathSpawnAbility;
-	if (SpawnData.SpawnCount <= 0) return Spawns;
+	if (SpawnData.SpawnCount <= 0) return;
 
-	Spawns.Reserve(SpawnData.SpawnCount);
+	OutSpawns.Reserve(SpawnData.SpawnCount);
 	for (int32 i = 0; i < SpawnData.SpawnCount; ++i)
 	{
 		const float Angle = (2.f * UE_PI / SpawnData.SpawnCount) * i;
-		const FVector2D Offset(FMath::Cos(Angle), FMath::Sin(Angle));
-		const FVector2D SpawnPos = DeadUnit.Position + Offset * SpawnData.SpawnRadius;
+		const FVector2D Offset(SimMath::Cos(Angle), SimMath::Sin(Angle));
+		const FVector2D SpawnPos = SimMath::Quantize(DeadUnit.Position + Offset * SpawnData.SpawnRadius);
 
 		FUnitSpawnRequest Request;
 		Request.UnitId = SpawnData.SpawnUnitId;
 		Request.Position = SpawnPos;
 		Request.Faction = DeadUnit.Faction;
 		Request.HP = SpawnData.SpawnUnitHP;
-		Spawns.Add(Request);
+		OutSpawns.Add(Request);
 	}
-
-	return Spawns;
 }
 
-TArray<int32> FCombatSystem::ApplyDeathDamage(const FUnit& DeadUnit, TArray<FUnit>& Enemies)
+void FCombatSystem::ApplyDeathDamage(const FUnit& DeadUnit, TArray<FUnit>& Enemies, TArray<int32>& OutNewlyDead)
 {
-	TArray<int32> NewlyDead;
+	OutNewlyDead.Reset();
 
-	if (!DeadUnit.bHasDeathDamage) return NewlyDead;
+	if (!DeadUnit.bHasDeathDamage) return;
 
 	const FDeathDamageData& DmgData = DeadUnit.DeathDamageAbility;
-	if (DmgData.Damage <= 0) return NewlyDead;
+	if (DmgData.Damage <= 0) return;
 
 	for (int32 i = 0; i < Enemies.Num(); ++i)
 	{
@@ -124,11 +123,9 @@ TArray<int32> FCombatSystem::ApplyDeathDamage(const FUnit& DeadUnit, TArray<FUni
 
 		if (bWasAlive && Enemy.bIsDead)
 		{
-			NewlyDead.Add(i);
+			OutNewlyDead.Add(i);
 		}
 	}
-
-	return NewlyDead;
 }
 
 void FCombatSystem::UpdateChargeState(FUnit& Unit, int32 TargetIndex, const TArray<FUnit>& AllUnits)
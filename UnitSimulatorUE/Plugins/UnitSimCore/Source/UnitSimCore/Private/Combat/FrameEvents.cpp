@@ -1,10 +1,13 @@
 #include "Combat/FrameEvents.h"
 
-void FFrameEvents::AddDamage(int32 SourceIndex, int32 TargetIndex, int32 Amount, EDamageType Type)
+void FFrameEvents::AddDamage(int32 SourceIndex, EUnitFaction TargetFaction, const FUnitHandle& Target, int32 Amount,
+	EDamageType Type)
 {
 	FSimDamageEvent Event;
 	Event.SourceIndex = SourceIndex;
-	Event.TargetIndex = TargetIndex;
+	Event.TargetIndex = Target.Index;
+	Event.TargetId = Target.Generation;
+	Event.TargetFaction = TargetFaction;
 	Event.Amount = Amount;
 	Event.Type = Type;
 	Damages.Add(Event);
@@ -15,11 +18,13 @@ void FFrameEvents::AddSpawn(const FUnitSpawnRequest& Spawn)
 	Spawns.Add(Spawn);
 }
 
-void FFrameEvents::AddTowerDamage(int32 SourceTowerIndex, int32 TargetIndex, int32 Amount)
+void FFrameEvents::AddTowerDamage(int32 SourceTowerIndex, EUnitFaction TargetFaction, const FUnitHandle& Target, int32 Amount)
 {
 	FTowerDamageEvent Event;
 	Event.SourceTowerIndex = SourceTowerIndex;
-	Event.TargetIndex = TargetIndex;
+	Event.TargetIndex = Target.Index;
+	Event.TargetId = Target.Generation;
+	Event.TargetFaction = TargetFaction;
 	Event.Amount = Amount;
 	TowerDamages.Add(Event);
 }
@@ -33,10 +38,18 @@ void FFrameEvents::AddDamageToTower(int32 SourceIndex, int32 TargetTowerIndex, i
 	DamageToTowers.Add(Event);
 }
 
+void FFrameEvents::Append(const FFrameEvents& Other)
+{
+	Damages.Append(Other.Damages);
+	Spawns.Append(Other.Spawns);
+	TowerDamages.Append(Other.TowerDamages);
+	DamageToTowers.Append(Other.DamageToTowers);
+}
+
 void FFrameEvents::Clear()
 {
-	Damages.Empty();
-	Spawns.Empty();
-	TowerDamages.Empty();
-	DamageToTowers.Empty();
+	Damages.Reset();
+	Spawns.Reset();
+	TowerDamages.Reset();
+	DamageToTowers.Reset();
 }
@@ -0,0 +1,110 @@
+#include "Combat/UnitSpatialGrid.h"
+#include "Units/Unit.h"
+
+void FUnitSpatialGrid::Build(const TArray<FUnit*>& Units, double InCellSize, double InSlack)
+{
+	const int32 Count = Units.Num();
+	SlackSquared = InSlack * InSlack;
+
+	UnitCells.Reset();
+	UnitCells.SetNumUninitialized(Count);
+	BuildPositions.Reset();
+	BuildPositions.SetNumUninitialized(Count);
+	CellEntries.Reset();
+	CellEntries.SetNumUninitialized(Count);
+
+	if (Count == 0)
+	{
+		CellsX = 0;
+		CellsY = 0;
+		CellStart.Reset();
+		CellStart.Add(0);
+		return;
+	}
+
+	// Bounds of the current unit set
+	FVector2D Min = Units[0]->Position;
+	FVector2D Max = Units[0]->Position;
+	for (int32 i = 1; i < Count; ++i)
+	{
+		const FVector2D& P = Units[i]->Position;
+		Min.X = FMath::Min(Min.X, P.X);
+		Min.Y = FMath::Min(Min.Y, P.Y);
+		Max.X = FMath::Max(Max.X, P.X);
+		Max.Y = FMath::Max(Max.Y, P.Y);
+	}
+
+	// Larger cells only add candidates, so growing the cell to cap the grid size stays correct
+	const double Extent = FMath::Max(Max.X - Min.X, Max.Y - Min.Y);
+	CellSize = FMath::Max3(InCellSize, Extent / static_cast<double>(MaxCellsPerAxis - 1), 1.0);
+	Origin = Min;
+	CellsX = static_cast<int32>((Max.X - Min.X) / CellSize) + 1;
+	CellsY = static_cast<int32>((Max.Y - Min.Y) / CellSize) + 1;
+
+	// Counting sort by cell; iterating units in order keeps each cell ascending
+	const int32 NumCells = NumLayers * CellsX * CellsY;
+	CellStart.Reset();
+	CellStart.SetNumZeroed(NumCells + 1);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FUnit& Unit = *Units[i];
+		const int32 X = FMath::Clamp(static_cast<int32>((Unit.Position.X - Origin.X) / CellSize), 0, CellsX - 1);
+		const int32 Y = FMath::Clamp(static_cast<int32>((Unit.Position.Y - Origin.Y) / CellSize), 0, CellsY - 1);
+		const int32 Layer = FMath::Clamp(static_cast<int32>(Unit.Layer), 0, NumLayers - 1);
+
+		UnitCells[i] = GetCellIndex(Layer, X, Y);
+		BuildPositions[i] = Unit.Position;
+		++CellStart[UnitCells[i] + 1];
+	}
+
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		CellStart[Cell + 1] += CellStart[Cell];
+	}
+
+	CellCursor.Reset();
+	CellCursor.Append(CellStart.GetData(), NumCells);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		CellEntries[CellCursor[UnitCells[i]]++] = i;
+	}
+}
+
+void FUnitSpatialGrid::GatherNeighbors(int32 Index, int32 MinIndex, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	if (!UnitCells.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	const int32 Cell = UnitCells[Index];
+	const int32 Layer = Cell / (CellsX * CellsY);
+	const int32 Local = Cell - Layer * CellsX * CellsY;
+	const int32 CX = Local % CellsX;
+	const int32 CY = Local / CellsX;
+
+	for (int32 Y = FMath::Max(CY - 1, 0); Y <= FMath::Min(CY + 1, CellsY - 1); ++Y)
+	{
+		for (int32 X = FMath::Max(CX - 1, 0); X <= FMath::Min(CX + 1, CellsX - 1); ++X)
+		{
+			const int32 Neighbor = GetCellIndex(Layer, X, Y);
+			for (int32 e = CellStart[Neighbor]; e < CellStart[Neighbor + 1]; ++e)
+			{
+				if (CellEntries[e] > MinIndex)
+				{
+					OutIndices.Add(CellEntries[e]);
+				}
+			}
+		}
+	}
+
+	OutIndices.Sort();
+}
+
+bool FUnitSpatialGrid::HasDrifted(int32 Index, const FVector2D& Position) const
+{
+	return !BuildPositions.IsValidIndex(Index)
+		|| FVector2D::DistSquared(BuildPositions[Index], Position) > SlackSquared;
+}
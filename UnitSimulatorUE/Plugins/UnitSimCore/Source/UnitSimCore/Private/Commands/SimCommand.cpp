@@ -0,0 +1,30 @@
+#include "Commands/SimCommand.h"
+
+int32 FSimCommand::GetFrameNumber() const
+{
+	return Visit([](const auto& Cmd) { return Cmd.FrameNumber; }, Payload);
+}
+
+void FSimCommand::Serialize(FArchive& Ar)
+{
+	uint8 RawType = static_cast<uint8>(GetType());
+	Ar << RawType;
+
+	switch (static_cast<ESimCommandType>(RawType))
+	{
+	case ESimCommandType::Spawn:     if (Ar.IsLoading()) Payload.Emplace<FSpawnUnitCommand>(); break;
+	case ESimCommandType::Move:      if (Ar.IsLoading()) Payload.Emplace<FMoveUnitCommand>(); break;
+	case ESimCommandType::Damage:    if (Ar.IsLoading()) Payload.Emplace<FDamageUnitCommand>(); break;
+	case ESimCommandType::Kill:      if (Ar.IsLoading()) Payload.Emplace<FKillUnitCommand>(); break;
+	case ESimCommandType::Revive:    if (Ar.IsLoading()) Payload.Emplace<FReviveUnitCommand>(); break;
+	case ESimCommandType::SetHealth: if (Ar.IsLoading()) Payload.Emplace<FSetUnitHealthCommand>(); break;
+	case ESimCommandType::Remove:    if (Ar.IsLoading()) Payload.Emplace<FRemoveUnitCommand>(); break;
+	default:                         Ar.SetError(); return;
+	}
+
+	Visit([&Ar](auto& Cmd)
+	{
+		using FCommandStruct = std::decay_t<decltype(Cmd)>;
+		FCommandStruct::StaticStruct()->SerializeBin(Ar, &Cmd);
+	}, Payload);
+}
@@ -0,0 +1,84 @@
+#include "Commands/SimCommandRing.h"
+
+FSimCommandRing::FSimCommandRing(int32 InCapacity)
+{
+	const uint64 Capacity = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(2, InCapacity)));
+	Mask = Capacity - 1;
+	Cells = MakeUnique<FCell[]>(Capacity);
+	for (uint64 i = 0; i < Capacity; ++i)
+	{
+		Cells[i].Sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+bool FSimCommandRing::Claim(uint64 Count, uint64& OutPos)
+{
+	uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		// The consumer frees slots in order, so the last slot being free for this lap frees them all
+		const uint64 Last = Pos + Count - 1;
+		const uint64 Sequence = Cells[Last & Mask].Sequence.load(std::memory_order_acquire);
+		const int64 Diff = static_cast<int64>(Sequence - Last);
+		if (Diff == 0)
+		{
+			if (EnqueuePos.compare_exchange_weak(Pos, Pos + Count, std::memory_order_relaxed))
+			{
+				OutPos = Pos;
+				return true;
+			}
+		}
+		else if (Diff < 0)
+		{
+			return false;
+		}
+		else
+		{
+			Pos = EnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool FSimCommandRing::Push(const FSimCommand& Command)
+{
+	uint64 Pos = 0;
+	if (!Claim(1, Pos)) return false;
+
+	FCell& Cell = Cells[Pos & Mask];
+	Cell.Command = Command;
+	Cell.Sequence.store(Pos + 1, std::memory_order_release);
+	return true;
+}
+
+bool FSimCommandRing::PushBulk(TConstArrayView<FSimCommand> Commands)
+{
+	const uint64 Count = Commands.Num();
+	if (Count == 0) return true;
+	if (Count > Mask + 1) return false;
+
+	uint64 Pos = 0;
+	if (!Claim(Count, Pos)) return false;
+
+	// Published in order; the consumer stops at the first slot not yet written
+	for (uint64 i = 0; i < Count; ++i)
+	{
+		FCell& Cell = Cells[(Pos + i) & Mask];
+		Cell.Command = Commands[i];
+		Cell.Sequence.store(Pos + i + 1, std::memory_order_release);
+	}
+	return true;
+}
+
+bool FSimCommandRing::Pop(FSimCommand& OutCommand)
+{
+	FCell& Cell = Cells[DequeuePos & Mask];
+	if (Cell.Sequence.load(std::memory_order_acquire) != DequeuePos + 1)
+	{
+		return false;
+	}
+
+	OutCommand = Cell.Command;
+	Cell.Sequence.store(DequeuePos + Mask + 1, std::memory_order_release);
+	++DequeuePos;
+	return true;
+}
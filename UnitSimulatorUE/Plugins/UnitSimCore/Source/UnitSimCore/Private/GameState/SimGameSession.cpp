@@ -22,8 +22,11 @@ void FSimGameSession::InitializeTowers(const TArray<FTowerSetup>& TowerSetups)
 		}
 	}
 
-	// Reset session state
+	// Reset session state; a custom game time is re-applied by the caller for each match
+	const FGameTimeSetup DefaultTime;
 	ElapsedTime = 0.f;
+	RegularTime = DefaultTime.RegularTime;
+	MaxGameTime = DefaultTime.MaxGameTime;
 	FriendlyCrowns = 0;
 	EnemyCrowns = 0;
 	Result = EGameResult::InProgress;
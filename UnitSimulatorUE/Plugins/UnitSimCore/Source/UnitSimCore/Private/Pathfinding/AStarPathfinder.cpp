@@ -9,10 +9,11 @@ FAStarPathfinder::FAStarPathfinder(FPathfindingGrid& InGrid)
 
 bool FAStarPathfinder::FindPath(const FVector2D& StartWorldPos, const FVector2D& EndWorldPos, TArray<FVector2D>& OutPath)
 {
-	OutPath.Empty();
+	OutPath.Reset();
+	Stats.Searches++;
 
-	FPathNode* StartNode = Grid.NodeFromWorldPoint(StartWorldPos);
-	FPathNode* EndNode = Grid.NodeFromWorldPoint(EndWorldPos);
+	const FPathNode* StartNode = Grid.NodeFromWorldPoint(StartWorldPos);
+	const FPathNode* EndNode = Grid.NodeFromWorldPoint(EndWorldPos);
 
 	if (StartNode == nullptr || EndNode == nullptr ||
 		!StartNode->bIsWalkable || !EndNode->bIsWalkable)
@@ -20,45 +21,27 @@ bool FAStarPathfinder::FindPath(const FVector2D& StartWorldPos, const FVector2D&
 		return false;
 	}
 
-	const int32 StartIndex = ToFlatIndex(StartNode->X, StartNode->Y);
-	const int32 EndIndex = ToFlatIndex(EndNode->X, EndNode->Y);
+	BeginSearch();
 
-	TArray<int32> OpenList;
-	TSet<int32> ClosedSet;
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+	const int32 Width = PreparedWidth;
+	const int32 Height = PreparedHeight;
+	const int32 StartIndex = StartNode->X + StartNode->Y * Width;
+	const int32 EndIndex = EndNode->X + EndNode->Y * Width;
 
-	Grid.ResetAllNodes();
+	FSearchNode& Start = Touch(StartIndex);
+	Start.GCost = 0;
+	Start.HCost = CalculateDistanceCost(*StartNode, *EndNode);
+	HeapPush(StartIndex);
 
-	StartNode->GCost = 0;
-	StartNode->HCost = CalculateDistanceCost(*StartNode, *EndNode);
-	OpenList.Add(StartIndex);
-
-	TArray<int32> NeighborIndices;
-
-	while (OpenList.Num() > 0)
+	if (SearchMode == EPathSearchMode::JumpPoint)
 	{
-		// Find node with lowest FCost in open list
-		int32 BestOpenIdx = 0;
-		const FPathNode* BestNode = Grid.GetNode(
-			OpenList[0] % Grid.GetWidth(),
-			OpenList[0] / Grid.GetWidth());
-
-		for (int32 i = 1; i < OpenList.Num(); ++i)
-		{
-			const int32 Idx = OpenList[i];
-			const FPathNode* CandidateNode = Grid.GetNode(
-				Idx % Grid.GetWidth(),
-				Idx / Grid.GetWidth());
-
-			if (CandidateNode->GetFCost() < BestNode->GetFCost() ||
-				(CandidateNode->GetFCost() == BestNode->GetFCost() &&
-				 CandidateNode->HCost < BestNode->HCost))
-			{
-				BestNode = CandidateNode;
-				BestOpenIdx = i;
-			}
-		}
+		return FindPathJumpPoint(StartIndex, EndIndex, OutPath);
+	}
 
-		const int32 CurrentIndex = OpenList[BestOpenIdx];
+	while (OpenHeap.Num() > 0)
+	{
+		const int32 CurrentIndex = HeapPop();
 
 		if (CurrentIndex == EndIndex)
 		{
@@ -66,37 +49,47 @@ bool FAStarPathfinder::FindPath(const FVector2D& StartWorldPos, const FVector2D&
 			return true;
 		}
 
-		OpenList.RemoveAt(BestOpenIdx);
-		ClosedSet.Add(CurrentIndex);
-
-		const FPathNode* CurrentNode = Grid.GetNode(
-			CurrentIndex % Grid.GetWidth(),
-			CurrentIndex / Grid.GetWidth());
+		SearchNodes[CurrentIndex].bClosed = true;
+		Stats.NodesExpanded++;
 
-		NeighborIndices.Reset();
-		GetNeighbors(*CurrentNode, NeighborIndices);
+		const FPathNode& CurrentNode = Nodes[CurrentIndex];
+		const int32 CurrentGCost = SearchNodes[CurrentIndex].GCost;
 
-		for (const int32 NeighborIndex : NeighborIndices)
+		for (const FNeighborStep& Step : NeighborSteps)
 		{
-			FPathNode* NeighborNode = Grid.GetNode(
-				NeighborIndex % Grid.GetWidth(),
-				NeighborIndex / Grid.GetWidth());
+			const int32 NX = CurrentNode.X + Step.DX;
+			const int32 NY = CurrentNode.Y + Step.DY;
+			if (NX < 0 || NX >= Width || NY < 0 || NY >= Height) continue;
+
+			// Prevent corner cutting through unwalkable tiles
+			if (Step.DX != 0 && Step.DY != 0 &&
+				(!Nodes[CurrentIndex + Step.DX].bIsWalkable || !Nodes[CurrentIndex + Step.DY * Width].bIsWalkable))
+			{
+				continue;
+			}
 
-			if (!NeighborNode->bIsWalkable || ClosedSet.Contains(NeighborIndex))
+			const int32 NeighborIndex = CurrentIndex + Step.Offset;
+			const FPathNode& NeighborNode = Nodes[NeighborIndex];
+			if (!NeighborNode.bIsWalkable || IsClosed(NeighborIndex))
 			{
 				continue;
 			}
 
-			const int32 TentativeGCost = CurrentNode->GCost + CalculateDistanceCost(*CurrentNode, *NeighborNode);
-			if (TentativeGCost < NeighborNode->GCost)
+			const int32 TentativeGCost = CurrentGCost + Step.Cost;
+			FSearchNode& Neighbor = Touch(NeighborIndex);
+			if (TentativeGCost < Neighbor.GCost)
 			{
-				NeighborNode->CameFromNodeIndex = CurrentIndex;
-				NeighborNode->GCost = TentativeGCost;
-				NeighborNode->HCost = CalculateDistanceCost(*NeighborNode, *EndNode);
+				Neighbor.CameFrom = CurrentIndex;
+				Neighbor.GCost = TentativeGCost;
+				Neighbor.HCost = CalculateDistanceCost(NeighborNode, *EndNode);
 
-				if (!OpenList.Contains(NeighborIndex))
+				if (Neighbor.HeapIndex == INDEX_NONE)
+				{
+					HeapPush(NeighborIndex);
+				}
+				else
 				{
-					OpenList.Add(NeighborIndex);
+					HeapSiftUp(Neighbor.HeapIndex);
 				}
 			}
 		}
@@ -105,70 +98,380 @@ bool FAStarPathfinder::FindPath(const FVector2D& StartWorldPos, const FVector2D&
 	return false;
 }
 
-void FAStarPathfinder::RetracePath(int32 StartNodeIndex, int32 EndNodeIndex, TArray<FVector2D>& OutPath)
+void FAStarPathfinder::BeginSearch()
 {
-	TArray<int32> PathIndices;
-	int32 CurrentIndex = EndNodeIndex;
-
-	while (CurrentIndex != -1 && CurrentIndex != StartNodeIndex)
+	const int32 Width = Grid.GetWidth();
+	const int32 Height = Grid.GetHeight();
+	if (Width != PreparedWidth || Height != PreparedHeight)
 	{
-		PathIndices.Add(CurrentIndex);
-		const FPathNode* Node = Grid.GetNode(
-			CurrentIndex % Grid.GetWidth(),
-			CurrentIndex / Grid.GetWidth());
-		CurrentIndex = Node->CameFromNodeIndex;
+		PreparedWidth = Width;
+		PreparedHeight = Height;
+		SearchNodes.Init(FSearchNode(), Width * Height);
+		SearchGeneration = 0;
+
+		// Same order as the original DX-outer, DY-inner loops, so ties resolve identically
+		int32 StepIndex = 0;
+		for (int32 DX = -1; DX <= 1; ++DX)
+		{
+			for (int32 DY = -1; DY <= 1; ++DY)
+			{
+				if (DX == 0 && DY == 0) continue;
+
+				FNeighborStep& Step = NeighborSteps[StepIndex++];
+				Step.DX = DX;
+				Step.DY = DY;
+				Step.Offset = DX + DY * Width;
+				Step.Cost = (DX != 0 && DY != 0) ? 14 : 10;
+			}
+		}
 	}
 
-	// Reverse to get start-to-end order
-	OutPath.Reserve(PathIndices.Num());
-	for (int32 i = PathIndices.Num() - 1; i >= 0; --i)
+	// On wrap-around, stale stamps could collide with new ones
+	if (++SearchGeneration == 0)
 	{
-		const FPathNode* Node = Grid.GetNode(
-			PathIndices[i] % Grid.GetWidth(),
-			PathIndices[i] / Grid.GetWidth());
-		OutPath.Add(Node->WorldPosition);
+		for (FSearchNode& Node : SearchNodes)
+		{
+			Node.Generation = 0;
+		}
+		SearchGeneration = 1;
 	}
+
+	OpenHeap.Reset();
+	NextSequence = 0;
 }
 
-int32 FAStarPathfinder::CalculateDistanceCost(const FPathNode& A, const FPathNode& B)
+FAStarPathfinder::FSearchNode& FAStarPathfinder::Touch(int32 NodeIndex)
 {
-	const int32 XDistance = FMath::Abs(A.X - B.X);
-	const int32 YDistance = FMath::Abs(A.Y - B.Y);
-	const int32 Remaining = FMath::Abs(XDistance - YDistance);
-	return 14 * FMath::Min(XDistance, YDistance) + 10 * Remaining;
+	FSearchNode& Node = SearchNodes[NodeIndex];
+	if (Node.Generation != SearchGeneration)
+	{
+		Node.GCost = TNumericLimits<int32>::Max();
+		Node.HCost = 0;
+		Node.CameFrom = INDEX_NONE;
+		Node.HeapIndex = INDEX_NONE;
+		Node.Generation = SearchGeneration;
+		Node.bClosed = false;
+	}
+	return Node;
 }
 
-void FAStarPathfinder::GetNeighbors(const FPathNode& Node, TArray<int32>& OutNeighborIndices)
+// ============================================================================
+// Jump Point Search
+// ============================================================================
+
+bool FAStarPathfinder::FindPathJumpPoint(int32 StartIndex, int32 EndIndex, TArray<FVector2D>& OutPath)
 {
-	for (int32 DX = -1; DX <= 1; ++DX)
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+	const FPathNode& EndNode = Nodes[EndIndex];
+
+	while (OpenHeap.Num() > 0)
 	{
-		for (int32 DY = -1; DY <= 1; ++DY)
+		const int32 CurrentIndex = HeapPop();
+
+		if (CurrentIndex == EndIndex)
 		{
-			if (DX == 0 && DY == 0) continue;
+			RetraceJumpPath(StartIndex, EndIndex, OutPath);
+			return true;
+		}
 
-			const int32 NX = Node.X + DX;
-			const int32 NY = Node.Y + DY;
-			const FPathNode* Neighbor = Grid.GetNode(NX, NY);
-			if (Neighbor == nullptr) continue;
+		SearchNodes[CurrentIndex].bClosed = true;
+		Stats.NodesExpanded++;
 
-			// Prevent corner cutting through unwalkable tiles
+		const FPathNode& CurrentNode = Nodes[CurrentIndex];
+		const int32 X = CurrentNode.X;
+		const int32 Y = CurrentNode.Y;
+		const int32 CurrentGCost = SearchNodes[CurrentIndex].GCost;
+
+		// Pruned directions: all eight from the start, otherwise the natural and
+		// forced neighbors of the direction we arrived in
+		int32 Directions[8][2];
+		int32 NumDirections = 0;
+		auto AddDirection = [&Directions, &NumDirections](int32 DX, int32 DY)
+		{
+			Directions[NumDirections][0] = DX;
+			Directions[NumDirections][1] = DY;
+			NumDirections++;
+		};
+
+		const int32 ParentIndex = SearchNodes[CurrentIndex].CameFrom;
+		if (ParentIndex == INDEX_NONE)
+		{
+			for (const FNeighborStep& Step : NeighborSteps)
+			{
+				if (Step.DX != 0 && Step.DY != 0 && (!IsWalkable(X + Step.DX, Y) || !IsWalkable(X, Y + Step.DY))) continue;
+				AddDirection(Step.DX, Step.DY);
+			}
+		}
+		else
+		{
+			const int32 DX = FMath::Sign(X - Nodes[ParentIndex].X);
+			const int32 DY = FMath::Sign(Y - Nodes[ParentIndex].Y);
 			if (DX != 0 && DY != 0)
 			{
-				const FPathNode* Horizontal = Grid.GetNode(Node.X + DX, Node.Y);
-				const FPathNode* Vertical = Grid.GetNode(Node.X, Node.Y + DY);
-				if (Horizontal != nullptr && Vertical != nullptr &&
-					(!Horizontal->bIsWalkable || !Vertical->bIsWalkable))
+				const bool bVertical = IsWalkable(X, Y + DY);
+				const bool bHorizontal = IsWalkable(X + DX, Y);
+				if (bVertical) AddDirection(0, DY);
+				if (bHorizontal) AddDirection(DX, 0);
+				if (bVertical && bHorizontal) AddDirection(DX, DY);
+			}
+			else if (DX != 0)
+			{
+				const bool bNext = IsWalkable(X + DX, Y);
+				const bool bUp = IsWalkable(X, Y + 1);
+				const bool bDown = IsWalkable(X, Y - 1);
+				if (bNext)
+				{
+					AddDirection(DX, 0);
+					if (bUp) AddDirection(DX, 1);
+					if (bDown) AddDirection(DX, -1);
+				}
+				if (bUp) AddDirection(0, 1);
+				if (bDown) AddDirection(0, -1);
+			}
+			else
+			{
+				const bool bNext = IsWalkable(X, Y + DY);
+				const bool bRight = IsWalkable(X + 1, Y);
+				const bool bLeft = IsWalkable(X - 1, Y);
+				if (bNext)
 				{
-					continue;
+					AddDirection(0, DY);
+					if (bRight) AddDirection(1, DY);
+					if (bLeft) AddDirection(-1, DY);
 				}
+				if (bRight) AddDirection(1, 0);
+				if (bLeft) AddDirection(-1, 0);
 			}
+		}
 
-			OutNeighborIndices.Add(ToFlatIndex(NX, NY));
+		for (int32 i = 0; i < NumDirections; ++i)
+		{
+			const int32 JumpIndex = Jump(X + Directions[i][0], Y + Directions[i][1], Directions[i][0], Directions[i][1], EndIndex);
+			if (JumpIndex == INDEX_NONE || IsClosed(JumpIndex))
+			{
+				continue;
+			}
+
+			// Runs are straight or diagonal, so the octile distance is their exact cost
+			const FPathNode& JumpNode = Nodes[JumpIndex];
+			const int32 TentativeGCost = CurrentGCost + CalculateDistanceCost(CurrentNode, JumpNode);
+			FSearchNode& Neighbor = Touch(JumpIndex);
+			if (TentativeGCost < Neighbor.GCost)
+			{
+				Neighbor.CameFrom = CurrentIndex;
+				Neighbor.GCost = TentativeGCost;
+				Neighbor.HCost = CalculateDistanceCost(JumpNode, EndNode);
+
+				if (Neighbor.HeapIndex == INDEX_NONE)
+				{
+					HeapPush(JumpIndex);
+				}
+				else
+				{
+					HeapSiftUp(Neighbor.HeapIndex);
+				}
+			}
 		}
 	}
+
+	return false;
 }
 
-int32 FAStarPathfinder::ToFlatIndex(int32 X, int32 Y) const
+int32 FAStarPathfinder::Jump(int32 X, int32 Y, int32 DX, int32 DY, int32 EndIndex) const
 {
-	return X + Y * Grid.GetWidth();
+	const int32 Width = PreparedWidth;
+	while (true)
+	{
+		if (!IsWalkable(X, Y))
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 Index = X + Y * Width;
+		if (Index == EndIndex)
+		{
+			return Index;
+		}
+
+		if (DX != 0 && DY != 0)
+		{
+			// A diagonal run stops where one of its straight runs would find something
+			if (Jump(X + DX, Y, DX, 0, EndIndex) != INDEX_NONE || Jump(X, Y + DY, 0, DY, EndIndex) != INDEX_NONE)
+			{
+				return Index;
+			}
+
+			// Prevent corner cutting through unwalkable tiles
+			if (!IsWalkable(X + DX, Y) || !IsWalkable(X, Y + DY))
+			{
+				return INDEX_NONE;
+			}
+		}
+		else if (DX != 0)
+		{
+			// Forced neighbor: a side cell the row behind could not step to without cutting a corner
+			if ((IsWalkable(X, Y - 1) && !IsWalkable(X - DX, Y - 1)) ||
+				(IsWalkable(X, Y + 1) && !IsWalkable(X - DX, Y + 1)))
+			{
+				return Index;
+			}
+		}
+		else
+		{
+			if ((IsWalkable(X - 1, Y) && !IsWalkable(X - 1, Y - DY)) ||
+				(IsWalkable(X + 1, Y) && !IsWalkable(X + 1, Y - DY)))
+			{
+				return Index;
+			}
+		}
+
+		X += DX;
+		Y += DY;
+	}
+}
+
+bool FAStarPathfinder::IsWalkable(int32 X, int32 Y) const
+{
+	return X >= 0 && X < PreparedWidth && Y >= 0 && Y < PreparedHeight &&
+		Grid.GetNodes()[X + Y * PreparedWidth].bIsWalkable;
+}
+
+void FAStarPathfinder::RetraceJumpPath(int32 StartNodeIndex, int32 EndNodeIndex, TArray<FVector2D>& OutPath)
+{
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+
+	int32 Length = 0;
+	for (int32 CurrentIndex = EndNodeIndex; CurrentIndex != StartNodeIndex; CurrentIndex = SearchNodes[CurrentIndex].CameFrom)
+	{
+		const FPathNode& Current = Nodes[CurrentIndex];
+		const FPathNode& Parent = Nodes[SearchNodes[CurrentIndex].CameFrom];
+		Length += FMath::Max(FMath::Abs(Current.X - Parent.X), FMath::Abs(Current.Y - Parent.Y));
+	}
+
+	// Fill back to front, walking each run from its end toward its jump-point parent
+	OutPath.SetNumUninitialized(Length);
+	int32 Write = Length;
+	for (int32 CurrentIndex = EndNodeIndex; CurrentIndex != StartNodeIndex; CurrentIndex = SearchNodes[CurrentIndex].CameFrom)
+	{
+		const FPathNode& Current = Nodes[CurrentIndex];
+		const FPathNode& Parent = Nodes[SearchNodes[CurrentIndex].CameFrom];
+		const int32 StepX = FMath::Sign(Parent.X - Current.X);
+		const int32 StepY = FMath::Sign(Parent.Y - Current.Y);
+		for (int32 X = Current.X, Y = Current.Y; X != Parent.X || Y != Parent.Y; X += StepX, Y += StepY)
+		{
+			OutPath[--Write] = Nodes[X + Y * PreparedWidth].WorldPosition;
+		}
+	}
+}
+
+// ============================================================================
+// Open Heap
+// ============================================================================
+
+bool FAStarPathfinder::HeapLess(int32 A, int32 B) const
+{
+	const FSearchNode& NodeA = SearchNodes[A];
+	const FSearchNode& NodeB = SearchNodes[B];
+	const int32 FCostA = NodeA.GCost + NodeA.HCost;
+	const int32 FCostB = NodeB.GCost + NodeB.HCost;
+	if (FCostA != FCostB) return FCostA < FCostB;
+	if (NodeA.HCost != NodeB.HCost) return NodeA.HCost < NodeB.HCost;
+	return NodeA.Sequence < NodeB.Sequence;
+}
+
+void FAStarPathfinder::HeapPush(int32 NodeIndex)
+{
+	FSearchNode& Node = SearchNodes[NodeIndex];
+	Node.Sequence = NextSequence++;
+	Node.HeapIndex = OpenHeap.Add(NodeIndex);
+	HeapSiftUp(Node.HeapIndex);
+}
+
+int32 FAStarPathfinder::HeapPop()
+{
+	const int32 Top = OpenHeap[0];
+	SearchNodes[Top].HeapIndex = INDEX_NONE;
+
+	const int32 Last = OpenHeap.Pop();
+	if (OpenHeap.Num() > 0)
+	{
+		OpenHeap[0] = Last;
+		SearchNodes[Last].HeapIndex = 0;
+		HeapSiftDown(0);
+	}
+	return Top;
+}
+
+void FAStarPathfinder::HeapSiftUp(int32 HeapPos)
+{
+	const int32 NodeIndex = OpenHeap[HeapPos];
+	while (HeapPos > 0)
+	{
+		const int32 ParentPos = (HeapPos - 1) / 2;
+		const int32 ParentIndex = OpenHeap[ParentPos];
+		if (!HeapLess(NodeIndex, ParentIndex)) break;
+
+		OpenHeap[HeapPos] = ParentIndex;
+		SearchNodes[ParentIndex].HeapIndex = HeapPos;
+		HeapPos = ParentPos;
+	}
+	OpenHeap[HeapPos] = NodeIndex;
+	SearchNodes[NodeIndex].HeapIndex = HeapPos;
+}
+
+void FAStarPathfinder::HeapSiftDown(int32 HeapPos)
+{
+	const int32 NodeIndex = OpenHeap[HeapPos];
+	const int32 Num = OpenHeap.Num();
+	while (true)
+	{
+		int32 ChildPos = HeapPos * 2 + 1;
+		if (ChildPos >= Num) break;
+		if (ChildPos + 1 < Num && HeapLess(OpenHeap[ChildPos + 1], OpenHeap[ChildPos]))
+		{
+			ChildPos++;
+		}
+
+		const int32 ChildIndex = OpenHeap[ChildPos];
+		if (!HeapLess(ChildIndex, NodeIndex)) break;
+
+		OpenHeap[HeapPos] = ChildIndex;
+		SearchNodes[ChildIndex].HeapIndex = HeapPos;
+		HeapPos = ChildPos;
+	}
+	OpenHeap[HeapPos] = NodeIndex;
+	SearchNodes[NodeIndex].HeapIndex = HeapPos;
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+void FAStarPathfinder::RetracePath(int32 StartNodeIndex, int32 EndNodeIndex, TArray<FVector2D>& OutPath)
+{
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+
+	int32 Length = 0;
+	for (int32 CurrentIndex = EndNodeIndex; CurrentIndex != INDEX_NONE && CurrentIndex != StartNodeIndex;
+		CurrentIndex = SearchNodes[CurrentIndex].CameFrom)
+	{
+		Length++;
+	}
+
+	// Fill back to front to get start-to-end order
+	OutPath.SetNumUninitialized(Length);
+	int32 Write = Length;
+	for (int32 CurrentIndex = EndNodeIndex; CurrentIndex != INDEX_NONE && CurrentIndex != StartNodeIndex;
+		CurrentIndex = SearchNodes[CurrentIndex].CameFrom)
+	{
+		OutPath[--Write] = Nodes[CurrentIndex].WorldPosition;
+	}
+}
+
+int32 FAStarPathfinder::CalculateDistanceCost(const FPathNode& A, const FPathNode& B)
+{
+	const int32 XDistance = FMath::Abs(A.X - B.X);
+	const int32 YDistance = FMath::Abs(A.Y - B.Y);
+	const int32 Remaining = FMath::Abs(XDistance - YDistance);
+	return 14 * FMath::Min(XDistance, YDistance) + 10 * Remaining;
 }
@@ -10,6 +10,11 @@ FDynamicObstacleSystem::FDynamicObstacleSystem(FPathfindingGrid& InGrid)
 }
 
 void FDynamicObstacleSystem::UpdateDynamicObstacles(const FUnit* Units, int32 UnitCount)
+{
+	UpdateDynamicObstacles(TConstArrayView<FUnit>(Units, UnitCount), TConstArrayView<FUnit>());
+}
+
+void FDynamicObstacleSystem::UpdateDynamicObstacles(TConstArrayView<FUnit> First, TConstArrayView<FUnit> Second)
 {
 	// Record static blocks once
 	if (!bStaticBlocksRecorded)
@@ -18,41 +23,69 @@ void FDynamicObstacleSystem::UpdateDynamicObstacles(const FUnit* Units, int32 Un
 		bStaticBlocksRecorded = true;
 	}
 
-	// Clear previous dynamic blocks
-	ClearDynamicBlocks();
+	// Count ground units per cell (member scratch; Reset keeps capacity, not iteration order)
+	CellCounts.Reset();
 
-	// Count ground units per cell
-	TMap<FIntPoint, int32> CellCounts;
-
-	for (int32 i = 0; i < UnitCount; ++i)
+	for (TConstArrayView<FUnit> Units : { First, Second })
 	{
-		const FUnit& Unit = Units[i];
-		if (Unit.bIsDead || Unit.Layer != EMovementLayer::Ground)
+		for (const FUnit& Unit : Units)
 		{
-			continue;
-		}
+			if (Unit.bIsDead || Unit.Layer != EMovementLayer::Ground)
+			{
+				continue;
+			}
 
-		const FPathNode* Node = Grid.NodeFromWorldPoint(Unit.Position);
-		if (Node != nullptr)
-		{
-			FIntPoint Key(Node->X, Node->Y);
-			int32& Count = CellCounts.FindOrAdd(Key, 0);
-			++Count;
+			const FPathNode* Node = Grid.NodeFromWorldPoint(Unit.Position);
+			if (Node != nullptr)
+			{
+				FIntPoint Key(Node->X, Node->Y);
+				int32& Count = CellCounts.FindOrAdd(Key, 0);
+				++Count;
+			}
 		}
 	}
 
-	// Mark dense cells as dynamic obstacles
+	// Dense cells become this update's dynamic obstacles
+	NewBlockedNodes.Reset();
 	for (const auto& Pair : CellCounts)
 	{
 		if (Pair.Value >= UnitSimConstants::DYNAMIC_OBSTACLE_DENSITY_THRESHOLD)
 		{
 			if (!StaticBlockedNodes.Contains(Pair.Key))
 			{
-				Grid.SetWalkable(Pair.Key.X, Pair.Key.Y, false);
-				DynamicBlockedNodes.Add(Pair.Key);
+				NewBlockedNodes.Add(Pair.Key);
 			}
 		}
 	}
+
+	// Touch only the cells that changed, so a crowd standing still leaves the
+	// grid's walkability version (and the flow fields keyed on it) alone
+	LastChangedCells.Reset();
+	for (const FIntPoint& Cell : DynamicBlockedNodes)
+	{
+		if (!NewBlockedNodes.Contains(Cell) && !StaticBlockedNodes.Contains(Cell))
+		{
+			Grid.SetWalkable(Cell.X, Cell.Y, true);
+			LastChangedCells.Add(Cell);
+		}
+	}
+	for (const FIntPoint& Cell : NewBlockedNodes)
+	{
+		if (!DynamicBlockedNodes.Contains(Cell))
+		{
+			Grid.SetWalkable(Cell.X, Cell.Y, false);
+			LastChangedCells.Add(Cell);
+		}
+	}
+	// Set iteration order depends on the sets' removal history, which a restored
+	// snapshot does not share; publish the cells in grid order
+	LastChangedCells.Sort([](const FIntPoint& A, const FIntPoint& B)
+	{
+		return A.Y != B.Y ? A.Y < B.Y : A.X < B.X;
+	});
+
+	// The previous set becomes next update's scratch
+	Swap(DynamicBlockedNodes, NewBlockedNodes);
 }
 
 void FDynamicObstacleSystem::ClearDynamicBlocks()
@@ -67,6 +100,40 @@ void FDynamicObstacleSystem::ClearDynamicBlocks()
 	DynamicBlockedNodes.Empty();
 }
 
+void FDynamicObstacleSystem::Reset()
+{
+	DynamicBlockedNodes.Empty();
+	LastChangedCells.Empty();
+	StaticBlockedNodes.Empty();
+	bStaticBlocksRecorded = false;
+}
+
+void FDynamicObstacleSystem::Serialize(FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		ClearDynamicBlocks();
+
+		// Static blocks are derived from the grid, not saved: record them while
+		// it holds only static obstacles, before the saved dynamic ones go on
+		if (!bStaticBlocksRecorded)
+		{
+			RecordStaticBlocks();
+			bStaticBlocksRecorded = true;
+		}
+	}
+
+	Ar << DynamicBlockedNodes;
+
+	if (Ar.IsLoading())
+	{
+		for (const FIntPoint& Cell : DynamicBlockedNodes)
+		{
+			Grid.SetWalkable(Cell.X, Cell.Y, false);
+		}
+	}
+}
+
 void FDynamicObstacleSystem::RecordStaticBlocks()
 {
 	for (int32 X = 0; X < Grid.GetWidth(); ++X)
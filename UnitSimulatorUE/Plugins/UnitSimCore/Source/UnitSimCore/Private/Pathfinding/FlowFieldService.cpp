@@ -0,0 +1,523 @@
+#include "Pathfinding/FlowFieldService.h"
+#include "Pathfinding/PathfindingGrid.h"
+#include "Pathfinding/PathNode.h"
+#include "GameConstants.h"
+
+namespace
+{
+	/** Min-heap order on (cost, cell): total, so builds expand cells in one fixed order */
+	struct FCostCellLess
+	{
+		bool operator()(const TPair<int32, int32>& A, const TPair<int32, int32>& B) const
+		{
+			return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+		}
+	};
+}
+
+FFlowFieldService::FFlowFieldService(FPathfindingGrid& InGrid)
+	: Grid(InGrid)
+{
+}
+
+// ============================================================================
+// Goals
+// ============================================================================
+
+int32 FFlowFieldService::AddGoal(const FVector2D& Position)
+{
+	const int32 Existing = FindGoal(Position, UnitSimConstants::FLOW_FIELD_GOAL_TOLERANCE);
+	if (Existing != INDEX_NONE)
+	{
+		return Existing;
+	}
+
+	FGoal& Goal = Goals.AddDefaulted_GetRef();
+	Goal.Position = Position;
+	return Goals.Num() - 1;
+}
+
+void FFlowFieldService::ClearGoals()
+{
+	Goals.Empty();
+}
+
+int32 FFlowFieldService::FindGoal(const FVector2D& Position, float Tolerance) const
+{
+	const double ToleranceSq = static_cast<double>(Tolerance) * Tolerance;
+	for (int32 i = 0; i < Goals.Num(); ++i)
+	{
+		if (FVector2D::DistSquared(Goals[i].Position, Position) <= ToleranceSq)
+		{
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+void FFlowFieldService::EnsureField(int32 GoalId)
+{
+	FGoal& Goal = Goals[GoalId];
+	if (Goal.bBuilt && Goal.BuiltVersion == Grid.GetWalkabilityVersion())
+	{
+		return;
+	}
+
+	PrepareSteps();
+	BuildField(Goal);
+}
+
+bool FFlowFieldService::FindPath(int32 GoalId, const FVector2D& Start, TArray<FVector2D>& OutPath)
+{
+	OutPath.Reset();
+	EnsureField(GoalId);
+
+	const int32 StartCell = CellIndex(Start);
+	if (StartCell == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FGoal& Goal = Goals[GoalId];
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+	if (!Nodes[StartCell].bIsWalkable || Goal.Direction[StartCell] == NoDirection)
+	{
+		return false;
+	}
+
+	Stats.PathsTraced++;
+
+	// Costs strictly fall along the directions, so the walk always ends on a goal cell
+	int32 Cell = StartCell;
+	while (Goal.Direction[Cell] != GoalDirection)
+	{
+		const int32 Next = Cell + NeighborSteps[Goal.Direction[Cell]].Offset;
+		if (Goal.Direction[Next] == GoalDirection && !Nodes[Next].bIsWalkable)
+		{
+			break;
+		}
+		OutPath.Add(Nodes[Next].WorldPosition);
+		Cell = Next;
+	}
+	return true;
+}
+
+FVector2D FFlowFieldService::SampleDirection(int32 GoalId, const FVector2D& Position)
+{
+	EnsureField(GoalId);
+
+	const int32 Cell = CellIndex(Position);
+	if (Cell == INDEX_NONE)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	const uint8 Direction = Goals[GoalId].Direction[Cell];
+	if (Direction == NoDirection || Direction == GoalDirection)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	const FVector2D& NextPosition = Grid.GetNodes()[Cell + NeighborSteps[Direction].Offset].WorldPosition;
+	return (NextPosition - Position).GetSafeNormal();
+}
+
+int32 FFlowFieldService::GetCost(int32 GoalId, const FVector2D& Position)
+{
+	EnsureField(GoalId);
+
+	const int32 Cell = CellIndex(Position);
+	if (Cell == INDEX_NONE || Goals[GoalId].Cost[Cell] == MAX_int32)
+	{
+		return INDEX_NONE;
+	}
+	return Goals[GoalId].Cost[Cell];
+}
+
+// ============================================================================
+// Field Build
+// ============================================================================
+
+void FFlowFieldService::PrepareSteps()
+{
+	const int32 Width = Grid.GetWidth();
+	if (Width == PreparedWidth)
+	{
+		return;
+	}
+	PreparedWidth = Width;
+
+	// DX-outer, DY-inner like the A* neighbor loop, which makes step 7 - i the reverse of step i
+	int32 StepIndex = 0;
+	for (int32 DX = -1; DX <= 1; ++DX)
+	{
+		for (int32 DY = -1; DY <= 1; ++DY)
+		{
+			if (DX == 0 && DY == 0) continue;
+
+			FNeighborStep& Step = NeighborSteps[StepIndex++];
+			Step.DX = DX;
+			Step.DY = DY;
+			Step.Offset = DX + DY * Width;
+			Step.Cost = (DX != 0 && DY != 0) ? 14 : 10;
+		}
+	}
+}
+
+void FFlowFieldService::BuildField(FGoal& Goal)
+{
+	Stats.FieldBuilds++;
+
+	const int32 Width = Grid.GetWidth();
+	const int32 Height = Grid.GetHeight();
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+
+	Goal.Cost.Init(MAX_int32, Width * Height);
+	Goal.Direction.Init(NoDirection, Width * Height);
+	Goal.BuiltVersion = Grid.GetWalkabilityVersion();
+	Goal.bBuilt = true;
+
+	OpenHeap.Reset();
+	const FCostCellLess Less;
+
+	CollectSeeds(Goal, Goal.Seeds);
+	for (const int32 Seed : Goal.Seeds)
+	{
+		Goal.Cost[Seed] = 0;
+		Goal.Direction[Seed] = GoalDirection;
+		OpenHeap.HeapPush(TPair<int32, int32>(0, Seed), Less);
+	}
+
+	// Dijkstra outward from the seeds over walkable cells; stale heap entries are skipped
+	while (OpenHeap.Num() > 0)
+	{
+		TPair<int32, int32> Top;
+		OpenHeap.HeapPop(Top, Less);
+		const int32 Cell = Top.Value;
+		if (Top.Key != Goal.Cost[Cell]) continue;
+
+		const FPathNode& Node = Nodes[Cell];
+		for (int32 StepIndex = 0; StepIndex < 8; ++StepIndex)
+		{
+			const FNeighborStep& Step = NeighborSteps[StepIndex];
+			const int32 NX = Node.X + Step.DX;
+			const int32 NY = Node.Y + Step.DY;
+			if (NX < 0 || NX >= Width || NY < 0 || NY >= Height) continue;
+
+			const int32 Neighbor = Cell + Step.Offset;
+			if (!Nodes[Neighbor].bIsWalkable) continue;
+
+			// Same corner-cutting rule as A*; the two side cells are shared by both directions
+			if (Step.DX != 0 && Step.DY != 0 &&
+				(!Nodes[Cell + Step.DX].bIsWalkable || !Nodes[Cell + Step.DY * Width].bIsWalkable))
+			{
+				continue;
+			}
+
+			const int32 NewCost = Top.Key + Step.Cost;
+			if (NewCost < Goal.Cost[Neighbor])
+			{
+				Goal.Cost[Neighbor] = NewCost;
+				Goal.Direction[Neighbor] = static_cast<uint8>(7 - StepIndex);
+				OpenHeap.HeapPush(TPair<int32, int32>(NewCost, Neighbor), Less);
+			}
+		}
+	}
+}
+
+void FFlowFieldService::CollectSeeds(const FGoal& Goal, TArray<int32>& OutSeeds)
+{
+	OutSeeds.Reset();
+	SeedVisited.Reset();
+	const int32 GoalCell = CellIndex(Goal.Position);
+	if (GoalCell == INDEX_NONE)
+	{
+		return;
+	}
+
+	OutSeeds.Add(GoalCell);
+	SeedVisited.Add(GoalCell);
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+	if (Nodes[GoalCell].bIsWalkable)
+	{
+		return;
+	}
+
+	// Flood the obstacle the goal sits in
+	const int32 Width = Grid.GetWidth();
+	const int32 Height = Grid.GetHeight();
+	const double SeedRadiusSq = static_cast<double>(UnitSimConstants::FLOW_FIELD_GOAL_SEED_RADIUS) *
+		UnitSimConstants::FLOW_FIELD_GOAL_SEED_RADIUS;
+	for (int32 SeedIndex = 0; SeedIndex < OutSeeds.Num(); ++SeedIndex)
+	{
+		const FPathNode& Seed = Nodes[OutSeeds[SeedIndex]];
+		for (const FNeighborStep& Step : NeighborSteps)
+		{
+			const int32 NX = Seed.X + Step.DX;
+			const int32 NY = Seed.Y + Step.DY;
+			if (NX < 0 || NX >= Width || NY < 0 || NY >= Height) continue;
+
+			const int32 Neighbor = OutSeeds[SeedIndex] + Step.Offset;
+			if (Nodes[Neighbor].bIsWalkable || SeedVisited.Contains(Neighbor)) continue;
+			if (FVector2D::DistSquared(Nodes[Neighbor].WorldPosition, Goal.Position) > SeedRadiusSq) continue;
+
+			SeedVisited.Add(Neighbor);
+			OutSeeds.Add(Neighbor);
+		}
+	}
+}
+
+// ============================================================================
+// Field Repair
+// ============================================================================
+
+void FFlowFieldService::RepairFields(TConstArrayView<FIntPoint> ChangedCells, uint32 FromVersion)
+{
+	const uint32 Version = Grid.GetWalkabilityVersion();
+	if (Version == FromVersion)
+	{
+		return;
+	}
+
+	PrepareSteps();
+	const int32 Width = Grid.GetWidth();
+	const int32 Height = Grid.GetHeight();
+	RepairCells.Reset();
+	for (const FIntPoint& Cell : ChangedCells)
+	{
+		if (Cell.X >= 0 && Cell.X < Width && Cell.Y >= 0 && Cell.Y < Height)
+		{
+			RepairCells.Add(Cell.X + Cell.Y * Width);
+		}
+	}
+
+	for (FGoal& Goal : Goals)
+	{
+		if (Goal.bBuilt && Goal.BuiltVersion == FromVersion)
+		{
+			RepairField(Goal, RepairCells);
+			Goal.BuiltVersion = Version;
+		}
+	}
+}
+
+void FFlowFieldService::RepairField(FGoal& Goal, TConstArrayView<int32> ChangedCells)
+{
+	Stats.FieldRepairs++;
+
+	const int32 Width = Grid.GetWidth();
+	const int32 Height = Grid.GetHeight();
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+
+	OpenHeap.Reset();
+	RepairRhs.Reset();
+	RepairDirty.Reset();
+	if (RepairDirtyFlags.Num() != Goal.Cost.Num())
+	{
+		RepairDirtyFlags.Init(false, Goal.Cost.Num());
+	}
+
+	// A blocked goal's obstacle may have grown or shrunk: swap the seed marks first
+	TArray<int32>& Seeds = RepairSeeds;
+	CollectSeeds(Goal, Seeds);
+	TArray<int32>& Changed = RepairChanged;
+	Changed.Reset();
+	Changed.Append(ChangedCells.GetData(), ChangedCells.Num());
+	{
+		// CollectSeeds left its visited set holding exactly the new seeds
+		const TSet<int32>& NewSeeds = SeedVisited;
+		for (const int32 Seed : Goal.Seeds)
+		{
+			if (!NewSeeds.Contains(Seed))
+			{
+				Goal.Direction[Seed] = NoDirection;
+				Changed.Add(Seed);
+			}
+		}
+		for (const int32 Seed : Seeds)
+		{
+			if (Goal.Direction[Seed] != GoalDirection)
+			{
+				Goal.Direction[Seed] = GoalDirection;
+				Changed.Add(Seed);
+			}
+		}
+		// The old seed list becomes the next repair's scratch
+		Swap(Goal.Seeds, Seeds);
+	}
+
+	// Edges into, out of and around a changed cell (it is a diagonal's side cell) all
+	// end on it or its neighbors
+	for (const int32 Cell : Changed)
+	{
+		MarkDirectionsDirty(Cell);
+		UpdateRepairCell(Goal, Cell);
+
+		const FPathNode& Node = Nodes[Cell];
+		for (const FNeighborStep& Step : NeighborSteps)
+		{
+			const int32 NX = Node.X + Step.DX;
+			const int32 NY = Node.Y + Step.DY;
+			if (NX < 0 || NX >= Width || NY < 0 || NY >= Height) continue;
+
+			UpdateRepairCell(Goal, Cell + Step.Offset);
+		}
+	}
+
+	// LPA* without a heuristic: settle lowered cells, raise the ones that lost their support
+	const FCostCellLess Less;
+	while (OpenHeap.Num() > 0)
+	{
+		TPair<int32, int32> Top;
+		OpenHeap.HeapPop(Top, Less);
+		const int32 Cell = Top.Value;
+		const int32 Rhs = RepairRhs.FindRef(Cell);
+		int32& Cost = Goal.Cost[Cell];
+		if (Cost == Rhs || Top.Key != FMath::Min(Cost, Rhs)) continue;
+
+		Stats.CellsRepaired++;
+		MarkDirectionsDirty(Cell);
+		if (Cost > Rhs)
+		{
+			Cost = Rhs;
+		}
+		else
+		{
+			Cost = MAX_int32;
+			UpdateRepairCell(Goal, Cell);
+		}
+
+		const FPathNode& Node = Nodes[Cell];
+		for (const FNeighborStep& Step : NeighborSteps)
+		{
+			const int32 NX = Node.X + Step.DX;
+			const int32 NY = Node.Y + Step.DY;
+			if (NX < 0 || NX >= Width || NY < 0 || NY >= Height) continue;
+
+			UpdateRepairCell(Goal, Cell + Step.Offset);
+		}
+	}
+
+	for (const int32 Cell : RepairDirty)
+	{
+		Goal.Direction[Cell] = PickDirection(Goal, Cell);
+		RepairDirtyFlags[Cell] = false;
+	}
+}
+
+bool FFlowFieldService::CanStep(const FGoal& Goal, int32 From, int32 StepIndex) const
+{
+	const int32 Width = Grid.GetWidth();
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+	const FPathNode& Node = Nodes[From];
+	const FNeighborStep& Step = NeighborSteps[StepIndex];
+
+	const int32 NX = Node.X + Step.DX;
+	const int32 NY = Node.Y + Step.DY;
+	if (NX < 0 || NX >= Width || NY < 0 || NY >= Grid.GetHeight()) return false;
+
+	// Into walkable cells only, and out of an obstacle only from the goal's own
+	if (!Nodes[From + Step.Offset].bIsWalkable) return false;
+	if (!Node.bIsWalkable && Goal.Direction[From] != GoalDirection) return false;
+
+	return Step.DX == 0 || Step.DY == 0 ||
+		(Nodes[From + Step.DX].bIsWalkable && Nodes[From + Step.DY * Width].bIsWalkable);
+}
+
+int32 FFlowFieldService::ComputeRhs(const FGoal& Goal, int32 Cell) const
+{
+	if (Goal.Direction[Cell] == GoalDirection) return 0;
+
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+	const FPathNode& Node = Nodes[Cell];
+	if (!Node.bIsWalkable) return MAX_int32;
+
+	int32 Best = MAX_int32;
+	for (int32 StepIndex = 0; StepIndex < 8; ++StepIndex)
+	{
+		const FNeighborStep& Step = NeighborSteps[StepIndex];
+		const int32 NX = Node.X + Step.DX;
+		const int32 NY = Node.Y + Step.DY;
+		if (NX < 0 || NX >= Grid.GetWidth() || NY < 0 || NY >= Grid.GetHeight()) continue;
+
+		const int32 From = Cell + Step.Offset;
+		if (Goal.Cost[From] == MAX_int32 || !CanStep(Goal, From, 7 - StepIndex)) continue;
+
+		Best = FMath::Min(Best, Goal.Cost[From] + Step.Cost);
+	}
+	return Best;
+}
+
+void FFlowFieldService::UpdateRepairCell(FGoal& Goal, int32 Cell)
+{
+	const int32 Rhs = ComputeRhs(Goal, Cell);
+	RepairRhs.Add(Cell, Rhs);
+	if (Rhs != Goal.Cost[Cell])
+	{
+		OpenHeap.HeapPush(TPair<int32, int32>(FMath::Min(Goal.Cost[Cell], Rhs), Cell), FCostCellLess());
+	}
+}
+
+uint8 FFlowFieldService::PickDirection(const FGoal& Goal, int32 Cell) const
+{
+	if (Goal.Direction[Cell] == GoalDirection) return GoalDirection;
+
+	const int32 Cost = Goal.Cost[Cell];
+	if (Cost == MAX_int32) return NoDirection;
+
+	// A build records the neighbor that first reached this cost: the cheapest, then lowest-indexed
+	const FPathNode& Node = Grid.GetNodes()[Cell];
+	uint8 Best = NoDirection;
+	int32 BestCost = MAX_int32;
+	int32 BestCell = MAX_int32;
+	for (int32 StepIndex = 0; StepIndex < 8; ++StepIndex)
+	{
+		const FNeighborStep& Step = NeighborSteps[StepIndex];
+		const int32 NX = Node.X + Step.DX;
+		const int32 NY = Node.Y + Step.DY;
+		if (NX < 0 || NX >= Grid.GetWidth() || NY < 0 || NY >= Grid.GetHeight()) continue;
+
+		const int32 From = Cell + Step.Offset;
+		const int32 FromCost = Goal.Cost[From];
+		if (FromCost == MAX_int32 || FromCost + Step.Cost != Cost || !CanStep(Goal, From, 7 - StepIndex)) continue;
+
+		if (FromCost < BestCost || (FromCost == BestCost && From < BestCell))
+		{
+			Best = static_cast<uint8>(StepIndex);
+			BestCost = FromCost;
+			BestCell = From;
+		}
+	}
+	return Best;
+}
+
+void FFlowFieldService::MarkDirectionsDirty(int32 Cell)
+{
+	const FPathNode& Node = Grid.GetNodes()[Cell];
+	for (int32 DY = -1; DY <= 1; ++DY)
+	{
+		for (int32 DX = -1; DX <= 1; ++DX)
+		{
+			const int32 NX = Node.X + DX;
+			const int32 NY = Node.Y + DY;
+			if (NX < 0 || NX >= Grid.GetWidth() || NY < 0 || NY >= Grid.GetHeight()) continue;
+
+			const int32 Neighbor = NX + NY * Grid.GetWidth();
+			if (!RepairDirtyFlags[Neighbor])
+			{
+				RepairDirtyFlags[Neighbor] = true;
+				RepairDirty.Add(Neighbor);
+			}
+		}
+	}
+}
+
+int32 FFlowFieldService::CellIndex(const FVector2D& Position) const
+{
+	const FPathNode* Node = Grid.NodeFromWorldPoint(Position);
+	return Node != nullptr ? Node->X + Node->Y * Grid.GetWidth() : INDEX_NONE;
+}
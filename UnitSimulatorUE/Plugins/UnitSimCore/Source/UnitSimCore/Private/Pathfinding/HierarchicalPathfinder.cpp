@@ -0,0 +1,551 @@
+#include "Pathfinding/HierarchicalPathfinder.h"
+#include "Pathfinding/PathfindingGrid.h"
+#include "Pathfinding/PathNode.h"
+#include "GameConstants.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+#include "Algo/Sort.h"
+
+namespace
+{
+	struct FOpenEntryLess
+	{
+		template <typename EntryType>
+		bool operator()(const EntryType& A, const EntryType& B) const
+		{
+			if (A.FCost != B.FCost) return A.FCost < B.FCost;
+			if (A.HCost != B.HCost) return A.HCost < B.HCost;
+			return A.Index < B.Index;
+		}
+	};
+}
+
+FHierarchicalPathfinder::FHierarchicalPathfinder(FPathfindingGrid& InGrid)
+	: Grid(InGrid)
+{
+}
+
+int32 FHierarchicalPathfinder::FCluster::FindEntrance(int32 Cell) const
+{
+	return Algo::BinarySearchBy(Entrances, Cell, &FEntrance::Cell);
+}
+
+int32 FHierarchicalPathfinder::GetNumEntrances() const
+{
+	int32 Count = 0;
+	for (const FCluster& Cluster : Clusters)
+	{
+		Count += Cluster.Entrances.Num();
+	}
+	return Count;
+}
+
+// ============================================================================
+// Query
+// ============================================================================
+
+bool FHierarchicalPathfinder::FindPath(const FVector2D& StartWorldPos, const FVector2D& EndWorldPos, TArray<FVector2D>& OutPath)
+{
+	OutPath.Reset();
+	Stats.Searches++;
+
+	const FPathNode* StartNode = Grid.NodeFromWorldPoint(StartWorldPos);
+	const FPathNode* EndNode = Grid.NodeFromWorldPoint(EndWorldPos);
+	if (StartNode == nullptr || EndNode == nullptr ||
+		!StartNode->bIsWalkable || !EndNode->bIsWalkable)
+	{
+		return false;
+	}
+
+	Refresh();
+
+	const int32 Width = Grid.GetWidth();
+	const int32 StartCell = StartNode->X + StartNode->Y * Width;
+	const int32 GoalCell = EndNode->X + EndNode->Y * Width;
+	if (StartCell == GoalCell)
+	{
+		return true;
+	}
+
+	// Both ends in one cluster: a local search usually settles it
+	const int32 StartCluster = ClusterOf(StartCell);
+	const int32 GoalCluster = ClusterOf(GoalCell);
+	if (StartCluster == GoalCluster && AppendLeg(StartCluster, StartCell, GoalCell, OutPath))
+	{
+		return true;
+	}
+
+	// Link start and goal to their clusters' entrances, then search the abstract graph
+	SearchCluster(Clusters[StartCluster], StartCell, INDEX_NONE, StartCosts, nullptr);
+	SearchCluster(Clusters[GoalCluster], GoalCell, INDEX_NONE, GoalCosts, nullptr);
+	if (!SearchAbstract(StartCell, GoalCell))
+	{
+		return false;
+	}
+
+	// Refine: border crossings are single steps, everything else a search inside one cluster
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+	for (int32 i = 1; i < AbstractPath.Num(); ++i)
+	{
+		const int32 From = AbstractPath[i - 1];
+		const int32 To = AbstractPath[i];
+		const int32 FromCluster = ClusterOf(From);
+		if (FromCluster != ClusterOf(To))
+		{
+			OutPath.Add(Nodes[To].WorldPosition);
+		}
+		else if (!AppendLeg(FromCluster, From, To, OutPath))
+		{
+			OutPath.Reset();
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FHierarchicalPathfinder::SearchAbstract(int32 StartCell, int32 GoalCell)
+{
+	AbstractNodes.Reset();
+	AbstractPath.Reset();
+	OpenHeap.Reset();
+	const FOpenEntryLess Less;
+
+	const int32 StartCluster = ClusterOf(StartCell);
+	const int32 GoalCluster = ClusterOf(GoalCell);
+
+	AbstractNodes.Add(StartCell).GCost = 0;
+	const int32 StartH = OctileDistance(StartCell, GoalCell);
+	OpenHeap.HeapPush(FOpenEntry{ StartH, StartH, StartCell }, Less);
+
+	while (OpenHeap.Num() > 0)
+	{
+		FOpenEntry Top;
+		OpenHeap.HeapPop(Top, Less);
+		const int32 Cell = Top.Index;
+		const int32 GCost = Top.FCost - Top.HCost;
+		{
+			FAbstractNode& Node = AbstractNodes[Cell];
+			if (Node.bClosed || Node.GCost != GCost) continue;
+			Node.bClosed = true;
+		}
+		Stats.AbstractNodesExpanded++;
+
+		if (Cell == GoalCell)
+		{
+			for (int32 PathCell = GoalCell; PathCell != INDEX_NONE; PathCell = AbstractNodes[PathCell].Parent)
+			{
+				AbstractPath.Add(PathCell);
+			}
+			Algo::Reverse(AbstractPath);
+			return true;
+		}
+
+		// Node references are not held here: adding a neighbor may grow the map
+		auto Relax = [this, Cell, GCost, GoalCell, &Less](int32 Next, int32 EdgeCost)
+		{
+			FAbstractNode& NextNode = AbstractNodes.FindOrAdd(Next);
+			const int32 NewGCost = GCost + EdgeCost;
+			if (NextNode.bClosed || NewGCost >= NextNode.GCost) return;
+
+			NextNode.GCost = NewGCost;
+			NextNode.Parent = Cell;
+			const int32 HCost = OctileDistance(Next, GoalCell);
+			OpenHeap.HeapPush(FOpenEntry{ NewGCost + HCost, HCost, Next }, Less);
+		};
+
+		const int32 ClusterIndex = ClusterOf(Cell);
+		const FCluster& Cluster = Clusters[ClusterIndex];
+		const int32 EntranceIndex = Cluster.FindEntrance(Cell);
+
+		if (Cell == StartCell)
+		{
+			for (const FEntrance& Entrance : Cluster.Entrances)
+			{
+				const int32 Cost = StartCosts[LocalIndex(Cluster, Entrance.Cell)];
+				if (Entrance.Cell != StartCell && Cost != MAX_int32)
+				{
+					Relax(Entrance.Cell, Cost);
+				}
+			}
+		}
+		else if (EntranceIndex != INDEX_NONE)
+		{
+			const int32 NumEntrances = Cluster.Entrances.Num();
+			for (int32 Other = 0; Other < NumEntrances; ++Other)
+			{
+				const int32 Cost = Cluster.IntraCosts[EntranceIndex * NumEntrances + Other];
+				if (Other != EntranceIndex && Cost != MAX_int32)
+				{
+					Relax(Cluster.Entrances[Other].Cell, Cost);
+				}
+			}
+		}
+
+		if (EntranceIndex != INDEX_NONE)
+		{
+			for (const int32 Link : Cluster.Entrances[EntranceIndex].Links)
+			{
+				Relax(Link, 10);
+			}
+		}
+
+		if (ClusterIndex == GoalCluster)
+		{
+			const int32 Cost = GoalCosts[LocalIndex(Cluster, Cell)];
+			if (Cost != MAX_int32)
+			{
+				Relax(GoalCell, Cost);
+			}
+		}
+	}
+
+	return false;
+}
+
+bool FHierarchicalPathfinder::AppendLeg(int32 ClusterIndex, int32 FromCell, int32 ToCell, TArray<FVector2D>& OutPath)
+{
+	const FCluster& Cluster = Clusters[ClusterIndex];
+	if (!SearchCluster(Cluster, FromCell, ToCell, LocalCost, &LocalParent))
+	{
+		return false;
+	}
+
+	int32 Length = 0;
+	for (int32 Cell = ToCell; Cell != FromCell; Cell = LocalParent[LocalIndex(Cluster, Cell)])
+	{
+		Length++;
+	}
+
+	// Fill back to front to get from-to order
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+	const int32 First = OutPath.Num();
+	OutPath.SetNumUninitialized(First + Length);
+	int32 Write = First + Length;
+	for (int32 Cell = ToCell; Cell != FromCell; Cell = LocalParent[LocalIndex(Cluster, Cell)])
+	{
+		OutPath[--Write] = Nodes[Cell].WorldPosition;
+	}
+	return true;
+}
+
+bool FHierarchicalPathfinder::SearchCluster(const FCluster& Cluster, int32 FromCell, int32 ToCell, TArray<int32>& OutCost, TArray<int32>* OutParent)
+{
+	const int32 Width = Grid.GetWidth();
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+	const int32 LocalNum = ClusterSize * ClusterSize;
+
+	OutCost.Init(MAX_int32, LocalNum);
+	if (OutParent != nullptr)
+	{
+		OutParent->Init(INDEX_NONE, LocalNum);
+	}
+
+	OpenHeap.Reset();
+	const FOpenEntryLess Less;
+
+	OutCost[LocalIndex(Cluster, FromCell)] = 0;
+	const int32 StartH = ToCell != INDEX_NONE ? OctileDistance(FromCell, ToCell) : 0;
+	OpenHeap.HeapPush(FOpenEntry{ StartH, StartH, FromCell }, Less);
+
+	while (OpenHeap.Num() > 0)
+	{
+		FOpenEntry Top;
+		OpenHeap.HeapPop(Top, Less);
+		const int32 Cell = Top.Index;
+		const int32 GCost = Top.FCost - Top.HCost;
+
+		// Every push lowers the cost, so only a cell's latest entry matches it
+		if (GCost != OutCost[LocalIndex(Cluster, Cell)]) continue;
+		Stats.LocalNodesExpanded++;
+
+		if (Cell == ToCell)
+		{
+			return true;
+		}
+
+		const int32 X = Cell % Width;
+		const int32 Y = Cell / Width;
+		for (int32 DX = -1; DX <= 1; ++DX)
+		{
+			for (int32 DY = -1; DY <= 1; ++DY)
+			{
+				if (DX == 0 && DY == 0) continue;
+
+				const int32 NX = X + DX;
+				const int32 NY = Y + DY;
+				if (NX < Cluster.MinX || NX >= Cluster.MaxX || NY < Cluster.MinY || NY >= Cluster.MaxY) continue;
+
+				const int32 Neighbor = Cell + DX + DY * Width;
+				if (!Nodes[Neighbor].bIsWalkable) continue;
+
+				// Prevent corner cutting through unwalkable tiles
+				if (DX != 0 && DY != 0 &&
+					(!Nodes[Cell + DX].bIsWalkable || !Nodes[Cell + DY * Width].bIsWalkable))
+				{
+					continue;
+				}
+
+				const int32 NewGCost = GCost + ((DX != 0 && DY != 0) ? 14 : 10);
+				const int32 NeighborLocal = LocalIndex(Cluster, Neighbor);
+				if (NewGCost < OutCost[NeighborLocal])
+				{
+					OutCost[NeighborLocal] = NewGCost;
+					if (OutParent != nullptr)
+					{
+						(*OutParent)[NeighborLocal] = Cell;
+					}
+					const int32 HCost = ToCell != INDEX_NONE ? OctileDistance(Neighbor, ToCell) : 0;
+					OpenHeap.HeapPush(FOpenEntry{ NewGCost + HCost, HCost, Neighbor }, Less);
+				}
+			}
+		}
+	}
+
+	return ToCell == INDEX_NONE;
+}
+
+// ============================================================================
+// Abstract Graph
+// ============================================================================
+
+void FHierarchicalPathfinder::Refresh()
+{
+	const int32 Width = Grid.GetWidth();
+	const int32 Height = Grid.GetHeight();
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+
+	TBitArray<> Dirty;
+	if (Width != PreparedWidth || Height != PreparedHeight)
+	{
+		BuildLayout();
+		Dirty.Init(true, Clusters.Num());
+	}
+	else if (KnownVersion != Grid.GetWalkabilityVersion())
+	{
+		Dirty.Init(false, Clusters.Num());
+		for (int32 Cell = 0; Cell < Nodes.Num(); ++Cell)
+		{
+			if (KnownWalkable[Cell] != Nodes[Cell].bIsWalkable)
+			{
+				KnownWalkable[Cell] = Nodes[Cell].bIsWalkable;
+				Dirty[ClusterOf(Cell)] = true;
+			}
+		}
+	}
+	else
+	{
+		return;
+	}
+	KnownVersion = Grid.GetWalkabilityVersion();
+
+	TBitArray<> Affected = Dirty;
+	for (TConstSetBitIterator<> It(Dirty); It; ++It)
+	{
+		RebuildBorders(It.GetIndex(), Affected);
+	}
+	for (TConstSetBitIterator<> It(Affected); It; ++It)
+	{
+		RebuildCluster(It.GetIndex());
+	}
+}
+
+void FHierarchicalPathfinder::BuildLayout()
+{
+	const int32 Width = Grid.GetWidth();
+	const int32 Height = Grid.GetHeight();
+	PreparedWidth = Width;
+	PreparedHeight = Height;
+
+	ClusterSize = UnitSimConstants::HPA_CLUSTER_SIZE;
+	ClustersX = (Width + ClusterSize - 1) / ClusterSize;
+	ClustersY = (Height + ClusterSize - 1) / ClusterSize;
+
+	Clusters.Reset();
+	Clusters.SetNum(ClustersX * ClustersY);
+	for (int32 CY = 0; CY < ClustersY; ++CY)
+	{
+		for (int32 CX = 0; CX < ClustersX; ++CX)
+		{
+			FCluster& Cluster = Clusters[CX + CY * ClustersX];
+			Cluster.MinX = CX * ClusterSize;
+			Cluster.MinY = CY * ClusterSize;
+			Cluster.MaxX = FMath::Min(Cluster.MinX + ClusterSize, Width);
+			Cluster.MaxY = FMath::Min(Cluster.MinY + ClusterSize, Height);
+		}
+	}
+
+	VerticalBorders.Reset();
+	VerticalBorders.SetNum(FMath::Max(ClustersX - 1, 0) * ClustersY);
+	HorizontalBorders.Reset();
+	HorizontalBorders.SetNum(ClustersX * FMath::Max(ClustersY - 1, 0));
+
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+	KnownWalkable.Init(false, Nodes.Num());
+	for (int32 Cell = 0; Cell < Nodes.Num(); ++Cell)
+	{
+		KnownWalkable[Cell] = Nodes[Cell].bIsWalkable;
+	}
+}
+
+void FHierarchicalPathfinder::BuildBorder(FBorder& OutBorder, int32 FirstLowCell, int32 Stride, int32 HighOffset, int32 Length) const
+{
+	OutBorder.Reset();
+	const TConstArrayView<FPathNode> Nodes = Grid.GetNodes();
+
+	auto AddRun = [&OutBorder, FirstLowCell, Stride, HighOffset](int32 RunStart, int32 RunEnd)
+	{
+		// Short runs cross in the middle, long ones at both ends
+		const int32 RunLength = RunEnd - RunStart;
+		if (RunLength < UnitSimConstants::HPA_ENTRANCE_SPLIT_LENGTH)
+		{
+			const int32 Low = FirstLowCell + (RunStart + RunLength / 2) * Stride;
+			OutBorder.Emplace(Low, Low + HighOffset);
+		}
+		else
+		{
+			const int32 First = FirstLowCell + RunStart * Stride;
+			const int32 Last = FirstLowCell + (RunEnd - 1) * Stride;
+			OutBorder.Emplace(First, First + HighOffset);
+			OutBorder.Emplace(Last, Last + HighOffset);
+		}
+	};
+
+	int32 RunStart = INDEX_NONE;
+	for (int32 i = 0; i < Length; ++i)
+	{
+		const int32 Low = FirstLowCell + i * Stride;
+		const bool bOpen = Nodes[Low].bIsWalkable && Nodes[Low + HighOffset].bIsWalkable;
+		if (bOpen && RunStart == INDEX_NONE)
+		{
+			RunStart = i;
+		}
+		else if (!bOpen && RunStart != INDEX_NONE)
+		{
+			AddRun(RunStart, i);
+			RunStart = INDEX_NONE;
+		}
+	}
+	if (RunStart != INDEX_NONE)
+	{
+		AddRun(RunStart, Length);
+	}
+}
+
+void FHierarchicalPathfinder::RebuildBorders(int32 ClusterIndex, TBitArray<>& InOutAffected)
+{
+	const int32 Width = Grid.GetWidth();
+	const int32 CX = ClusterIndex % ClustersX;
+	const int32 CY = ClusterIndex / ClustersX;
+
+	FBorder NewBorder;
+	auto Update = [this, &NewBorder, &InOutAffected](FBorder& Border, int32 OtherCluster)
+	{
+		if (NewBorder != Border)
+		{
+			Border = MoveTemp(NewBorder);
+			InOutAffected[OtherCluster] = true;
+		}
+	};
+
+	// Left and right: vertical borders, stepping along Y
+	if (CX > 0)
+	{
+		const FCluster& Left = Clusters[ClusterIndex - 1];
+		BuildBorder(NewBorder, (Left.MaxX - 1) + Left.MinY * Width, Width, 1, Left.MaxY - Left.MinY);
+		Update(VerticalBorders[(CX - 1) + CY * (ClustersX - 1)], ClusterIndex - 1);
+	}
+	if (CX < ClustersX - 1)
+	{
+		const FCluster& Cluster = Clusters[ClusterIndex];
+		BuildBorder(NewBorder, (Cluster.MaxX - 1) + Cluster.MinY * Width, Width, 1, Cluster.MaxY - Cluster.MinY);
+		Update(VerticalBorders[CX + CY * (ClustersX - 1)], ClusterIndex + 1);
+	}
+
+	// Below and above: horizontal borders, stepping along X
+	if (CY > 0)
+	{
+		const FCluster& Below = Clusters[ClusterIndex - ClustersX];
+		BuildBorder(NewBorder, Below.MinX + (Below.MaxY - 1) * Width, 1, Width, Below.MaxX - Below.MinX);
+		Update(HorizontalBorders[CX + (CY - 1) * ClustersX], ClusterIndex - ClustersX);
+	}
+	if (CY < ClustersY - 1)
+	{
+		const FCluster& Cluster = Clusters[ClusterIndex];
+		BuildBorder(NewBorder, Cluster.MinX + (Cluster.MaxY - 1) * Width, 1, Width, Cluster.MaxX - Cluster.MinX);
+		Update(HorizontalBorders[CX + CY * ClustersX], ClusterIndex + ClustersX);
+	}
+}
+
+void FHierarchicalPathfinder::RebuildCluster(int32 ClusterIndex)
+{
+	Stats.ClustersRebuilt++;
+
+	const int32 CX = ClusterIndex % ClustersX;
+	const int32 CY = ClusterIndex / ClustersX;
+	FCluster& Cluster = Clusters[ClusterIndex];
+
+	// (own cell, cell across) for every transition on the cluster's four borders
+	TArray<TPair<int32, int32>> Crossings;
+	auto Gather = [&Crossings](const FBorder& Border, bool bOwnIsLow)
+	{
+		for (const TPair<int32, int32>& Transition : Border)
+		{
+			Crossings.Emplace(bOwnIsLow ? Transition.Key : Transition.Value, bOwnIsLow ? Transition.Value : Transition.Key);
+		}
+	};
+	if (CX > 0) Gather(VerticalBorders[(CX - 1) + CY * (ClustersX - 1)], false);
+	if (CX < ClustersX - 1) Gather(VerticalBorders[CX + CY * (ClustersX - 1)], true);
+	if (CY > 0) Gather(HorizontalBorders[CX + (CY - 1) * ClustersX], false);
+	if (CY < ClustersY - 1) Gather(HorizontalBorders[CX + CY * ClustersX], true);
+
+	Algo::Sort(Crossings, [](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+	{
+		return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+	});
+
+	// A corner cell can be an entrance on two borders: one entrance, two links
+	Cluster.Entrances.Reset();
+	for (const TPair<int32, int32>& Crossing : Crossings)
+	{
+		if (Cluster.Entrances.Num() == 0 || Cluster.Entrances.Last().Cell != Crossing.Key)
+		{
+			Cluster.Entrances.AddDefaulted_GetRef().Cell = Crossing.Key;
+		}
+		Cluster.Entrances.Last().Links.Add(Crossing.Value);
+	}
+
+	const int32 NumEntrances = Cluster.Entrances.Num();
+	Cluster.IntraCosts.Init(MAX_int32, NumEntrances * NumEntrances);
+	for (int32 From = 0; From < NumEntrances; ++From)
+	{
+		SearchCluster(Cluster, Cluster.Entrances[From].Cell, INDEX_NONE, LocalCost, nullptr);
+		for (int32 To = 0; To < NumEntrances; ++To)
+		{
+			Cluster.IntraCosts[From * NumEntrances + To] = LocalCost[LocalIndex(Cluster, Cluster.Entrances[To].Cell)];
+		}
+	}
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+int32 FHierarchicalPathfinder::ClusterOf(int32 Cell) const
+{
+	const int32 Width = Grid.GetWidth();
+	return (Cell % Width) / ClusterSize + ((Cell / Width) / ClusterSize) * ClustersX;
+}
+
+int32 FHierarchicalPathfinder::LocalIndex(const FCluster& Cluster, int32 Cell) const
+{
+	const int32 Width = Grid.GetWidth();
+	return (Cell % Width - Cluster.MinX) + (Cell / Width - Cluster.MinY) * ClusterSize;
+}
+
+int32 FHierarchicalPathfinder::OctileDistance(int32 CellA, int32 CellB) const
+{
+	const int32 Width = Grid.GetWidth();
+	const int32 XDistance = FMath::Abs(CellA % Width - CellB % Width);
+	const int32 YDistance = FMath::Abs(CellA / Width - CellB / Width);
+	return 14 * FMath::Min(XDistance, YDistance) + 10 * FMath::Abs(XDistance - YDistance);
+}
@@ -0,0 +1,229 @@
+#include "Pathfinding/PathCache.h"
+#include "Pathfinding/PathfindingGrid.h"
+#include "Pathfinding/PathNode.h"
+
+FPathCache::FPathCache(const FPathfindingGrid& InGrid, int32 InCapacity)
+	: Grid(InGrid)
+	, Capacity(FMath::Max(1, InCapacity))
+	, KnownVersion(InGrid.GetWalkabilityVersion())
+{
+}
+
+void FPathCache::BeginFrame()
+{
+	Frame++;
+	Suffixes.Reset();
+}
+
+void FPathCache::SetSearchContext(uint8 Context)
+{
+	if (Context != SearchContext)
+	{
+		Clear();
+		SearchContext = Context;
+	}
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+bool FPathCache::Find(const FVector2D& Start, const FVector2D& Goal, EMovementLayer Layer, TArray<FVector2D>& OutPath)
+{
+	OutPath.Reset();
+
+	FKey Key;
+	if (!MakeKey(Start, Goal, Layer, Key))
+	{
+		Stats.Misses++;
+		return false;
+	}
+
+	// This frame's path for the same query
+	const int32* Slot = Index.Find(Key);
+	if (Slot != nullptr && Entries[*Slot].Frame == Frame)
+	{
+		Unlink(*Slot);
+		PushFront(*Slot);
+		OutPath.Append(Entries[*Slot].Path);
+		Stats.Hits++;
+		return true;
+	}
+
+	// The tail of one of this frame's paths through the start cell. Checked before
+	// older exact paths, which a restored simulation would not have.
+	if (const FSuffixRef* Ref = Suffixes.Find(Key))
+	{
+		const FEntry& Donor = Entries[Ref->Slot];
+		if (Donor.Stamp == Ref->Stamp && Donor.Frame == Frame)
+		{
+			OutPath.Append(Donor.Path.GetData() + Ref->Offset + 1, Donor.Path.Num() - Ref->Offset - 1);
+			Stats.SuffixHits++;
+			return true;
+		}
+	}
+
+	// A path from an earlier frame: what a fresh search would find, so use it as one
+	if (Slot != nullptr)
+	{
+		UseThisFrame(*Slot);
+		OutPath.Append(Entries[*Slot].Path);
+		Stats.Hits++;
+		return true;
+	}
+
+	Stats.Misses++;
+	return false;
+}
+
+void FPathCache::Add(const FVector2D& Start, const FVector2D& Goal, EMovementLayer Layer, const TArray<FVector2D>& Path)
+{
+	FKey Key;
+	if (!MakeKey(Start, Goal, Layer, Key))
+	{
+		return;
+	}
+
+	int32 Slot = INDEX_NONE;
+	if (const int32* Existing = Index.Find(Key))
+	{
+		Slot = *Existing;
+	}
+	else
+	{
+		if (Index.Num() >= Capacity)
+		{
+			const int32 Victim = Tail;
+			Unlink(Victim);
+			Index.Remove(Entries[Victim].Key);
+			Entries[Victim].Path.Reset();
+			FreeSlots.Add(Victim);
+		}
+
+		Slot = FreeSlots.Num() > 0 ? FreeSlots.Pop() : Entries.AddDefaulted();
+		Index.Add(Key, Slot);
+	}
+
+	FEntry& Entry = Entries[Slot];
+	Entry.Key = Key;
+	Entry.Path.Reset();
+	Entry.Path.Append(Path);
+	Entry.Stamp = NextStamp++;
+	UseThisFrame(Slot);
+}
+
+void FPathCache::Clear()
+{
+	if (Index.Num() > 0)
+	{
+		Stats.Invalidations++;
+	}
+
+	// Entries stay allocated as free slots, so their paths' buffers are reused
+	FreeSlots.Reset();
+	for (int32 Slot = Entries.Num() - 1; Slot >= 0; --Slot)
+	{
+		FEntry& Entry = Entries[Slot];
+		Entry.Path.Reset();
+		Entry.Prev = INDEX_NONE;
+		Entry.Next = INDEX_NONE;
+		FreeSlots.Add(Slot);
+	}
+	Index.Reset();
+	Suffixes.Reset();
+	Head = INDEX_NONE;
+	Tail = INDEX_NONE;
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+bool FPathCache::MakeKey(const FVector2D& Start, const FVector2D& Goal, EMovementLayer Layer, FKey& OutKey)
+{
+	if (Grid.GetWalkabilityVersion() != KnownVersion)
+	{
+		Clear();
+		KnownVersion = Grid.GetWalkabilityVersion();
+	}
+
+	const FPathNode* StartNode = Grid.NodeFromWorldPoint(Start);
+	const FPathNode* GoalNode = Grid.NodeFromWorldPoint(Goal);
+	if (StartNode == nullptr || GoalNode == nullptr)
+	{
+		return false;
+	}
+
+	const int32 Width = Grid.GetWidth();
+	OutKey.StartCell = StartNode->X + StartNode->Y * Width;
+	OutKey.GoalCell = GoalNode->X + GoalNode->Y * Width;
+	OutKey.Layer = static_cast<uint8>(Layer);
+	return true;
+}
+
+void FPathCache::UseThisFrame(int32 Slot)
+{
+	FEntry& Entry = Entries[Slot];
+	Entry.Frame = Frame;
+	Unlink(Slot);
+	PushFront(Slot);
+
+	// The first of this frame's paths through a cell is the one that donates from it
+	const int32 Width = Grid.GetWidth();
+	for (int32 Offset = 0; Offset < Entry.Path.Num() - 1; ++Offset)
+	{
+		const FPathNode* Node = Grid.NodeFromWorldPoint(Entry.Path[Offset]);
+		if (Node == nullptr) continue;
+
+		FKey SuffixKey = Entry.Key;
+		SuffixKey.StartCell = Node->X + Node->Y * Width;
+		if (!Suffixes.Contains(SuffixKey))
+		{
+			Suffixes.Add(SuffixKey, FSuffixRef{ Slot, Offset, Entry.Stamp });
+		}
+	}
+}
+
+void FPathCache::Unlink(int32 Slot)
+{
+	FEntry& Entry = Entries[Slot];
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else if (Head == Slot)
+	{
+		Head = Entry.Next;
+	}
+	else
+	{
+		return;   // Not in the list
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+	else
+	{
+		Tail = Entry.Prev;
+	}
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+}
+
+void FPathCache::PushFront(int32 Slot)
+{
+	FEntry& Entry = Entries[Slot];
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Head;
+	if (Head != INDEX_NONE)
+	{
+		Entries[Head].Prev = Slot;
+	}
+	Head = Slot;
+	if (Tail == INDEX_NONE)
+	{
+		Tail = Slot;
+	}
+}
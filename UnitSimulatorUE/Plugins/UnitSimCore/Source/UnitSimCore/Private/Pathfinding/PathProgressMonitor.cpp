@@ -3,33 +3,38 @@
 #include "GameConstants.h"
 
 bool PathProgressMonitor::ShouldReplan(const FUnit& Unit, int32 CurrentFrame)
+{
+	return GetReplanReason(Unit, CurrentFrame) != EReplanReason::None;
+}
+
+EReplanReason PathProgressMonitor::GetReplanReason(const FUnit& Unit, int32 CurrentFrame)
 {
 	// Cooldown check
 	const int32 FramesSinceReplan = CurrentFrame - Unit.LastReplanFrame;
 	if (FramesSinceReplan < UnitSimConstants::REPLAN_COOLDOWN_FRAMES)
 	{
-		return false;
+		return EReplanReason::None;
 	}
 
 	// Trigger 1: Waypoint progress stall
 	if (Unit.FramesSinceLastWaypointProgress >= UnitSimConstants::REPLAN_STALL_THRESHOLD)
 	{
-		return true;
+		return EReplanReason::Stall;
 	}
 
 	// Trigger 2: Long avoidance state
 	if (Unit.FramesSinceAvoidanceStart >= UnitSimConstants::REPLAN_AVOIDANCE_THRESHOLD)
 	{
-		return true;
+		return EReplanReason::Avoidance;
 	}
 
 	// Trigger 3: Periodic replan (long-distance paths)
 	if (FramesSinceReplan >= UnitSimConstants::REPLAN_PERIODIC_INTERVAL)
 	{
-		return true;
+		return EReplanReason::Periodic;
 	}
 
-	return false;
+	return EReplanReason::None;
 }
 
 void PathProgressMonitor::UpdateProgress(FUnit& Unit, bool bIsAvoiding, bool bMadeProgress)
@@ -0,0 +1,255 @@
+#include "Pathfinding/PathRequestService.h"
+#include "Pathfinding/HierarchicalPathfinder.h"
+#include "Pathfinding/PathNode.h"
+#include "Async/TaskGraphInterfaces.h"
+
+FPathRequestService::FPathRequestService(const FPathfindingGrid& InGrid, int32 InBudget)
+	: Grid(InGrid)
+	, Budget(FMath::Max(1, InBudget))
+{
+}
+
+FPathRequestService::~FPathRequestService()
+{
+	// Workers hold pointers into this object
+	UE::Tasks::Wait(Tasks);
+}
+
+// ============================================================================
+// Requests
+// ============================================================================
+
+void FPathRequestService::Submit(const FPathRequest& Request)
+{
+	const uint64 UnitKey = (static_cast<uint64>(Request.Faction) << 32) | static_cast<uint32>(Request.UnitId);
+	if (const int32* Existing = RequestByUnit.Find(UnitKey))
+	{
+		Requests[*Existing] = Request;
+		return;
+	}
+
+	RequestByUnit.Add(UnitKey, Requests.Num());
+	Requests.Add(Request);
+	if (Results.Num() < Requests.Num())
+	{
+		Results.AddDefaulted();
+	}
+}
+
+const TArray<int32>& FPathRequestService::SortByUrgency()
+{
+	UrgencyOrder.Reset(Requests.Num());
+	for (int32 i = 0; i < Requests.Num(); ++i)
+	{
+		UrgencyOrder.Add(i);
+	}
+
+	// Stable, so ties keep submission order
+	UrgencyOrder.StableSort([this](int32 A, int32 B)
+	{
+		const FPathRequest& RA = Requests[A];
+		const FPathRequest& RB = Requests[B];
+		if (RA.Priority != RB.Priority) return RA.Priority < RB.Priority;
+		return RA.LastReplanFrame < RB.LastReplanFrame;
+	});
+	return UrgencyOrder;
+}
+
+bool FPathRequestService::QueueSearch(int32 Index, bool bHierarchical)
+{
+	const FPathRequest& Request = Requests[Index];
+	FResult& Result = Results[Index];
+
+	const FPathNode* StartNode = Grid.NodeFromWorldPoint(Request.Start);
+	const FPathNode* GoalNode = Grid.NodeFromWorldPoint(Request.Goal);
+	if (StartNode == nullptr || GoalNode == nullptr)
+	{
+		Result.Status = EStatus::Answered;
+		Result.bFound = false;
+		return true;
+	}
+
+	// Searches depend only on the two cells, so identical queries share one
+	const int32 Width = Grid.GetWidth();
+	const uint64 QueryKey =
+		(static_cast<uint64>(StartNode->X + StartNode->Y * Width) << 33)
+		| (static_cast<uint64>(GoalNode->X + GoalNode->Y * Width) << 1)
+		| (bHierarchical ? 1 : 0);
+	if (const int32* Existing = SearchByQuery.Find(QueryKey))
+	{
+		Result.Status = EStatus::Searched;
+		Result.SearchIndex = *Existing;
+		Stats.SharedSearches++;
+		return true;
+	}
+
+	if (NumSearches >= Budget)
+	{
+		Stats.Deferred++;
+		return false;
+	}
+
+	Result.Status = EStatus::Searched;
+	Result.SearchIndex = NumSearches++;
+	SearchByQuery.Add(QueryKey, Result.SearchIndex);
+
+	// RunSearch overwrites the result fields (and the path's contents) of a reused search
+	FSearch& Search = Result.SearchIndex < Searches.Num() ? Searches[Result.SearchIndex] : Searches.AddDefaulted_GetRef();
+	Search.RequestIndex = Index;
+	Search.bHierarchical = bHierarchical;
+	return true;
+}
+
+// ============================================================================
+// Searches
+// ============================================================================
+
+void FPathRequestService::Launch(EPathSearchMode SearchMode, bool bAsync)
+{
+	if (NumSearches == 0) return;
+
+	RefreshSnapshot();
+
+	// HPA* keeps one abstract graph, so its queries run in order on one task;
+	// flat searches are dealt round-robin to the other workers
+	HierarchicalSearches.Reset();
+	const int32 NumWorkers = FMath::Clamp(
+		bAsync ? FTaskGraphInterface::Get().GetNumWorkerThreads() : 1, 1, UnitSimConstants::PATH_REQUEST_MAX_WORKERS);
+	while (Workers.Num() < NumWorkers)
+	{
+		Workers.AddDefaulted_GetRef().Pathfinder = MakeUnique<FAStarPathfinder>(Snapshot);
+	}
+	for (FWorker& Worker : Workers)
+	{
+		Worker.Pathfinder->SetSearchMode(SearchMode);
+		Worker.Searches.Reset();
+	}
+
+	int32 NextWorker = 0;
+	for (int32 SearchIndex = 0; SearchIndex < NumSearches; ++SearchIndex)
+	{
+		if (Searches[SearchIndex].bHierarchical)
+		{
+			HierarchicalSearches.Add(SearchIndex);
+		}
+		else
+		{
+			Workers[NextWorker].Searches.Add(SearchIndex);
+			NextWorker = (NextWorker + 1) % NumWorkers;
+		}
+	}
+
+	auto RunHierarchical = [this]()
+	{
+		for (int32 SearchIndex : HierarchicalSearches)
+		{
+			RunSearch(nullptr, SearchIndex);
+		}
+	};
+	auto RunWorker = [this](int32 WorkerIndex)
+	{
+		FWorker& Worker = Workers[WorkerIndex];
+		for (int32 SearchIndex : Worker.Searches)
+		{
+			RunSearch(Worker.Pathfinder.Get(), SearchIndex);
+		}
+	};
+
+	if (!bAsync)
+	{
+		RunHierarchical();
+		RunWorker(0);
+		return;
+	}
+
+	if (HierarchicalSearches.Num() > 0)
+	{
+		Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, RunHierarchical));
+	}
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		if (Workers[WorkerIndex].Searches.Num() > 0)
+		{
+			Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [RunWorker, WorkerIndex]() { RunWorker(WorkerIndex); }));
+		}
+	}
+}
+
+void FPathRequestService::Wait()
+{
+	UE::Tasks::Wait(Tasks);
+	Tasks.Reset();
+
+	for (int32 Index = 0; Index < Requests.Num(); ++Index)
+	{
+		FResult& Result = Results[Index];
+		if (Result.Status != EStatus::Searched) continue;
+
+		const FSearch& Search = Searches[Result.SearchIndex];
+		Result.bFound = Search.bFound;
+		Result.Path.Reset();
+		Result.Path.Append(Search.Path);
+	}
+
+	Stats.Searches += NumSearches;
+	for (FWorker& Worker : Workers)
+	{
+		Stats.NodesExpanded += Worker.Pathfinder->GetStats().NodesExpanded;
+		Worker.Pathfinder->ResetStats();
+	}
+	if (HierarchicalPathfinder.IsValid())
+	{
+		Stats.HierarchicalSearches += HierarchicalPathfinder->GetStats().Searches;
+		Stats.ClustersRebuilt += HierarchicalPathfinder->GetStats().ClustersRebuilt;
+		HierarchicalPathfinder->ResetStats();
+	}
+}
+
+void FPathRequestService::Reset()
+{
+	// Results and searches are pooled: the entries (and their path buffers) are
+	// kept for the next step's requests, so only the live ones are cleared
+	for (int32 Index = 0; Index < Requests.Num(); ++Index)
+	{
+		FResult& Result = Results[Index];
+		Result.Status = EStatus::Deferred;
+		Result.bFound = false;
+		Result.SearchIndex = INDEX_NONE;
+		Result.Path.Reset();
+	}
+	Requests.Reset();
+	UrgencyOrder.Reset();
+	RequestByUnit.Reset();
+	SearchByQuery.Reset();
+	NumSearches = 0;
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+void FPathRequestService::RefreshSnapshot()
+{
+	if (bHasSnapshot && Snapshot.GetWalkabilityVersion() == Grid.GetWalkabilityVersion())
+	{
+		return;
+	}
+
+	// Workers' pathfinders and the HPA* graph keep pointing at the snapshot; the
+	// graph notices the version move and rebuilds only the clusters that changed
+	Snapshot = Grid;
+	bHasSnapshot = true;
+	if (!HierarchicalPathfinder.IsValid())
+	{
+		HierarchicalPathfinder = MakeUnique<FHierarchicalPathfinder>(Snapshot);
+	}
+}
+
+void FPathRequestService::RunSearch(FAStarPathfinder* Pathfinder, int32 SearchIndex)
+{
+	FSearch& Search = Searches[SearchIndex];
+	const FPathRequest& Request = Requests[Search.RequestIndex];
+	Search.bFound = Pathfinder != nullptr
+		? Pathfinder->FindPath(Request.Start, Request.Goal, Search.Path)
+		: HierarchicalPathfinder->FindPath(Request.Start, Request.Goal, Search.Path);
+}
@@ -19,6 +19,15 @@ FPathfindingGrid::FPathfindingGrid(float MapWidth, float MapHeight, float InNode
 	}
 }
 
+void FPathfindingGrid::WriteWalkable(FPathNode& Node, bool bIsWalkable)
+{
+	if (Node.bIsWalkable != bIsWalkable)
+	{
+		Node.bIsWalkable = bIsWalkable;
+		WalkabilityVersion++;
+	}
+}
+
 FPathNode* FPathfindingGrid::GetNode(int32 X, int32 Y)
 {
 	if (X >= 0 && X < Width && Y >= 0 && Y < Height)
@@ -58,7 +67,7 @@ bool FPathfindingGrid::SetWalkable(int32 X, int32 Y, bool bIsWalkable)
 	{
 		return false;
 	}
-	Node->bIsWalkable = bIsWalkable;
+	WriteWalkable(*Node, bIsWalkable);
 	return true;
 }
 
@@ -69,7 +78,7 @@ bool FPathfindingGrid::SetWalkableWorld(const FVector2D& WorldPosition, bool bIs
 	{
 		return false;
 	}
-	Node->bIsWalkable = bIsWalkable;
+	WriteWalkable(*Node, bIsWalkable);
 	return true;
 }
 
@@ -84,7 +93,7 @@ void FPathfindingGrid::SetWalkableRect(const FVector2D& Min, const FVector2D& Ma
 	{
 		for (int32 Y = MinY; Y <= MaxY; ++Y)
 		{
-			Grid[FlatIndex(X, Y)].bIsWalkable = bIsWalkable;
+			WriteWalkable(Grid[FlatIndex(X, Y)], bIsWalkable);
 		}
 	}
 }
@@ -109,7 +118,7 @@ void FPathfindingGrid::SetWalkableCircle(const FVector2D& Center, float Radius,
 
 			if (DistSq <= RadiusSq)
 			{
-				Node.bIsWalkable = bIsWalkable;
+				WriteWalkable(Node, bIsWalkable);
 			}
 		}
 	}
@@ -139,3 +148,12 @@ void FPathfindingGrid::ResetAllNodes()
 		Node.ResetCosts();
 	}
 }
+
+void FPathfindingGrid::ResetWalkability()
+{
+	for (FPathNode& Node : Grid)
+	{
+		WriteWalkable(Node, true);
+		Node.ResetCosts();
+	}
+}
@@ -73,15 +73,9 @@ FUnitStateData FUnitStateData::FromUnit(const FUnit& Unit, const TArray<FUnit>&
 	Data.Forward = Unit.Forward;
 	Data.CurrentDestination = Unit.CurrentDestination;
 
-	// Target ID: use the target unit's Id if valid
-	if (Unit.TargetIndex >= 0 && Unit.TargetIndex < AllEnemies.Num())
-	{
-		Data.TargetId = AllEnemies[Unit.TargetIndex].Id;
-	}
-	else
-	{
-		Data.TargetId = -1;
-	}
+	// Target ID: use the target unit's Id if the handle is still valid
+	const int32 TargetIndex = Unit.Target.Resolve(AllEnemies);
+	Data.TargetId = (TargetIndex != INDEX_NONE) ? AllEnemies[TargetIndex].Id : -1;
 
 	Data.TakenSlotIndex = Unit.TakenSlotIndex;
 	Data.bHasAvoidanceTarget = Unit.bHasAvoidanceTarget;
@@ -91,9 +85,9 @@ FUnitStateData FUnitStateData::FromUnit(const FUnit& Unit, const TArray<FUnit>&
 	Data.bIsMoving = Unit.Velocity.SizeSquared() > 0.01;
 
 	// In attack range detection
-	if (Unit.TargetIndex >= 0 && Unit.TargetIndex < AllEnemies.Num() && !AllEnemies[Unit.TargetIndex].bIsDead)
+	if (TargetIndex != INDEX_NONE && !AllEnemies[TargetIndex].bIsDead)
 	{
-		const double DistToTarget = FVector2D::Distance(Unit.Position, AllEnemies[Unit.TargetIndex].Position);
+		const double DistToTarget = FVector2D::Distance(Unit.Position, AllEnemies[TargetIndex].Position);
 		Data.bInAttackRange = DistToTarget <= Unit.AttackRange;
 	}
 	else
@@ -200,6 +194,181 @@ FFrameData FFrameData::FromSimulationState(
 	return Data;
 }
 
+// ============================================================================
+// JSON
+// ============================================================================
+
+namespace
+{
+	TArray<TSharedPtr<FJsonValue>> VectorToJson(const FVector2D& V)
+	{
+		return { MakeShared<FJsonValueNumber>(V.X), MakeShared<FJsonValueNumber>(V.Y) };
+	}
+
+	FVector2D VectorFromJson(const FJsonObject& Obj, const TCHAR* Field)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		if (!Obj.TryGetArrayField(Field, Values) || Values->Num() != 2)
+		{
+			return FVector2D::ZeroVector;
+		}
+		return FVector2D((*Values)[0]->AsNumber(), (*Values)[1]->AsNumber());
+	}
+
+	TSharedRef<FJsonObject> UnitToJson(const FUnitStateData& U)
+	{
+		TSharedRef<FJsonObject> Obj = MakeShared<FJsonObject>();
+		Obj->SetNumberField(TEXT("id"), U.Id);
+		Obj->SetStringField(TEXT("label"), U.Label);
+		Obj->SetStringField(TEXT("unitId"), U.UnitId);
+		Obj->SetStringField(TEXT("targetPriority"), U.TargetPriority);
+		Obj->SetStringField(TEXT("role"), U.Role);
+		Obj->SetStringField(TEXT("faction"), U.Faction);
+		Obj->SetBoolField(TEXT("isDead"), U.bIsDead);
+		Obj->SetNumberField(TEXT("hp"), U.HP);
+		Obj->SetNumberField(TEXT("radius"), U.Radius);
+		Obj->SetNumberField(TEXT("speed"), U.Speed);
+		Obj->SetNumberField(TEXT("turnSpeed"), U.TurnSpeed);
+		Obj->SetNumberField(TEXT("attackRange"), U.AttackRange);
+		Obj->SetNumberField(TEXT("attackCooldown"), U.AttackCooldown);
+		Obj->SetNumberField(TEXT("layer"), static_cast<uint8>(U.Layer));
+		Obj->SetNumberField(TEXT("canTarget"), static_cast<uint8>(U.CanTarget));
+		Obj->SetNumberField(TEXT("damage"), U.Damage);
+		Obj->SetNumberField(TEXT("shieldHP"), U.ShieldHP);
+		Obj->SetNumberField(TEXT("maxShieldHP"), U.MaxShieldHP);
+		Obj->SetBoolField(TEXT("hasChargeState"), U.bHasChargeState);
+		Obj->SetBoolField(TEXT("isCharging"), U.bIsCharging);
+		Obj->SetBoolField(TEXT("isCharged"), U.bIsCharged);
+		Obj->SetNumberField(TEXT("requiredChargeDistance"), U.RequiredChargeDistance);
+
+		TArray<TSharedPtr<FJsonValue>> Abilities;
+		for (EAbilityType Ability : U.Abilities)
+		{
+			Abilities.Add(MakeShared<FJsonValueNumber>(static_cast<uint8>(Ability)));
+		}
+		Obj->SetArrayField(TEXT("abilities"), Abilities);
+
+		Obj->SetArrayField(TEXT("position"), VectorToJson(U.Position));
+		Obj->SetArrayField(TEXT("velocity"), VectorToJson(U.Velocity));
+		Obj->SetArrayField(TEXT("forward"), VectorToJson(U.Forward));
+		Obj->SetArrayField(TEXT("currentDestination"), VectorToJson(U.CurrentDestination));
+		Obj->SetNumberField(TEXT("targetId"), U.TargetId);
+		Obj->SetNumberField(TEXT("takenSlotIndex"), U.TakenSlotIndex);
+		Obj->SetBoolField(TEXT("hasAvoidanceTarget"), U.bHasAvoidanceTarget);
+		Obj->SetArrayField(TEXT("avoidanceTarget"), VectorToJson(U.AvoidanceTarget));
+		Obj->SetBoolField(TEXT("isMoving"), U.bIsMoving);
+		Obj->SetBoolField(TEXT("inAttackRange"), U.bInAttackRange);
+		return Obj;
+	}
+
+	void UnitFromJson(const FJsonObject& Obj, FUnitStateData& U)
+	{
+		U.Id = static_cast<int32>(Obj.GetNumberField(TEXT("id")));
+		U.Label = Obj.GetStringField(TEXT("label"));
+		U.UnitId = Obj.GetStringField(TEXT("unitId"));
+		U.TargetPriority = Obj.GetStringField(TEXT("targetPriority"));
+		U.Role = Obj.GetStringField(TEXT("role"));
+		U.Faction = Obj.GetStringField(TEXT("faction"));
+		U.bIsDead = Obj.GetBoolField(TEXT("isDead"));
+		U.HP = static_cast<int32>(Obj.GetNumberField(TEXT("hp")));
+		U.Radius = static_cast<float>(Obj.GetNumberField(TEXT("radius")));
+		U.Speed = static_cast<float>(Obj.GetNumberField(TEXT("speed")));
+		U.TurnSpeed = static_cast<float>(Obj.GetNumberField(TEXT("turnSpeed")));
+		U.AttackRange = static_cast<float>(Obj.GetNumberField(TEXT("attackRange")));
+		U.AttackCooldown = static_cast<float>(Obj.GetNumberField(TEXT("attackCooldown")));
+		U.Layer = static_cast<EMovementLayer>(static_cast<uint8>(Obj.GetNumberField(TEXT("layer"))));
+		U.CanTarget = static_cast<ETargetType>(static_cast<uint8>(Obj.GetNumberField(TEXT("canTarget"))));
+		U.Damage = static_cast<int32>(Obj.GetNumberField(TEXT("damage")));
+		U.ShieldHP = static_cast<int32>(Obj.GetNumberField(TEXT("shieldHP")));
+		U.MaxShieldHP = static_cast<int32>(Obj.GetNumberField(TEXT("maxShieldHP")));
+		U.bHasChargeState = Obj.GetBoolField(TEXT("hasChargeState"));
+		U.bIsCharging = Obj.GetBoolField(TEXT("isCharging"));
+		U.bIsCharged = Obj.GetBoolField(TEXT("isCharged"));
+		U.RequiredChargeDistance = static_cast<float>(Obj.GetNumberField(TEXT("requiredChargeDistance")));
+
+		U.Abilities.Reset();
+		const TArray<TSharedPtr<FJsonValue>>* Abilities = nullptr;
+		if (Obj.TryGetArrayField(TEXT("abilities"), Abilities))
+		{
+			for (const TSharedPtr<FJsonValue>& Ability : *Abilities)
+			{
+				U.Abilities.Add(static_cast<EAbilityType>(static_cast<uint8>(Ability->AsNumber())));
+			}
+		}
+
+		U.Position = VectorFromJson(Obj, TEXT("position"));
+		U.Velocity = VectorFromJson(Obj, TEXT("velocity"));
+		U.Forward = VectorFromJson(Obj, TEXT("forward"));
+		U.CurrentDestination = VectorFromJson(Obj, TEXT("currentDestination"));
+		U.TargetId = static_cast<int32>(Obj.GetNumberField(TEXT("targetId")));
+		U.TakenSlotIndex = static_cast<int32>(Obj.GetNumberField(TEXT("takenSlotIndex")));
+		U.bHasAvoidanceTarget = Obj.GetBoolField(TEXT("hasAvoidanceTarget"));
+		U.AvoidanceTarget = VectorFromJson(Obj, TEXT("avoidanceTarget"));
+		U.bIsMoving = Obj.GetBoolField(TEXT("isMoving"));
+		U.bInAttackRange = Obj.GetBoolField(TEXT("inAttackRange"));
+	}
+
+	TSharedRef<FJsonObject> TowerToJson(const FTowerStateData& T)
+	{
+		TSharedRef<FJsonObject> Obj = MakeShared<FJsonObject>();
+		Obj->SetNumberField(TEXT("id"), T.Id);
+		Obj->SetStringField(TEXT("type"), T.Type);
+		Obj->SetStringField(TEXT("faction"), T.Faction);
+		Obj->SetArrayField(TEXT("position"), VectorToJson(T.Position));
+		Obj->SetNumberField(TEXT("radius"), T.Radius);
+		Obj->SetNumberField(TEXT("attackRange"), T.AttackRange);
+		Obj->SetNumberField(TEXT("maxHP"), T.MaxHP);
+		Obj->SetNumberField(TEXT("currentHP"), T.CurrentHP);
+		Obj->SetBoolField(TEXT("isActivated"), T.bIsActivated);
+		Obj->SetNumberField(TEXT("attackCooldown"), T.AttackCooldown);
+		return Obj;
+	}
+
+	void TowerFromJson(const FJsonObject& Obj, FTowerStateData& T)
+	{
+		T.Id = static_cast<int32>(Obj.GetNumberField(TEXT("id")));
+		T.Type = Obj.GetStringField(TEXT("type"));
+		T.Faction = Obj.GetStringField(TEXT("faction"));
+		T.Position = VectorFromJson(Obj, TEXT("position"));
+		T.Radius = static_cast<float>(Obj.GetNumberField(TEXT("radius")));
+		T.AttackRange = static_cast<float>(Obj.GetNumberField(TEXT("attackRange")));
+		T.MaxHP = static_cast<int32>(Obj.GetNumberField(TEXT("maxHP")));
+		T.CurrentHP = static_cast<int32>(Obj.GetNumberField(TEXT("currentHP")));
+		T.bIsActivated = Obj.GetBoolField(TEXT("isActivated"));
+		T.AttackCooldown = static_cast<float>(Obj.GetNumberField(TEXT("attackCooldown")));
+	}
+
+	template<typename StateType, typename ToJsonFn>
+	void SetRecordArray(FJsonObject& Root, const TCHAR* Field, const TArray<StateType>& States, ToJsonFn ToJsonObject)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(States.Num());
+		for (const StateType& State : States)
+		{
+			Values.Add(MakeShared<FJsonValueObject>(ToJsonObject(State)));
+		}
+		Root.SetArrayField(Field, Values);
+	}
+
+	/** Missing arrays (header-only JSON from older builds) read as empty */
+	template<typename StateType, typename FromJsonFn>
+	void GetRecordArray(const FJsonObject& Root, const TCHAR* Field, TArray<StateType>& OutStates, FromJsonFn FromJsonObject)
+	{
+		OutStates.Reset();
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		if (!Root.TryGetArrayField(Field, Values)) return;
+
+		for (const TSharedPtr<FJsonValue>& Value : *Values)
+		{
+			const TSharedPtr<FJsonObject>* Obj = nullptr;
+			if (Value->TryGetObject(Obj) && Obj && (*Obj).IsValid())
+			{
+				FromJsonObject(**Obj, OutStates.AddDefaulted_GetRef());
+			}
+		}
+	}
+}
+
 FString FFrameData::ToJson() const
 {
 	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
@@ -207,13 +376,24 @@ FString FFrameData::ToJson() const
 	Root->SetNumberField(TEXT("currentWave"), CurrentWave);
 	Root->SetNumberField(TEXT("livingFriendlyCount"), LivingFriendlyCount);
 	Root->SetNumberField(TEXT("livingEnemyCount"), LivingEnemyCount);
+	Root->SetArrayField(TEXT("mainTarget"), VectorToJson(MainTarget));
 	Root->SetNumberField(TEXT("elapsedTime"), ElapsedTime);
 	Root->SetNumberField(TEXT("friendlyCrowns"), FriendlyCrowns);
 	Root->SetNumberField(TEXT("enemyCrowns"), EnemyCrowns);
+	Root->SetNumberField(TEXT("gameResult"), static_cast<uint8>(GameResult));
+	Root->SetNumberField(TEXT("winConditionType"), static_cast<uint8>(WinConditionType));
 	Root->SetBoolField(TEXT("isOvertime"), bIsOvertime);
 	Root->SetBoolField(TEXT("allWavesCleared"), bAllWavesCleared);
 	Root->SetBoolField(TEXT("maxFramesReached"), bMaxFramesReached);
 
+	// JSON numbers are doubles, so the 64-bit hash travels as hex
+	Root->SetStringField(TEXT("stateHash"), FString::Printf(TEXT("%016llx"), static_cast<uint64>(StateHash)));
+
+	SetRecordArray(*Root, TEXT("friendlyUnits"), FriendlyUnits, UnitToJson);
+	SetRecordArray(*Root, TEXT("enemyUnits"), EnemyUnits, UnitToJson);
+	SetRecordArray(*Root, TEXT("friendlyTowers"), FriendlyTowers, TowerToJson);
+	SetRecordArray(*Root, TEXT("enemyTowers"), EnemyTowers, TowerToJson);
+
 	FString OutputString;
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
 	FJsonSerializer::Serialize(Root, Writer);
@@ -233,12 +413,30 @@ bool FFrameData::FromJson(const FString& JsonString, FFrameData& OutFrameData)
 	OutFrameData.CurrentWave = static_cast<int32>(Root->GetNumberField(TEXT("currentWave")));
 	OutFrameData.LivingFriendlyCount = static_cast<int32>(Root->GetNumberField(TEXT("livingFriendlyCount")));
 	OutFrameData.LivingEnemyCount = static_cast<int32>(Root->GetNumberField(TEXT("livingEnemyCount")));
+	OutFrameData.MainTarget = VectorFromJson(*Root, TEXT("mainTarget"));
 	OutFrameData.ElapsedTime = static_cast<float>(Root->GetNumberField(TEXT("elapsedTime")));
 	OutFrameData.FriendlyCrowns = static_cast<int32>(Root->GetNumberField(TEXT("friendlyCrowns")));
 	OutFrameData.EnemyCrowns = static_cast<int32>(Root->GetNumberField(TEXT("enemyCrowns")));
+
+	double Number = 0.0;
+	OutFrameData.GameResult = Root->TryGetNumberField(TEXT("gameResult"), Number)
+		? static_cast<EGameResult>(static_cast<uint8>(Number)) : EGameResult::InProgress;
+	OutFrameData.WinConditionType = Root->TryGetNumberField(TEXT("winConditionType"), Number)
+		? static_cast<EWinCondition>(static_cast<uint8>(Number)) : EWinCondition::None;
+
 	OutFrameData.bIsOvertime = Root->GetBoolField(TEXT("isOvertime"));
 	OutFrameData.bAllWavesCleared = Root->GetBoolField(TEXT("allWavesCleared"));
 	OutFrameData.bMaxFramesReached = Root->GetBoolField(TEXT("maxFramesReached"));
 
+	FString StateHashText;
+	OutFrameData.StateHash = Root->TryGetStringField(TEXT("stateHash"), StateHashText)
+		? static_cast<int64>(FCString::Strtoui64(*StateHashText, nullptr, 16))
+		: 0;
+
+	GetRecordArray(*Root, TEXT("friendlyUnits"), OutFrameData.FriendlyUnits, UnitFromJson);
+	GetRecordArray(*Root, TEXT("enemyUnits"), OutFrameData.EnemyUnits, UnitFromJson);
+	GetRecordArray(*Root, TEXT("friendlyTowers"), OutFrameData.FriendlyTowers, TowerFromJson);
+	GetRecordArray(*Root, TEXT("enemyTowers"), OutFrameData.EnemyTowers, TowerFromJson);
+
 	return true;
 }
@@ -0,0 +1,457 @@
+#include "Simulation/FrameDataBinary.h"
+
+using namespace FrameDataBinary;
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "FrameDataBinary records are read in place and assume a little-endian target");
+
+namespace
+{
+	// Byte = index into the table. Order matches the enums, as FromUnit/FromTower name them.
+	const TCHAR* const TargetPriorityNames[] = { TEXT("Nearest"), TEXT("Buildings") };
+	const TCHAR* const RoleNames[] = { TEXT("Melee"), TEXT("Ranged"), TEXT("Tank"), TEXT("MiniTank"),
+		TEXT("GlassCannon"), TEXT("Swarm"), TEXT("Spawner"), TEXT("Support"), TEXT("Siege") };
+	const TCHAR* const FactionNames[] = { TEXT("Friendly"), TEXT("Enemy") };
+	const TCHAR* const TowerTypeNames[] = { TEXT("Princess"), TEXT("King") };
+
+	template<int32 N>
+	uint8 NameToByte(const FString& Name, const TCHAR* const (&Names)[N])
+	{
+		for (int32 i = 0; i < N; ++i)
+		{
+			if (Name.Equals(Names[i], ESearchCase::CaseSensitive)) return static_cast<uint8>(i);
+		}
+		return EnumEscape;
+	}
+
+	template<int32 N>
+	bool ByteToName(uint8 Byte, const TCHAR* const (&Names)[N], FString& Out)
+	{
+		if (Byte >= N) return false;
+		Out = Names[Byte];
+		return true;
+	}
+
+	// ========================================================================
+	// Extras: [u32 length][UTF-8] strings, [u32 count][bytes] abilities
+	// ========================================================================
+
+	void WriteCount(TArray<uint8>& Out, uint32 Count)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(&Count), sizeof(Count));
+	}
+
+	void WriteString(TArray<uint8>& Out, const FString& S)
+	{
+		const FTCHARToUTF8 Utf8(*S);
+		WriteCount(Out, static_cast<uint32>(Utf8.Length()));
+		Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	void WriteEscaped(TArray<uint8>& Out, uint8 Byte, const FString& Name)
+	{
+		if (Byte == EnumEscape) WriteString(Out, Name);
+	}
+
+	struct FExtrasReader
+	{
+		TArrayView<const uint8> Bytes;
+		int32 Pos = 0;
+		bool bError = false;
+
+		const uint8* Take(int64 Size)
+		{
+			if (bError || Size > Bytes.Num() - Pos)
+			{
+				bError = true;
+				return nullptr;
+			}
+			const uint8* Data = Bytes.GetData() + Pos;
+			Pos += static_cast<int32>(Size);
+			return Data;
+		}
+
+		uint32 Count()
+		{
+			uint32 V = 0;
+			if (const uint8* Data = Take(sizeof(V))) FMemory::Memcpy(&V, Data, sizeof(V));
+			return V;
+		}
+
+		FUtf8StringView String()
+		{
+			const uint32 Length = Count();
+			const uint8* Data = Take(Length);
+			return Data ? FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Data), static_cast<int32>(Length)) : FUtf8StringView();
+		}
+
+		void String(FString& Out)
+		{
+			const FUtf8StringView View = String();
+			const FUTF8ToTCHAR Chars(View.GetData(), View.Len());
+			Out = FString(Chars.Length(), Chars.Get());
+		}
+
+		/** Enum name: from the table, or from the extras if it was escaped */
+		template<int32 N>
+		void Name(uint8 Byte, const TCHAR* const (&Names)[N], FString& Out)
+		{
+			if (Byte == EnumEscape)
+			{
+				String(Out);
+			}
+			else if (!ByteToName(Byte, Names, Out))
+			{
+				bError = true;
+			}
+		}
+	};
+
+	FExtrasReader RecordExtras(TArrayView<const uint8> Extras, uint32 Offset, uint32 Size)
+	{
+		return FExtrasReader{ Extras.Slice(static_cast<int32>(Offset), static_cast<int32>(Size)) };
+	}
+
+	void Pack(const FVector2D& V, double (&Out)[2])
+	{
+		Out[0] = V.X;
+		Out[1] = V.Y;
+	}
+
+	FVector2D Unpack(const double (&In)[2])
+	{
+		return FVector2D(In[0], In[1]);
+	}
+
+	template<typename RecordType>
+	void StoreRecord(TArray<uint8>& Out, int32 At, const RecordType& Record)
+	{
+		FMemory::Memcpy(Out.GetData() + At, &Record, sizeof(RecordType));
+	}
+
+	// ========================================================================
+	// Records
+	// ========================================================================
+
+	/** Fill R from Data, appending its extras to Out */
+	void WriteUnit(const FUnitStateData& Data, FUnitRecord& R, TArray<uint8>& Out, int32 ExtrasStart)
+	{
+		R.Id = Data.Id;
+		R.TargetPriority = NameToByte(Data.TargetPriority, TargetPriorityNames);
+		R.Role = NameToByte(Data.Role, RoleNames);
+		R.Faction = NameToByte(Data.Faction, FactionNames);
+		R.Layer = static_cast<uint8>(Data.Layer);
+		R.CanTarget = static_cast<uint8>(Data.CanTarget);
+		R.Flags = (Data.bIsDead ? UnitDead : 0)
+			| (Data.bHasChargeState ? UnitHasChargeState : 0)
+			| (Data.bIsCharging ? UnitCharging : 0)
+			| (Data.bIsCharged ? UnitCharged : 0)
+			| (Data.bHasAvoidanceTarget ? UnitHasAvoidanceTarget : 0)
+			| (Data.bIsMoving ? UnitMoving : 0)
+			| (Data.bInAttackRange ? UnitInAttackRange : 0);
+		R.HP = Data.HP;
+		R.Damage = Data.Damage;
+		R.ShieldHP = Data.ShieldHP;
+		R.MaxShieldHP = Data.MaxShieldHP;
+		R.TargetId = Data.TargetId;
+		R.TakenSlotIndex = Data.TakenSlotIndex;
+		R.Radius = Data.Radius;
+		R.Speed = Data.Speed;
+		R.TurnSpeed = Data.TurnSpeed;
+		R.AttackRange = Data.AttackRange;
+		R.AttackCooldown = Data.AttackCooldown;
+		R.RequiredChargeDistance = Data.RequiredChargeDistance;
+		Pack(Data.Position, R.Position);
+		Pack(Data.Velocity, R.Velocity);
+		Pack(Data.Forward, R.Forward);
+		Pack(Data.CurrentDestination, R.CurrentDestination);
+		Pack(Data.AvoidanceTarget, R.AvoidanceTarget);
+
+		const int32 Start = Out.Num();
+		WriteString(Out, Data.Label);
+		WriteString(Out, Data.UnitId);
+		WriteCount(Out, static_cast<uint32>(Data.Abilities.Num()));
+		Out.Append(reinterpret_cast<const uint8*>(Data.Abilities.GetData()), Data.Abilities.Num());
+		WriteEscaped(Out, R.TargetPriority, Data.TargetPriority);
+		WriteEscaped(Out, R.Role, Data.Role);
+		WriteEscaped(Out, R.Faction, Data.Faction);
+		R.ExtrasOffset = static_cast<uint32>(Start - ExtrasStart);
+		R.ExtrasSize = static_cast<uint32>(Out.Num() - Start);
+	}
+
+	void WriteTower(const FTowerStateData& Data, FTowerRecord& R, TArray<uint8>& Out, int32 ExtrasStart)
+	{
+		R.Id = Data.Id;
+		R.Type = NameToByte(Data.Type, TowerTypeNames);
+		R.Faction = NameToByte(Data.Faction, FactionNames);
+		R.Flags = Data.bIsActivated ? TowerActivated : 0;
+		Pack(Data.Position, R.Position);
+		R.Radius = Data.Radius;
+		R.AttackRange = Data.AttackRange;
+		R.AttackCooldown = Data.AttackCooldown;
+		R.MaxHP = Data.MaxHP;
+		R.CurrentHP = Data.CurrentHP;
+
+		const int32 Start = Out.Num();
+		WriteEscaped(Out, R.Type, Data.Type);
+		WriteEscaped(Out, R.Faction, Data.Faction);
+		R.ExtrasOffset = static_cast<uint32>(Start - ExtrasStart);
+		R.ExtrasSize = static_cast<uint32>(Out.Num() - Start);
+	}
+
+	template<typename StateType, typename RecordType, typename FillFn>
+	void WriteRecords(const TArray<StateType>& States, int32& RecordPos, TArray<uint8>& Out, int32 ExtrasStart, FillFn Fill)
+	{
+		for (const StateType& State : States)
+		{
+			RecordType R{};
+			Fill(State, R, Out, ExtrasStart);
+			StoreRecord(Out, RecordPos, R);
+			RecordPos += sizeof(RecordType);
+		}
+	}
+}
+
+// ============================================================================
+// Write / Read
+// ============================================================================
+
+void FrameDataBinary::Write(const FFrameData& Frame, TArray<uint8>& Out)
+{
+	const int32 NumUnits = Frame.FriendlyUnits.Num() + Frame.EnemyUnits.Num();
+	const int32 NumTowers = Frame.FriendlyTowers.Num() + Frame.EnemyTowers.Num();
+	const int32 Start = Out.Num();
+	const int32 ExtrasStart = Start + sizeof(FHeaderRecord) + NumUnits * sizeof(FUnitRecord) + NumTowers * sizeof(FTowerRecord);
+
+	// Extras are mostly two short strings per unit
+	constexpr int32 TypicalUnitExtras = 48;
+	Out.Reserve(ExtrasStart + NumUnits * TypicalUnitExtras);
+	Out.AddUninitialized(ExtrasStart - Start);
+
+	// Records reference the extras by offset, so Out may reallocate while extras are appended
+	int32 RecordPos = Start + sizeof(FHeaderRecord);
+	WriteRecords<FUnitStateData, FUnitRecord>(Frame.FriendlyUnits, RecordPos, Out, ExtrasStart, WriteUnit);
+	WriteRecords<FUnitStateData, FUnitRecord>(Frame.EnemyUnits, RecordPos, Out, ExtrasStart, WriteUnit);
+	WriteRecords<FTowerStateData, FTowerRecord>(Frame.FriendlyTowers, RecordPos, Out, ExtrasStart, WriteTower);
+	WriteRecords<FTowerStateData, FTowerRecord>(Frame.EnemyTowers, RecordPos, Out, ExtrasStart, WriteTower);
+
+	FHeaderRecord H{};
+	H.Magic = Magic;
+	H.Version = Version;
+	H.GameResult = static_cast<uint8>(Frame.GameResult);
+	H.WinConditionType = static_cast<uint8>(Frame.WinConditionType);
+	H.FrameNumber = Frame.FrameNumber;
+	H.CurrentWave = Frame.CurrentWave;
+	H.LivingFriendlyCount = Frame.LivingFriendlyCount;
+	H.LivingEnemyCount = Frame.LivingEnemyCount;
+	Pack(Frame.MainTarget, H.MainTarget);
+	H.ElapsedTime = Frame.ElapsedTime;
+	H.FriendlyCrowns = Frame.FriendlyCrowns;
+	H.EnemyCrowns = Frame.EnemyCrowns;
+	H.Flags = (Frame.bIsOvertime ? FrameOvertime : 0)
+		| (Frame.bAllWavesCleared ? FrameAllWavesCleared : 0)
+		| (Frame.bMaxFramesReached ? FrameMaxFramesReached : 0);
+	H.StateHash = static_cast<uint64>(Frame.StateHash);
+	H.NumFriendlyUnits = static_cast<uint32>(Frame.FriendlyUnits.Num());
+	H.NumEnemyUnits = static_cast<uint32>(Frame.EnemyUnits.Num());
+	H.NumFriendlyTowers = static_cast<uint32>(Frame.FriendlyTowers.Num());
+	H.NumEnemyTowers = static_cast<uint32>(Frame.EnemyTowers.Num());
+	H.ExtrasSize = static_cast<uint32>(Out.Num() - ExtrasStart);
+	StoreRecord(Out, Start, H);
+}
+
+bool FrameDataBinary::Read(TArrayView<const uint8> Bytes, FFrameData& OutFrame)
+{
+	FFrameDataView View;
+	return View.Open(Bytes) && View.ToFrameData(OutFrame);
+}
+
+// ============================================================================
+// FUnitStateView / FTowerStateView
+// ============================================================================
+
+FUtf8StringView FUnitStateView::GetLabel() const
+{
+	FExtrasReader In = RecordExtras(Extras, Record->ExtrasOffset, Record->ExtrasSize);
+	return In.String();
+}
+
+FUtf8StringView FUnitStateView::GetUnitId() const
+{
+	FExtrasReader In = RecordExtras(Extras, Record->ExtrasOffset, Record->ExtrasSize);
+	In.String();
+	return In.String();
+}
+
+int32 FUnitStateView::GetNumAbilities() const
+{
+	FExtrasReader In = RecordExtras(Extras, Record->ExtrasOffset, Record->ExtrasSize);
+	In.String();
+	In.String();
+	const uint32 Count = In.Count();
+	return (!In.bError && Count <= static_cast<uint32>(In.Bytes.Num() - In.Pos)) ? static_cast<int32>(Count) : 0;
+}
+
+EAbilityType FUnitStateView::GetAbility(int32 Index) const
+{
+	FExtrasReader In = RecordExtras(Extras, Record->ExtrasOffset, Record->ExtrasSize);
+	In.String();
+	In.String();
+	const uint32 Count = In.Count();
+	const uint8* Abilities = In.Take(Count);
+	if (!Abilities || Index < 0 || static_cast<uint32>(Index) >= Count) return EAbilityType::ChargeAttack;
+	return static_cast<EAbilityType>(Abilities[Index]);
+}
+
+bool FUnitStateView::ToStateData(FUnitStateData& Out) const
+{
+	const FUnitRecord& R = *Record;
+	FExtrasReader In = RecordExtras(Extras, R.ExtrasOffset, R.ExtrasSize);
+
+	Out.Id = R.Id;
+	In.String(Out.Label);
+	In.String(Out.UnitId);
+
+	const uint32 NumAbilities = In.Count();
+	Out.Abilities.Reset();
+	if (const uint8* Abilities = In.Take(NumAbilities))
+	{
+		Out.Abilities.Append(reinterpret_cast<const EAbilityType*>(Abilities), static_cast<int32>(NumAbilities));
+	}
+
+	In.Name(R.TargetPriority, TargetPriorityNames, Out.TargetPriority);
+	In.Name(R.Role, RoleNames, Out.Role);
+	In.Name(R.Faction, FactionNames, Out.Faction);
+
+	Out.bIsDead = (R.Flags & UnitDead) != 0;
+	Out.HP = R.HP;
+	Out.Radius = R.Radius;
+	Out.Speed = R.Speed;
+	Out.TurnSpeed = R.TurnSpeed;
+	Out.AttackRange = R.AttackRange;
+	Out.AttackCooldown = R.AttackCooldown;
+	Out.Layer = static_cast<EMovementLayer>(R.Layer);
+	Out.CanTarget = static_cast<ETargetType>(R.CanTarget);
+	Out.Damage = R.Damage;
+	Out.ShieldHP = R.ShieldHP;
+	Out.MaxShieldHP = R.MaxShieldHP;
+	Out.bHasChargeState = (R.Flags & UnitHasChargeState) != 0;
+	Out.bIsCharging = (R.Flags & UnitCharging) != 0;
+	Out.bIsCharged = (R.Flags & UnitCharged) != 0;
+	Out.RequiredChargeDistance = R.RequiredChargeDistance;
+	Out.Position = Unpack(R.Position);
+	Out.Velocity = Unpack(R.Velocity);
+	Out.Forward = Unpack(R.Forward);
+	Out.CurrentDestination = Unpack(R.CurrentDestination);
+	Out.TargetId = R.TargetId;
+	Out.TakenSlotIndex = R.TakenSlotIndex;
+	Out.bHasAvoidanceTarget = (R.Flags & UnitHasAvoidanceTarget) != 0;
+	Out.AvoidanceTarget = Unpack(R.AvoidanceTarget);
+	Out.bIsMoving = (R.Flags & UnitMoving) != 0;
+	Out.bInAttackRange = (R.Flags & UnitInAttackRange) != 0;
+
+	return !In.bError && In.Pos == In.Bytes.Num();
+}
+
+bool FTowerStateView::ToStateData(FTowerStateData& Out) const
+{
+	const FTowerRecord& R = *Record;
+	FExtrasReader In = RecordExtras(Extras, R.ExtrasOffset, R.ExtrasSize);
+
+	Out.Id = R.Id;
+	In.Name(R.Type, TowerTypeNames, Out.Type);
+	In.Name(R.Faction, FactionNames, Out.Faction);
+	Out.Position = Unpack(R.Position);
+	Out.Radius = R.Radius;
+	Out.AttackRange = R.AttackRange;
+	Out.MaxHP = R.MaxHP;
+	Out.CurrentHP = R.CurrentHP;
+	Out.bIsActivated = (R.Flags & TowerActivated) != 0;
+	Out.AttackCooldown = R.AttackCooldown;
+
+	return !In.bError && In.Pos == In.Bytes.Num();
+}
+
+// ============================================================================
+// FFrameDataView
+// ============================================================================
+
+bool FFrameDataView::Open(TArrayView<const uint8> Bytes)
+{
+	Header = nullptr;
+	Units = nullptr;
+	Towers = nullptr;
+	Extras = TArrayView<const uint8>();
+
+	if (Bytes.Num() < static_cast<int32>(sizeof(FHeaderRecord))) return false;
+
+	const FHeaderRecord* H = reinterpret_cast<const FHeaderRecord*>(Bytes.GetData());
+	if (H->Magic != Magic || H->Version != Version) return false;
+
+	const uint64 NumUnits = static_cast<uint64>(H->NumFriendlyUnits) + H->NumEnemyUnits;
+	const uint64 NumTowers = static_cast<uint64>(H->NumFriendlyTowers) + H->NumEnemyTowers;
+	const uint64 RecordsEnd = sizeof(FHeaderRecord) + NumUnits * sizeof(FUnitRecord) + NumTowers * sizeof(FTowerRecord);
+	if (RecordsEnd + H->ExtrasSize != static_cast<uint64>(Bytes.Num())) return false;
+
+	const FUnitRecord* UnitRecords = reinterpret_cast<const FUnitRecord*>(Bytes.GetData() + sizeof(FHeaderRecord));
+	const FTowerRecord* TowerRecords = reinterpret_cast<const FTowerRecord*>(UnitRecords + NumUnits);
+
+	// Checked once here so the views can slice the extras without bounds checks of their own
+	for (uint64 i = 0; i < NumUnits; ++i)
+	{
+		if (static_cast<uint64>(UnitRecords[i].ExtrasOffset) + UnitRecords[i].ExtrasSize > H->ExtrasSize) return false;
+	}
+	for (uint64 i = 0; i < NumTowers; ++i)
+	{
+		if (static_cast<uint64>(TowerRecords[i].ExtrasOffset) + TowerRecords[i].ExtrasSize > H->ExtrasSize) return false;
+	}
+
+	Header = H;
+	Units = UnitRecords;
+	Towers = TowerRecords;
+	Extras = Bytes.Slice(static_cast<int32>(RecordsEnd), static_cast<int32>(H->ExtrasSize));
+	return true;
+}
+
+bool FFrameDataView::ToFrameData(FFrameData& Out) const
+{
+	if (!IsValid()) return false;
+
+	const FHeaderRecord& H = *Header;
+	Out.FrameNumber = H.FrameNumber;
+	Out.CurrentWave = H.CurrentWave;
+	Out.LivingFriendlyCount = H.LivingFriendlyCount;
+	Out.LivingEnemyCount = H.LivingEnemyCount;
+	Out.MainTarget = Unpack(H.MainTarget);
+	Out.ElapsedTime = H.ElapsedTime;
+	Out.FriendlyCrowns = H.FriendlyCrowns;
+	Out.EnemyCrowns = H.EnemyCrowns;
+	Out.GameResult = static_cast<EGameResult>(H.GameResult);
+	Out.WinConditionType = static_cast<EWinCondition>(H.WinConditionType);
+	Out.bIsOvertime = (H.Flags & FrameOvertime) != 0;
+	Out.bAllWavesCleared = (H.Flags & FrameAllWavesCleared) != 0;
+	Out.bMaxFramesReached = (H.Flags & FrameMaxFramesReached) != 0;
+	Out.StateHash = static_cast<int64>(H.StateHash);
+
+	bool bOk = true;
+	Out.FriendlyUnits.SetNum(NumFriendlyUnits());
+	for (int32 i = 0; i < NumFriendlyUnits(); ++i)
+	{
+		bOk &= GetFriendlyUnit(i).ToStateData(Out.FriendlyUnits[i]);
+	}
+	Out.EnemyUnits.SetNum(NumEnemyUnits());
+	for (int32 i = 0; i < NumEnemyUnits(); ++i)
+	{
+		bOk &= GetEnemyUnit(i).ToStateData(Out.EnemyUnits[i]);
+	}
+	Out.FriendlyTowers.SetNum(NumFriendlyTowers());
+	for (int32 i = 0; i < NumFriendlyTowers(); ++i)
+	{
+		bOk &= GetFriendlyTower(i).ToStateData(Out.FriendlyTowers[i]);
+	}
+	Out.EnemyTowers.SetNum(NumEnemyTowers());
+	for (int32 i = 0; i < NumEnemyTowers(); ++i)
+	{
+		bOk &= GetEnemyTower(i).ToStateData(Out.EnemyTowers[i]);
+	}
+	return bOk;
+}
@@ -0,0 +1,540 @@
+#include "Simulation/FrameDelta.h"
+
+namespace
+{
+	constexpr uint8 PacketKeyframe = 1 << 0;
+
+	uint32 ZigZag(int32 V) { return (static_cast<uint32>(V) << 1) ^ static_cast<uint32>(V >> 31); }
+	int32 UnZigZag(uint32 V) { return static_cast<int32>(V >> 1) ^ -static_cast<int32>(V & 1); }
+
+	template<typename T>
+	bool BitsDiffer(const T& A, const T& B) { return FMemory::Memcmp(&A, &B, sizeof(T)) != 0; }
+
+	FIntPoint Quantize(const FVector2D& V, double Step)
+	{
+		return FIntPoint(FMath::RoundToInt32(V.X / Step), FMath::RoundToInt32(V.Y / Step));
+	}
+
+	// ========================================================================
+	// Byte streams (raw floats are little-endian, as on every UE target)
+	// ========================================================================
+
+	struct FByteWriter
+	{
+		TArray<uint8>& Bytes;
+
+		void Raw(const void* Data, int32 Size) { Bytes.Append(static_cast<const uint8*>(Data), Size); }
+		void Byte(uint8 V) { Bytes.Add(V); }
+		void Int(int32 V) { Packed(ZigZag(V)); }
+
+		/** LEB128: 7 bits per byte, high bit set while more follow */
+		void Packed(uint32 V)
+		{
+			while (V >= 0x80)
+			{
+				Bytes.Add(static_cast<uint8>(V | 0x80));
+				V >>= 7;
+			}
+			Bytes.Add(static_cast<uint8>(V));
+		}
+	};
+
+	struct FByteReader
+	{
+		const TArray<uint8>& Bytes;
+		int32 Pos = 0;
+		bool bError = false;
+
+		int32 Remaining() const { return Bytes.Num() - Pos; }
+
+		/** Next Size bytes, or nullptr (and the error flag) past the end */
+		const uint8* Take(int32 Size)
+		{
+			if (bError || Size < 0 || Size > Remaining())
+			{
+				bError = true;
+				return nullptr;
+			}
+			const uint8* Data = Bytes.GetData() + Pos;
+			Pos += Size;
+			return Data;
+		}
+
+		void Raw(void* Out, int32 Size)
+		{
+			if (const uint8* Data = Take(Size))
+			{
+				FMemory::Memcpy(Out, Data, Size);
+			}
+		}
+
+		uint8 Byte()
+		{
+			const uint8* Data = Take(1);
+			return Data ? *Data : 0;
+		}
+
+		uint32 Packed()
+		{
+			uint32 V = 0;
+			for (int32 Shift = 0; Shift < 35; Shift += 7)
+			{
+				const uint8 B = Byte();
+				V |= static_cast<uint32>(B & 0x7F) << Shift;
+				if ((B & 0x80) == 0) return V;
+			}
+			bError = true;
+			return 0;
+		}
+
+		int32 Int() { return UnZigZag(Packed()); }
+	};
+
+	// ========================================================================
+	// Field visitors
+	// ========================================================================
+
+	/** Marks each field of Cur that differs from Ref, writes it and moves Ref to the value the decoder will hold */
+	struct FDiffWriter
+	{
+		FByteWriter Out;
+		double VectorStep = 0.0;
+		uint32 Mask = 0;
+		int32 Bit = 0;
+
+		bool Mark(bool bChanged)
+		{
+			if (bChanged) Mask |= 1u << Bit;
+			Bit++;
+			return bChanged;
+		}
+
+		void operator()(const int32& Cur, int32& Ref)
+		{
+			if (Mark(Cur != Ref))
+			{
+				Out.Int(static_cast<int32>(static_cast<uint32>(Cur) - static_cast<uint32>(Ref)));
+				Ref = Cur;
+			}
+		}
+
+		/** Hashes don't delta-compress; a change stores the new value */
+		void operator()(const int64& Cur, int64& Ref)
+		{
+			if (Mark(Cur != Ref))
+			{
+				Out.Raw(&Cur, sizeof(int64));
+				Ref = Cur;
+			}
+		}
+
+		void operator()(const float& Cur, float& Ref)
+		{
+			if (Mark(BitsDiffer(Cur, Ref)))
+			{
+				Out.Raw(&Cur, sizeof(float));
+				Ref = Cur;
+			}
+		}
+
+		/** Bools are pure toggles: the mask bit is the payload */
+		void operator()(const bool& Cur, bool& Ref)
+		{
+			if (Mark(Cur != Ref)) Ref = Cur;
+		}
+
+		void operator()(const FString& Cur, FString& Ref)
+		{
+			if (Mark(!Cur.Equals(Ref, ESearchCase::CaseSensitive)))
+			{
+				const FTCHARToUTF8 Utf8(*Cur);
+				Out.Packed(Utf8.Length());
+				Out.Raw(Utf8.Get(), Utf8.Length());
+				Ref = Cur;
+			}
+		}
+
+		template<typename EnumType>
+		typename TEnableIf<TIsEnum<EnumType>::Value>::Type operator()(const EnumType& Cur, EnumType& Ref)
+		{
+			if (Mark(Cur != Ref))
+			{
+				Out.Byte(static_cast<uint8>(Cur));
+				Ref = Cur;
+			}
+		}
+
+		void operator()(const TArray<EAbilityType>& Cur, TArray<EAbilityType>& Ref)
+		{
+			if (Mark(Cur != Ref))
+			{
+				Out.Packed(Cur.Num());
+				Out.Raw(Cur.GetData(), Cur.Num());
+				Ref = Cur;
+			}
+		}
+
+		void operator()(const FVector2D& Cur, FVector2D& Ref)
+		{
+			if (VectorStep > 0.0)
+			{
+				// Sent whenever Ref is not the snapped value yet, so error stays within half a step
+				const FIntPoint Q = Quantize(Cur, VectorStep);
+				const FVector2D Snapped(Q.X * VectorStep, Q.Y * VectorStep);
+				if (Mark(BitsDiffer(Snapped.X, Ref.X) || BitsDiffer(Snapped.Y, Ref.Y)))
+				{
+					const FIntPoint RefQ = Quantize(Ref, VectorStep);
+					Out.Int(Q.X - RefQ.X);
+					Out.Int(Q.Y - RefQ.Y);
+					Ref = Snapped;
+				}
+			}
+			else if (Mark(BitsDiffer(Cur.X, Ref.X) || BitsDiffer(Cur.Y, Ref.Y)))
+			{
+				Out.Raw(&Cur.X, sizeof(double));
+				Out.Raw(&Cur.Y, sizeof(double));
+				Ref = Cur;
+			}
+		}
+	};
+
+	/** Applies the fields flagged in Mask to Ref (the first argument of each pair is ignored) */
+	struct FDiffReader
+	{
+		FByteReader& In;
+		double VectorStep = 0.0;
+		uint32 Mask = 0;
+		int32 Bit = 0;
+
+		bool Next() { return ((Mask >> Bit++) & 1u) != 0; }
+
+		void operator()(const int32&, int32& Ref)
+		{
+			if (Next()) Ref = static_cast<int32>(static_cast<uint32>(Ref) + static_cast<uint32>(In.Int()));
+		}
+
+		void operator()(const int64&, int64& Ref)
+		{
+			if (Next()) In.Raw(&Ref, sizeof(int64));
+		}
+
+		void operator()(const float&, float& Ref)
+		{
+			if (Next()) In.Raw(&Ref, sizeof(float));
+		}
+
+		void operator()(const bool&, bool& Ref)
+		{
+			if (Next()) Ref = !Ref;
+		}
+
+		void operator()(const FString&, FString& Ref)
+		{
+			if (!Next()) return;
+			const int32 Length = static_cast<int32>(In.Packed());
+			if (const uint8* Data = In.Take(Length))
+			{
+				const FUTF8ToTCHAR Chars(reinterpret_cast<const UTF8CHAR*>(Data), Length);
+				Ref = FString(Chars.Length(), Chars.Get());
+			}
+		}
+
+		template<typename EnumType>
+		typename TEnableIf<TIsEnum<EnumType>::Value>::Type operator()(const EnumType&, EnumType& Ref)
+		{
+			if (Next()) Ref = static_cast<EnumType>(In.Byte());
+		}
+
+		void operator()(const TArray<EAbilityType>&, TArray<EAbilityType>& Ref)
+		{
+			if (!Next()) return;
+			const int32 Num = static_cast<int32>(In.Packed());
+			if (const uint8* Data = In.Take(Num))
+			{
+				Ref.SetNumUninitialized(Num);
+				FMemory::Memcpy(Ref.GetData(), Data, Num);
+			}
+		}
+
+		void operator()(const FVector2D&, FVector2D& Ref)
+		{
+			if (!Next()) return;
+			if (VectorStep > 0.0)
+			{
+				const FIntPoint RefQ = Quantize(Ref, VectorStep);
+				const int32 QX = RefQ.X + In.Int();
+				const int32 QY = RefQ.Y + In.Int();
+				Ref = FVector2D(QX * VectorStep, QY * VectorStep);
+			}
+			else
+			{
+				In.Raw(&Ref.X, sizeof(double));
+				In.Raw(&Ref.Y, sizeof(double));
+			}
+		}
+	};
+
+	// ========================================================================
+	// Record layouts (at most 32 fields each; Ids are carried by the block order)
+	// ========================================================================
+
+	template<typename VisitorType>
+	void VisitFields(const FFrameData& Cur, FFrameData& Ref, VisitorType& Visit)
+	{
+		Visit(Cur.FrameNumber, Ref.FrameNumber);
+		Visit(Cur.CurrentWave, Ref.CurrentWave);
+		Visit(Cur.LivingFriendlyCount, Ref.LivingFriendlyCount);
+		Visit(Cur.LivingEnemyCount, Ref.LivingEnemyCount);
+		Visit(Cur.MainTarget, Ref.MainTarget);
+		Visit(Cur.ElapsedTime, Ref.ElapsedTime);
+		Visit(Cur.FriendlyCrowns, Ref.FriendlyCrowns);
+		Visit(Cur.EnemyCrowns, Ref.EnemyCrowns);
+		Visit(Cur.GameResult, Ref.GameResult);
+		Visit(Cur.WinConditionType, Ref.WinConditionType);
+		Visit(Cur.bIsOvertime, Ref.bIsOvertime);
+		Visit(Cur.bAllWavesCleared, Ref.bAllWavesCleared);
+		Visit(Cur.bMaxFramesReached, Ref.bMaxFramesReached);
+		Visit(Cur.StateHash, Ref.StateHash);
+	}
+
+	template<typename VisitorType>
+	void VisitFields(const FUnitStateData& Cur, FUnitStateData& Ref, VisitorType& Visit)
+	{
+		Visit(Cur.Label, Ref.Label);
+		Visit(Cur.UnitId, Ref.UnitId);
+		Visit(Cur.TargetPriority, Ref.TargetPriority);
+		Visit(Cur.Role, Ref.Role);
+		Visit(Cur.Faction, Ref.Faction);
+		Visit(Cur.bIsDead, Ref.bIsDead);
+		Visit(Cur.HP, Ref.HP);
+		Visit(Cur.Radius, Ref.Radius);
+		Visit(Cur.Speed, Ref.Speed);
+		Visit(Cur.TurnSpeed, Ref.TurnSpeed);
+		Visit(Cur.AttackRange, Ref.AttackRange);
+		Visit(Cur.AttackCooldown, Ref.AttackCooldown);
+		Visit(Cur.Layer, Ref.Layer);
+		Visit(Cur.CanTarget, Ref.CanTarget);
+		Visit(Cur.Damage, Ref.Damage);
+		Visit(Cur.ShieldHP, Ref.ShieldHP);
+		Visit(Cur.MaxShieldHP, Ref.MaxShieldHP);
+		Visit(Cur.bHasChargeState, Ref.bHasChargeState);
+		Visit(Cur.bIsCharging, Ref.bIsCharging);
+		Visit(Cur.bIsCharged, Ref.bIsCharged);
+		Visit(Cur.RequiredChargeDistance, Ref.RequiredChargeDistance);
+		Visit(Cur.Abilities, Ref.Abilities);
+		Visit(Cur.Position, Ref.Position);
+		Visit(Cur.Velocity, Ref.Velocity);
+		Visit(Cur.Forward, Ref.Forward);
+		Visit(Cur.CurrentDestination, Ref.CurrentDestination);
+		Visit(Cur.TargetId, Ref.TargetId);
+		Visit(Cur.TakenSlotIndex, Ref.TakenSlotIndex);
+		Visit(Cur.bHasAvoidanceTarget, Ref.bHasAvoidanceTarget);
+		Visit(Cur.AvoidanceTarget, Ref.AvoidanceTarget);
+		Visit(Cur.bIsMoving, Ref.bIsMoving);
+		Visit(Cur.bInAttackRange, Ref.bInAttackRange);
+	}
+
+	template<typename VisitorType>
+	void VisitFields(const FTowerStateData& Cur, FTowerStateData& Ref, VisitorType& Visit)
+	{
+		Visit(Cur.Type, Ref.Type);
+		Visit(Cur.Faction, Ref.Faction);
+		Visit(Cur.Position, Ref.Position);
+		Visit(Cur.Radius, Ref.Radius);
+		Visit(Cur.AttackRange, Ref.AttackRange);
+		Visit(Cur.MaxHP, Ref.MaxHP);
+		Visit(Cur.CurrentHP, Ref.CurrentHP);
+		Visit(Cur.bIsActivated, Ref.bIsActivated);
+		Visit(Cur.AttackCooldown, Ref.AttackCooldown);
+	}
+
+	/** Mask, then the changed fields (staged in FieldBytes since the mask comes first) */
+	template<typename StateType>
+	void WriteRecord(FByteWriter& Out, TArray<uint8>& FieldBytes, double VectorStep, const StateType& Cur, StateType& Ref)
+	{
+		FieldBytes.Reset();
+		FDiffWriter Writer{ FByteWriter{ FieldBytes }, VectorStep };
+		VisitFields(Cur, Ref, Writer);
+		Out.Packed(Writer.Mask);
+		Out.Raw(FieldBytes.GetData(), FieldBytes.Num());
+	}
+
+	template<typename StateType>
+	void ReadRecord(FByteReader& In, double VectorStep, StateType& Ref)
+	{
+		FDiffReader Reader{ In, VectorStep, In.Packed() };
+		VisitFields(Ref, Ref, Reader);
+	}
+
+	// ========================================================================
+	// Blocks (one per unit / tower array)
+	// ========================================================================
+
+	/** Reorder Refs to Ids, carrying records over by Id; new Ids (and every Id on a keyframe) start from defaults */
+	template<typename StateType>
+	void Rebase(const TArray<int32>& Ids, TArray<StateType>& Refs, bool bKeyframe)
+	{
+		TMap<int32, int32> OldSlots;
+		if (!bKeyframe)
+		{
+			OldSlots.Reserve(Refs.Num());
+			for (int32 i = 0; i < Refs.Num(); ++i)
+			{
+				OldSlots.Add(Refs[i].Id, i);
+			}
+		}
+
+		TArray<StateType> NewRefs;
+		NewRefs.SetNum(Ids.Num());
+		for (int32 i = 0; i < Ids.Num(); ++i)
+		{
+			if (const int32* Old = OldSlots.Find(Ids[i]))
+			{
+				NewRefs[i] = MoveTemp(Refs[*Old]);
+			}
+			NewRefs[i].Id = Ids[i];
+		}
+		Refs = MoveTemp(NewRefs);
+	}
+
+	/** Order byte, the Id list if the order changed, then one record per entry */
+	template<typename StateType>
+	void EncodeBlock(FByteWriter& Out, TArray<uint8>& FieldBytes, TArray<int32>& Ids, double VectorStep, bool bKeyframe,
+		const TArray<StateType>& Cur, TArray<StateType>& Refs)
+	{
+		bool bSameOrder = !bKeyframe && Cur.Num() == Refs.Num();
+		for (int32 i = 0; bSameOrder && i < Cur.Num(); ++i)
+		{
+			bSameOrder = Cur[i].Id == Refs[i].Id;
+		}
+
+		Out.Byte(bSameOrder ? 0 : 1);
+		if (!bSameOrder)
+		{
+			Ids.Reset();
+			Out.Packed(Cur.Num());
+			int32 PrevId = 0;
+			for (const StateType& State : Cur)
+			{
+				Out.Int(State.Id - PrevId);
+				PrevId = State.Id;
+				Ids.Add(State.Id);
+			}
+			Rebase(Ids, Refs, bKeyframe);
+		}
+
+		for (int32 i = 0; i < Cur.Num(); ++i)
+		{
+			WriteRecord(Out, FieldBytes, VectorStep, Cur[i], Refs[i]);
+		}
+	}
+
+	template<typename StateType>
+	void DecodeBlock(FByteReader& In, TArray<int32>& Ids, double VectorStep, bool bKeyframe, TArray<StateType>& Refs)
+	{
+		const bool bSameOrder = In.Byte() == 0;
+		if (bSameOrder && bKeyframe)
+		{
+			In.bError = true;
+			return;
+		}
+
+		if (!bSameOrder)
+		{
+			// Every Id takes at least a byte, which bounds a corrupt count
+			const int32 Num = static_cast<int32>(In.Packed());
+			if (Num < 0 || Num > In.Remaining())
+			{
+				In.bError = true;
+				return;
+			}
+			Ids.Reset();
+			int32 PrevId = 0;
+			for (int32 i = 0; i < Num; ++i)
+			{
+				PrevId += In.Int();
+				Ids.Add(PrevId);
+			}
+			Rebase(Ids, Refs, bKeyframe);
+		}
+
+		for (StateType& Ref : Refs)
+		{
+			if (In.bError) return;
+			ReadRecord(In, VectorStep, Ref);
+		}
+	}
+}
+
+// ============================================================================
+// Encoder
+// ============================================================================
+
+FFrameDeltaEncoder::FFrameDeltaEncoder(const FFrameDeltaSettings& InSettings)
+	: Settings(InSettings)
+{
+}
+
+void FFrameDeltaEncoder::Encode(const FFrameData& Frame, TArray<uint8>& OutPacket)
+{
+	OutPacket.Reset();
+	FByteWriter Out{ OutPacket };
+
+	const bool bKeyframe = FramesSinceKeyframe == INDEX_NONE || FramesSinceKeyframe + 1 >= Settings.KeyframeInterval;
+	if (bKeyframe)
+	{
+		Reference = FFrameData();
+		FramesSinceKeyframe = 0;
+	}
+	else
+	{
+		FramesSinceKeyframe++;
+	}
+
+	Out.Byte(bKeyframe ? PacketKeyframe : 0);
+	if (bKeyframe)
+	{
+		Out.Raw(&Settings.VectorStep, sizeof(double));
+	}
+
+	const double Step = Settings.VectorStep;
+	WriteRecord(Out, FieldBytes, Step, Frame, Reference);
+	EncodeBlock(Out, FieldBytes, Ids, Step, bKeyframe, Frame.FriendlyUnits, Reference.FriendlyUnits);
+	EncodeBlock(Out, FieldBytes, Ids, Step, bKeyframe, Frame.EnemyUnits, Reference.EnemyUnits);
+	EncodeBlock(Out, FieldBytes, Ids, Step, bKeyframe, Frame.FriendlyTowers, Reference.FriendlyTowers);
+	EncodeBlock(Out, FieldBytes, Ids, Step, bKeyframe, Frame.EnemyTowers, Reference.EnemyTowers);
+}
+
+// ============================================================================
+// Decoder
+// ============================================================================
+
+bool FFrameDeltaDecoder::Decode(const TArray<uint8>& Packet)
+{
+	FByteReader In{ Packet };
+
+	const bool bKeyframe = (In.Byte() & PacketKeyframe) != 0;
+	if (bKeyframe)
+	{
+		Frame = FFrameData();
+		In.Raw(&VectorStep, sizeof(double));
+	}
+	else if (!bHasKeyframe)
+	{
+		return false;
+	}
+
+	ReadRecord(In, VectorStep, Frame);
+	DecodeBlock(In, Ids, VectorStep, bKeyframe, Frame.FriendlyUnits);
+	DecodeBlock(In, Ids, VectorStep, bKeyframe, Frame.EnemyUnits);
+	DecodeBlock(In, Ids, VectorStep, bKeyframe, Frame.FriendlyTowers);
+	DecodeBlock(In, Ids, VectorStep, bKeyframe, Frame.EnemyTowers);
+
+	// A short or overlong packet leaves Frame half-applied: resync on the next keyframe
+	bHasKeyframe = !In.bError && In.Remaining() == 0;
+	if (!bHasKeyframe)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[FrameDelta] Corrupt packet (%d bytes), waiting for a keyframe"), Packet.Num());
+	}
+	return bHasKeyframe;
+}
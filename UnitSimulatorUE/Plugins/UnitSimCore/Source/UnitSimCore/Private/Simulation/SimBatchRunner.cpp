@@ -0,0 +1,194 @@
+#include "Simulation/SimBatchRunner.h"
+#include "Simulation/SimulatorCore.h"
+#include "Terrain/MapLayout.h"
+#include "Units/UnitRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include <atomic>
+
+// ============================================================================
+// Summary
+// ============================================================================
+
+FSimBatchSummary FSimBatchSummary::Aggregate(const TArray<FSimMatchResult>& Results)
+{
+	FSimBatchSummary Summary;
+	Summary.Matches = Results.Num();
+	if (Summary.Matches == 0) return Summary;
+
+	for (const FSimMatchResult& R : Results)
+	{
+		switch (R.Result)
+		{
+		case EGameResult::FriendlyWin: Summary.FriendlyWins++; break;
+		case EGameResult::EnemyWin:    Summary.EnemyWins++; break;
+		case EGameResult::Draw:        Summary.Draws++; break;
+		default:                       Summary.Unfinished++; break;
+		}
+
+		Summary.AvgFrames += R.FrameCount;
+		Summary.AvgFriendlyCrowns += R.FriendlyCrowns;
+		Summary.AvgEnemyCrowns += R.EnemyCrowns;
+		Summary.AvgFriendlyTowerHPRatio += R.FriendlyTowerHPRatio;
+		Summary.AvgEnemyTowerHPRatio += R.EnemyTowerHPRatio;
+	}
+
+	const double Count = static_cast<double>(Summary.Matches);
+	Summary.AvgFrames /= Count;
+	Summary.AvgFriendlyCrowns /= Count;
+	Summary.AvgEnemyCrowns /= Count;
+	Summary.AvgFriendlyTowerHPRatio /= Count;
+	Summary.AvgEnemyTowerHPRatio /= Count;
+	return Summary;
+}
+
+FString FSimBatchSummary::ToTable() const
+{
+	const double Total = FMath::Max(1, Matches);
+	auto Row = [](const TCHAR* Label, const FString& Value)
+	{
+		return FString::Printf(TEXT("%-24s %s\n"), Label, *Value);
+	};
+	auto Share = [Total](int32 N)
+	{
+		return FString::Printf(TEXT("%8d  (%5.1f%%)"), N, 100.0 * N / Total);
+	};
+
+	FString Table;
+	Table += Row(TEXT("Matches"), FString::Printf(TEXT("%8d"), Matches));
+	Table += Row(TEXT("Friendly wins"), Share(FriendlyWins));
+	Table += Row(TEXT("Enemy wins"), Share(EnemyWins));
+	Table += Row(TEXT("Draws"), Share(Draws));
+	Table += Row(TEXT("Unfinished"), Share(Unfinished));
+	Table += Row(TEXT("Avg frames"), FString::Printf(TEXT("%8.1f"), AvgFrames));
+	Table += Row(TEXT("Avg crowns F / E"), FString::Printf(TEXT("%8.2f / %.2f"), AvgFriendlyCrowns, AvgEnemyCrowns));
+	Table += Row(TEXT("Avg tower HP F / E"), FString::Printf(TEXT("%8.3f / %.3f"), AvgFriendlyTowerHPRatio, AvgEnemyTowerHPRatio));
+	Table += Row(TEXT("Workers"), FString::Printf(TEXT("%8d"), NumWorkers));
+	Table += Row(TEXT("Wall / busy seconds"), FString::Printf(TEXT("%8.2f / %.2f"), WallSeconds, BusySeconds));
+	Table += Row(TEXT("Matches/sec"), FString::Printf(TEXT("%8.2f"), MatchesPerSecond));
+	Table += Row(TEXT("Matches/sec/core"), FString::Printf(TEXT("%8.2f"), MatchesPerSecondPerCore));
+	return Table;
+}
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+FSimBatchRunner::FSimBatchRunner(int32 InNumWorkers)
+{
+	NumWorkers = InNumWorkers > 0
+		? InNumWorkers
+		: FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+}
+
+FSimBatchRunner::~FSimBatchRunner() = default;
+
+FSimBatchSummary FSimBatchRunner::Run(const TArray<FSimBatchJob>& Jobs, TArray<FSimMatchResult>& OutResults)
+{
+	OutResults.Reset();
+	OutResults.SetNum(Jobs.Num());
+
+	const int32 Workers = FMath::Clamp(Jobs.Num(), 1, NumWorkers);
+	while (Instances.Num() < Workers)
+	{
+		Instances.Add(MakeUnique<FSimulatorCore>());
+	}
+
+	TArray<double> BusySeconds;
+	BusySeconds.SetNumZeroed(Workers);
+	std::atomic<int32> NextJob{0};
+
+	const double WallStart = FPlatformTime::Seconds();
+
+	ParallelFor(Workers, [&](int32 Worker)
+	{
+		FSimulatorCore& Sim = *Instances[Worker];
+		for (int32 JobIndex = NextJob++; JobIndex < Jobs.Num(); JobIndex = NextJob++)
+		{
+			RunMatch(Sim, Jobs[JobIndex], JobIndex, OutResults[JobIndex]);
+			BusySeconds[Worker] += OutResults[JobIndex].Seconds;
+		}
+	});
+
+	FSimBatchSummary Summary = FSimBatchSummary::Aggregate(OutResults);
+	Summary.NumWorkers = Workers;
+	Summary.WallSeconds = FPlatformTime::Seconds() - WallStart;
+	for (const double Seconds : BusySeconds)
+	{
+		Summary.BusySeconds += Seconds;
+	}
+	if (Summary.WallSeconds > 0.0)
+	{
+		Summary.MatchesPerSecond = Summary.Matches / Summary.WallSeconds;
+	}
+	if (Summary.BusySeconds > 0.0)
+	{
+		Summary.MatchesPerSecondPerCore = Summary.Matches / Summary.BusySeconds;
+	}
+	return Summary;
+}
+
+void FSimBatchRunner::RunMatch(FSimulatorCore& Sim, const FSimBatchJob& Job, int32 JobIndex, FSimMatchResult& OutResult) const
+{
+	const double Start = FPlatformTime::Seconds();
+
+	Sim.Restart(Job.Setup);
+	Sim.SetHasMoreWaves(Job.bHasMoreWaves);
+	Sim.SetParallelPhase1(false);
+	Sim.SetAsyncPathRequests(false);
+
+	if (PrepareMatch)
+	{
+		FRandomStream Stream(Job.Seed);
+		PrepareMatch(Sim, Job, Stream);
+	}
+
+	Sim.Run();
+
+	const FSimGameSession& Session = Sim.GetGameSession();
+	OutResult.JobIndex = JobIndex;
+	OutResult.Seed = Job.Seed;
+	OutResult.Result = Session.Result;
+	OutResult.WinCondition = Session.WinConditionType;
+	OutResult.FriendlyCrowns = Session.FriendlyCrowns;
+	OutResult.EnemyCrowns = Session.EnemyCrowns;
+	OutResult.FrameCount = Sim.GetCurrentFrame();
+	OutResult.FriendlyTowerHPRatio = Session.GetTotalTowerHPRatio(EUnitFaction::Friendly);
+	OutResult.EnemyTowerHPRatio = Session.GetTotalTowerHPRatio(EUnitFaction::Enemy);
+	OutResult.Seconds = FPlatformTime::Seconds() - Start;
+}
+
+FSimBatchJob FSimBatchRunner::MakeRandomSkirmish(int32 Seed, int32 UnitsPerSide)
+{
+	FSimBatchJob Job;
+	Job.Seed = Seed;
+	Job.Setup = FInitialSetup::CreateClashRoyaleStandard();
+
+	TArray<FName> UnitIds;
+	for (const FUnitDefinition& Def : FUnitRegistry::GetDefaultDefinitions())
+	{
+		UnitIds.Add(Def.UnitId);
+	}
+	if (UnitIds.Num() == 0) return Job;
+
+	FRandomStream Stream(Seed);
+	auto AddGroups = [&](EUnitFaction Faction, float YMin, float YMax, float XMin, float XMax)
+	{
+		for (int32 i = 0; i < UnitsPerSide; ++i)
+		{
+			FUnitSpawnSetup& Spawn = Job.Setup.InitialUnits.AddDefaulted_GetRef();
+			Spawn.UnitId = UnitIds[Stream.RandRange(0, UnitIds.Num() - 1)];
+			Spawn.Faction = Faction;
+			Spawn.Position = FVector2D(Stream.FRandRange(XMin, XMax), Stream.FRandRange(YMin, YMax));
+		}
+	};
+
+	AddGroups(EUnitFaction::Friendly,
+		MapLayout::FRIENDLY_SPAWN_ZONE_Y_MIN, MapLayout::FRIENDLY_SPAWN_ZONE_Y_MAX,
+		MapLayout::FRIENDLY_SPAWN_ZONE_X_MIN, MapLayout::FRIENDLY_SPAWN_ZONE_X_MAX);
+	AddGroups(EUnitFaction::Enemy,
+		MapLayout::ENEMY_SPAWN_ZONE_Y_MIN, MapLayout::ENEMY_SPAWN_ZONE_Y_MAX,
+		MapLayout::ENEMY_SPAWN_ZONE_X_MIN, MapLayout::ENEMY_SPAWN_ZONE_X_MAX);
+
+	return Job;
+}
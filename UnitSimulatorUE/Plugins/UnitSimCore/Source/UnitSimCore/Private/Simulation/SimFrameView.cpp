@@ -0,0 +1,39 @@
+#include "Simulation/SimFrameView.h"
+
+namespace
+{
+	int32 CountLiving(const TArray<FUnit>& Squad)
+	{
+		int32 Living = 0;
+		for (const FUnit& Unit : Squad)
+		{
+			if (!Unit.bIsDead) Living++;
+		}
+		return Living;
+	}
+}
+
+int32 FSimFrameView::GetLivingFriendlyCount() const
+{
+	return CountLiving(Friendlies);
+}
+
+int32 FSimFrameView::GetLivingEnemyCount() const
+{
+	return CountLiving(Enemies);
+}
+
+FFrameData FSimFrameView::ToFrameData() const
+{
+	FFrameData Data = FFrameData::FromSimulationState(
+		FrameNumber,
+		Friendlies,
+		Enemies,
+		MainTarget,
+		CurrentWave,
+		bHasMoreWaves,
+		&Session
+	);
+	Data.StateHash = static_cast<int64>(StateHash);
+	return Data;
+}
@@ -0,0 +1,182 @@
+#include "Simulation/SimProfiler.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("A* Searches"), STAT_UnitSim_PathRequests, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("A* Nodes Expanded"), STAT_UnitSim_PathNodesExpanded, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Avoidance Risks"), STAT_UnitSim_AvoidanceRisks, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Collision Pairs"), STAT_UnitSim_CollisionPairs, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Events"), STAT_UnitSim_CombatEvents, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Unit Events"), STAT_UnitSim_UnitEvents, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Builds"), STAT_UnitSim_FlowFieldBuilds, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Repairs"), STAT_UnitSim_FlowFieldRepairs, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Paths"), STAT_UnitSim_FlowFieldPaths, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HPA* Searches"), STAT_UnitSim_HierarchicalPaths, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HPA* Cluster Rebuilds"), STAT_UnitSim_ClusterRebuilds, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Cache Hits"), STAT_UnitSim_PathCacheHits, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Cache Misses"), STAT_UnitSim_PathCacheMisses, STATGROUP_UnitSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Paths Deferred"), STAT_UnitSim_PathsDeferred, STATGROUP_UnitSim);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Path Cache Hit Rate"), STAT_UnitSim_PathCacheHitRate, STATGROUP_UnitSim);
+
+FSimProfiler::FSimProfiler(int32 InHistoryFrames)
+{
+	History.SetNum(FMath::Max(1, InHistoryFrames));
+}
+
+// ============================================================================
+// Frame
+// ============================================================================
+
+void FSimProfiler::BeginFrame(int32 FrameNumber)
+{
+	Current = FSimFrameProfile();
+	Current.FrameNumber = FrameNumber;
+	FrameStartCycles = FPlatformTime::Cycles64();
+}
+
+void FSimProfiler::EndFrame()
+{
+	Current.TotalSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - FrameStartCycles);
+
+	for (int32 i = 0; i < FSimFrameProfile::NumCounters; ++i)
+	{
+		Current.Counters[i] = PendingCounters[i].exchange(0, std::memory_order_relaxed);
+	}
+
+	INC_DWORD_STAT_BY(STAT_UnitSim_PathRequests, Current.GetCounter(ESimCounter::PathRequests));
+	INC_DWORD_STAT_BY(STAT_UnitSim_PathNodesExpanded, Current.GetCounter(ESimCounter::PathNodesExpanded));
+	INC_DWORD_STAT_BY(STAT_UnitSim_AvoidanceRisks, Current.GetCounter(ESimCounter::AvoidanceRisks));
+	INC_DWORD_STAT_BY(STAT_UnitSim_CollisionPairs, Current.GetCounter(ESimCounter::CollisionPairs));
+	INC_DWORD_STAT_BY(STAT_UnitSim_CombatEvents, Current.GetCounter(ESimCounter::CombatEvents));
+	INC_DWORD_STAT_BY(STAT_UnitSim_UnitEvents, Current.GetCounter(ESimCounter::UnitEvents));
+	INC_DWORD_STAT_BY(STAT_UnitSim_FlowFieldBuilds, Current.GetCounter(ESimCounter::FlowFieldBuilds));
+	INC_DWORD_STAT_BY(STAT_UnitSim_FlowFieldRepairs, Current.GetCounter(ESimCounter::FlowFieldRepairs));
+	INC_DWORD_STAT_BY(STAT_UnitSim_FlowFieldPaths, Current.GetCounter(ESimCounter::FlowFieldPaths));
+	INC_DWORD_STAT_BY(STAT_UnitSim_HierarchicalPaths, Current.GetCounter(ESimCounter::HierarchicalPaths));
+	INC_DWORD_STAT_BY(STAT_UnitSim_ClusterRebuilds, Current.GetCounter(ESimCounter::ClusterRebuilds));
+	INC_DWORD_STAT_BY(STAT_UnitSim_PathCacheHits, Current.GetCounter(ESimCounter::PathCacheHits));
+	INC_DWORD_STAT_BY(STAT_UnitSim_PathCacheMisses, Current.GetCounter(ESimCounter::PathCacheMisses));
+	INC_DWORD_STAT_BY(STAT_UnitSim_PathsDeferred, Current.GetCounter(ESimCounter::PathsDeferred));
+
+	const int32 CacheLookups = Current.GetCounter(ESimCounter::PathCacheHits) + Current.GetCounter(ESimCounter::PathCacheMisses);
+	if (CacheLookups > 0)
+	{
+		SET_FLOAT_STAT(STAT_UnitSim_PathCacheHitRate, static_cast<float>(Current.GetCounter(ESimCounter::PathCacheHits)) / CacheLookups);
+	}
+
+	History[NumRecorded % History.Num()] = Current;
+	NumRecorded++;
+}
+
+void FSimProfiler::Reset()
+{
+	NumRecorded = 0;
+	Current = FSimFrameProfile();
+	for (std::atomic<int32>& Counter : PendingCounters)
+	{
+		Counter.store(0, std::memory_order_relaxed);
+	}
+}
+
+// ============================================================================
+// History
+// ============================================================================
+
+TArray<FSimFrameProfile> FSimProfiler::GetRecentFrames(int32 MaxFrames) const
+{
+	const int32 Num = FMath::Clamp(MaxFrames, 0, FMath::Min(NumRecorded, History.Num()));
+
+	TArray<FSimFrameProfile> Frames;
+	Frames.Reserve(Num);
+	for (int32 i = NumRecorded - Num; i < NumRecorded; ++i)
+	{
+		Frames.Add(History[i % History.Num()]);
+	}
+	return Frames;
+}
+
+const FSimFrameProfile* FSimProfiler::GetLastFrame() const
+{
+	return NumRecorded > 0 ? &History[(NumRecorded - 1) % History.Num()] : nullptr;
+}
+
+// ============================================================================
+// Names
+// ============================================================================
+
+const TCHAR* FSimProfiler::GetPhaseName(ESimPhase Phase)
+{
+	switch (Phase)
+	{
+	case ESimPhase::Prepare:             return TEXT("Prepare");
+	case ESimPhase::Commands:            return TEXT("Commands");
+	case ESimPhase::DynamicObstacles:    return TEXT("DynamicObstacles");
+	case ESimPhase::EnemyUpdate:         return TEXT("EnemyUpdate");
+	case ESimPhase::FriendlyUpdate:      return TEXT("FriendlyUpdate");
+	case ESimPhase::TowerUpdate:         return TEXT("TowerUpdate");
+	case ESimPhase::PathDispatch:        return TEXT("PathDispatch");
+	case ESimPhase::Collisions:          return TEXT("Collisions");
+	case ESimPhase::ApplyDamage:         return TEXT("ApplyDamage");
+	case ESimPhase::ApplyTowerDamage:    return TEXT("ApplyTowerDamage");
+	case ESimPhase::ApplyDamageToTowers: return TEXT("ApplyDamageToTowers");
+	case ESimPhase::Deaths:              return TEXT("Deaths");
+	case ESimPhase::Spawns:              return TEXT("Spawns");
+	case ESimPhase::Session:             return TEXT("Session");
+	case ESimPhase::PathApply:           return TEXT("PathApply");
+	case ESimPhase::StateHash:           return TEXT("StateHash");
+	case ESimPhase::Callbacks:           return TEXT("Callbacks");
+	case ESimPhase::Snapshot:            return TEXT("Snapshot");
+	default:                             return TEXT("Unknown");
+	}
+}
+
+const TCHAR* FSimProfiler::GetCounterName(ESimCounter Counter)
+{
+	switch (Counter)
+	{
+	case ESimCounter::PathRequests:      return TEXT("PathRequests");
+	case ESimCounter::PathNodesExpanded: return TEXT("PathNodesExpanded");
+	case ESimCounter::AvoidanceRisks:    return TEXT("AvoidanceRisks");
+	case ESimCounter::CollisionPairs:    return TEXT("CollisionPairs");
+	case ESimCounter::CombatEvents:      return TEXT("CombatEvents");
+	case ESimCounter::UnitEvents:        return TEXT("UnitEvents");
+	case ESimCounter::FlowFieldBuilds:   return TEXT("FlowFieldBuilds");
+	case ESimCounter::FlowFieldRepairs:  return TEXT("FlowFieldRepairs");
+	case ESimCounter::FlowFieldPaths:    return TEXT("FlowFieldPaths");
+	case ESimCounter::HierarchicalPaths: return TEXT("HierarchicalPaths");
+	case ESimCounter::ClusterRebuilds:   return TEXT("ClusterRebuilds");
+	case ESimCounter::PathCacheHits:     return TEXT("PathCacheHits");
+	case ESimCounter::PathCacheMisses:   return TEXT("PathCacheMisses");
+	case ESimCounter::PathsDeferred:     return TEXT("PathsDeferred");
+	default:                             return TEXT("Unknown");
+	}
+}
+
+FString FSimFrameProfile::ToString() const
+{
+	FString Text = FString::Printf(TEXT("Frame %d: %.1f us"), FrameNumber, TotalSeconds * 1e6);
+	for (int32 i = 0; i < NumPhases; ++i)
+	{
+		Text += FString::Printf(TEXT(" | %s %.1f"), FSimProfiler::GetPhaseName(static_cast<ESimPhase>(i)), PhaseSeconds[i] * 1e6);
+	}
+	for (int32 i = 0; i < NumCounters; ++i)
+	{
+		Text += FString::Printf(TEXT(" | %s %d"), FSimProfiler::GetCounterName(static_cast<ESimCounter>(i)), Counters[i]);
+	}
+	return Text;
+}
+
+// ============================================================================
+// Phase Scope
+// ============================================================================
+
+FSimProfiler::FPhaseScope::FPhaseScope(FSimProfiler& InProfiler, ESimPhase InPhase)
+	: Profiler(InProfiler)
+	, Phase(InPhase)
+	, StartCycles(FPlatformTime::Cycles64())
+{
+}
+
+FSimProfiler::FPhaseScope::~FPhaseScope()
+{
+	Profiler.AddPhaseSeconds(Phase, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles));
+}
@@ -0,0 +1,280 @@
+#include "Simulation/SimReplay.h"
+#include "Simulation/SimulatorCore.h"
+#include "Units/UnitRegistry.h"
+#include "Algo/BinarySearch.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/** Bump the version whenever FSimReplay::Serialize changes (snapshots carry their own) */
+	constexpr uint32 ReplayMagic = 0x55525059; // 'URPY'
+	constexpr uint32 ReplayVersion = 2;
+}
+
+// ============================================================================
+// FSimReplay
+// ============================================================================
+
+void FSimReplay::Save(TArray<uint8>& OutData)
+{
+	OutData.Reset();
+	FMemoryWriter Writer(OutData);
+	Serialize(Writer);
+}
+
+bool FSimReplay::Load(const TArray<uint8>& Data)
+{
+	Reset();
+	FMemoryReader Reader(Data);
+	Serialize(Reader);
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SimReplay] Replay rejected (expected version %u)"), ReplayVersion);
+		Reset();
+		return false;
+	}
+	return true;
+}
+
+void FSimReplay::Reset()
+{
+	Setup = FInitialSetup();
+	DataSetHash = 0;
+	KeyframeInterval = UnitSimConstants::REPLAY_KEYFRAME_INTERVAL;
+	EndFrame = 0;
+	Commands.Reset();
+	Keyframes.Reset();
+	FrameHashes.Reset();
+}
+
+const FSimStateHash* FSimReplay::FindFrameHash(int32 Frame) const
+{
+	if (Keyframes.Num() == 0) return nullptr;
+	const int32 Index = Frame - Keyframes[0].Frame;
+	return FrameHashes.IsValidIndex(Index) ? &FrameHashes[Index] : nullptr;
+}
+
+void FSimReplay::Serialize(FArchive& Ar)
+{
+	uint32 Magic = ReplayMagic;
+	uint32 Version = ReplayVersion;
+	Ar << Magic << Version;
+	if (Magic != ReplayMagic || Version != ReplayVersion)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	FInitialSetup::StaticStruct()->SerializeBin(Ar, &Setup);
+	Ar << DataSetHash << KeyframeInterval << EndFrame;
+
+	int32 NumCommands = Commands.Num();
+	Ar << NumCommands;
+	if (Ar.IsLoading())
+	{
+		// Every command takes at least its frame and type
+		if (Ar.IsError() || NumCommands < 0 || NumCommands > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+		Commands.SetNum(NumCommands);
+	}
+	for (FCommandEntry& Entry : Commands)
+	{
+		Ar << Entry.Frame;
+		Entry.Command.Serialize(Ar);
+	}
+
+	int32 NumKeyframes = Keyframes.Num();
+	Ar << NumKeyframes;
+	if (Ar.IsLoading())
+	{
+		if (Ar.IsError() || NumKeyframes < 0 || NumKeyframes > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+		Keyframes.SetNum(NumKeyframes);
+	}
+	for (FKeyframe& Keyframe : Keyframes)
+	{
+		Ar << Keyframe.Frame << Keyframe.Snapshot;
+	}
+
+	Ar << FrameHashes;
+}
+
+uint32 FSimReplay::HashDataSet(const FUnitRegistry& Registry)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	int32 FixedPointMath = UNITSIM_FIXED_POINT;
+	Writer << FixedPointMath;
+
+	// Registry order is a hash map's; sort so equal data sets hash equal
+	TArray<FName> Ids = Registry.GetRegisteredIds();
+	Ids.Sort(FNameLexicalLess());
+	for (const FName& Id : Ids)
+	{
+		FUnitDefinition Definition = *Registry.GetDefinition(Id);
+		FUnitDefinition::StaticStruct()->SerializeBin(Writer, &Definition);
+	}
+
+	return FCrc::MemCrc32(Bytes.GetData(), Bytes.Num());
+}
+
+// ============================================================================
+// FSimReplayRecorder
+// ============================================================================
+
+FSimReplayRecorder::FSimReplayRecorder(FSimulatorCore& InSim)
+	: Sim(InSim)
+{
+}
+
+void FSimReplayRecorder::Begin(const FInitialSetup& Setup, int32 KeyframeInterval)
+{
+	Replay.Reset();
+	Replay.Setup = Setup;
+	Replay.DataSetHash = FSimReplay::HashDataSet(Sim.GetUnitRegistry());
+	Replay.KeyframeInterval = FMath::Max(0, KeyframeInterval);
+	Replay.EndFrame = Sim.GetCurrentFrame();
+	WriteKeyframe();
+}
+
+bool FSimReplayRecorder::SubmitCommand(const FSimCommand& Command)
+{
+	if (!Sim.EnqueueCommand(Command)) return false;
+
+	Replay.Commands.Add(FSimReplay::FCommandEntry{ Sim.GetCurrentFrame(), Command });
+	return true;
+}
+
+FFrameData FSimReplayRecorder::Tick()
+{
+	FFrameData FrameResult = Sim.Step();
+	Replay.EndFrame = Sim.GetCurrentFrame();
+	Replay.FrameHashes.Add(Sim.GetStateHash());
+
+	// Taken before anything is submitted for the new frame, so a seek never feeds a command twice
+	if (Replay.KeyframeInterval > 0 && Replay.Keyframes.Num() > 0
+		&& (Replay.EndFrame - Replay.Keyframes[0].Frame) % Replay.KeyframeInterval == 0)
+	{
+		WriteKeyframe();
+	}
+
+	return FrameResult;
+}
+
+void FSimReplayRecorder::WriteKeyframe()
+{
+	FSimReplay::FKeyframe& Keyframe = Replay.Keyframes.AddDefaulted_GetRef();
+	Keyframe.Frame = Sim.GetCurrentFrame();
+	Sim.SaveSnapshot(Keyframe.Snapshot);
+}
+
+// ============================================================================
+// FSimReplayPlayer
+// ============================================================================
+
+FSimReplayPlayer::FSimReplayPlayer(FSimulatorCore& InSim, const FSimReplay& InReplay)
+	: Sim(InSim)
+	, Replay(InReplay)
+{
+}
+
+bool FSimReplayPlayer::Start()
+{
+	bInSync = false;
+	Divergence = FSimDivergence();
+
+	if (Replay.Keyframes.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SimReplay] Replay has no starting keyframe"));
+		return false;
+	}
+
+	const uint32 DataSetHash = FSimReplay::HashDataSet(Sim.GetUnitRegistry());
+	if (DataSetHash != Replay.DataSetHash)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SimReplay] Data set mismatch (replay %08x, simulator %08x)"),
+			Replay.DataSetHash, DataSetHash);
+		return false;
+	}
+
+	Sim.Initialize(Replay.Setup);
+	return Seek(Replay.Keyframes[0].Frame);
+}
+
+bool FSimReplayPlayer::Seek(int32 Frame)
+{
+	if (Replay.Keyframes.Num() == 0) return false;
+
+	const int32 Target = FMath::Clamp(Frame, Replay.Keyframes[0].Frame, Replay.EndFrame);
+	const int32 KeyIndex = Algo::UpperBoundBy(Replay.Keyframes, Target, &FSimReplay::FKeyframe::Frame) - 1;
+	const FSimReplay::FKeyframe& Keyframe = Replay.Keyframes[KeyIndex];
+
+	// Stepping on from the current frame beats a restore unless a keyframe lies in between
+	const int32 CurrentFrame = Sim.GetCurrentFrame();
+	if (!bInSync || CurrentFrame > Target || CurrentFrame < Keyframe.Frame)
+	{
+		bInSync = Sim.RestoreSnapshot(Keyframe.Snapshot);
+		if (!bInSync)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[SimReplay] Keyframe %d failed to restore"), Keyframe.Frame);
+			return false;
+		}
+	}
+
+	LastSeekFrames = Target - Sim.GetCurrentFrame();
+	while (Sim.GetCurrentFrame() < Target)
+	{
+		FeedCommands();
+		Sim.StepSilent();
+		CheckFrameHash();
+	}
+	return true;
+}
+
+FFrameData FSimReplayPlayer::Step()
+{
+	FeedCommands();
+	FFrameData FrameResult = Sim.Step();
+	CheckFrameHash();
+	return FrameResult;
+}
+
+bool FSimReplayPlayer::IsAtEnd() const
+{
+	return Sim.GetCurrentFrame() >= Replay.EndFrame;
+}
+
+void FSimReplayPlayer::FeedCommands()
+{
+	const int32 Frame = Sim.GetCurrentFrame();
+	for (int32 i = Algo::LowerBoundBy(Replay.Commands, Frame, &FSimReplay::FCommandEntry::Frame);
+		i < Replay.Commands.Num() && Replay.Commands[i].Frame == Frame; ++i)
+	{
+		Sim.EnqueueCommand(Replay.Commands[i].Command);
+	}
+}
+
+void FSimReplayPlayer::CheckFrameHash()
+{
+	if (Divergence.IsFound() || !Sim.IsStateHashEnabled()) return;
+
+	const int32 Frame = Sim.GetCurrentFrame() - 1;
+	const FSimStateHash* Recorded = Replay.FindFrameHash(Frame);
+	if (!Recorded || Recorded->Combined == 0) return;
+
+	const FSimStateHash& Played = Sim.GetStateHash();
+	if (*Recorded != Played)
+	{
+		Divergence.Frame = Frame;
+		Divergence.Domain = Recorded->FindFirstDifference(Played);
+		UE_LOG(LogTemp, Warning, TEXT("[SimReplay] Playback diverged from the recording at %s"), *Divergence.ToString());
+	}
+}
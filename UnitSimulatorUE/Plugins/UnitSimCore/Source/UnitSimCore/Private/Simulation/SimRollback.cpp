@@ -0,0 +1,163 @@
+#include "Simulation/SimRollback.h"
+#include "Simulation/SimulatorCore.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** Fold a timing sample into a running average (first sample seeds it) */
+	void Blend(double& Average, double Sample)
+	{
+		constexpr double Weight = 0.1;
+		Average = (Average == 0.0) ? Sample : Average + (Sample - Average) * Weight;
+	}
+}
+
+FSimRollback::FSimRollback(FSimulatorCore& InSim, int32 InMaxRollbackFrames)
+	: Sim(InSim)
+{
+	Ring.SetNum(FMath::Max(1, InMaxRollbackFrames));
+}
+
+void FSimRollback::Reset()
+{
+	for (FSnapshotSlot& Slot : Ring)
+	{
+		Slot.Frame = INDEX_NONE;
+	}
+	CommandLog.Reset();
+	RollbackFrame = MAX_int32;
+	LastRollbackFrames = 0;
+}
+
+// ============================================================================
+// Commands
+// ============================================================================
+
+void FSimRollback::SubmitCommand(const FSimCommand& Command)
+{
+	const int32 CurrentFrame = Sim.GetCurrentFrame();
+	int32 Frame = Command.GetFrameNumber();
+
+	if (Frame < CurrentFrame)
+	{
+		const int32 Oldest = GetOldestHeldFrame();
+		if (Frame < Oldest)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[SimRollback] Command for frame %d is older than the rollback window, applying at frame %d"),
+				Frame, Oldest);
+			Frame = Oldest;
+			NumClampedCommands++;
+		}
+		if (Frame < CurrentFrame)
+		{
+			RollbackFrame = FMath::Min(RollbackFrame, Frame);
+		}
+	}
+
+	// After every command already logged at or before Frame: submission order holds within a frame
+	const int32 InsertAt = Algo::UpperBoundBy(CommandLog, Frame, &FLoggedCommand::Frame);
+	CommandLog.Insert(FLoggedCommand{ Frame, Command }, InsertAt);
+}
+
+// ============================================================================
+// Tick
+// ============================================================================
+
+FFrameData FSimRollback::Tick()
+{
+	const int32 PresentFrame = Sim.GetCurrentFrame();
+	LastRollbackFrames = 0;
+
+	if (RollbackFrame < PresentFrame)
+	{
+		const FSnapshotSlot& Slot = Ring[RollbackFrame % Ring.Num()];
+		const double RestoreStart = FPlatformTime::Seconds();
+
+		if (Slot.Frame == RollbackFrame && Sim.RestoreSnapshot(Slot.Data))
+		{
+			Blend(AvgRestoreSeconds, FPlatformTime::Seconds() - RestoreStart);
+
+			// Snapshots after the rollback frame are rewritten along the way
+			while (Sim.GetCurrentFrame() < PresentFrame)
+			{
+				BeginFrame();
+				const double StepStart = FPlatformTime::Seconds();
+				Sim.StepSilent();
+				Blend(AvgSilentStepSeconds, FPlatformTime::Seconds() - StepStart);
+			}
+			LastRollbackFrames = PresentFrame - RollbackFrame;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("[SimRollback] No snapshot for frame %d, late commands applied at frame %d"),
+				RollbackFrame, PresentFrame);
+		}
+	}
+	RollbackFrame = MAX_int32;
+
+	BeginFrame();
+	const double StepStart = FPlatformTime::Seconds();
+	FFrameData FrameResult = Sim.Step();
+	Blend(AvgStepSeconds, FPlatformTime::Seconds() - StepStart);
+
+	// Commands before the oldest snapshot can never be replayed again
+	const int32 Oldest = GetOldestHeldFrame();
+	const int32 NumExpired = Algo::LowerBoundBy(CommandLog, Oldest, &FLoggedCommand::Frame);
+	if (NumExpired > 0)
+	{
+		CommandLog.RemoveAt(0, NumExpired);
+	}
+
+	return FrameResult;
+}
+
+void FSimRollback::BeginFrame()
+{
+	const int32 Frame = Sim.GetCurrentFrame();
+
+	const double SaveStart = FPlatformTime::Seconds();
+	FSnapshotSlot& Slot = Ring[Frame % Ring.Num()];
+	Sim.SaveSnapshot(Slot.Data);
+	Slot.Frame = Frame;
+	Blend(AvgSaveSeconds, FPlatformTime::Seconds() - SaveStart);
+
+	// Late commands were clamped to a held frame, so everything still due is logged at its frame exactly
+	for (int32 i = Algo::LowerBoundBy(CommandLog, Frame, &FLoggedCommand::Frame);
+		i < CommandLog.Num() && CommandLog[i].Frame == Frame; ++i)
+	{
+		Sim.EnqueueCommand(CommandLog[i].Command);
+	}
+}
+
+int32 FSimRollback::GetOldestHeldFrame() const
+{
+	const int32 CurrentFrame = Sim.GetCurrentFrame();
+	int32 Oldest = CurrentFrame;
+	for (const FSnapshotSlot& Slot : Ring)
+	{
+		// Slots ahead of the current frame belong to a timeline that was rolled back past
+		if (Slot.Frame != INDEX_NONE && Slot.Frame < CurrentFrame)
+		{
+			Oldest = FMath::Min(Oldest, Slot.Frame);
+		}
+	}
+	return Oldest;
+}
+
+// ============================================================================
+// Budget
+// ============================================================================
+
+int32 FSimRollback::EstimateRollbackBound(double BudgetSeconds) const
+{
+	if (AvgStepSeconds <= 0.0) return 0;
+
+	// Present frame: its save and step. Rollback: one restore, then a save and a silent step per frame.
+	const double SilentStep = AvgSilentStepSeconds > 0.0 ? AvgSilentStepSeconds : AvgStepSeconds;
+	const double Spare = BudgetSeconds - AvgSaveSeconds - AvgStepSeconds - AvgRestoreSeconds;
+	const double PerFrame = AvgSaveSeconds + SilentStep;
+	if (Spare <= 0.0 || PerFrame <= 0.0) return 0;
+
+	return FMath::FloorToInt32(Spare / PerFrame);
+}
@@ -0,0 +1,123 @@
+#include "Simulation/SimStateBisect.h"
+#include "Simulation/SimReplay.h"
+#include "Simulation/SimulatorCore.h"
+
+namespace
+{
+	/** First slot whose record hashes differ (the shorter length if one list is a prefix) */
+	template<typename RecordType, typename HashFn>
+	int32 FindDifferingSlot(TConstArrayView<RecordType> A, TConstArrayView<RecordType> B, HashFn Hash)
+	{
+		const int32 Num = FMath::Min(A.Num(), B.Num());
+		for (int32 i = 0; i < Num; ++i)
+		{
+			if (Hash(A[i]) != Hash(B[i])) return i;
+		}
+		return A.Num() != B.Num() ? Num : INDEX_NONE;
+	}
+}
+
+FSimDivergence SimStateBisect::CompareHashes(TConstArrayView<FSimStateHash> A, TConstArrayView<FSimStateHash> B, int32 FirstFrame)
+{
+	FSimDivergence Result;
+	const int32 Num = FMath::Min(A.Num(), B.Num());
+	for (int32 i = 0; i < Num; ++i)
+	{
+		if (A[i].Combined == 0 || B[i].Combined == 0 || A[i] == B[i]) continue;
+
+		Result.Frame = FirstFrame + i;
+		Result.Domain = A[i].FindFirstDifference(B[i]);
+		return Result;
+	}
+
+	if (A.Num() != B.Num())
+	{
+		Result.Frame = FirstFrame + Num;
+	}
+	return Result;
+}
+
+FSimDivergence SimStateBisect::CompareReplays(const FSimReplay& A, const FSimReplay& B)
+{
+	if (A.Keyframes.Num() == 0 || B.Keyframes.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SimStateBisect] Replay has no starting keyframe"));
+		return FSimDivergence();
+	}
+
+	// Align the streams on the later starting frame
+	const int32 StartA = A.Keyframes[0].Frame;
+	const int32 StartB = B.Keyframes[0].Frame;
+	const int32 FirstFrame = FMath::Max(StartA, StartB);
+	const int32 SkipA = FMath::Min(FirstFrame - StartA, A.FrameHashes.Num());
+	const int32 SkipB = FMath::Min(FirstFrame - StartB, B.FrameHashes.Num());
+	return CompareHashes(
+		TConstArrayView<FSimStateHash>(A.FrameHashes).RightChop(SkipA),
+		TConstArrayView<FSimStateHash>(B.FrameHashes).RightChop(SkipB),
+		FirstFrame);
+}
+
+FSimDivergence SimStateBisect::CompareStates(const FSimulatorCore& A, const FSimulatorCore& B)
+{
+	FSimDivergence Result;
+	const FSimStateHash HashA = A.ComputeStateHash();
+	const FSimStateHash HashB = B.ComputeStateHash();
+	Result.Domain = HashA.FindFirstDifference(HashB);
+	if (Result.Domain == ESimHashDomain::Count) return Result;
+
+	Result.Frame = A.GetCurrentFrame() - 1;
+	switch (Result.Domain)
+	{
+	case ESimHashDomain::FriendlyUnits:
+		Result.Index = FindDifferingSlot<FUnit>(A.GetFriendlyUnits(), B.GetFriendlyUnits(), &SimStateHash::HashUnit);
+		break;
+	case ESimHashDomain::EnemyUnits:
+		Result.Index = FindDifferingSlot<FUnit>(A.GetEnemyUnits(), B.GetEnemyUnits(), &SimStateHash::HashUnit);
+		break;
+	case ESimHashDomain::FriendlyTowers:
+		Result.Index = FindDifferingSlot<FTower>(A.GetGameSession().FriendlyTowers, B.GetGameSession().FriendlyTowers, &SimStateHash::HashTower);
+		break;
+	case ESimHashDomain::EnemyTowers:
+		Result.Index = FindDifferingSlot<FTower>(A.GetGameSession().EnemyTowers, B.GetGameSession().EnemyTowers, &SimStateHash::HashTower);
+		break;
+	default:
+		break;
+	}
+	return Result;
+}
+
+FSimDivergence SimStateBisect::VerifyReplay(FSimulatorCore& Sim, const FSimReplay& Replay)
+{
+	const bool bWasEnabled = Sim.IsStateHashEnabled();
+	Sim.SetStateHashEnabled(true);
+
+	FSimReplayPlayer Player(Sim, Replay);
+	if (Player.Start())
+	{
+		while (!Player.IsAtEnd() && !Player.GetDivergence().IsFound())
+		{
+			Player.Seek(Sim.GetCurrentFrame() + 1);
+		}
+	}
+
+	Sim.SetStateHashEnabled(bWasEnabled);
+	return Player.GetDivergence();
+}
+
+FSimDivergence SimStateBisect::CompareRuns(FSimulatorCore& SimA, FSimulatorCore& SimB, const FSimReplay& Replay)
+{
+	FSimReplayPlayer PlayerA(SimA, Replay);
+	FSimReplayPlayer PlayerB(SimB, Replay);
+	if (!PlayerA.Start() || !PlayerB.Start()) return FSimDivergence();
+
+	while (!PlayerA.IsAtEnd())
+	{
+		const int32 Next = SimA.GetCurrentFrame() + 1;
+		PlayerA.Seek(Next);
+		PlayerB.Seek(Next);
+
+		const FSimDivergence Result = CompareStates(SimA, SimB);
+		if (Result.IsFound()) return Result;
+	}
+	return FSimDivergence();
+}
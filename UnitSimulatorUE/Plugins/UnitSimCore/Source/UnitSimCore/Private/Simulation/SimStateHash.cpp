@@ -0,0 +1,207 @@
+#include "Simulation/SimStateHash.h"
+#include "Units/Unit.h"
+#include "Towers/Tower.h"
+#include "GameState/SimGameSession.h"
+
+// ============================================================================
+// FSimStateHash
+// ============================================================================
+
+ESimHashDomain FSimStateHash::FindFirstDifference(const FSimStateHash& Other) const
+{
+	for (int32 i = 0; i < NumDomains; ++i)
+	{
+		if (Domains[i] != Other.Domains[i]) return static_cast<ESimHashDomain>(i);
+	}
+	return ESimHashDomain::Count;
+}
+
+bool FSimStateHash::operator==(const FSimStateHash& Other) const
+{
+	return Combined == Other.Combined && FindFirstDifference(Other) == ESimHashDomain::Count;
+}
+
+FArchive& operator<<(FArchive& Ar, FSimStateHash& Hash)
+{
+	Ar << Hash.Combined;
+	for (uint64& Domain : Hash.Domains)
+	{
+		Ar << Domain;
+	}
+	return Ar;
+}
+
+// ============================================================================
+// FSimDivergence
+// ============================================================================
+
+FString FSimDivergence::ToString() const
+{
+	if (!IsFound()) return TEXT("No divergence");
+	if (Index == INDEX_NONE)
+	{
+		return FString::Printf(TEXT("Frame %d: %s"), Frame, SimStateHash::GetDomainName(Domain));
+	}
+	return FString::Printf(TEXT("Frame %d: %s[%d]"), Frame, SimStateHash::GetDomainName(Domain), Index);
+}
+
+// ============================================================================
+// FSimStateHasher
+// ============================================================================
+
+void FSimStateHasher::Add(float Value)
+{
+	uint32 Bits;
+	FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	Add(static_cast<uint64>(Bits));
+}
+
+void FSimStateHasher::Add(double Value)
+{
+	uint64 Bits;
+	FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	Add(Bits);
+}
+
+void FSimStateHasher::Add(const FVector2D& Value)
+{
+	Add(Value.X);
+	Add(Value.Y);
+}
+
+void FSimStateHasher::Add(const FUnitHandle& Handle)
+{
+	Add(Handle.Index);
+	Add(Handle.Generation);
+}
+
+uint64 FSimStateHasher::Get() const
+{
+	// fmix64 finalizer, so nearby states don't leave nearby hashes
+	uint64 Hash = State;
+	Hash ^= Hash >> 33;
+	Hash *= 0xFF51AFD7ED558CCDull;
+	Hash ^= Hash >> 33;
+	Hash *= 0xC4CEB9FE1A85EC53ull;
+	Hash ^= Hash >> 33;
+	return Hash;
+}
+
+// ============================================================================
+// State
+// ============================================================================
+
+uint64 SimStateHash::HashUnit(const FUnit& Unit)
+{
+	FSimStateHasher Hasher;
+	Hasher.Add(Unit.Id);
+	Hasher.Add(Unit.bIsDead);
+	Hasher.Add(Unit.HP);
+	Hasher.Add(Unit.ShieldHP);
+	Hasher.Add(Unit.MaxShieldHP);
+	Hasher.Add(Unit.Speed);
+	Hasher.Add(Unit.AttackCooldown);
+
+	// Kinematics
+	Hasher.Add(Unit.Position);
+	Hasher.Add(Unit.Velocity);
+	Hasher.Add(Unit.Forward);
+	Hasher.Add(Unit.PreviousPosition);
+
+	// Targeting and slots
+	Hasher.Add(Unit.Target);
+	Hasher.Add(Unit.TargetTowerIndex);
+	Hasher.Add(Unit.TakenSlotIndex);
+	Hasher.Add(Unit.FramesSinceSlotEvaluation);
+	Hasher.Add(Unit.FramesSinceTargetEvaluation);
+	Hasher.Add(Unit.AttackSlots.Num());
+	for (const int32 Slot : Unit.AttackSlots)
+	{
+		Hasher.Add(Slot);
+	}
+
+	// Charge
+	Hasher.Add(Unit.ChargeState.bIsCharging);
+	Hasher.Add(Unit.ChargeState.bIsCharged);
+	Hasher.Add(Unit.ChargeState.ChargedDistance);
+
+	// Movement and avoidance progress (the waypoints follow from the destination and replan frame)
+	Hasher.Add(Unit.CurrentDestination);
+	Hasher.Add(Unit.MovementPath.Num());
+	Hasher.Add(Unit.MovementPathIndex);
+	Hasher.Add(Unit.AvoidancePath.Num());
+	Hasher.Add(Unit.AvoidancePathIndex);
+	Hasher.Add(Unit.bHasAvoidanceTarget);
+	Hasher.Add(Unit.AvoidanceTarget);
+	Hasher.Add(Unit.AvoidanceThreatIndex);
+	Hasher.Add(Unit.LastReplanFrame);
+	Hasher.Add(Unit.FramesSinceLastWaypointProgress);
+	Hasher.Add(Unit.FramesSinceAvoidanceStart);
+	return Hasher.Get();
+}
+
+uint64 SimStateHash::HashTower(const FTower& Tower)
+{
+	FSimStateHasher Hasher;
+	Hasher.Add(Tower.Id);
+	Hasher.Add(Tower.CurrentHP);
+	Hasher.Add(Tower.bIsActivated);
+	Hasher.Add(Tower.AttackCooldown);
+	Hasher.Add(Tower.CurrentTarget);
+	return Hasher.Get();
+}
+
+uint64 SimStateHash::HashUnits(TConstArrayView<FUnit> Units)
+{
+	FSimStateHasher Hasher;
+	Hasher.Add(Units.Num());
+	for (const FUnit& Unit : Units)
+	{
+		Hasher.Add(HashUnit(Unit));
+	}
+	return Hasher.Get();
+}
+
+uint64 SimStateHash::HashTowers(TConstArrayView<FTower> Towers)
+{
+	FSimStateHasher Hasher;
+	Hasher.Add(Towers.Num());
+	for (const FTower& Tower : Towers)
+	{
+		Hasher.Add(HashTower(Tower));
+	}
+	return Hasher.Get();
+}
+
+void SimStateHash::AddSession(FSimStateHasher& Hasher, const FSimGameSession& Session)
+{
+	Hasher.Add(Session.ElapsedTime);
+	Hasher.Add(Session.FriendlyCrowns);
+	Hasher.Add(Session.EnemyCrowns);
+	Hasher.Add(Session.Result);
+	Hasher.Add(Session.WinConditionType);
+	Hasher.Add(Session.bIsOvertime);
+}
+
+void SimStateHash::Combine(FSimStateHash& Hash)
+{
+	FSimStateHasher Hasher;
+	for (const uint64 Domain : Hash.Domains)
+	{
+		Hasher.Add(Domain);
+	}
+	Hash.Combined = Hasher.Get();
+}
+
+const TCHAR* SimStateHash::GetDomainName(ESimHashDomain Domain)
+{
+	switch (Domain)
+	{
+	case ESimHashDomain::FriendlyUnits:  return TEXT("FriendlyUnits");
+	case ESimHashDomain::EnemyUnits:     return TEXT("EnemyUnits");
+	case ESimHashDomain::FriendlyTowers: return TEXT("FriendlyTowers");
+	case ESimHashDomain::EnemyTowers:    return TEXT("EnemyTowers");
+	case ESimHashDomain::Session:        return TEXT("Session");
+	default:                             return TEXT("None");
+	}
+}
@@ -0,0 +1,99 @@
+#include "Simulation/SimulatorCallbacks.h"
+
+namespace
+{
+	FString UnitLabel(EUnitFaction Faction, int32 UnitId)
+	{
+		return FString::Printf(TEXT("%s%d"), Faction == EUnitFaction::Friendly ? TEXT("F") : TEXT("E"), UnitId);
+	}
+}
+
+// ============================================================================
+// FSimStateChange
+// ============================================================================
+
+FString FSimStateChange::Describe() const
+{
+	switch (Type)
+	{
+	case ESimStateChangeType::UnitInjected:
+		return FString::Printf(TEXT("Unit %s injected at (%.0f, %.0f)"), *UnitLabel(Faction, UnitId), Position.X, Position.Y);
+	case ESimStateChangeType::UnitSpawned:
+		return FString::Printf(TEXT("Unit %s spawned at (%.0f, %.0f)"), *UnitLabel(Faction, UnitId), Position.X, Position.Y);
+	case ESimStateChangeType::UnknownUnitType:
+		return FString::Printf(TEXT("Warning: Unknown unit type '%s', using defaults"), *UnitType.ToString());
+	case ESimStateChangeType::UnitRemoved:
+		return FString::Printf(TEXT("Unit %s removed from simulation"), *UnitLabel(Faction, UnitId));
+	case ESimStateChangeType::UnitDamaged:
+		return FString::Printf(TEXT("Unit %d damaged by %d"), UnitId, Value);
+	case ESimStateChangeType::UnitKilled:
+		return FString::Printf(TEXT("Unit %d killed"), UnitId);
+	case ESimStateChangeType::DestinationSet:
+		return FString::Printf(TEXT("Unit %d destination set"), UnitId);
+	case ESimStateChangeType::UnitRevived:
+		return FString::Printf(TEXT("Unit %d revived with %d HP"), UnitId, Value);
+	case ESimStateChangeType::HealthSet:
+		return FString::Printf(TEXT("Unit %d HP set to %d"), UnitId, Value);
+	case ESimStateChangeType::StateLoaded:
+		return FString::Printf(TEXT("State loaded from frame %d"), Value);
+	default:
+		return FString();
+	}
+}
+
+// ============================================================================
+// FSimulatorCallbacks
+// ============================================================================
+
+void FSimulatorCallbacks::BroadcastUnitEvent(const FUnitEventData& EventData)
+{
+	UnitEvents.Add(EventData);
+	if (!bInStep) Deliver();
+}
+
+void FSimulatorCallbacks::BroadcastStateChanged(const FSimStateChange& Change)
+{
+	StateChanges.Add(Change);
+	if (!bInStep) Deliver();
+}
+
+void FSimulatorCallbacks::BeginStep()
+{
+	UnitEvents.Reset();
+	StateChanges.Reset();
+	NumDeliveredUnitEvents = 0;
+	NumDeliveredStateChanges = 0;
+	bInStep = true;
+}
+
+void FSimulatorCallbacks::EndStep()
+{
+	bInStep = false;
+	Deliver();
+}
+
+void FSimulatorCallbacks::Deliver()
+{
+	// Counters move before each broadcast, so a listener that records more events
+	// (or re-enters Deliver) never gets one twice; copies survive the buffer growing
+	const bool bDeliverUnitEvents = !bMuted && OnUnitEvent.IsBound();
+	while (NumDeliveredUnitEvents < UnitEvents.Num())
+	{
+		const int32 Index = NumDeliveredUnitEvents++;
+		if (bDeliverUnitEvents)
+		{
+			const FUnitEventData EventData = UnitEvents[Index];
+			OnUnitEvent.Broadcast(EventData);
+		}
+	}
+
+	const bool bDeliverStateChanges = !bMuted && OnStateChanged.IsBound();
+	while (NumDeliveredStateChanges < StateChanges.Num())
+	{
+		const int32 Index = NumDeliveredStateChanges++;
+		if (bDeliverStateChanges)
+		{
+			OnStateChanged.Broadcast(StateChanges[Index].Describe());
+		}
+	}
+}
@@ -1,11 +1,85 @@
 #include "Simulation/SimulatorCore.h"
 #include "Pathfinding/PathfindingGrid.h"
 #include "Pathfinding/AStarPathfinder.h"
+#include "Pathfinding/FlowFieldService.h"
+#include "Pathfinding/HierarchicalPathfinder.h"
+#include "Pathfinding/PathCache.h"
+#include "Pathfinding/PathRequestService.h"
 #include "Pathfinding/DynamicObstacleSystem.h"
 #include "Pathfinding/PathSmoother.h"
+#include "Pathfinding/PathProgressMonitor.h"
 #include "Terrain/TerrainObstacleProvider.h"
 #include "Towers/TowerObstacleProvider.h"
 #include "Combat/AvoidanceSystem.h"
+#include "Math/SimMath.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Prepare"), STAT_UnitSim_Prepare, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Commands"), STAT_UnitSim_Commands, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Dynamic Obstacles"), STAT_UnitSim_DynamicObstacles, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Enemy Update"), STAT_UnitSim_EnemyUpdate, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Friendly Update"), STAT_UnitSim_FriendlyUpdate, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Tower Update"), STAT_UnitSim_TowerUpdate, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Path Dispatch"), STAT_UnitSim_PathDispatch, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Collisions"), STAT_UnitSim_Collisions, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Apply Damage"), STAT_UnitSim_ApplyDamage, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Apply Tower Damage"), STAT_UnitSim_ApplyTowerDamage, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Apply Damage To Towers"), STAT_UnitSim_ApplyDamageToTowers, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Deaths"), STAT_UnitSim_Deaths, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Spawns"), STAT_UnitSim_Spawns, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Session"), STAT_UnitSim_Session, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Path Apply"), STAT_UnitSim_PathApply, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("State Hash"), STAT_UnitSim_StateHash, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Callbacks"), STAT_UnitSim_Callbacks, STATGROUP_UnitSim);
+DECLARE_CYCLE_STAT(TEXT("Snapshot"), STAT_UnitSim_Snapshot, STATGROUP_UnitSim);
+
+// One Step() phase under "stat UnitSim", in Unreal Insights and in the profiler's history
+#define UNITSIM_PHASE_SCOPE(Phase) \
+	SCOPE_CYCLE_COUNTER(STAT_UnitSim_##Phase); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(UnitSim_##Phase); \
+	FSimProfiler::FPhaseScope PhaseScope_##Phase(Profiler, ESimPhase::Phase)
+
+namespace
+{
+	/** Leading words of every snapshot; bump the version whenever SerializeState changes */
+	constexpr uint32 SnapshotMagic = 0x55534E50; // 'USNP'
+	constexpr uint32 SnapshotVersion = 1;
+
+	void SerializeSquad(FArchive& Ar, TArray<FUnit>& Squad)
+	{
+		int32 Num = Squad.Num();
+		Ar << Num;
+		if (Ar.IsLoading())
+		{
+			// Every unit takes well over a byte, so a count past the end is corrupt data
+			if (Ar.IsError() || Num < 0 || Num > Ar.TotalSize() - Ar.Tell())
+			{
+				Ar.SetError();
+				return;
+			}
+			// Reuses the slots' existing arrays where the squad already has them
+			Squad.SetNum(Num);
+		}
+		for (FUnit& Unit : Squad)
+		{
+			Unit.Serialize(Ar);
+		}
+	}
+
+	/** State change about Unit; Value is its damage, HP or frame depending on Type */
+	FSimStateChange MakeStateChange(ESimStateChangeType Type, const FUnit& Unit, int32 Value = 0)
+	{
+		FSimStateChange Change;
+		Change.Type = Type;
+		Change.Faction = Unit.Faction;
+		Change.UnitId = Unit.Id;
+		Change.Value = Value;
+		Change.Position = Unit.Position;
+		return Change;
+	}
+}
 
 // ============================================================================
 // Constructor / Destructor
@@ -43,18 +117,18 @@ void FSimulatorCore::Initialize(const FInitialSetup& Setup)
 	EnemySquad.Empty();
 
 	// Spawn initial units
+	ReindexSquads();
 	SpawnInitialUnits(Setup.InitialUnits);
 	UE_LOG(LogTemp, Log, TEXT("[SimulatorCore] Spawned %d friendly, %d enemy initial units"),
 		FriendlySquad.Num(), EnemySquad.Num());
 
-	// Initialize pathfinding
-	PathfindingGrid = MakeUnique<FPathfindingGrid>(
-		static_cast<float>(UnitSimConstants::SIMULATION_WIDTH),
-		static_cast<float>(UnitSimConstants::SIMULATION_HEIGHT),
-		UnitSimConstants::UNIT_RADIUS);
-	Pathfinder = MakeUnique<FAStarPathfinder>(*PathfindingGrid);
-	PathSmoother = MakeUnique<FPathSmoother>(*PathfindingGrid);
-	DynamicObstacleSystem = MakeUnique<FDynamicObstacleSystem>(*PathfindingGrid);
+	// Initialize pathfinding. The grid's size is fixed, so a grid left from an
+	// earlier match only needs its walkability cleared before obstacles are re-applied.
+	if (!EnsurePathfinding())
+	{
+		PathfindingGrid->ResetWalkability();
+		DynamicObstacleSystem->Reset();
+	}
 	UE_LOG(LogTemp, Log, TEXT("[SimulatorCore] Pathfinding grid initialized"));
 
 	// Initialize towers from setup
@@ -74,6 +148,8 @@ void FSimulatorCore::Initialize(const FInitialSetup& Setup)
 	CurrentFrame = 0;
 	CurrentWave = 0;
 	bHasMoreWaves = true;
+	Profiler.Reset();
+	StateHash = ComputeStateHash();
 
 	UE_LOG(LogTemp, Log, TEXT("[SimulatorCore] Initialization complete. Towers: %dF/%dE"),
 		GameSession.FriendlyTowers.Num(), GameSession.EnemyTowers.Num());
@@ -89,13 +165,18 @@ void FSimulatorCore::Reset()
 	NextEnemyId = 0;
 	FriendlySquad.Empty();
 	EnemySquad.Empty();
+	ReindexSquads();
 
-	// Drain command queue
-	TSharedPtr<ISimulationCommand> Cmd;
-	while (CommandQueue.Dequeue(Cmd)) {}
+	// Drop queued commands
+	DrainCommandRing();
+	PendingCommands.Reset();
 
 	PathfindingGrid.Reset();
 	Pathfinder.Reset();
+	FlowFields.Reset();
+	HierarchicalPathfinder.Reset();
+	PathCache.Reset();
+	PathRequests.Reset();
 	DynamicObstacleSystem.Reset();
 	PathSmoother.Reset();
 
@@ -103,6 +184,40 @@ void FSimulatorCore::Reset()
 	UE_LOG(LogTemp, Log, TEXT("[SimulatorCore] Reset complete"));
 }
 
+void FSimulatorCore::Restart(const FInitialSetup& Setup)
+{
+	bIsRunning = false;
+	NextFriendlyId = 0;
+	NextEnemyId = 0;
+
+	// Drop queued commands
+	DrainCommandRing();
+	PendingCommands.Reset();
+
+	// Squad target and rally point belong to the previous match
+	SquadBehavior = FSquadBehavior();
+
+	Initialize(Setup);
+}
+
+bool FSimulatorCore::EnsurePathfinding()
+{
+	if (PathfindingGrid.IsValid()) return false;
+
+	PathfindingGrid = MakeUnique<FPathfindingGrid>(
+		static_cast<float>(UnitSimConstants::SIMULATION_WIDTH),
+		static_cast<float>(UnitSimConstants::SIMULATION_HEIGHT),
+		UnitSimConstants::UNIT_RADIUS);
+	Pathfinder = MakeUnique<FAStarPathfinder>(*PathfindingGrid);
+	FlowFields = MakeUnique<FFlowFieldService>(*PathfindingGrid);
+	HierarchicalPathfinder = MakeUnique<FHierarchicalPathfinder>(*PathfindingGrid);
+	PathCache = MakeUnique<FPathCache>(*PathfindingGrid);
+	PathRequests = MakeUnique<FPathRequestService>(*PathfindingGrid);
+	PathSmoother = MakeUnique<FPathSmoother>(*PathfindingGrid);
+	DynamicObstacleSystem = MakeUnique<FDynamicObstacleSystem>(*PathfindingGrid);
+	return true;
+}
+
 void FSimulatorCore::ConfigureStaticObstacles()
 {
 	if (!PathfindingGrid.IsValid()) return;
@@ -118,8 +233,137 @@ void FSimulatorCore::ConfigureStaticObstacles()
 	FTowerObstacleProvider TowerProvider(AllTowers.GetData(), AllTowers.Num());
 	PathfindingGrid->ApplyObstacles(TowerProvider);
 
-	UE_LOG(LogTemp, Log, TEXT("[SimulatorCore] Static obstacles configured: terrain + %d towers"),
-		AllTowers.Num());
+	// Shared destinations get flow fields, built lazily against these obstacles
+	FlowFields->ClearGoals();
+	for (const FTower& Tower : AllTowers)
+	{
+		FlowFields->AddGoal(Tower.Position);
+	}
+	for (const FVector2D& BridgeCenter : FTerrainSystem::GetBridgeCenters())
+	{
+		FlowFields->AddGoal(BridgeCenter);
+	}
+	FlowFields->AddGoal(MainTarget);
+
+	UE_LOG(LogTemp, Log, TEXT("[SimulatorCore] Static obstacles configured: terrain + %d towers, %d flow field goals"),
+		AllTowers.Num(), FlowFields->GetNumGoals());
+}
+
+bool FSimulatorCore::FindPath(const FVector2D& Start, const FVector2D& Goal, TArray<FVector2D>& OutPath, EMovementLayer Layer)
+{
+	bool bFound = false;
+	bool bHierarchical = false;
+	if (AnswerPathQuery(Start, Goal, Layer, OutPath, bFound, bHierarchical))
+	{
+		return bFound;
+	}
+
+	bFound = bHierarchical
+		? HierarchicalPathfinder->FindPath(Start, Goal, OutPath)
+		: Pathfinder->FindPath(Start, Goal, OutPath);
+	if (bFound)
+	{
+		PathCache->Add(Start, Goal, Layer, OutPath);
+	}
+	return bFound;
+}
+
+bool FSimulatorCore::AnswerPathQuery(const FVector2D& Start, const FVector2D& Goal, EMovementLayer Layer,
+	TArray<FVector2D>& OutPath, bool& bOutFound, bool& bOutHierarchical)
+{
+	bOutFound = false;
+	bOutHierarchical = false;
+
+	const FPathNode* StartNode = PathfindingGrid.IsValid() ? PathfindingGrid->NodeFromWorldPoint(Start) : nullptr;
+	const FPathNode* GoalNode = PathfindingGrid.IsValid() ? PathfindingGrid->NodeFromWorldPoint(Goal) : nullptr;
+	if (StartNode == nullptr || GoalNode == nullptr)
+	{
+		OutPath.Reset();
+		return true;
+	}
+
+	const int32 GoalId = FlowFields->FindGoal(Goal, UnitSimConstants::FLOW_FIELD_GOAL_TOLERANCE);
+	if (GoalId != INDEX_NONE)
+	{
+		bOutFound = FlowFields->FindPath(GoalId, Start, OutPath);
+		return true;
+	}
+
+	PathCache->SetSearchContext(static_cast<uint8>(Pathfinder->GetSearchMode()));
+	if (PathCache->Find(Start, Goal, Layer, OutPath))
+	{
+		bOutFound = true;
+		return true;
+	}
+
+	// Routed on the cells, not the exact points, so a cached path is always what a search would give
+	bOutHierarchical =
+		FVector2D::Distance(StartNode->WorldPosition, GoalNode->WorldPosition) >= UnitSimConstants::HPA_MIN_QUERY_DISTANCE;
+	return false;
+}
+
+void FSimulatorCore::RequestPath(const FPathRequest& Request)
+{
+	if (PathRequests.IsValid())
+	{
+		PathRequests->Submit(Request);
+	}
+}
+
+void FSimulatorCore::DispatchPathRequests()
+{
+	if (!PathRequests.IsValid() || PathRequests->Num() == 0) return;
+
+	// Flow fields and the cache answer here; the budget goes to the most urgent of the rest
+	for (const int32 Index : PathRequests->SortByUrgency())
+	{
+		const FPathRequest& Request = PathRequests->GetRequest(Index);
+		FPathRequestService::FResult& Result = PathRequests->GetResult(Index);
+
+		bool bHierarchical = false;
+		if (AnswerPathQuery(Request.Start, Request.Goal, Request.Layer, Result.Path, Result.bFound, bHierarchical))
+		{
+			Result.Status = FPathRequestService::EStatus::Answered;
+		}
+		else
+		{
+			PathRequests->QueueSearch(Index, bHierarchical);
+		}
+	}
+
+	PathRequests->Launch(Pathfinder->GetSearchMode(), bAsyncPathRequests);
+}
+
+void FSimulatorCore::ApplyPathRequests()
+{
+	if (!PathRequests.IsValid() || PathRequests->Num() == 0) return;
+
+	PathRequests->Wait();
+
+	// Submission order, so the cache and the units see the same sequence however the searches ran
+	for (int32 i = 0; i < PathRequests->Num(); ++i)
+	{
+		const FPathRequest& Request = PathRequests->GetRequest(i);
+		const FPathRequestService::FResult& Result = PathRequests->GetResult(i);
+		if (Result.Status == FPathRequestService::EStatus::Deferred) continue;
+
+		if (Result.Status == FPathRequestService::EStatus::Searched && Result.bFound)
+		{
+			PathCache->Add(Request.Start, Request.Goal, Request.Layer, Result.Path);
+		}
+
+		FUnit* Unit = FindUnit(Request.Faction, Request.UnitId);
+		if (Unit == nullptr || Unit->bIsDead) continue;
+
+		if (Result.bFound)
+		{
+			Unit->SetMovementPath(Result.Path);
+		}
+		Unit->CurrentDestination = Request.Goal;
+		PathProgressMonitor::OnReplan(*Unit, CurrentFrame);
+	}
+
+	PathRequests->Reset();
 }
 
 // ============================================================================
@@ -139,16 +383,16 @@ void FSimulatorCore::Run()
 
 	while (CurrentFrame < UnitSimConstants::MAX_FRAMES && bIsRunning)
 	{
-		FFrameData FrameResult = Step();
+		const FSimFrameView FrameResult = Advance();
 
-		if (FrameResult.bAllWavesCleared)
+		if (FrameResult.AllWavesCleared())
 		{
 			Callbacks.OnSimulationComplete.Broadcast(CurrentFrame, TEXT("AllWavesCleared"));
 			UE_LOG(LogTemp, Log, TEXT("All enemy waves eliminated at frame %d."), CurrentFrame);
 			break;
 		}
 
-		if (FrameResult.bMaxFramesReached)
+		if (FrameResult.MaxFramesReached())
 		{
 			Callbacks.OnSimulationComplete.Broadcast(CurrentFrame, TEXT("MaxFramesReached"));
 			UE_LOG(LogTemp, Log, TEXT("Maximum frames reached at frame %d."), CurrentFrame);
@@ -177,71 +421,262 @@ FFrameData FSimulatorCore::Step()
 		return FFrameData();
 	}
 
-	FFrameEvents Events;
+	AdvanceFrame();
+
+	// Generate frame data
+	FFrameData FrameResult;
+	{
+		UNITSIM_PHASE_SCOPE(Snapshot);
+		FrameResult = MakeFrameView(CurrentFrame).ToFrameData();
+	}
+	Profiler.EndFrame();
+
+	// Notify callbacks
+	Callbacks.OnFrameGenerated.Broadcast(FrameResult);
+
+	// Advance frame
+	CurrentFrame++;
+
+	return FrameResult;
+}
+
+FSimFrameView FSimulatorCore::Advance()
+{
+	if (!bIsInitialized)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SimulatorCore] Must be initialized before stepping"));
+		return GetFrameView();
+	}
+
+	AdvanceFrame();
+
+	// Only listeners need a snapshot
+	const FSimFrameView FrameResult = MakeFrameView(CurrentFrame);
+	if (Callbacks.OnFrameGenerated.IsBound())
+	{
+		FFrameData FrameData;
+		{
+			UNITSIM_PHASE_SCOPE(Snapshot);
+			FrameData = FrameResult.ToFrameData();
+		}
+		Profiler.EndFrame();
+		Callbacks.OnFrameGenerated.Broadcast(FrameData);
+	}
+	else
+	{
+		Profiler.EndFrame();
+	}
+
+	CurrentFrame++;
+
+	return FrameResult;
+}
+
+void FSimulatorCore::StepSilent()
+{
+	if (!bIsInitialized)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SimulatorCore] Must be initialized before stepping"));
+		return;
+	}
+
+	const bool bWasMuted = Callbacks.bMuted;
+	Callbacks.bMuted = true;
+	AdvanceFrame();
+	Callbacks.bMuted = bWasMuted;
+	Profiler.EndFrame();
+
+	CurrentFrame++;
+}
+
+void FSimulatorCore::AdvanceFrame()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UnitSim_Step);
+	Profiler.BeginFrame(CurrentFrame);
+
+	// Unit events and state changes are buffered for the frame and delivered at its end
+	Callbacks.BeginStep();
+
+	// Only paths found during this frame lend their tails to later queries in it
+	if (PathCache.IsValid())
+	{
+		PathCache->BeginFrame();
+	}
+
+	// Member buffer, so a steady-state frame reuses last frame's capacity
+	FFrameEvents& Events = FrameEvents;
+	Events.Clear();
 	const float DeltaTime = UnitSimConstants::FRAME_TIME_SECONDS;
 
+	// Recycle slots of units that died in earlier frames before anything spawns
+	{
+		UNITSIM_PHASE_SCOPE(Prepare);
+		ReclaimDeadUnits(EUnitFaction::Friendly);
+		ReclaimDeadUnits(EUnitFaction::Enemy);
+	}
+
 	// Process queued commands
-	ProcessCommands();
+	{
+		UNITSIM_PHASE_SCOPE(Commands);
+		ProcessCommands();
+	}
 
 	// Update dynamic obstacles periodically
 	if (CurrentFrame % UnitSimConstants::DYNAMIC_OBSTACLE_UPDATE_INTERVAL == 0 && DynamicObstacleSystem.IsValid())
 	{
-		TArray<FUnit*> LivingUnits;
-		GetAllLivingUnits(LivingUnits);
-		// Build flat array for DynamicObstacleSystem
-		TArray<FUnit> AllLiving;
-		for (FUnit* U : LivingUnits)
-		{
-			AllLiving.Add(*U);
-		}
-		DynamicObstacleSystem->UpdateDynamicObstacles(AllLiving.GetData(), AllLiving.Num());
+		UNITSIM_PHASE_SCOPE(DynamicObstacles);
+		// Dead units are skipped by the system, so the squads go in as they are
+		const uint32 PreviousVersion = PathfindingGrid->GetWalkabilityVersion();
+		DynamicObstacleSystem->UpdateDynamicObstacles(FriendlySquad, EnemySquad);
+
+		// Built flow fields are repaired around the toggled cells instead of rebuilt
+		FlowFields->RepairFields(DynamicObstacleSystem->GetLastChangedCells(), PreviousVersion);
 	}
 
 	// ════════════════════════════════════════════════════════════════════════
 	// Phase 1: Collect (no HP changes)
 	// ════════════════════════════════════════════════════════════════════════
-	EnemyBehavior.UpdateEnemySquad(*this, EnemySquad, FriendlySquad, GameSession.FriendlyTowers, Events);
-	SquadBehavior.UpdateFriendlySquad(*this, FriendlySquad, EnemySquad, GameSession.EnemyTowers, MainTarget, Events);
-	TowerBehavior.UpdateAllTowers(GameSession, FriendlySquad, EnemySquad, Events, DeltaTime);
+	// Behaviors scan the hot streams. Enemies and towers fan out over ParallelFor
+	// against frame-start state and merge their events in index order; the friendly
+	// squad (formation followers track the moved leader) still syncs unit by unit.
+	{
+		UNITSIM_PHASE_SCOPE(Prepare);
+		FriendlyHotStreams.Build(FriendlySquad);
+		EnemyHotStreams.Build(EnemySquad);
+	}
+	{
+		UNITSIM_PHASE_SCOPE(EnemyUpdate);
+		EnemyBehavior.UpdateEnemySquad(*this, EnemySquad, FriendlySquad, GameSession.FriendlyTowers, Events);
+	}
+	{
+		UNITSIM_PHASE_SCOPE(FriendlyUpdate);
+		SquadBehavior.UpdateFriendlySquad(*this, FriendlySquad, EnemySquad, GameSession.EnemyTowers, MainTarget, Events);
+	}
+	{
+		UNITSIM_PHASE_SCOPE(TowerUpdate);
+		TowerBehavior.UpdateAllTowers(GameSession, FriendlyHotStreams, EnemyHotStreams, Events, DeltaTime, bParallelPhase1);
+	}
+
+	// Replans queued in Phase 1 search on workers while collisions and events resolve
+	{
+		UNITSIM_PHASE_SCOPE(PathDispatch);
+		DispatchPathRequests();
+	}
+
+#if UNITSIM_FIXED_POINT
+	// Snap what Phase 1 integrated back onto the Q16.16 grid
+	for (TArray<FUnit>* Squad : { &FriendlySquad, &EnemySquad })
+	{
+		for (FUnit& Unit : *Squad)
+		{
+			Unit.Position = SimMath::Quantize(Unit.Position);
+			Unit.Velocity = SimMath::Quantize(Unit.Velocity);
+			Unit.Forward = SimMath::Quantize(Unit.Forward);
+		}
+	}
+#endif
 
 	// ════════════════════════════════════════════════════════════════════════
 	// Phase 1.5: Collision Resolution (Body Blocking)
 	// ════════════════════════════════════════════════════════════════════════
-	ResolveCollisions();
+	{
+		UNITSIM_PHASE_SCOPE(Collisions);
+		ResolveCollisions();
+	}
 
 	// ════════════════════════════════════════════════════════════════════════
 	// Phase 2: Apply events
 	// ════════════════════════════════════════════════════════════════════════
-	ApplyDamageEvents(Events);
-	ApplyTowerDamageEvents(Events);
-	ApplyDamageToTowers(Events);
-	ProcessDeaths(Events);
-	ApplySpawnEvents(Events);
+	Profiler.AddCount(ESimCounter::CombatEvents, Events.GetDamageCount() + Events.GetTowerDamageCount()
+		+ Events.GetDamageToTowerCount() + Events.GetSpawnCount());
+	{
+		UNITSIM_PHASE_SCOPE(ApplyDamage);
+		ApplyDamageEvents(Events);
+	}
+	{
+		UNITSIM_PHASE_SCOPE(ApplyTowerDamage);
+		ApplyTowerDamageEvents(Events);
+	}
+	{
+		UNITSIM_PHASE_SCOPE(ApplyDamageToTowers);
+		ApplyDamageToTowers(Events);
+	}
+	{
+		UNITSIM_PHASE_SCOPE(Deaths);
+		ProcessDeaths(Events);
+	}
+	{
+		UNITSIM_PHASE_SCOPE(Spawns);
+		ApplySpawnEvents(Events);
+	}
 
 	// Update game session
-	GameSession.ElapsedTime += DeltaTime;
-	GameSession.UpdateKingTowerActivation();
-	GameSession.UpdateCrowns();
-	WinConditionEvaluator.Evaluate(GameSession);
+	{
+		UNITSIM_PHASE_SCOPE(Session);
+		GameSession.ElapsedTime += DeltaTime;
+		GameSession.UpdateKingTowerActivation();
+		GameSession.UpdateCrowns();
+		WinConditionEvaluator.Evaluate(GameSession);
+	}
 
-	// Generate frame data
-	FFrameData FrameResult = FFrameData::FromSimulationState(
-		CurrentFrame,
-		FriendlySquad,
-		EnemySquad,
-		MainTarget,
-		CurrentWave,
-		bHasMoreWaves,
-		&GameSession
-	);
+	// Fixed landing point for this step's paths: units follow them from the next frame
+	{
+		UNITSIM_PHASE_SCOPE(PathApply);
+		ApplyPathRequests();
+	}
 
-	// Notify callbacks
-	Callbacks.OnFrameGenerated.Broadcast(FrameResult);
+	if (bStateHashEnabled)
+	{
+		UNITSIM_PHASE_SCOPE(StateHash);
+		StateHash = ComputeStateHash();
+	}
+	else
+	{
+		StateHash = FSimStateHash();
+	}
 
-	// Advance frame
-	CurrentFrame++;
+	if (Pathfinder.IsValid())
+	{
+		Profiler.AddCount(ESimCounter::PathRequests, Pathfinder->GetStats().Searches);
+		Profiler.AddCount(ESimCounter::PathNodesExpanded, Pathfinder->GetStats().NodesExpanded);
+		Pathfinder->ResetStats();
+	}
+	if (FlowFields.IsValid())
+	{
+		Profiler.AddCount(ESimCounter::FlowFieldBuilds, FlowFields->GetStats().FieldBuilds);
+		Profiler.AddCount(ESimCounter::FlowFieldRepairs, FlowFields->GetStats().FieldRepairs);
+		Profiler.AddCount(ESimCounter::FlowFieldPaths, FlowFields->GetStats().PathsTraced);
+		FlowFields->ResetStats();
+	}
+	if (HierarchicalPathfinder.IsValid())
+	{
+		Profiler.AddCount(ESimCounter::HierarchicalPaths, HierarchicalPathfinder->GetStats().Searches);
+		Profiler.AddCount(ESimCounter::ClusterRebuilds, HierarchicalPathfinder->GetStats().ClustersRebuilt);
+		HierarchicalPathfinder->ResetStats();
+	}
+	if (PathCache.IsValid())
+	{
+		const FPathCache::FStats& CacheStats = PathCache->GetStats();
+		Profiler.AddCount(ESimCounter::PathCacheHits, CacheStats.Hits + CacheStats.SuffixHits);
+		Profiler.AddCount(ESimCounter::PathCacheMisses, CacheStats.Misses);
+		PathCache->ResetStats();
+	}
+	if (PathRequests.IsValid())
+	{
+		const FPathRequestService::FStats& RequestStats = PathRequests->GetStats();
+		Profiler.AddCount(ESimCounter::PathRequests, RequestStats.Searches - RequestStats.HierarchicalSearches);
+		Profiler.AddCount(ESimCounter::PathNodesExpanded, RequestStats.NodesExpanded);
+		Profiler.AddCount(ESimCounter::HierarchicalPaths, RequestStats.HierarchicalSearches);
+		Profiler.AddCount(ESimCounter::ClusterRebuilds, RequestStats.ClustersRebuilt);
+		Profiler.AddCount(ESimCounter::PathsDeferred, RequestStats.Deferred);
+		PathRequests->ResetStats();
+	}
+	Profiler.AddCount(ESimCounter::UnitEvents, Callbacks.GetUnitEvents().Num());
 
-	return FrameResult;
+	{
+		UNITSIM_PHASE_SCOPE(Callbacks);
+		Callbacks.EndStep();
+	}
 }
 
 void FSimulatorCore::Stop()
@@ -254,133 +689,157 @@ void FSimulatorCore::Stop()
 // Command Queue
 // ============================================================================
 
-void FSimulatorCore::EnqueueCommand(TSharedPtr<ISimulationCommand> Command)
+bool FSimulatorCore::EnqueueCommand(const FSimCommand& Command)
 {
-	CommandQueue.Enqueue(Command);
+	if (!CommandRing.Push(Command))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[SimulatorCore] Command queue full, command for frame %d dropped"),
+			Command.GetFrameNumber());
+		return false;
+	}
+	return true;
 }
 
-void FSimulatorCore::ProcessCommands()
+bool FSimulatorCore::EnqueueCommands(TConstArrayView<FSimCommand> Commands)
 {
-	TSharedPtr<ISimulationCommand> Cmd;
-	while (CommandQueue.Peek(Cmd))
+	if (!CommandRing.PushBulk(Commands))
 	{
-		if (Cmd->GetFrameNumber() <= CurrentFrame)
-		{
-			CommandQueue.Dequeue(Cmd);
-			ExecuteCommand(Cmd);
-		}
-		else
+		UE_LOG(LogTemp, Warning, TEXT("[SimulatorCore] Command queue full, %d commands dropped (capacity %d)"),
+			Commands.Num(), CommandRing.GetCapacity());
+		return false;
+	}
+	return true;
+}
+
+void FSimulatorCore::DrainCommandRing()
+{
+	FSimCommand Cmd;
+	bool bSorted = true;
+	while (CommandRing.Pop(Cmd))
+	{
+		bSorted = bSorted && (PendingCommands.Num() == 0
+			|| PendingCommands.Last().GetFrameNumber() <= Cmd.GetFrameNumber());
+		PendingCommands.Add(Cmd);
+	}
+
+	if (!bSorted)
+	{
+		// Stable, so commands for one frame keep their enqueue order
+		PendingCommands.StableSort([](const FSimCommand& A, const FSimCommand& B)
 		{
-			break;
-		}
+			return A.GetFrameNumber() < B.GetFrameNumber();
+		});
 	}
 }
 
-void FSimulatorCore::ExecuteCommand(const TSharedPtr<ISimulationCommand>& Cmd)
+void FSimulatorCore::ProcessCommands()
 {
-	const FSimCommandWrapper* Wrapper = static_cast<const FSimCommandWrapper*>(Cmd.Get());
-	if (!Wrapper) return;
+	DrainCommandRing();
 
-	switch (Wrapper->Type)
+	int32 NumDue = 0;
+	while (NumDue < PendingCommands.Num() && PendingCommands[NumDue].GetFrameNumber() <= CurrentFrame)
+	{
+		ExecuteCommand(PendingCommands[NumDue]);
+		NumDue++;
+	}
+
+	if (NumDue > 0)
+	{
+		PendingCommands.RemoveAt(0, NumDue);
+	}
+}
+
+void FSimulatorCore::ExecuteCommand(const FSimCommand& Cmd)
+{
+	switch (Cmd.GetType())
 	{
 	case ESimCommandType::Spawn:
 	{
-		const FSpawnUnitCommand& Spawn = Wrapper->SpawnCmd;
+		const FSpawnUnitCommand& Spawn = Cmd.Get<FSpawnUnitCommand>();
 		InjectUnit(Spawn.Position, Spawn.Role, Spawn.Faction, Spawn.HP, Spawn.Speed, Spawn.TurnSpeed);
 		break;
 	}
 	case ESimCommandType::Damage:
 	{
-		const FDamageUnitCommand& Damage = Wrapper->DamageCmd;
-		TArray<FUnit>& Squad = (Damage.Faction == EUnitFaction::Friendly) ? FriendlySquad : EnemySquad;
-		for (FUnit& U : Squad)
+		const FDamageUnitCommand& Damage = Cmd.Get<FDamageUnitCommand>();
+		if (FUnit* U = FindUnit(Damage.Faction, Damage.UnitId))
 		{
-			if (U.Id == Damage.UnitId)
-			{
-				U.TakeDamage(Damage.Damage);
-				Callbacks.BroadcastStateChanged(FString::Printf(TEXT("Unit %d damaged by %d"), U.Id, Damage.Damage));
-				break;
-			}
+			U->TakeDamage(Damage.Damage);
+			Callbacks.BroadcastStateChanged(MakeStateChange(ESimStateChangeType::UnitDamaged, *U, Damage.Damage));
 		}
 		break;
 	}
 	case ESimCommandType::Kill:
 	{
-		const FKillUnitCommand& Kill = Wrapper->KillCmd;
-		TArray<FUnit>& Squad = (Kill.Faction == EUnitFaction::Friendly) ? FriendlySquad : EnemySquad;
-		for (FUnit& U : Squad)
+		const FKillUnitCommand& Kill = Cmd.Get<FKillUnitCommand>();
+		if (FUnit* U = FindUnit(Kill.Faction, Kill.UnitId))
 		{
-			if (U.Id == Kill.UnitId)
-			{
-				U.HP = 0;
-				U.bIsDead = true;
-				U.Velocity = FVector2D::ZeroVector;
-				Callbacks.BroadcastStateChanged(FString::Printf(TEXT("Unit %d killed"), U.Id));
-				break;
-			}
+			U->HP = 0;
+			U->bIsDead = true;
+			U->Velocity = FVector2D::ZeroVector;
+			Callbacks.BroadcastStateChanged(MakeStateChange(ESimStateChangeType::UnitKilled, *U));
 		}
 		break;
 	}
 	case ESimCommandType::Remove:
 	{
-		const FRemoveUnitCommand& Remove = Wrapper->RemoveCmd;
+		const FRemoveUnitCommand& Remove = Cmd.Get<FRemoveUnitCommand>();
 		RemoveUnit(Remove.UnitId, Remove.Faction);
 		break;
 	}
 	case ESimCommandType::Move:
 	{
-		const FMoveUnitCommand& Move = Wrapper->MoveCmd;
-		TArray<FUnit>& Squad = (Move.Faction == EUnitFaction::Friendly) ? FriendlySquad : EnemySquad;
-		for (FUnit& U : Squad)
+		const FMoveUnitCommand& Move = Cmd.Get<FMoveUnitCommand>();
+		if (FUnit* U = FindUnit(Move.Faction, Move.UnitId))
 		{
-			if (U.Id == Move.UnitId)
-			{
-				U.CurrentDestination = Move.Destination;
-				Callbacks.BroadcastStateChanged(FString::Printf(TEXT("Unit %d destination set"), U.Id));
-				break;
-			}
+			U->CurrentDestination = Move.Destination;
+			Callbacks.BroadcastStateChanged(MakeStateChange(ESimStateChangeType::DestinationSet, *U));
 		}
 		break;
 	}
 	case ESimCommandType::Revive:
 	{
-		const FReviveUnitCommand& Revive = Wrapper->ReviveCmd;
-		TArray<FUnit>& Squad = (Revive.Faction == EUnitFaction::Friendly) ? FriendlySquad : EnemySquad;
-		for (FUnit& U : Squad)
+		const FReviveUnitCommand& Revive = Cmd.Get<FReviveUnitCommand>();
+		if (FUnit* U = FindUnit(Revive.Faction, Revive.UnitId))
 		{
-			if (U.Id == Revive.UnitId)
-			{
-				U.HP = Revive.HP;
-				U.bIsDead = false;
-				Callbacks.BroadcastStateChanged(FString::Printf(TEXT("Unit %d revived with %d HP"), U.Id, Revive.HP));
-				break;
-			}
+			U->HP = Revive.HP;
+			U->bIsDead = false;
+			Callbacks.BroadcastStateChanged(MakeStateChange(ESimStateChangeType::UnitRevived, *U, Revive.HP));
+		}
+		else
+		{
+			LogReclaimedTarget(TEXT("Revive"), Revive.Faction, Revive.UnitId);
 		}
 		break;
 	}
 	case ESimCommandType::SetHealth:
 	{
-		const FSetUnitHealthCommand& SetHP = Wrapper->SetHealthCmd;
-		TArray<FUnit>& Squad = (SetHP.Faction == EUnitFaction::Friendly) ? FriendlySquad : EnemySquad;
-		for (FUnit& U : Squad)
+		const FSetUnitHealthCommand& SetHP = Cmd.Get<FSetUnitHealthCommand>();
+		if (FUnit* U = FindUnit(SetHP.Faction, SetHP.UnitId))
 		{
-			if (U.Id == SetHP.UnitId)
+			U->HP = SetHP.HP;
+			U->bIsDead = (SetHP.HP <= 0);
+			if (U->bIsDead)
 			{
-				U.HP = SetHP.HP;
-				U.bIsDead = (SetHP.HP <= 0);
-				if (U.bIsDead)
-				{
-					U.Velocity = FVector2D::ZeroVector;
-				}
-				Callbacks.BroadcastStateChanged(FString::Printf(TEXT("Unit %d HP set to %d"), U.Id, SetHP.HP));
-				break;
+				U->Velocity = FVector2D::ZeroVector;
 			}
+			Callbacks.BroadcastStateChanged(MakeStateChange(ESimStateChangeType::HealthSet, *U, SetHP.HP));
+		}
+		else
+		{
+			LogReclaimedTarget(TEXT("SetHealth"), SetHP.Faction, SetHP.UnitId);
 		}
 		break;
 	}
 	}
 }
 
+void FSimulatorCore::LogReclaimedTarget(const TCHAR* CommandName, EUnitFaction Faction, int32 UnitId) const
+{
+	UE_LOG(LogTemp, Warning, TEXT("[SimulatorCore] %s for unit %d (%s) ignored: no such unit, or it died in an earlier frame and was reclaimed before the command was queued"),
+		CommandName, UnitId, Faction == EUnitFaction::Friendly ? TEXT("Friendly") : TEXT("Enemy"));
+}
+
 // ============================================================================
 // Phase 2: Apply Events
 // ============================================================================
@@ -389,28 +848,7 @@ void FSimulatorCore::ApplyDamageEvents(const FFrameEvents& Events)
 {
 	for (const FSimDamageEvent& Dmg : Events.Damages)
 	{
-		// Determine target squad by source
-		// TargetIndex is an index into the opposing squad
-		// We need to figure out which squad it belongs to
-		// In the C# version, damage events store direct references.
-		// In UE5, TargetIndex is the index into one of the squads.
-		// The convention is: if SourceIndex is in Friendlies, TargetIndex is in Enemies and vice-versa.
-		// However, we also need to handle splash damage to same-squad.
-		// For now, we try both squads.
-
-		FUnit* Target = nullptr;
-		if (Dmg.TargetIndex >= 0)
-		{
-			if (Dmg.TargetIndex < EnemySquad.Num())
-			{
-				Target = &EnemySquad[Dmg.TargetIndex];
-			}
-			if (Target == nullptr && Dmg.TargetIndex < FriendlySquad.Num())
-			{
-				Target = &FriendlySquad[Dmg.TargetIndex];
-			}
-		}
-
+		FUnit* Target = FindEventTarget(Dmg.TargetFaction, Dmg.TargetIndex, Dmg.TargetId);
 		if (Target && !Target->bIsDead)
 		{
 			Target->TakeDamage(Dmg.Amount);
@@ -422,19 +860,7 @@ void FSimulatorCore::ApplyTowerDamageEvents(const FFrameEvents& Events)
 {
 	for (const FTowerDamageEvent& Dmg : Events.TowerDamages)
 	{
-		FUnit* Target = nullptr;
-		if (Dmg.TargetIndex >= 0)
-		{
-			if (Dmg.TargetIndex < FriendlySquad.Num())
-			{
-				Target = &FriendlySquad[Dmg.TargetIndex];
-			}
-			if (Target == nullptr && Dmg.TargetIndex < EnemySquad.Num())
-			{
-				Target = &EnemySquad[Dmg.TargetIndex];
-			}
-		}
-
+		FUnit* Target = FindEventTarget(Dmg.TargetFaction, Dmg.TargetIndex, Dmg.TargetId);
 		if (Target && !Target->bIsDead)
 		{
 			Target->TakeDamage(Dmg.Amount);
@@ -442,6 +868,17 @@ void FSimulatorCore::ApplyTowerDamageEvents(const FFrameEvents& Events)
 	}
 }
 
+FUnit* FSimulatorCore::FindEventTarget(EUnitFaction Faction, int32 TargetIndex, int32 TargetId)
+{
+	TArray<FUnit>& Squad = GetSquad(Faction);
+	if (!Squad.IsValidIndex(TargetIndex)) return nullptr;
+
+	// Events carry the target's Id; reject them if the slot changed hands
+	FUnit& Target = Squad[TargetIndex];
+	if (Target.Id != TargetId) return nullptr;
+	return &Target;
+}
+
 void FSimulatorCore::ApplyDamageToTowers(const FFrameEvents& Events)
 {
 	for (const FDamageToTowerEvent& Dmg : Events.DamageToTowers)
@@ -481,17 +918,18 @@ void FSimulatorCore::ApplyDamageToTowers(const FFrameEvents& Events)
 
 void FSimulatorCore::ProcessDeaths(FFrameEvents& Events)
 {
-	TQueue<int32> FriendlyDeathQueue;
-	TQueue<int32> EnemyDeathQueue;
-	TSet<int32> ProcessedFriendly;
-	TSet<int32> ProcessedEnemy;
+	// Member scratch: the queues are read front to back, so deaths keep FIFO order
+	FriendlyDeathQueue.Reset();
+	EnemyDeathQueue.Reset();
+	ProcessedFriendly.Reset();
+	ProcessedEnemy.Reset();
 
 	// Collect initial deaths: friendly
 	for (int32 i = 0; i < FriendlySquad.Num(); i++)
 	{
 		if (!FriendlySquad[i].bIsDead && FriendlySquad[i].HP <= 0)
 		{
-			FriendlyDeathQueue.Enqueue(i);
+			FriendlyDeathQueue.Add(i);
 		}
 	}
 	// Collect initial deaths: enemy
@@ -499,23 +937,24 @@ void FSimulatorCore::ProcessDeaths(FFrameEvents& Events)
 	{
 		if (!EnemySquad[i].bIsDead && EnemySquad[i].HP <= 0)
 		{
-			EnemyDeathQueue.Enqueue(i);
+			EnemyDeathQueue.Add(i);
 		}
 	}
 
 	// Process friendly deaths
-	int32 DeadIdx;
-	while (FriendlyDeathQueue.Dequeue(DeadIdx))
+	for (int32 QueueIdx = 0; QueueIdx < FriendlyDeathQueue.Num(); QueueIdx++)
 	{
+		const int32 DeadIdx = FriendlyDeathQueue[QueueIdx];
 		if (ProcessedFriendly.Contains(DeadIdx)) continue;
 
 		FUnit& Dead = FriendlySquad[DeadIdx];
 		Dead.bIsDead = true;
 		Dead.Velocity = FVector2D::ZeroVector;
 		// Release slot on target
-		if (Dead.TargetIndex >= 0 && Dead.TargetIndex < EnemySquad.Num())
+		const int32 DeadTargetIndex = Dead.Target.Resolve(EnemySquad);
+		if (DeadTargetIndex != INDEX_NONE)
 		{
-			EnemySquad[Dead.TargetIndex].ReleaseSlot(DeadIdx, Dead.TakenSlotIndex);
+			EnemySquad[DeadTargetIndex].ReleaseSlot(Dead.Id, Dead.TakenSlotIndex);
 		}
 		ProcessedFriendly.Add(DeadIdx);
 
@@ -530,34 +969,36 @@ void FSimulatorCore::ProcessDeaths(FFrameEvents& Events)
 		Callbacks.BroadcastUnitEvent(EvtData);
 
 		// Death spawn
-		TArray<FUnitSpawnRequest> Spawns = CombatSystem.CreateDeathSpawnRequests(Dead);
-		for (const FUnitSpawnRequest& S : Spawns)
+		CombatSystem.CreateDeathSpawnRequests(Dead, DeathSpawns);
+		for (const FUnitSpawnRequest& S : DeathSpawns)
 		{
 			Events.AddSpawn(S);
 		}
 
 		// Death damage
-		TArray<int32> NewlyDead = CombatSystem.ApplyDeathDamage(Dead, EnemySquad);
+		CombatSystem.ApplyDeathDamage(Dead, EnemySquad, NewlyDead);
 		for (int32 KilledIdx : NewlyDead)
 		{
 			if (!ProcessedEnemy.Contains(KilledIdx))
 			{
-				EnemyDeathQueue.Enqueue(KilledIdx);
+				EnemyDeathQueue.Add(KilledIdx);
 			}
 		}
 	}
 
-	// Process enemy deaths
-	while (EnemyDeathQueue.Dequeue(DeadIdx))
+	// Process enemy deaths (friendlies they kill are left for the next frame, as before)
+	for (int32 QueueIdx = 0; QueueIdx < EnemyDeathQueue.Num(); QueueIdx++)
 	{
+		const int32 DeadIdx = EnemyDeathQueue[QueueIdx];
 		if (ProcessedEnemy.Contains(DeadIdx)) continue;
 
 		FUnit& Dead = EnemySquad[DeadIdx];
 		Dead.bIsDead = true;
 		Dead.Velocity = FVector2D::ZeroVector;
-		if (Dead.TargetIndex >= 0 && Dead.TargetIndex < FriendlySquad.Num())
+		const int32 DeadTargetIndex = Dead.Target.Resolve(FriendlySquad);
+		if (DeadTargetIndex != INDEX_NONE)
 		{
-			FriendlySquad[Dead.TargetIndex].ReleaseSlot(DeadIdx, Dead.TakenSlotIndex);
+			FriendlySquad[DeadTargetIndex].ReleaseSlot(Dead.Id, Dead.TakenSlotIndex);
 		}
 		ProcessedEnemy.Add(DeadIdx);
 
@@ -570,18 +1011,18 @@ void FSimulatorCore::ProcessDeaths(FFrameEvents& Events)
 		EvtData.bHasPosition = true;
 		Callbacks.BroadcastUnitEvent(EvtData);
 
-		TArray<FUnitSpawnRequest> Spawns = CombatSystem.CreateDeathSpawnRequests(Dead);
-		for (const FUnitSpawnRequest& S : Spawns)
+		CombatSystem.CreateDeathSpawnRequests(Dead, DeathSpawns);
+		for (const FUnitSpawnRequest& S : DeathSpawns)
 		{
 			Events.AddSpawn(S);
 		}
 
-		TArray<int32> NewlyDead = CombatSystem.ApplyDeathDamage(Dead, FriendlySquad);
+		CombatSystem.ApplyDeathDamage(Dead, FriendlySquad, NewlyDead);
 		for (int32 KilledIdx : NewlyDead)
 		{
 			if (!ProcessedFriendly.Contains(KilledIdx))
 			{
-				FriendlyDeathQueue.Enqueue(KilledIdx);
+				FriendlyDeathQueue.Add(KilledIdx);
 			}
 		}
 	}
@@ -601,10 +1042,24 @@ void FSimulatorCore::ApplySpawnEvents(const FFrameEvents& Events)
 
 void FSimulatorCore::ResolveCollisions()
 {
-	TArray<FUnit*> AllUnits;
+	TArray<FUnit*>& AllUnits = CollisionUnits;
 	GetAllLivingUnits(AllUnits);
 	if (AllUnits.Num() < 2) return;
 
+	// Broadphase: cells cover the largest combined radius plus drift slack on both units,
+	// so any pair that can overlap while both stay within slack shares a 3x3 neighbourhood
+	double MaxRadius = 0.0;
+	for (const FUnit* Unit : AllUnits)
+	{
+		MaxRadius = FMath::Max(MaxRadius, static_cast<double>(Unit->Radius));
+	}
+	const double Slack = MaxRadius * UnitSimConstants::COLLISION_BROADPHASE_SLACK_RATIO;
+	const double CellSize = 2.0 * MaxRadius + 2.0 * Slack;
+	CollisionGrid.Build(AllUnits, CellSize, Slack);
+
+	TArray<int32>& Candidates = CollisionCandidates;
+	int32 NumPairs = 0;
+
 	for (int32 Iteration = 0; Iteration < UnitSimConstants::COLLISION_RESOLUTION_ITERATIONS; Iteration++)
 	{
 		bool bAnyResolved = false;
@@ -614,15 +1069,20 @@ void FSimulatorCore::ResolveCollisions()
 			FUnit* UnitA = AllUnits[i];
 			if (UnitA->bIsDead) continue;
 
-			for (int32 j = i + 1; j < AllUnits.Num(); j++)
+			// Candidates are visited in ascending j, matching the full i<j pair order
+			CollisionGrid.GatherNeighbors(i, i, Candidates);
+
+			for (int32 c = 0; c < Candidates.Num(); c++)
 			{
+				const int32 j = Candidates[c];
 				FUnit* UnitB = AllUnits[j];
 				if (UnitB->bIsDead) continue;
-				if (!UnitA->IsSameLayer(*UnitB)) continue;
+				NumPairs++;
 
 				const double CombinedRadius = UnitA->Radius + UnitB->Radius;
 				const FVector2D Delta = UnitB->Position - UnitA->Position;
-				const double Distance = Delta.Size();
+				const double Distance = SimMath::Length(Delta);
+				bool bPushed = false;
 
 				if (Distance < CombinedRadius && Distance > 0.001)
 				{
@@ -630,9 +1090,9 @@ void FSimulatorCore::ResolveCollisions()
 					const FVector2D PushDir = AvoidanceSystem::SafeNormalize(Delta);
 					const double PushAmount = Overlap * 0.5 * UnitSimConstants::COLLISION_PUSH_STRENGTH;
 
-					UnitA->Position -= PushDir * PushAmount;
-					UnitB->Position += PushDir * PushAmount;
-					bAnyResolved = true;
+					UnitA->Position = SimMath::Quantize(UnitA->Position - PushDir * PushAmount);
+					UnitB->Position = SimMath::Quantize(UnitB->Position + PushDir * PushAmount);
+					bPushed = true;
 				}
 				else if (Distance <= 0.001)
 				{
@@ -642,15 +1102,29 @@ void FSimulatorCore::ResolveCollisions()
 						static_cast<double>(UnitB->Id % 7 - 3) * 0.1 + 0.5
 					);
 					RandomDir = AvoidanceSystem::SafeNormalize(RandomDir);
-					UnitA->Position -= RandomDir * PushAmount;
-					UnitB->Position += RandomDir * PushAmount;
-					bAnyResolved = true;
+					UnitA->Position = SimMath::Quantize(UnitA->Position - RandomDir * PushAmount);
+					UnitB->Position = SimMath::Quantize(UnitB->Position + RandomDir * PushAmount);
+					bPushed = true;
+				}
+
+				if (!bPushed) continue;
+				bAnyResolved = true;
+
+				// A push beyond the slack could bring an unindexed pair into range:
+				// rebucket and continue after j so no pair is skipped or revisited
+				if (CollisionGrid.HasDrifted(i, UnitA->Position) || CollisionGrid.HasDrifted(j, UnitB->Position))
+				{
+					CollisionGrid.Build(AllUnits, CellSize, Slack);
+					CollisionGrid.GatherNeighbors(i, j, Candidates);
+					c = -1;
 				}
 			}
 		}
 
 		if (!bAnyResolved) break;
 	}
+
+	Profiler.AddCount(ESimCounter::CollisionPairs, NumPairs);
 }
 
 // ============================================================================
@@ -671,15 +1145,13 @@ int32 FSimulatorCore::InjectUnit(
 	const float UnitTurnSpeed = (TurnSpeed > 0.f) ? TurnSpeed : ((Faction == EUnitFaction::Friendly) ? 0.08f : 0.1f);
 
 	FUnit Unit;
-	const FName UnitIdName(*FString::Printf(TEXT("%s"), *StaticEnum<EUnitRole>()->GetNameStringByValue(static_cast<int64>(Role)).ToLower()));
+	const FName UnitIdName(*StaticEnum<EUnitRole>()->GetNameStringByValue(static_cast<int64>(Role)).ToLower());
 	Unit.Initialize(Id, UnitIdName, Faction, Position, UnitSimConstants::UNIT_RADIUS,
 		UnitSpeed, UnitTurnSpeed, Role, Health, UnitSimConstants::FRIENDLY_ATTACK_DAMAGE);
 
-	TArray<FUnit>& Squad = (Faction == EUnitFaction::Friendly) ? FriendlySquad : EnemySquad;
-	Squad.Add(Unit);
+	AddUnitToSquad(Unit);
 
-	Callbacks.BroadcastStateChanged(FString::Printf(TEXT("Unit %s injected at (%.0f, %.0f)"),
-		*Unit.GetLabel(), Position.X, Position.Y));
+	Callbacks.BroadcastStateChanged(MakeStateChange(ESimStateChangeType::UnitInjected, Unit));
 
 	FUnitEventData EvtData;
 	EvtData.EventType = EUnitEventType::Spawned;
@@ -734,16 +1206,15 @@ int32 FSimulatorCore::InjectSpawnedUnit(const FUnitSpawnRequest& Request)
 
 		if (!Request.UnitId.IsNone())
 		{
-			Callbacks.BroadcastStateChanged(FString::Printf(TEXT("Warning: Unknown unit type '%s', using defaults"),
-				*Request.UnitId.ToString()));
+			FSimStateChange Change = MakeStateChange(ESimStateChangeType::UnknownUnitType, Unit);
+			Change.UnitType = Request.UnitId;
+			Callbacks.BroadcastStateChanged(Change);
 		}
 	}
 
-	TArray<FUnit>& Squad = (Request.Faction == EUnitFaction::Friendly) ? FriendlySquad : EnemySquad;
-	Squad.Add(Unit);
+	AddUnitToSquad(Unit);
 
-	Callbacks.BroadcastStateChanged(FString::Printf(TEXT("Unit %s spawned at (%.0f, %.0f)"),
-		*Unit.GetLabel(), Request.Position.X, Request.Position.Y));
+	Callbacks.BroadcastStateChanged(MakeStateChange(ESimStateChangeType::UnitSpawned, Unit));
 
 	FUnitEventData EvtData;
 	EvtData.EventType = EUnitEventType::Spawned;
@@ -759,22 +1230,33 @@ int32 FSimulatorCore::InjectSpawnedUnit(const FUnitSpawnRequest& Request)
 
 bool FSimulatorCore::RemoveUnit(int32 UnitId, EUnitFaction Faction)
 {
-	TArray<FUnit>& Squad = (Faction == EUnitFaction::Friendly) ? FriendlySquad : EnemySquad;
+	TArray<FUnit>& Squad = GetSquad(Faction);
+	const int32 Slot = GetIdIndex(Faction).Find(Squad, UnitId);
 
-	for (int32 i = 0; i < Squad.Num(); i++)
+	if (Slot == INDEX_NONE)
 	{
-		if (Squad[i].Id == UnitId)
-		{
-			Callbacks.BroadcastStateChanged(FString::Printf(TEXT("Unit %s removed from simulation"),
-				*Squad[i].GetLabel()));
-			Squad.RemoveAt(i);
-			return true;
-		}
+		UE_LOG(LogTemp, Warning, TEXT("Unit %d (%s) not found for removal"),
+			UnitId, Faction == EUnitFaction::Friendly ? TEXT("Friendly") : TEXT("Enemy"));
+		return false;
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("Unit %d (%s) not found for removal"),
-		UnitId, Faction == EUnitFaction::Friendly ? TEXT("Friendly") : TEXT("Enemy"));
-	return false;
+	FUnit& Removed = Squad[Slot];
+	Callbacks.BroadcastStateChanged(MakeStateChange(ESimStateChangeType::UnitRemoved, Removed));
+
+	// Give back the attack slot the unit held on its own target
+	TArray<FUnit>& Opponents = GetOpposingUnits(Faction);
+	const int32 RemovedTargetIndex = Removed.Target.Resolve(Opponents);
+	if (RemovedTargetIndex != INDEX_NONE)
+	{
+		Opponents[RemovedTargetIndex].ReleaseSlot(Removed.Id, Removed.TakenSlotIndex);
+	}
+
+	// Later slots shift down: re-index, then re-point handles (handles to the removed unit are cleared)
+	Squad.RemoveAt(Slot);
+	GetIdIndex(Faction).Rebuild(Squad);
+	GetFreeSlots(Faction).Reset();
+	RebindHandles(Faction);
+	return true;
 }
 
 void FSimulatorCore::ClearFriendlyAttackSlots()
@@ -800,6 +1282,7 @@ void FSimulatorCore::LoadState(const FFrameData& FrameData)
 
 	ReconstructUnits(FrameData.FriendlyUnits, EUnitFaction::Friendly, FriendlySquad);
 	ReconstructUnits(FrameData.EnemyUnits, EUnitFaction::Enemy, EnemySquad);
+	ReindexSquads();
 
 	NextFriendlyId = 0;
 	for (const FUnit& U : FriendlySquad)
@@ -823,8 +1306,21 @@ void FSimulatorCore::LoadState(const FFrameData& FrameData)
 		GameSession.InitializeDefaultTowers();
 	}
 
+	// A core loaded before it was ever initialized has no grid yet; one that
+	// was keeps its grid, cleared for the loaded towers' footprints
+	if (!EnsurePathfinding())
+	{
+		PathfindingGrid->ResetWalkability();
+		DynamicObstacleSystem->Reset();
+	}
+	ConfigureStaticObstacles();
+
 	bIsInitialized = true;
-	Callbacks.BroadcastStateChanged(FString::Printf(TEXT("State loaded from frame %d"), FrameData.FrameNumber));
+	StateHash = ComputeStateHash();
+	FSimStateChange Loaded;
+	Loaded.Type = ESimStateChangeType::StateLoaded;
+	Loaded.Value = FrameData.FrameNumber;
+	Callbacks.BroadcastStateChanged(Loaded);
 	UE_LOG(LogTemp, Log, TEXT("Simulation state loaded from frame %d."), FrameData.FrameNumber);
 }
 
@@ -836,15 +1332,160 @@ FFrameData FSimulatorCore::GetCurrentFrameData() const
 		return FFrameData();
 	}
 
-	return FFrameData::FromSimulationState(
-		CurrentFrame,
-		FriendlySquad,
-		EnemySquad,
-		MainTarget,
-		CurrentWave,
-		bHasMoreWaves,
-		&GameSession
-	);
+	return GetFrameView().ToFrameData();
+}
+
+// ============================================================================
+// Binary Snapshots
+// ============================================================================
+
+void FSimulatorCore::SaveSnapshot(TArray<uint8>& OutData)
+{
+	OutData.Reset();
+	if (!bIsInitialized)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SimulatorCore] Must be initialized before saving a snapshot"));
+		return;
+	}
+
+	FMemoryWriter Writer(OutData);
+	uint32 Magic = SnapshotMagic;
+	uint32 Version = SnapshotVersion;
+	Writer << Magic << Version;
+	SerializeState(Writer);
+}
+
+bool FSimulatorCore::RestoreSnapshot(const TArray<uint8>& Data)
+{
+	FMemoryReader Reader(Data);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic << Version;
+	if (Reader.IsError() || Magic != SnapshotMagic || Version != SnapshotVersion)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[SimulatorCore] Snapshot rejected (expected version %u)"), SnapshotVersion);
+		return false;
+	}
+
+	SerializeState(Reader);
+	if (Reader.IsError())
+	{
+		bIsInitialized = false;
+		UE_LOG(LogTemp, Error, TEXT("[SimulatorCore] Snapshot truncated or corrupt; simulator left uninitialized"));
+		return false;
+	}
+	StateHash = ComputeStateHash();
+	return true;
+}
+
+// ============================================================================
+// State Hash
+// ============================================================================
+
+FSimStateHash FSimulatorCore::ComputeStateHash() const
+{
+	FSimStateHash Hash;
+	Hash.Domains[static_cast<int32>(ESimHashDomain::FriendlyUnits)] = SimStateHash::HashUnits(FriendlySquad);
+	Hash.Domains[static_cast<int32>(ESimHashDomain::EnemyUnits)] = SimStateHash::HashUnits(EnemySquad);
+	Hash.Domains[static_cast<int32>(ESimHashDomain::FriendlyTowers)] = SimStateHash::HashTowers(GameSession.FriendlyTowers);
+	Hash.Domains[static_cast<int32>(ESimHashDomain::EnemyTowers)] = SimStateHash::HashTowers(GameSession.EnemyTowers);
+
+	// The frame number travels next to the hash, so restoring or stepping leaves it out
+	FSimStateHasher Session;
+	SimStateHash::AddSession(Session, GameSession);
+	Session.Add(CurrentWave);
+	Session.Add(bHasMoreWaves);
+	Session.Add(NextFriendlyId);
+	Session.Add(NextEnemyId);
+	Session.Add(MainTarget);
+	Hash.Domains[static_cast<int32>(ESimHashDomain::Session)] = Session.Get();
+
+	SimStateHash::Combine(Hash);
+	return Hash;
+}
+
+void FSimulatorCore::SerializeState(FArchive& Ar)
+{
+	// Clock and counters
+	Ar << CurrentFrame << CurrentWave << bHasMoreWaves;
+	Ar << NextFriendlyId << NextEnemyId;
+	Ar << MainTarget;
+
+	// Session: towers, time, crowns, result
+	auto TowerFootprints = [this]()
+	{
+		TArray<FVector, TInlineAllocator<8>> Footprints;
+		for (const TArray<FTower>* Towers : { &GameSession.FriendlyTowers, &GameSession.EnemyTowers })
+		{
+			for (const FTower& Tower : *Towers)
+			{
+				Footprints.Emplace(Tower.Position.X, Tower.Position.Y, Tower.Radius);
+			}
+		}
+		return Footprints;
+	};
+	TArray<FVector, TInlineAllocator<8>> PreviousFootprints;
+	if (Ar.IsLoading())
+	{
+		PreviousFootprints = TowerFootprints();
+	}
+
+	FSimGameSession::StaticStruct()->SerializeBin(Ar, &GameSession);
+
+	// Static obstacles are the terrain plus the tower footprints. Rolling back
+	// within a match keeps them; only a fresh grid or another layout re-applies them.
+	if (Ar.IsLoading())
+	{
+		const bool bNewGrid = EnsurePathfinding();
+		if (bNewGrid || !bIsInitialized || TowerFootprints() != PreviousFootprints)
+		{
+			if (!bNewGrid)
+			{
+				PathfindingGrid->ResetWalkability();
+				DynamicObstacleSystem->Reset();
+			}
+			ConfigureStaticObstacles();
+		}
+	}
+
+	// Units and slot bookkeeping. The Id indices are derived, the free slot lists are not:
+	// they were built at the start of the saved frame and later injections draw from them.
+	SerializeSquad(Ar, FriendlySquad);
+	SerializeSquad(Ar, EnemySquad);
+	Ar << FriendlyFreeSlots << EnemyFreeSlots;
+	if (Ar.IsLoading())
+	{
+		FriendlyIdIndex.Rebuild(FriendlySquad);
+		EnemyIdIndex.Rebuild(EnemySquad);
+	}
+
+	SquadBehavior.Serialize(Ar);
+
+	// Pending commands (anything still in the ring is picked up first);
+	// loading discards whatever was queued and refills from the snapshot
+	DrainCommandRing();
+	int32 NumPending = PendingCommands.Num();
+	Ar << NumPending;
+	if (Ar.IsLoading())
+	{
+		if (Ar.IsError() || NumPending < 0 || NumPending > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+		PendingCommands.SetNum(NumPending);
+	}
+	for (FSimCommand& Pending : PendingCommands)
+	{
+		Pending.Serialize(Ar);
+	}
+
+	DynamicObstacleSystem->Serialize(Ar);
+
+	if (Ar.IsLoading())
+	{
+		bIsInitialized = !Ar.IsError();
+	}
 }
 
 // ============================================================================
@@ -862,7 +1503,7 @@ bool FSimulatorCore::AllEnemiesDead() const
 
 void FSimulatorCore::GetAllLivingUnits(TArray<FUnit*>& OutUnits)
 {
-	OutUnits.Empty();
+	OutUnits.Reset();
 	for (FUnit& U : FriendlySquad)
 	{
 		if (!U.bIsDead) OutUnits.Add(&U);
@@ -878,6 +1519,123 @@ TArray<FUnit>& FSimulatorCore::GetOpposingUnits(EUnitFaction Faction)
 	return (Faction == EUnitFaction::Friendly) ? EnemySquad : FriendlySquad;
 }
 
+FUnit* FSimulatorCore::FindUnit(EUnitFaction Faction, int32 UnitId)
+{
+	TArray<FUnit>& Squad = GetSquad(Faction);
+	const int32 Slot = GetIdIndex(Faction).Find(Squad, UnitId);
+	return Slot != INDEX_NONE ? &Squad[Slot] : nullptr;
+}
+
+const FUnit* FSimulatorCore::FindUnit(EUnitFaction Faction, int32 UnitId) const
+{
+	const bool bFriendly = (Faction == EUnitFaction::Friendly);
+	const TArray<FUnit>& Squad = bFriendly ? FriendlySquad : EnemySquad;
+	const int32 Slot = (bFriendly ? FriendlyIdIndex : EnemyIdIndex).Find(Squad, UnitId);
+	return Slot != INDEX_NONE ? &Squad[Slot] : nullptr;
+}
+
+void FSimulatorCore::AddUnitToSquad(const FUnit& Unit)
+{
+	TArray<FUnit>& Squad = GetSquad(Unit.Faction);
+	FUnitIdIndex& IdIndex = GetIdIndex(Unit.Faction);
+	TArray<int32>& FreeSlots = GetFreeSlots(Unit.Faction);
+
+	// Reuse a dead slot; skip any revived by a command since the list was built.
+	// Handles to the previous occupant go stale because its Id no longer matches.
+	while (FreeSlots.Num() > 0)
+	{
+		const int32 Slot = FreeSlots.Pop();
+		if (!Squad.IsValidIndex(Slot) || !Squad[Slot].bIsDead) continue;
+
+		IdIndex.Remove(Squad[Slot].Id);
+		Squad[Slot] = Unit;
+		IdIndex.Add(Unit.Id, Slot);
+		return;
+	}
+
+	const int32 Slot = Squad.Add(Unit);
+	IdIndex.Add(Unit.Id, Slot);
+}
+
+void FSimulatorCore::ReindexSquads()
+{
+	FriendlyIdIndex.Rebuild(FriendlySquad);
+	EnemyIdIndex.Rebuild(EnemySquad);
+	FriendlyFreeSlots.Reset();
+	EnemyFreeSlots.Reset();
+}
+
+void FSimulatorCore::ReclaimDeadUnits(EUnitFaction Faction)
+{
+	TArray<FUnit>& Squad = GetSquad(Faction);
+	TArray<int32>& FreeSlots = GetFreeSlots(Faction);
+	FreeSlots.Reset();
+
+	// Dead units a queued Revive/SetHealth still names keep their slot and Id
+	DrainCommandRing();
+	ReviveTargets.Reset();
+	for (const FSimCommand& Pending : PendingCommands)
+	{
+		if (Pending.GetType() == ESimCommandType::Revive)
+		{
+			const FReviveUnitCommand& Revive = Pending.Get<FReviveUnitCommand>();
+			if (Revive.Faction == Faction) ReviveTargets.AddUnique(Revive.UnitId);
+		}
+		else if (Pending.GetType() == ESimCommandType::SetHealth)
+		{
+			const FSetUnitHealthCommand& SetHP = Pending.Get<FSetUnitHealthCommand>();
+			if (SetHP.Faction == Faction) ReviveTargets.AddUnique(SetHP.UnitId);
+		}
+	}
+	auto IsReclaimable = [this](const FUnit& U) { return U.bIsDead && !ReviveTargets.Contains(U.Id); };
+
+	int32 DeadCount = 0;
+	for (const FUnit& U : Squad)
+	{
+		if (IsReclaimable(U)) DeadCount++;
+	}
+	if (DeadCount == 0) return;
+
+	const int32 LivingCount = Squad.Num() - DeadCount;
+	if (DeadCount >= FMath::Max(UnitSimConstants::SQUAD_COMPACTION_MIN_DEAD, LivingCount))
+	{
+		// Order-preserving removal keeps the living units' update order
+		Squad.RemoveAll(IsReclaimable);
+		GetIdIndex(Faction).Rebuild(Squad);
+		RebindHandles(Faction);
+		return;
+	}
+
+	for (int32 i = Squad.Num() - 1; i >= 0; i--)
+	{
+		if (IsReclaimable(Squad[i])) FreeSlots.Add(i);
+	}
+}
+
+void FSimulatorCore::RebindHandles(EUnitFaction Faction)
+{
+	const TArray<FUnit>& Squad = GetSquad(Faction);
+	const FUnitIdIndex& IdIndex = GetIdIndex(Faction);
+
+	// Units target the opposing squad
+	for (FUnit& Opponent : GetOpposingUnits(Faction))
+	{
+		IdIndex.Rebind(Opponent.Target, Squad);
+	}
+
+	// Towers target the squad of the other faction
+	TArray<FTower>& Towers = (Faction == EUnitFaction::Friendly) ? GameSession.EnemyTowers : GameSession.FriendlyTowers;
+	for (FTower& Tower : Towers)
+	{
+		IdIndex.Rebind(Tower.CurrentTarget, Squad);
+	}
+
+	if (Faction == EUnitFaction::Enemy)
+	{
+		SquadBehavior.RebindSquadTarget(IdIndex, Squad);
+	}
+}
+
 void FSimulatorCore::SpawnInitialUnits(const TArray<FUnitSpawnSetup>& UnitSetups)
 {
 	for (const FUnitSpawnSetup& Setup : UnitSetups)
@@ -904,10 +1662,10 @@ FVector2D FSimulatorCore::CalculateSpreadPosition(const FVector2D& Center, float
 	if (Total <= 1) return Center;
 
 	const double Angle = 2.0 * UE_DOUBLE_PI * Index / Total;
-	return FVector2D(
-		Center.X + Radius * FMath::Cos(Angle),
-		Center.Y + Radius * FMath::Sin(Angle)
-	);
+	return SimMath::Quantize(FVector2D(
+		Center.X + Radius * SimMath::Cos(Angle),
+		Center.Y + Radius * SimMath::Sin(Angle)
+	));
 }
 
 void FSimulatorCore::SpawnUnitFromSetup(const FName& UnitId, EUnitFaction Faction, const FVector2D& Position, int32 HPOverride)
@@ -930,13 +1688,12 @@ void FSimulatorCore::SpawnUnitFromSetup(const FName& UnitId, EUnitFaction Factio
 			4.0f, 0.1f, EUnitRole::Melee, Health, UnitSimConstants::FRIENDLY_ATTACK_DAMAGE);
 	}
 
-	TArray<FUnit>& Squad = (Faction == EUnitFaction::Friendly) ? FriendlySquad : EnemySquad;
-	Squad.Add(Unit);
+	AddUnitToSquad(Unit);
 }
 
 void FSimulatorCore::ReconstructUnits(const TArray<FUnitStateData>& StateList, EUnitFaction ExpectedFaction, TArray<FUnit>& OutUnits)
 {
-	OutUnits.Empty();
+	OutUnits.Reset();
 
 	for (const FUnitStateData& State : StateList)
 	{
@@ -0,0 +1,55 @@
+#include "Simulation/UnitSimBatchCommandlet.h"
+#include "Simulation/SimBatchRunner.h"
+
+UUnitSimBatchCommandlet::UUnitSimBatchCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UUnitSimBatchCommandlet::Main(const FString& Params)
+{
+	int32 Matches = 1000;
+	int32 Workers = 0;
+	int32 BaseSeed = 1;
+	int32 UnitsPerSide = 4;
+	FParse::Value(*Params, TEXT("Matches="), Matches);
+	FParse::Value(*Params, TEXT("Workers="), Workers);
+	FParse::Value(*Params, TEXT("Seed="), BaseSeed);
+	FParse::Value(*Params, TEXT("Units="), UnitsPerSide);
+
+	if (Matches <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[UnitSimBatch] -Matches must be positive"));
+		return 1;
+	}
+
+	TArray<FSimBatchJob> Jobs;
+	Jobs.Reserve(Matches);
+	for (int32 i = 0; i < Matches; ++i)
+	{
+		Jobs.Add(FSimBatchRunner::MakeRandomSkirmish(BaseSeed + i, UnitsPerSide));
+	}
+
+	FSimBatchRunner Runner(Workers);
+	UE_LOG(LogTemp, Display, TEXT("[UnitSimBatch] Running %d matches on %d workers"), Matches, Runner.GetNumWorkers());
+
+	// The simulator logs every initialize/run at Log; silence it for the batch
+	const ELogVerbosity::Type PreviousVerbosity = LogTemp.GetVerbosity();
+	LogTemp.SetVerbosity(ELogVerbosity::Warning);
+
+	TArray<FSimMatchResult> Results;
+	const FSimBatchSummary Summary = Runner.Run(Jobs, Results);
+
+	LogTemp.SetVerbosity(PreviousVerbosity);
+
+	TArray<FString> Lines;
+	Summary.ToTable().ParseIntoArrayLines(Lines);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[UnitSimBatch] %s"), *Line);
+	}
+	return 0;
+}
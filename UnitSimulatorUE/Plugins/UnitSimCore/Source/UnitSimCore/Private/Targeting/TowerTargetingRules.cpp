@@ -1,5 +1,6 @@
 #include "Targeting/TowerTargetingRules.h"
 #include "Units/Unit.h"
+#include "Units/UnitHotStreams.h"
 #include "Towers/Tower.h"
 
 int32 TowerTargetingRules::SelectTowerTarget(
@@ -96,3 +97,54 @@ void TowerTargetingRules::SelectTarget(
 
 	OutTowerTargetIndex = SelectTowerTarget(Unit, Towers);
 }
+
+int32 TowerTargetingRules::SelectUnitTarget(
+	const FUnit& Unit,
+	const FUnitHotStreams& Enemies)
+{
+	float BestDistance;
+	return Enemies.FindNearestTargetable(Unit.Position, Unit.CanTarget, BestDistance);
+}
+
+void TowerTargetingRules::SelectTarget(
+	const FUnit& Unit,
+	const FUnitHotStreams& Enemies,
+	const TArray<FTower>& Towers,
+	int32& OutUnitTargetIndex,
+	int32& OutTowerTargetIndex)
+{
+	OutUnitTargetIndex = -1;
+	OutTowerTargetIndex = -1;
+
+	// Buildings priority: prefer towers first
+	if (Unit.TargetPriority == ETargetPriority::Buildings)
+	{
+		OutTowerTargetIndex = SelectTowerTarget(Unit, Towers);
+		if (OutTowerTargetIndex >= 0)
+		{
+			return;
+		}
+
+		OutUnitTargetIndex = SelectUnitTarget(Unit, Enemies);
+		return;
+	}
+
+	// Default (Nearest): prefer enemy units, fallback to towers
+	bool bHasLivingEnemy = false;
+	for (int32 i = 0; i < Enemies.Num(); ++i)
+	{
+		if (!Enemies.IsDead(i))
+		{
+			bHasLivingEnemy = true;
+			break;
+		}
+	}
+
+	if (bHasLivingEnemy)
+	{
+		OutUnitTargetIndex = SelectUnitTarget(Unit, Enemies);
+		return;
+	}
+
+	OutTowerTargetIndex = SelectTowerTarget(Unit, Towers);
+}
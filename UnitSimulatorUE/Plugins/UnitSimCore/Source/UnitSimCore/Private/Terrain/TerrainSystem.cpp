@@ -53,6 +53,11 @@ bool FTerrainSystem::IsCrossingRiver(const FVector2D& From, const FVector2D& To)
 	return (bFromLower && bToUpper) || (bFromUpper && bToLower);
 }
 
+TArray<FVector2D> FTerrainSystem::GetBridgeCenters()
+{
+	return { LeftBridgeCenter, RightBridgeCenter };
+}
+
 FVector2D FTerrainSystem::GetNearestBridgeCenter(const FVector2D& Position)
 {
 	const float LeftDistance = FVector2D::Distance(Position, LeftBridgeCenter);
@@ -1,5 +1,6 @@
 #include "Towers/Tower.h"
 #include "Units/Unit.h"
+#include "Units/UnitHotStreams.h"
 
 void FTower::TakeDamage(int32 Amount)
 {
@@ -33,6 +34,16 @@ bool FTower::CanAttackUnit(const FUnit& InTarget) const
 	return Distance <= AttackRange;
 }
 
+bool FTower::CanAttackUnit(const FUnitHotStreams& Units, int32 Index) const
+{
+	if (IsDestroyed()) return false;
+	if (Type == ETowerType::King && !bIsActivated) return false;
+	if (!Units.IsTargetableBy(Index, CanTarget)) return false;
+
+	const float Distance = Units.DistanceTo(Index, Position);
+	return Distance <= AttackRange;
+}
+
 void FTower::OnAttackPerformed()
 {
 	AttackCooldown = 1.f / AttackSpeed;
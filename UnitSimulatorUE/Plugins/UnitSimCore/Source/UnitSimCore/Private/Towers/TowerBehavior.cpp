@@ -1,25 +1,29 @@
 #include "Towers/TowerBehavior.h"
 #include "Towers/Tower.h"
-#include "Units/Unit.h"
+#include "Units/UnitHotStreams.h"
 #include "Combat/FrameEvents.h"
+#include "Simulation/ParallelCollect.h"
 #include "GameState/SimGameSession.h"
 
 void FTowerBehavior::UpdateTowers(
 	TArray<FTower>& Towers,
-	const TArray<FUnit>& Enemies,
+	const FUnitHotStreams& Enemies,
 	FFrameEvents& Events,
-	float DeltaTime)
+	float DeltaTime,
+	bool bParallel)
 {
-	for (int32 i = 0; i < Towers.Num(); ++i)
-	{
-		UpdateTower(Towers[i], i, Enemies, Events, DeltaTime);
-	}
+	// A tower only writes itself and its own events, and reads the frozen streams
+	ParallelCollect::ForEachOrdered(Towers.Num(), BatchEvents, Events, bParallel,
+		[&](int32 i, FFrameEvents& TowerEvents)
+		{
+			UpdateTower(Towers[i], i, Enemies, TowerEvents, DeltaTime);
+		});
 }
 
 void FTowerBehavior::UpdateTower(
 	FTower& Tower,
 	int32 TowerIndex,
-	const TArray<FUnit>& Enemies,
+	const FUnitHotStreams& Enemies,
 	FFrameEvents& Events,
 	float DeltaTime)
 {
@@ -31,38 +35,35 @@ void FTowerBehavior::UpdateTower(
 	ProcessAttack(Tower, TowerIndex, Events);
 }
 
-void FTowerBehavior::ValidateAndUpdateTarget(FTower& Tower, const TArray<FUnit>& Enemies)
+void FTowerBehavior::ValidateAndUpdateTarget(FTower& Tower, const FUnitHotStreams& Enemies)
 {
-	// Validate current target
-	if (Tower.CurrentTargetIndex >= 0)
+	// Validate current target (a stale handle resolves to INDEX_NONE)
+	if (Tower.CurrentTarget.IsSet())
 	{
-		if (Tower.CurrentTargetIndex >= Enemies.Num() ||
-			Enemies[Tower.CurrentTargetIndex].bIsDead ||
-			!Tower.CanAttackUnit(Enemies[Tower.CurrentTargetIndex]))
+		const int32 TargetIndex = Tower.CurrentTarget.Resolve(Enemies);
+		if (TargetIndex == INDEX_NONE || !Tower.CanAttackUnit(Enemies, TargetIndex))
 		{
-			Tower.CurrentTargetIndex = -1;
+			Tower.CurrentTarget.Reset();
 		}
 	}
 
 	// Select new target if needed
-	if (Tower.CurrentTargetIndex < 0)
+	if (!Tower.CurrentTarget.IsSet())
 	{
-		Tower.CurrentTargetIndex = FindNearestTarget(Tower, Enemies);
+		Tower.CurrentTarget = FUnitHandle::Make(Enemies, FindNearestTarget(Tower, Enemies));
 	}
 }
 
-int32 FTowerBehavior::FindNearestTarget(const FTower& Tower, const TArray<FUnit>& Enemies)
+int32 FTowerBehavior::FindNearestTarget(const FTower& Tower, const FUnitHotStreams& Enemies)
 {
 	int32 BestIndex = -1;
 	float BestDistance = TNumericLimits<float>::Max();
 
 	for (int32 i = 0; i < Enemies.Num(); ++i)
 	{
-		const FUnit& Enemy = Enemies[i];
-		if (Enemy.bIsDead) continue;
-		if (!Tower.CanAttackUnit(Enemy)) continue;
+		if (!Tower.CanAttackUnit(Enemies, i)) continue;
 
-		const float Dist = FVector2D::Distance(Tower.Position, Enemy.Position);
+		const float Dist = Enemies.DistanceTo(i, Tower.Position);
 		if (Dist < BestDistance)
 		{
 			BestDistance = Dist;
@@ -76,22 +77,24 @@ int32 FTowerBehavior::FindNearestTarget(const FTower& Tower, const TArray<FUnit>
 void FTowerBehavior::ProcessAttack(FTower& Tower, int32 TowerIndex, FFrameEvents& Events)
 {
 	if (!Tower.IsReadyToAttack()) return;
-	if (Tower.CurrentTargetIndex < 0) return;
+	if (!Tower.CurrentTarget.IsSet()) return;
 
-	Events.AddTowerDamage(TowerIndex, Tower.CurrentTargetIndex, Tower.Damage);
+	const EUnitFaction TargetFaction = (Tower.Faction == EUnitFaction::Friendly) ? EUnitFaction::Enemy : EUnitFaction::Friendly;
+	Events.AddTowerDamage(TowerIndex, TargetFaction, Tower.CurrentTarget, Tower.Damage);
 	Tower.OnAttackPerformed();
 }
 
 void FTowerBehavior::UpdateAllTowers(
 	FSimGameSession& Session,
-	const TArray<FUnit>& FriendlyUnits,
-	const TArray<FUnit>& EnemyUnits,
+	const FUnitHotStreams& FriendlyUnits,
+	const FUnitHotStreams& EnemyUnits,
 	FFrameEvents& Events,
-	float DeltaTime)
+	float DeltaTime,
+	bool bParallel)
 {
 	// Friendly towers attack enemy units
-	UpdateTowers(Session.FriendlyTowers, EnemyUnits, Events, DeltaTime);
+	UpdateTowers(Session.FriendlyTowers, EnemyUnits, Events, DeltaTime, bParallel);
 
 	// Enemy towers attack friendly units
-	UpdateTowers(Session.EnemyTowers, FriendlyUnits, Events, DeltaTime);
+	UpdateTowers(Session.EnemyTowers, FriendlyUnits, Events, DeltaTime, bParallel);
 }
@@ -1,4 +1,5 @@
 #include "Units/Unit.h"
+#include "Math/SimMath.h"
 
 void FUnit::Initialize(int32 InId, const FName& InUnitId, EUnitFaction InFaction,
 	const FVector2D& InPosition, float InRadius, float InSpeed, float InTurnSpeed,
@@ -8,7 +9,7 @@ void FUnit::Initialize(int32 InId, const FName& InUnitId, EUnitFaction InFaction
 	Id = InId;
 	UnitId = InUnitId;
 	Faction = InFaction;
-	Position = InPosition;
+	Position = SimMath::Quantize(InPosition);
 	CurrentDestination = InPosition;
 	Radius = InRadius;
 	Speed = InSpeed;
@@ -28,7 +29,7 @@ void FUnit::Initialize(int32 InId, const FName& InUnitId, EUnitFaction InFaction
 	bIsDead = false;
 	Velocity = FVector2D::ZeroVector;
 	Forward = FVector2D(1.0, 0.0);
-	TargetIndex = -1;
+	Target.Reset();
 	TargetTowerIndex = -1;
 }
 
@@ -66,23 +67,23 @@ FVector2D FUnit::GetSlotPosition(int32 SlotIndex, float AttackerRadius) const
 {
 	const float Angle = (2.f * UE_PI / UnitSimConstants::NUM_ATTACK_SLOTS) * SlotIndex;
 	const float Distance = Radius + AttackerRadius + 10.f;
-	return Position + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Distance;
+	return Position + FVector2D(SimMath::Cos(Angle), SimMath::Sin(Angle)) * Distance;
 }
 
-int32 FUnit::TryClaimSlot(int32 AttackerIndex)
+int32 FUnit::TryClaimSlot(int32 AttackerId)
 {
 	for (int32 i = 0; i < UnitSimConstants::NUM_ATTACK_SLOTS; ++i)
 	{
 		if (AttackSlots[i] == -1)
 		{
-			AttackSlots[i] = AttackerIndex;
+			AttackSlots[i] = AttackerId;
 			return i;
 		}
 	}
 	return -1;
 }
 
-int32 FUnit::ClaimBestSlot(int32 AttackerIndex, const FVector2D& AttackerPosition, float AttackerRadius)
+int32 FUnit::FindBestSlot(int32 AttackerId, const FVector2D& AttackerPosition, float AttackerRadius) const
 {
 	int32 BestIndex = -1;
 	float BestDistance = TNumericLimits<float>::Max();
@@ -90,7 +91,7 @@ int32 FUnit::ClaimBestSlot(int32 AttackerIndex, const FVector2D& AttackerPositio
 	for (int32 i = 0; i < UnitSimConstants::NUM_ATTACK_SLOTS; ++i)
 	{
 		const int32 Occupant = AttackSlots[i];
-		if (Occupant != -1 && Occupant != AttackerIndex) continue;
+		if (Occupant != -1 && Occupant != AttackerId) continue;
 
 		const float Dist = FVector2D::Distance(AttackerPosition, GetSlotPosition(i, AttackerRadius));
 		if (Dist < BestDistance)
@@ -100,25 +101,32 @@ int32 FUnit::ClaimBestSlot(int32 AttackerIndex, const FVector2D& AttackerPositio
 		}
 	}
 
+	return BestIndex;
+}
+
+int32 FUnit::ClaimBestSlot(int32 AttackerId, const FVector2D& AttackerPosition, float AttackerRadius)
+{
+	const int32 BestIndex = FindBestSlot(AttackerId, AttackerPosition, AttackerRadius);
+
 	if (BestIndex != -1)
 	{
 		// Release old slot if different
 		if (TakenSlotIndex != -1 && TakenSlotIndex != BestIndex &&
-			TakenSlotIndex < AttackSlots.Num() && AttackSlots[TakenSlotIndex] == AttackerIndex)
+			TakenSlotIndex < AttackSlots.Num() && AttackSlots[TakenSlotIndex] == AttackerId)
 		{
 			AttackSlots[TakenSlotIndex] = -1;
 		}
-		AttackSlots[BestIndex] = AttackerIndex;
+		AttackSlots[BestIndex] = AttackerId;
 	}
 
 	return BestIndex;
 }
 
-void FUnit::ReleaseSlot(int32 AttackerIndex, int32 SlotIdx)
+void FUnit::ReleaseSlot(int32 AttackerId, int32 SlotIdx)
 {
 	if (SlotIdx >= 0 && SlotIdx < AttackSlots.Num())
 	{
-		if (AttackSlots[SlotIdx] == AttackerIndex)
+		if (AttackSlots[SlotIdx] == AttackerId)
 		{
 			AttackSlots[SlotIdx] = -1;
 		}
@@ -127,7 +135,9 @@ void FUnit::ReleaseSlot(int32 AttackerIndex, int32 SlotIdx)
 
 void FUnit::SetAvoidancePath(const TArray<FVector2D>& Waypoints)
 {
-	AvoidancePath = Waypoints;
+	// Reset + Append keeps the buffer, so a replaced path reuses its capacity
+	AvoidancePath.Reset();
+	AvoidancePath.Append(Waypoints);
 	AvoidancePathIndex = 0;
 }
 
@@ -151,13 +161,14 @@ bool FUnit::TryGetNextAvoidanceWaypoint(FVector2D& OutWaypoint) const
 
 void FUnit::ClearAvoidancePath()
 {
-	AvoidancePath.Empty();
+	AvoidancePath.Reset();
 	AvoidancePathIndex = 0;
 }
 
 void FUnit::SetMovementPath(const TArray<FVector2D>& Path)
 {
-	MovementPath = Path;
+	MovementPath.Reset();
+	MovementPath.Append(Path);
 	MovementPathIndex = 0;
 }
 
@@ -184,7 +195,7 @@ bool FUnit::TryGetNextMovementWaypoint(FVector2D& OutWaypoint)
 
 void FUnit::ClearMovementPath()
 {
-	MovementPath.Empty();
+	MovementPath.Reset();
 	MovementPathIndex = 0;
 }
 
@@ -195,8 +206,8 @@ void FUnit::UpdateRotation()
 		return;
 	}
 
-	const float TargetAngle = FMath::Atan2(Velocity.Y, Velocity.X);
-	const float CurrentAngle = FMath::Atan2(Forward.Y, Forward.X);
+	const float TargetAngle = SimMath::Atan2(Velocity.Y, Velocity.X);
+	const float CurrentAngle = SimMath::Atan2(Forward.Y, Forward.X);
 	float AngleDiff = TargetAngle - CurrentAngle;
 
 	// Normalize to [-PI, PI]
@@ -205,7 +216,7 @@ void FUnit::UpdateRotation()
 
 	const float Rotation = FMath::Clamp(AngleDiff, -TurnSpeed, TurnSpeed);
 	const float NewAngle = CurrentAngle + Rotation;
-	Forward = FVector2D(FMath::Cos(NewAngle), FMath::Sin(NewAngle));
+	Forward = FVector2D(SimMath::Cos(NewAngle), SimMath::Sin(NewAngle));
 }
 
 int32 FUnit::TakeDamage(int32 InDamage)
@@ -262,3 +273,22 @@ void FUnit::OnAttackPerformed()
 		ChargeState.ConsumeCharge();
 	}
 }
+
+void FUnit::Serialize(FArchive& Ar)
+{
+	// UPROPERTY fields in declaration order, no tags
+	StaticStruct()->SerializeBin(Ar, this);
+
+	// Typed ability caches (saved rather than rebuilt from Abilities, so restore is a straight copy)
+	FChargeAttackData::StaticStruct()->SerializeBin(Ar, &ChargeAttackAbility);
+	FSplashDamageData::StaticStruct()->SerializeBin(Ar, &SplashDamageAbility);
+	FShieldData::StaticStruct()->SerializeBin(Ar, &ShieldAbility);
+	FDeathSpawnData::StaticStruct()->SerializeBin(Ar, &DeathSpawnAbility);
+	FDeathDamageData::StaticStruct()->SerializeBin(Ar, &DeathDamageAbility);
+	FStatusEffectAbilityData::StaticStruct()->SerializeBin(Ar, &StatusEffectAbility);
+
+	Ar << bHasSplashDamage << bHasShield << bHasDeathSpawn << bHasDeathDamage << bHasStatusEffect;
+
+	Ar << AvoidancePath << AvoidancePathIndex;
+	Ar << MovementPath << MovementPathIndex;
+}
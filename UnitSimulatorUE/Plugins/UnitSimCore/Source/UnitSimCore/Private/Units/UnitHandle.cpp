@@ -0,0 +1,35 @@
+#include "Units/UnitHandle.h"
+#include "Units/Unit.h"
+#include "Units/UnitHotStreams.h"
+
+FUnitHandle FUnitHandle::Make(const TArray<FUnit>& Squad, int32 InIndex)
+{
+	FUnitHandle Handle;
+	if (Squad.IsValidIndex(InIndex))
+	{
+		Handle.Index = InIndex;
+		Handle.Generation = Squad[InIndex].Id;
+	}
+	return Handle;
+}
+
+FUnitHandle FUnitHandle::Make(const FUnitHotStreams& Streams, int32 InIndex)
+{
+	FUnitHandle Handle;
+	if (InIndex >= 0 && InIndex < Streams.Num())
+	{
+		Handle.Index = InIndex;
+		Handle.Generation = Streams.GetId(InIndex);
+	}
+	return Handle;
+}
+
+int32 FUnitHandle::Resolve(const TArray<FUnit>& Squad) const
+{
+	return (Squad.IsValidIndex(Index) && Squad[Index].Id == Generation) ? Index : INDEX_NONE;
+}
+
+int32 FUnitHandle::Resolve(const FUnitHotStreams& Streams) const
+{
+	return (Index >= 0 && Index < Streams.Num() && Streams.GetId(Index) == Generation) ? Index : INDEX_NONE;
+}
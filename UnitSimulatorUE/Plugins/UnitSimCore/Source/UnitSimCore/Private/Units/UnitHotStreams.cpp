@@ -0,0 +1,56 @@
+#include "Units/UnitHotStreams.h"
+#include "Units/Unit.h"
+
+void FUnitHotStreams::Build(const TArray<FUnit>& Units)
+{
+	const int32 Count = Units.Num();
+
+	PosX.SetNumUninitialized(Count);
+	PosY.SetNumUninitialized(Count);
+	VelX.SetNumUninitialized(Count);
+	VelY.SetNumUninitialized(Count);
+	FwdX.SetNumUninitialized(Count);
+	FwdY.SetNumUninitialized(Count);
+	Radius.SetNumUninitialized(Count);
+	Flags.SetNumUninitialized(Count);
+	Ids.SetNumUninitialized(Count);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Sync(i, Units[i]);
+	}
+}
+
+void FUnitHotStreams::Sync(int32 Index, const FUnit& Unit)
+{
+	PosX[Index] = Unit.Position.X;
+	PosY[Index] = Unit.Position.Y;
+	VelX[Index] = Unit.Velocity.X;
+	VelY[Index] = Unit.Velocity.Y;
+	FwdX[Index] = Unit.Forward.X;
+	FwdY[Index] = Unit.Forward.Y;
+	Radius[Index] = Unit.Radius;
+	Flags[Index] = static_cast<uint8>((Unit.bIsDead ? FlagDead : 0) | (Unit.Layer == EMovementLayer::Air ? FlagAir : 0));
+	Ids[Index] = Unit.Id;
+}
+
+int32 FUnitHotStreams::FindNearestTargetable(const FVector2D& From, ETargetType CanTarget, float& OutDistance) const
+{
+	int32 BestIndex = -1;
+	float BestDistance = TNumericLimits<float>::Max();
+
+	for (int32 i = 0; i < Num(); ++i)
+	{
+		if (!IsTargetableBy(i, CanTarget)) continue;
+
+		const float Dist = DistanceTo(i, From);
+		if (Dist < BestDistance)
+		{
+			BestDistance = Dist;
+			BestIndex = i;
+		}
+	}
+
+	OutDistance = BestDistance;
+	return BestIndex;
+}
@@ -0,0 +1,34 @@
+#include "Units/UnitIdIndex.h"
+#include "Units/Unit.h"
+#include "Units/UnitHandle.h"
+
+void FUnitIdIndex::Rebuild(const TArray<FUnit>& Squad)
+{
+	SlotById.Reset();
+	SlotById.Reserve(Squad.Num());
+	for (int32 i = 0; i < Squad.Num(); ++i)
+	{
+		SlotById.Add(Squad[i].Id, i);
+	}
+}
+
+int32 FUnitIdIndex::Find(const TArray<FUnit>& Squad, int32 UnitId) const
+{
+	const int32* Slot = SlotById.Find(UnitId);
+	if (Slot && Squad.IsValidIndex(*Slot) && Squad[*Slot].Id == UnitId)
+	{
+		return *Slot;
+	}
+	return INDEX_NONE;
+}
+
+void FUnitIdIndex::Rebind(FUnitHandle& Handle, const TArray<FUnit>& Squad) const
+{
+	if (!Handle.IsSet()) return;
+
+	Handle.Index = Find(Squad, Handle.Generation);
+	if (Handle.Index == INDEX_NONE)
+	{
+		Handle.Reset();
+	}
+}
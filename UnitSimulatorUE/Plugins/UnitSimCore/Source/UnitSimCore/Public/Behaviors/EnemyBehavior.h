@@ -2,16 +2,26 @@
 
 #include "CoreMinimal.h"
 #include "GameConstants.h"
+#include "Combat/FrameEvents.h"
+#include "Combat/AvoidanceSystem.h"
+#include "Pathfinding/PathRequestService.h"
 
 // Forward declarations
 struct FUnit;
 struct FTower;
-struct FFrameEvents;
 class FSimulatorCore;
+class FUnitHotStreams;
 
 /**
  * Enemy AI behavior: target scoring/selection, slot-based positioning, tower combat.
  * Uses 2-Phase Update pattern: only collects events in Phase 1.
+ *
+ * Enemies update in parallel against frame-start state: they read the hot
+ * streams and friendly slots as they were when the squad update began, and
+ * writes to shared state (attack slot claims/releases, path requests) are queued
+ * per enemy and committed serially in index order afterwards. A claim may
+ * therefore land on a different slot than the one the enemy steered toward
+ * this frame; the committed slot is used from the next frame on.
  * Ported from EnemyBehavior.cs (316 lines)
  */
 class UNITSIMCORE_API FEnemyBehavior
@@ -33,6 +43,53 @@ public:
 		FFrameEvents& Events);
 
 private:
+	// ════════════════════════════════════════════════════════════════════════
+	// Deferred Shared Writes
+	// ════════════════════════════════════════════════════════════════════════
+
+	/** Attack slot change on a friendly, applied during the serial commit */
+	struct FPendingSlotOp
+	{
+		int32 TargetIndex = INDEX_NONE;
+		bool bClaim = false;
+		/** Slot to release (release ops only) */
+		int32 SlotIndex = -1;
+		/** Attacker position/radius the claim is scored from (claim ops only) */
+		FVector2D Position = FVector2D::ZeroVector;
+		float Radius = 0.f;
+	};
+
+	/** Shared-state writes one enemy queued this frame, in the order it made them */
+	struct FPendingOps
+	{
+		TArray<FPendingSlotOp, TInlineAllocator<3>> SlotOps;
+		bool bPathRequested = false;
+		FPathRequest PathRequest;
+
+		/** Avoidance scratch for this enemy (overwritten each call, kept for its capacity) */
+		TArray<AvoidanceSystem::FAvoidanceRisk> AvoidanceRisks;
+
+		void Reset()
+		{
+			SlotOps.Reset();
+			bPathRequested = false;
+		}
+	};
+
+	/** Indexed like the enemy squad; element i is only touched by enemy i's task */
+	TArray<FPendingOps> PendingOps;
+
+	/** Per-batch event buffers for the parallel update (kept across frames) */
+	TArray<FFrameEvents> BatchEvents;
+
+	void QueueSlotRelease(int32 EnemyIndex, int32 TargetIndex, int32 SlotIndex);
+
+	/** Predict the claim against frame-start slots and queue the real one */
+	int32 QueueSlotClaim(int32 EnemyIndex, const FUnit& Enemy, const FUnit& Target, int32 TargetIndex);
+
+	/** Apply every queued slot op and path search in enemy index order */
+	void CommitPendingOps(FSimulatorCore& Sim, TArray<FUnit>& Enemies, TArray<FUnit>& Friendlies);
+
 	// ════════════════════════════════════════════════════════════════════════
 	// Targeting
 	// ════════════════════════════════════════════════════════════════════════
@@ -41,16 +98,21 @@ private:
 		FUnit& Enemy,
 		int32 EnemyIndex,
 		TArray<FUnit>& LivingFriendlies,
+		const FUnitHotStreams& FriendlyStreams,
 		TArray<FTower>& FriendlyTowers);
 
 	int32 SelectBestTarget(
 		const FUnit& Enemy,
-		const TArray<FUnit>& Candidates);
+		const TArray<FUnit>& Candidates,
+		const FUnitHotStreams& CandidateStreams);
 
 	float EvaluateTargetScore(
 		const FUnit& Enemy,
 		const FUnit& Candidate);
 
+	/** Score penalty for attackers already occupying the candidate's slots */
+	static float GetCrowdPenalty(const FUnit& Candidate);
+
 	// ════════════════════════════════════════════════════════════════════════
 	// Movement & Combat
 	// ════════════════════════════════════════════════════════════════════════
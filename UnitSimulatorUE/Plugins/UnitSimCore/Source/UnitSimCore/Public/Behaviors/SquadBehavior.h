@@ -2,12 +2,16 @@
 
 #include "CoreMinimal.h"
 #include "GameConstants.h"
+#include "Units/UnitHandle.h"
+#include "Combat/AvoidanceSystem.h"
 
 // Forward declarations
 struct FUnit;
 struct FTower;
 struct FFrameEvents;
 class FSimulatorCore;
+class FUnitHotStreams;
+class FUnitIdIndex;
 
 /**
  * Friendly squad behavior: formation movement, combat targeting, tower assault.
@@ -34,13 +38,23 @@ public:
 		const FVector2D& MainTarget,
 		FFrameEvents& Events);
 
+	/** Re-point the squad target after enemy slots have moved */
+	void RebindSquadTarget(const FUnitIdIndex& EnemyIds, const TArray<FUnit>& Enemies);
+
+	/** Binary round trip of the squad target and rally point (simulator snapshots) */
+	void Serialize(FArchive& Ar);
+
 private:
-	/** Current squad target index (-1 = none) */
-	int32 SquadTargetIndex = -1;
+	/** Current squad target in the enemy squad (unset = none) */
+	FUnitHandle SquadTarget;
 
 	/** Rally point for formation movement */
 	FVector2D RallyPoint = FVector2D::ZeroVector;
 
+	// Per-frame scratch, not state: reset before use so steady-state frames reuse their capacity
+	TSet<int32> EngagedUnitIndices;
+	TArray<AvoidanceSystem::FAvoidanceRisk> AvoidanceRisks;
+
 	/** Formation offsets for followers relative to leader */
 	static const TArray<FVector2D>& GetFormationOffsets();
 
@@ -50,7 +64,8 @@ private:
 
 	void UpdateSquadTargetAndRallyPoint(
 		TArray<FUnit>& Friendlies,
-		TArray<FUnit>& LivingEnemies);
+		TArray<FUnit>& LivingEnemies,
+		const FUnitHotStreams& EnemyStreams);
 
 	// ════════════════════════════════════════════════════════════════════════
 	// Formation
@@ -65,13 +80,15 @@ private:
 	// Engagement Detection
 	// ════════════════════════════════════════════════════════════════════════
 
-	TSet<int32> DetermineEngagedUnits(
+	/** Replaces OutEngaged with the indices of friendlies ready to engage */
+	void DetermineEngagedUnits(
 		TArray<FUnit>& Friendlies,
-		TArray<FUnit>& LivingEnemies);
+		const FUnitHotStreams& EnemyStreams,
+		TSet<int32>& OutEngaged);
 
 	bool IsUnitReadyToEngage(
 		const FUnit& Friendly,
-		const TArray<FUnit>& LivingEnemies);
+		const FUnitHotStreams& EnemyStreams);
 
 	// ════════════════════════════════════════════════════════════════════════
 	// Combat
@@ -89,6 +106,7 @@ private:
 		FUnit& Friendly,
 		int32 FriendlyIndex,
 		TArray<FUnit>& LivingEnemies,
+		const FUnitHotStreams& EnemyStreams,
 		TArray<FTower>& EnemyTowers);
 
 	void UpdateCombat(
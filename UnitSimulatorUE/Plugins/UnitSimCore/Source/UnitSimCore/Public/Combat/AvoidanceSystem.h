@@ -4,6 +4,7 @@
 #include "GameConstants.h"
 
 struct FUnit;
+class FUnitHotStreams;
 
 /**
  * Predictive collision avoidance system.
@@ -24,30 +25,33 @@ namespace AvoidanceSystem
 	/**
 	 * Compute predictive avoidance vector for a mover.
 	 * @param Mover             The unit being steered
-	 * @param MoverIndex        Index of the mover in the units array
-	 * @param Others            All units array
-	 * @param OtherCount        Number of units
+	 * @param MoverIndex        Index of the mover in the Others streams
+	 * @param Others            Hot streams of the mover's squad
 	 * @param DesiredDirection   Desired movement direction
 	 * @param OutAvoidanceTarget World-space avoidance waypoint
 	 * @param bOutIsDetouring   Whether the unit is detouring
 	 * @param OutThreatIndex    Index of primary avoidance threat (-1 = none)
+	 * @param Risks             Caller-owned scratch for the risks found (overwritten; reused across calls)
+	 * @param OutRisksEvaluated If set, receives how many neighbours were tested for risk
 	 * @return Weighted avoidance direction
 	 */
 	UNITSIMCORE_API FVector2D PredictiveAvoidanceVector(
 		FUnit& Mover,
 		int32 MoverIndex,
-		const FUnit* Others,
-		int32 OtherCount,
+		const FUnitHotStreams& Others,
 		const FVector2D& DesiredDirection,
 		FVector2D& OutAvoidanceTarget,
 		bool& bOutIsDetouring,
-		int32& OutThreatIndex);
+		int32& OutThreatIndex,
+		TArray<FAvoidanceRisk>& Risks,
+		int32* OutRisksEvaluated = nullptr);
 
-	/** Build segmented avoidance waypoint path */
-	TArray<FVector2D> BuildSegmentedAvoidancePath(
+	/** Build segmented avoidance waypoint path into OutPath (replacing its contents) */
+	void BuildSegmentedAvoidancePath(
 		const FUnit& Mover,
 		const FVector2D& BaseDir,
-		const FAvoidanceRisk& PrimaryRisk);
+		const FAvoidanceRisk& PrimaryRisk,
+		TArray<FVector2D>& OutPath);
 
 	/** Check if a direction is clear of all risks */
 	bool IsDirectionClear(
@@ -66,4 +70,15 @@ namespace AvoidanceSystem
 		const FUnit& B,
 		float& OutT,
 		float& OutDistance);
+
+	/** Try get first collision time from raw kinematics */
+	bool TryGetFirstCollision(
+		const FVector2D& PositionA,
+		const FVector2D& VelocityA,
+		float RadiusA,
+		const FVector2D& PositionB,
+		const FVector2D& VelocityB,
+		float RadiusB,
+		float& OutT,
+		float& OutDistance);
 }
@@ -39,15 +39,15 @@ public:
 
 	/**
 	 * Create spawn requests for a dead unit's DeathSpawn ability.
-	 * @return Spawn requests to process
+	 * @param OutSpawns  Replaced with the spawn requests to process
 	 */
-	TArray<FUnitSpawnRequest> CreateDeathSpawnRequests(const FUnit& DeadUnit);
+	void CreateDeathSpawnRequests(const FUnit& DeadUnit, TArray<FUnitSpawnRequest>& OutSpawns);
 
 	/**
 	 * Apply death damage from a dead unit to nearby enemies.
-	 * @return Indices of units newly killed by death damage
+	 * @param OutNewlyDead  Replaced with the indices of units newly killed by death damage
 	 */
-	TArray<int32> ApplyDeathDamage(const FUnit& DeadUnit, TArray<FUnit>& Enemies);
+	void ApplyDeathDamage(const FUnit& DeadUnit, TArray<FUnit>& Enemies, TArray<int32>& OutNewlyDead);
 
 	// ════════════════════════════════════════════════════════════════════════
 	// Charge State
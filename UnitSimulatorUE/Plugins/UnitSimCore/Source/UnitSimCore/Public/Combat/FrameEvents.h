@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameConstants.h"
+#include "Units/UnitHandle.h"
 #include "FrameEvents.generated.h"
 
 /** Damage type enum */
@@ -29,6 +30,14 @@ struct UNITSIMCORE_API FSimDamageEvent
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 TargetIndex = -1;
 
+	/** Id of the target unit when the event was collected; skipped if the slot changed hands */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 TargetId = -1;
+
+	/** Squad that TargetIndex refers to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EUnitFaction TargetFaction = EUnitFaction::Enemy;
+
 	/** Damage amount */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 Amount = 0;
@@ -52,6 +61,14 @@ struct UNITSIMCORE_API FTowerDamageEvent
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 TargetIndex = -1;
 
+	/** Id of the target unit when the event was collected; skipped if the slot changed hands */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 TargetId = -1;
+
+	/** Squad that TargetIndex refers to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EUnitFaction TargetFaction = EUnitFaction::Enemy;
+
 	/** Damage amount */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 Amount = 0;
@@ -117,10 +134,16 @@ struct UNITSIMCORE_API FFrameEvents
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<FDamageToTowerEvent> DamageToTowers;
 
-	void AddDamage(int32 SourceIndex, int32 TargetIndex, int32 Amount, EDamageType Type = EDamageType::Normal);
+	void AddDamage(int32 SourceIndex, EUnitFaction TargetFaction, const FUnitHandle& Target, int32 Amount,
+		EDamageType Type = EDamageType::Normal);
 	void AddSpawn(const FUnitSpawnRequest& Spawn);
-	void AddTowerDamage(int32 SourceTowerIndex, int32 TargetIndex, int32 Amount);
+	void AddTowerDamage(int32 SourceTowerIndex, EUnitFaction TargetFaction, const FUnitHandle& Target, int32 Amount);
 	void AddDamageToTower(int32 SourceIndex, int32 TargetTowerIndex, int32 Amount);
+
+	/** Append every event of Other after this buffer's events, preserving order */
+	void Append(const FFrameEvents& Other);
+
+	/** Drop all events, keeping the arrays' capacity for the next frame */
 	void Clear();
 
 	int32 GetDamageCount() const { return Damages.Num(); }
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FUnit;
+
+/**
+ * Uniform grid broadphase over a flat list of units.
+ * Units are bucketed by cell with one partition per EMovementLayer, so a
+ * neighbourhood query only returns units that can physically collide.
+ * Within a cell, entries keep ascending unit index order.
+ */
+class UNITSIMCORE_API FUnitSpatialGrid
+{
+public:
+	/**
+	 * Bucket units by their current position.
+	 * @param Units       Units to index (indices into this array are used by queries)
+	 * @param InCellSize  Cell edge length; must cover the largest query distance plus 2x slack
+	 * @param InSlack     Distance a unit may drift from its bucketed position before HasDrifted reports it
+	 */
+	void Build(const TArray<FUnit*>& Units, double InCellSize, double InSlack);
+
+	/**
+	 * Collect indices greater than MinIndex of units in the 3x3 cell neighbourhood
+	 * of Index (same layer only), sorted ascending.
+	 */
+	void GatherNeighbors(int32 Index, int32 MinIndex, TArray<int32>& OutIndices) const;
+
+	/** True when the unit has moved further than the slack since the last Build */
+	bool HasDrifted(int32 Index, const FVector2D& Position) const;
+
+	double GetCellSize() const { return CellSize; }
+	int32 GetUnitCount() const { return UnitCells.Num(); }
+
+private:
+	static constexpr int32 NumLayers = 2;
+	static constexpr int32 MaxCellsPerAxis = 1024;
+
+	double CellSize = 1.0;
+	double SlackSquared = 0.0;
+	FVector2D Origin = FVector2D::ZeroVector;
+	int32 CellsX = 0;
+	int32 CellsY = 0;
+
+	/** Prefix offsets into CellEntries, one per cell plus terminator */
+	TArray<int32> CellStart;
+	/** Unit indices grouped by cell, ascending within a cell */
+	TArray<int32> CellEntries;
+	/** Flat cell index of each unit at build time */
+	TArray<int32> UnitCells;
+	/** Unit positions at build time */
+	TArray<FVector2D> BuildPositions;
+	/** Scratch write offsets used while filling CellEntries */
+	TArray<int32> CellCursor;
+
+	int32 GetCellIndex(int32 Layer, int32 X, int32 Y) const { return (Layer * CellsY + Y) * CellsX + X; }
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/TVariant.h"
+#include "Commands/SimulationCommands.h"
+
+/**
+ * Command type enum; values are the payload's variant index.
+ */
+enum class ESimCommandType : uint8
+{
+	Spawn,
+	Move,
+	Damage,
+	Kill,
+	Revive,
+	SetHealth,
+	Remove
+};
+
+/**
+ * Value-typed simulation command: exactly one of the command structs, sized
+ * to the largest of them. Copied into the simulator's command ring, so
+ * enqueuing never allocates.
+ */
+struct UNITSIMCORE_API FSimCommand
+{
+	using FPayload = TVariant<
+		FSpawnUnitCommand,
+		FMoveUnitCommand,
+		FDamageUnitCommand,
+		FKillUnitCommand,
+		FReviveUnitCommand,
+		FSetUnitHealthCommand,
+		FRemoveUnitCommand>;
+
+	FPayload Payload;
+
+	ESimCommandType GetType() const { return static_cast<ESimCommandType>(Payload.GetIndex()); }
+
+	/** Frame at whose start the command runs */
+	int32 GetFrameNumber() const;
+
+	/** The active command (T must match GetType) */
+	template <typename T>
+	const T& Get() const { return Payload.Get<T>(); }
+
+	/** Binary round trip of the type and the active command (snapshots, replays) */
+	void Serialize(FArchive& Ar);
+
+	static FSimCommand MakeSpawn(const FSpawnUnitCommand& Cmd) { return Make(Cmd); }
+	static FSimCommand MakeMove(const FMoveUnitCommand& Cmd) { return Make(Cmd); }
+	static FSimCommand MakeDamage(const FDamageUnitCommand& Cmd) { return Make(Cmd); }
+	static FSimCommand MakeKill(const FKillUnitCommand& Cmd) { return Make(Cmd); }
+	static FSimCommand MakeRevive(const FReviveUnitCommand& Cmd) { return Make(Cmd); }
+	static FSimCommand MakeSetHealth(const FSetUnitHealthCommand& Cmd) { return Make(Cmd); }
+	static FSimCommand MakeRemove(const FRemoveUnitCommand& Cmd) { return Make(Cmd); }
+
+private:
+	template <typename T>
+	static FSimCommand Make(const T& Cmd)
+	{
+		FSimCommand Command;
+		Command.Payload.Set<T>(Cmd);
+		return Command;
+	}
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameConstants.h"
+#include "Commands/SimCommand.h"
+#include <atomic>
+
+/**
+ * Bounded lock-free multi-producer / single-consumer ring of FSimCommand.
+ *
+ * Any thread may Push or PushBulk; only the owning simulation thread Pops.
+ * Each cell carries a sequence number that tells producers whether it is free
+ * for their lap and the consumer whether it has been published. Commands come
+ * out in the order their slots were claimed; a bulk push claims its slots in
+ * one step, so its commands stay contiguous. Storage is allocated once.
+ */
+class UNITSIMCORE_API FSimCommandRing
+{
+public:
+	/** Capacity is rounded up to a power of two */
+	explicit FSimCommandRing(int32 InCapacity = UnitSimConstants::COMMAND_RING_CAPACITY);
+
+	FSimCommandRing(const FSimCommandRing&) = delete;
+	FSimCommandRing& operator=(const FSimCommandRing&) = delete;
+
+	/** Any thread. Returns false if the ring is full. */
+	bool Push(const FSimCommand& Command);
+
+	/** Any thread. All or nothing: returns false if the commands don't fit right now (or ever). */
+	bool PushBulk(TConstArrayView<FSimCommand> Commands);
+
+	/** Consumer only. Returns false if the next command is not published yet. */
+	bool Pop(FSimCommand& OutCommand);
+
+	int32 GetCapacity() const { return static_cast<int32>(Mask + 1); }
+
+private:
+	struct FCell
+	{
+		std::atomic<uint64> Sequence{0};
+		FSimCommand Command;
+	};
+
+	TUniquePtr<FCell[]> Cells;
+	uint64 Mask = 0;
+
+	// Producers and the consumer each own a cache line
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos{0};
+	alignas(PLATFORM_CACHE_LINE_SIZE) uint64 DequeuePos = 0;
+
+	/** Claim Count consecutive slots starting at OutPos. Returns false if they are not all free. */
+	bool Claim(uint64 Count, uint64& OutPos);
+};
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Commands/ISimulationCommand.h"
 #include "GameConstants.h"
 #include "SimulationCommands.generated.h"
 
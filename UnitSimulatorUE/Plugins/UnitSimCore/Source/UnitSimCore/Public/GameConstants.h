@@ -168,6 +168,28 @@ namespace UnitSimConstants
 	// Wave settings
 	constexpr int32 MAX_WAVES = 3;
 
+	// Squad slot pooling
+	constexpr int32 SQUAD_COMPACTION_MIN_DEAD = 32; // Compact once dead slots reach max(this, living count)
+
+	// Parallel Phase 1
+	constexpr int32 PHASE1_PARALLEL_BATCH_SIZE = 64; // Units (or towers) per ParallelFor task; batches own one FFrameEvents each
+
+	// Rollback
+	constexpr int32 ROLLBACK_MAX_FRAMES = 8; // Snapshots kept; commands later than this are applied at the oldest one
+
+	// Frame delta stream
+	constexpr int32 FRAME_DELTA_KEYFRAME_INTERVAL = 30; // One self-contained frame per second at 30 Hz
+	constexpr double FRAME_DELTA_VECTOR_STEP = 1.0 / 256.0; // Quantum for vector fields on the wire (0 = exact doubles)
+
+	// Replay recording
+	constexpr int32 REPLAY_KEYFRAME_INTERVAL = 300; // Full snapshot every 10 s at 30 Hz; seeks re-simulate at most this many frames
+
+	// Command queue
+	constexpr int32 COMMAND_RING_CAPACITY = 1024; // Commands in flight between two steps (power of two); also the largest bulk enqueue
+
+	// Step profiler
+	constexpr int32 PROFILER_HISTORY_FRAMES = 300; // Per-phase breakdowns kept for headless readback (10 s at 30 Hz)
+
 	// Targeting settings (enemy)
 	constexpr int32 TARGET_REEVALUATE_INTERVAL_FRAMES = 45;
 	constexpr float TARGET_SWITCH_MARGIN = 15.f;
@@ -198,6 +220,23 @@ namespace UnitSimConstants
 	constexpr int32 DYNAMIC_OBSTACLE_DENSITY_THRESHOLD = 3;
 	constexpr int32 DYNAMIC_OBSTACLE_UPDATE_INTERVAL = 15;
 
+	// Flow Field Settings
+	constexpr float FLOW_FIELD_GOAL_TOLERANCE = 1.f;      // Destination this close to a registered goal uses its field
+	constexpr float FLOW_FIELD_GOAL_SEED_RADIUS = 200.f;  // Blocked goal (tower, river): seed its obstacle cells this far out
+
+	// Hierarchical Pathfinding Settings
+	constexpr int32 HPA_CLUSTER_SIZE = 16;                // Cells per cluster side (160x255 grid -> 10x16 clusters)
+	constexpr int32 HPA_ENTRANCE_SPLIT_LENGTH = 6;        // Open border runs this long get a transition at each end
+	constexpr float HPA_MIN_QUERY_DISTANCE = 640.f;       // Shorter queries (two clusters) stay on flat A*
+	constexpr double HPA_QUERY_BUDGET_US = 250.0;         // p95 time of a query at least HPA_MIN_QUERY_DISTANCE long
+
+	// Path Cache Settings
+	constexpr int32 PATH_CACHE_CAPACITY = 256;            // Paths kept (least recently used evicted first)
+
+	// Path Request Settings
+	constexpr int32 PATH_REQUEST_BUDGET = 24;             // Searches started per frame; less urgent requests retry next frame
+	constexpr int32 PATH_REQUEST_MAX_WORKERS = 4;         // Worker tasks sharing one frame's A* searches (HPA* gets its own)
+
 	// Phase 4: Path Smoothing Settings
 	constexpr bool PATH_SMOOTHING_ENABLED = true;
 	constexpr int32 PATH_SMOOTHING_MAX_SKIP = 10;
@@ -208,4 +247,5 @@ namespace UnitSimConstants
 	// Phase 6: Collision Resolution Settings (Body Blocking)
 	constexpr int32 COLLISION_RESOLUTION_ITERATIONS = 3;
 	constexpr float COLLISION_PUSH_STRENGTH = 0.8f;
+	constexpr float COLLISION_BROADPHASE_SLACK_RATIO = 0.5f; // Drift allowed (x max radius) before rebucketing
 }
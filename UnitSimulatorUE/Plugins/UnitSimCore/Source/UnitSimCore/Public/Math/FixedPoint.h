@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Q16.16 fixed-point scalar.
+ * Range +-32767 with 1/65536 resolution: the 3200 x 5100 map fits with room
+ * for squared lengths to be taken in 64-bit intermediates. All operations are
+ * integer-only, so results are bit-identical on every compiler and CPU.
+ */
+struct UNITSIMCORE_API FFixed
+{
+	static constexpr int32 FracBits = 16;
+	static constexpr int32 One = 1 << FracBits;
+
+	int32 Raw = 0;
+
+	static constexpr FFixed FromRaw(int32 InRaw) { FFixed F; F.Raw = InRaw; return F; }
+	static constexpr FFixed FromInt(int32 V) { return FromRaw(V * One); }
+
+	/**
+	 * Round to the nearest representable value (floor(x + 0.5) is exact in IEEE double).
+	 * Values beyond the range saturate at its ends instead of overflowing the cast.
+	 */
+	static FFixed FromDouble(double V)
+	{
+		const double Scaled = FMath::Clamp(FMath::FloorToDouble(V * One + 0.5),
+			static_cast<double>(MIN_int32), static_cast<double>(MAX_int32));
+		return FromRaw(static_cast<int32>(Scaled));
+	}
+
+	/** Exact: every Q16.16 value is representable as a double */
+	double ToDouble() const { return static_cast<double>(Raw) / One; }
+
+	FFixed operator+(FFixed B) const { return FromRaw(Raw + B.Raw); }
+	FFixed operator-(FFixed B) const { return FromRaw(Raw - B.Raw); }
+	FFixed operator-() const { return FromRaw(-Raw); }
+	FFixed operator*(FFixed B) const { return FromRaw(static_cast<int32>((static_cast<int64>(Raw) * B.Raw) >> FracBits)); }
+	FFixed operator/(FFixed B) const { return FromRaw(static_cast<int32>((static_cast<int64>(Raw) << FracBits) / B.Raw)); }
+
+	FFixed& operator+=(FFixed B) { Raw += B.Raw; return *this; }
+	FFixed& operator-=(FFixed B) { Raw -= B.Raw; return *this; }
+
+	bool operator==(FFixed B) const { return Raw == B.Raw; }
+	bool operator!=(FFixed B) const { return Raw != B.Raw; }
+	bool operator<(FFixed B) const { return Raw < B.Raw; }
+	bool operator<=(FFixed B) const { return Raw <= B.Raw; }
+	bool operator>(FFixed B) const { return Raw > B.Raw; }
+	bool operator>=(FFixed B) const { return Raw >= B.Raw; }
+};
+
+/**
+ * Integer-only math on FFixed.
+ * Trig uses 257-entry tables (quarter-wave sine, atan on [0, 1]) with linear
+ * interpolation; max error is about 3e-5 for Sin/Cos and 6e-5 rad for Atan2.
+ */
+namespace FixedMath
+{
+	constexpr FFixed Pi = FFixed::FromRaw(205887);
+	constexpr FFixed HalfPi = FFixed::FromRaw(102944);
+	constexpr FFixed TwoPi = FFixed::FromRaw(411775);
+
+	UNITSIMCORE_API FFixed Sqrt(FFixed V);
+	UNITSIMCORE_API FFixed Sin(FFixed Angle);
+	UNITSIMCORE_API FFixed Cos(FFixed Angle);
+	UNITSIMCORE_API FFixed Atan2(FFixed Y, FFixed X);
+
+	/** Length of (X, Y); squares are summed in 64 bits so map-sized vectors don't overflow */
+	UNITSIMCORE_API FFixed Length(FFixed X, FFixed Y);
+
+	/** Scale (X, Y) to unit length; zero vectors stay zero */
+	UNITSIMCORE_API void Normalize(FFixed& X, FFixed& Y);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/FixedPoint.h"
+
+// Set from UnitSimCore.Build.cs (bUseFixedPointMath)
+#ifndef UNITSIM_FIXED_POINT
+#define UNITSIM_FIXED_POINT 0
+#endif
+
+/**
+ * Simulation math backend.
+ *
+ * Trig and vector lengths in the simulation go through here. The default build
+ * forwards to FMath. With UNITSIM_FIXED_POINT=1 they run on FFixed (Q16.16,
+ * table trig) and their results, plus unit kinematics via Quantize, are
+ * snapped to the Q16.16 grid. Positions then stay exact Q16.16 values carried
+ * in doubles. libm trig, whose results differ between compilers and CPUs, is
+ * never used; the remaining double ops (+, -, *, /) are correctly rounded IEEE
+ * and agree everywhere, so two machines stepping the same commands stay
+ * bit-identical.
+ */
+namespace SimMath
+{
+#if UNITSIM_FIXED_POINT
+	inline double Quantize(double V) { return FFixed::FromDouble(V).ToDouble(); }
+	inline FVector2D Quantize(const FVector2D& V) { return FVector2D(Quantize(V.X), Quantize(V.Y)); }
+
+	inline double Sin(double Angle) { return FixedMath::Sin(FFixed::FromDouble(Angle)).ToDouble(); }
+	inline double Cos(double Angle) { return FixedMath::Cos(FFixed::FromDouble(Angle)).ToDouble(); }
+	inline float Sin(float Angle) { return static_cast<float>(Sin(static_cast<double>(Angle))); }
+	inline float Cos(float Angle) { return static_cast<float>(Cos(static_cast<double>(Angle))); }
+	inline double Atan2(double Y, double X) { return FixedMath::Atan2(FFixed::FromDouble(Y), FFixed::FromDouble(X)).ToDouble(); }
+
+	inline double Length(const FVector2D& V)
+	{
+		return FixedMath::Length(FFixed::FromDouble(V.X), FFixed::FromDouble(V.Y)).ToDouble();
+	}
+
+	/** V scaled to unit length, or zero when its squared length is below MinLengthSquared */
+	inline FVector2D SafeNormal(const FVector2D& V, double MinLengthSquared)
+	{
+		if (V.SizeSquared() < MinLengthSquared) return FVector2D::ZeroVector;
+		FFixed X = FFixed::FromDouble(V.X);
+		FFixed Y = FFixed::FromDouble(V.Y);
+		FixedMath::Normalize(X, Y);
+		return FVector2D(X.ToDouble(), Y.ToDouble());
+	}
+#else
+	inline double Quantize(double V) { return V; }
+	inline FVector2D Quantize(const FVector2D& V) { return V; }
+
+	inline double Sin(double Angle) { return FMath::Sin(Angle); }
+	inline double Cos(double Angle) { return FMath::Cos(Angle); }
+	inline float Sin(float Angle) { return FMath::Sin(Angle); }
+	inline float Cos(float Angle) { return FMath::Cos(Angle); }
+	inline double Atan2(double Y, double X) { return FMath::Atan2(Y, X); }
+
+	inline double Length(const FVector2D& V) { return V.Size(); }
+
+	/** V scaled to unit length, or zero when its squared length is below MinLengthSquared */
+	inline FVector2D SafeNormal(const FVector2D& V, double MinLengthSquared)
+	{
+		const float LenSq = V.SizeSquared();
+		if (LenSq < MinLengthSquared) return FVector2D::ZeroVector;
+		return V / FMath::Sqrt(LenSq);
+	}
+#endif
+
+	inline double Distance(const FVector2D& A, const FVector2D& B) { return Length(B - A); }
+}
@@ -5,11 +5,26 @@
 class FPathfindingGrid;
 struct FPathNode;
 
+/** Search FAStarPathfinder::FindPath runs; both return paths of the same (optimal) cost */
+enum class EPathSearchMode : uint8
+{
+	AStar,       // Every neighbor of every expanded node
+	JumpPoint    // Jump Point Search: straight and diagonal runs skipped to the next jump point
+};
+
 /**
  * A* pathfinder with diagonal movement.
  * Diagonal cost = 14, straight cost = 10.
  * Prevents corner cutting through unwalkable tiles.
  * Ported from Pathfinding/AStarPathfinder.cs (131 lines)
+ *
+ * The open list is an indexed binary heap ordered by (F, H, insertion order),
+ * which expands nodes in exactly the order of the original linear scan. Search
+ * state, closed flags included, lives in the pathfinder, stamped with a
+ * per-query generation, so a query touches only the nodes it visits; nothing
+ * is cleared between queries and the grid's node costs are unused.
+ *
+ * SetSearchMode(JumpPoint) runs Jump Point Search over the same heap and state.
  */
 class UNITSIMCORE_API FAStarPathfinder
 {
@@ -22,18 +37,92 @@ public:
 	 */
 	bool FindPath(const FVector2D& StartWorldPos, const FVector2D& EndWorldPos, TArray<FVector2D>& OutPath);
 
+	/**
+	 * Jump Point Search expands far fewer nodes on open ground. It keeps the same
+	 * no-corner-cutting rule and octile costs, and its paths are still cell by cell,
+	 * so only ties between equally short paths can differ from plain A*.
+	 */
+	EPathSearchMode GetSearchMode() const { return SearchMode; }
+	void SetSearchMode(EPathSearchMode Mode) { SearchMode = Mode; }
+
+	/** Work done since the last ResetStats (harvested by the simulator's profiler each step) */
+	struct FStats
+	{
+		int32 Searches = 0;
+		int32 NodesExpanded = 0;
+	};
+
+	const FStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FStats(); }
+
 private:
+	/** One of the eight moves, in the order neighbors are expanded */
+	struct FNeighborStep
+	{
+		int32 DX = 0;
+		int32 DY = 0;
+		int32 Offset = 0;    // Flat-index delta
+		int32 Cost = 0;      // 10 straight, 14 diagonal
+	};
+
+	/** Per-node search state; stale unless Generation matches the current query */
+	struct FSearchNode
+	{
+		int32 GCost = 0;
+		int32 HCost = 0;
+		int32 CameFrom = INDEX_NONE;
+		int32 HeapIndex = INDEX_NONE;
+		uint32 Sequence = 0;     // Open-list insertion order, the last tie-breaker
+		uint32 Generation = 0;
+		bool bClosed = false;
+	};
+
 	FPathfindingGrid& Grid;
+	FStats Stats;
+	EPathSearchMode SearchMode = EPathSearchMode::AStar;
+
+	// Sized to the grid on first use and kept across queries
+	TArray<FSearchNode> SearchNodes;
+	TArray<int32> OpenHeap;
+	FNeighborStep NeighborSteps[8];
+	int32 PreparedWidth = 0;
+	int32 PreparedHeight = 0;
+	uint32 SearchGeneration = 0;
+	uint32 NextSequence = 0;
 
-	/** Retrace path from end to start using CameFromNodeIndex chain */
+	/** Size the search state and neighbor offsets to the grid, and start a new generation */
+	void BeginSearch();
+
+	/** Node's search state for this query (initialized on first touch) */
+	FSearchNode& Touch(int32 NodeIndex);
+
+	/** Node was expanded this query (false for nodes this query has not touched) */
+	bool IsClosed(int32 NodeIndex) const
+	{
+		const FSearchNode& Node = SearchNodes[NodeIndex];
+		return Node.Generation == SearchGeneration && Node.bClosed;
+	}
+
+	bool HeapLess(int32 A, int32 B) const;
+	void HeapPush(int32 NodeIndex);
+	int32 HeapPop();
+	void HeapSiftUp(int32 HeapPos);
+	void HeapSiftDown(int32 HeapPos);
+
+	/** Jump Point Search body of FindPath, after the endpoints are checked and the search begun */
+	bool FindPathJumpPoint(int32 StartIndex, int32 EndIndex, TArray<FVector2D>& OutPath);
+
+	/** Next jump point from (X, Y) moving (DX, DY), or INDEX_NONE */
+	int32 Jump(int32 X, int32 Y, int32 DX, int32 DY, int32 EndIndex) const;
+
+	bool IsWalkable(int32 X, int32 Y) const;
+
+	/** Retrace a jump-point chain, filling in every cell along each straight or diagonal run */
+	void RetraceJumpPath(int32 StartNodeIndex, int32 EndNodeIndex, TArray<FVector2D>& OutPath);
+
+	/** Retrace path from end to start using the CameFrom chain */
 	void RetracePath(int32 StartNodeIndex, int32 EndNodeIndex, TArray<FVector2D>& OutPath);
 
 	/** Calculate distance cost between two nodes (10/14 diagonal) */
 	static int32 CalculateDistanceCost(const FPathNode& A, const FPathNode& B);
-
-	/** Get valid neighbor nodes (including diagonals with corner-cut prevention) */
-	void GetNeighbors(const FPathNode& Node, TArray<int32>& OutNeighborIndices);
-
-	/** Convert grid coords to flat index */
-	int32 ToFlatIndex(int32 X, int32 Y) const;
 };
@@ -23,19 +23,40 @@ public:
 	 */
 	void UpdateDynamicObstacles(const FUnit* Units, int32 UnitCount);
 
+	/** Same as above over two unit arrays in order, without concatenating them */
+	void UpdateDynamicObstacles(TConstArrayView<FUnit> First, TConstArrayView<FUnit> Second);
+
 	/** Clear all dynamic blocks, restoring non-static nodes to walkable */
 	void ClearDynamicBlocks();
 
+	/** Forget dynamic and recorded static blocks (the grid's static obstacles are about to be re-applied) */
+	void Reset();
+
+	/**
+	 * Binary round trip of the dynamic block set (simulator snapshots).
+	 * Loading swaps the current dynamic blocks on the grid for the saved ones;
+	 * the grid must already carry the static obstacles of the saved match.
+	 */
+	void Serialize(FArchive& Ar);
+
 	/** Number of currently blocked dynamic nodes */
 	int32 GetDynamicBlockCount() const { return DynamicBlockedNodes.Num(); }
 
+	/** Cells the last UpdateDynamicObstacles blocked or unblocked, in row-major order (for incremental repairs) */
+	TConstArrayView<FIntPoint> GetLastChangedCells() const { return LastChangedCells; }
+
 private:
 	FPathfindingGrid& Grid;
 
 	TSet<FIntPoint> DynamicBlockedNodes;
 	TSet<FIntPoint> StaticBlockedNodes;
+	TArray<FIntPoint> LastChangedCells;
 	bool bStaticBlocksRecorded = false;
 
+	// Update scratch, kept across updates for its capacity
+	TMap<FIntPoint, int32> CellCounts;
+	TSet<FIntPoint> NewBlockedNodes;
+
 	/** Record current unwalkable nodes as static (one-time) */
 	void RecordStaticBlocks();
 };
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+
+class FPathfindingGrid;
+
+/**
+ * Cached flow fields toward a few shared goals (towers, bridge centers, main target).
+ *
+ * Each goal keeps an integration field (cost to the goal, 10 straight / 14 diagonal,
+ * no corner cutting, as in FAStarPathfinder) and a direction field (the neighbor to
+ * step to). A field is built on first use and rebuilt only when the grid's
+ * walkability version has moved since; after that a direction is a lookup and a
+ * path is a walk down the field, whatever the number of units asking.
+ *
+ * A goal on a blocked cell (a tower footprint, the river) is reached at the edge of
+ * its obstacle: the blocked cells connected to it within FLOW_FIELD_GOAL_SEED_RADIUS
+ * all count as the goal.
+ *
+ * When only a known set of cells changed (the dynamic obstacle update), RepairFields
+ * fixes the built fields in place, LPA* style: the changed cells and their neighbors
+ * are re-evaluated and only cells whose cost moves are expanded. A repaired field is
+ * identical to a rebuilt one (directions are a function of the final costs), so a
+ * simulation restored with cold fields follows the same paths.
+ */
+class UNITSIMCORE_API FFlowFieldService
+{
+public:
+	explicit FFlowFieldService(FPathfindingGrid& InGrid);
+
+	/** Register a goal (or return the one already at that position) */
+	int32 AddGoal(const FVector2D& Position);
+
+	/** Forget every goal and its fields */
+	void ClearGoals();
+
+	/** Goal within Tolerance of Position, or INDEX_NONE */
+	int32 FindGoal(const FVector2D& Position, float Tolerance) const;
+
+	int32 GetNumGoals() const { return Goals.Num(); }
+	FVector2D GetGoalPosition(int32 GoalId) const { return Goals[GoalId].Position; }
+
+	/** Build the goal's fields if the grid changed since they were last built */
+	void EnsureField(int32 GoalId);
+
+	/**
+	 * Bring fields built at FromVersion up to the grid's current walkability, given
+	 * every cell whose walkability changed since. Fields built at another version are
+	 * left to rebuild on next use.
+	 */
+	void RepairFields(TConstArrayView<FIntPoint> ChangedCells, uint32 FromVersion);
+
+	/**
+	 * Waypoints from Start down the goal's field, in FAStarPathfinder::FindPath's
+	 * form: start cell excluded, goal cell (or the last cell before a blocked goal)
+	 * included. False if Start is blocked or cannot reach the goal.
+	 */
+	bool FindPath(int32 GoalId, const FVector2D& Start, TArray<FVector2D>& OutPath);
+
+	/** Unit direction toward the goal from Position, zero at the goal or where unreachable */
+	FVector2D SampleDirection(int32 GoalId, const FVector2D& Position);
+
+	/** Integration cost from Position's cell to the goal, INDEX_NONE if unreachable */
+	int32 GetCost(int32 GoalId, const FVector2D& Position);
+
+	/** Work done since the last ResetStats (harvested by the simulator's profiler each step) */
+	struct FStats
+	{
+		int32 FieldBuilds = 0;
+		int32 FieldRepairs = 0;
+		int32 CellsRepaired = 0;     // Cells expanded by repairs (a build expands every reachable cell)
+		int32 PathsTraced = 0;
+	};
+
+	const FStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FStats(); }
+
+private:
+	static constexpr uint8 NoDirection = 0xFF;
+	static constexpr uint8 GoalDirection = 0xFE;
+
+	struct FGoal
+	{
+		FVector2D Position = FVector2D::ZeroVector;
+		TArray<int32> Cost;         // Integration field, MAX_int32 where unreachable
+		TArray<uint8> Direction;    // Index into NeighborSteps, GoalDirection on seeds, NoDirection unreachable
+		TArray<int32> Seeds;        // Cells at cost 0
+		uint32 BuiltVersion = 0;
+		bool bBuilt = false;
+	};
+
+	struct FNeighborStep
+	{
+		int32 DX = 0;
+		int32 DY = 0;
+		int32 Offset = 0;
+		int32 Cost = 0;
+	};
+
+	FPathfindingGrid& Grid;
+	FStats Stats;
+	TArray<FGoal> Goals;
+	FNeighborStep NeighborSteps[8];
+	int32 PreparedWidth = 0;
+
+	// Dijkstra / repair scratch, kept across builds
+	TArray<TPair<int32, int32>> OpenHeap;   // (Cost, Cell); (min(cost, rhs), Cell) while repairing
+	TMap<int32, int32> RepairRhs;           // One-step lookahead costs of cells a repair touched
+	TArray<int32> RepairDirty;              // Cells whose direction may have changed
+	TBitArray<> RepairDirtyFlags;
+	TArray<int32> RepairCells;              // Changed cells as grid indices
+	TArray<int32> RepairSeeds;
+	TArray<int32> RepairChanged;            // Changed cells plus seeds that came or went
+	TSet<int32> SeedVisited;                // Cells CollectSeeds reached (exactly its seeds)
+
+	void PrepareSteps();
+	void BuildField(FGoal& Goal);
+
+	/** The goal cell, plus the blocked cells flooded from it when it is blocked (also fills SeedVisited) */
+	void CollectSeeds(const FGoal& Goal, TArray<int32>& OutSeeds);
+
+	/** Repair a built field after ChangedCells toggled */
+	void RepairField(FGoal& Goal, TConstArrayView<int32> ChangedCells);
+
+	/** Whether the field integrates from From to its neighbor along NeighborSteps[StepIndex] */
+	bool CanStep(const FGoal& Goal, int32 From, int32 StepIndex) const;
+
+	/** Best cost through Cell's neighbors (0 on seeds) */
+	int32 ComputeRhs(const FGoal& Goal, int32 Cell) const;
+
+	/** Re-evaluate a cell during a repair; queue it when its cost is no longer consistent */
+	void UpdateRepairCell(FGoal& Goal, int32 Cell);
+
+	/** The step a build would have recorded for Cell, from the costs around it */
+	uint8 PickDirection(const FGoal& Goal, int32 Cell) const;
+
+	/** Queue Cell and its neighbors for PickDirection at the end of the repair */
+	void MarkDirectionsDirty(int32 Cell);
+
+	/** Cell index of Position, INDEX_NONE off the grid */
+	int32 CellIndex(const FVector2D& Position) const;
+};
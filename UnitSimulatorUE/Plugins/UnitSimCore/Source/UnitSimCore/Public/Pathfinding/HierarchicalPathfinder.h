@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+
+class FPathfindingGrid;
+
+/**
+ * Hierarchical A* (HPA*) over the pathfinding grid for long queries.
+ *
+ * The grid is cut into HPA_CLUSTER_SIZE square clusters. Each open run of cell
+ * pairs along a cluster border gets one or two transitions; their cells are the
+ * cluster's entrances, joined inside the cluster by edges costed with a search
+ * confined to it. A query links start and goal to the entrances of their own
+ * clusters, searches that small abstract graph, and refines only the clusters the
+ * abstract path passes through. Paths are near-optimal, not optimal.
+ *
+ * The graph follows the grid's walkability. When the grid's version moves, the
+ * changed cells are found against a copy of the last walkability seen and only
+ * their clusters (and neighbors whose shared border changed) are rebuilt.
+ */
+class UNITSIMCORE_API FHierarchicalPathfinder
+{
+public:
+	explicit FHierarchicalPathfinder(FPathfindingGrid& InGrid);
+
+	/**
+	 * Find a path from start to end world positions, in FAStarPathfinder::FindPath's
+	 * form: start cell excluded, end cell included.
+	 */
+	bool FindPath(const FVector2D& StartWorldPos, const FVector2D& EndWorldPos, TArray<FVector2D>& OutPath);
+
+	/** Bring the abstract graph up to date with the grid's walkability (FindPath does this first) */
+	void Refresh();
+
+	int32 GetNumClusters() const { return Clusters.Num(); }
+	int32 GetNumEntrances() const;
+
+	/** Work done since the last ResetStats (harvested by the simulator's profiler each step) */
+	struct FStats
+	{
+		int32 Searches = 0;
+		int32 AbstractNodesExpanded = 0;
+		int32 LocalNodesExpanded = 0;
+		int32 ClustersRebuilt = 0;
+	};
+
+	const FStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FStats(); }
+
+private:
+	struct FEntrance
+	{
+		int32 Cell = INDEX_NONE;
+		TArray<int32, TInlineAllocator<2>> Links;   // Entrance cells across the border, one straight step away
+	};
+
+	struct FCluster
+	{
+		int32 MinX = 0;
+		int32 MinY = 0;
+		int32 MaxX = 0;   // Exclusive
+		int32 MaxY = 0;   // Exclusive
+		TArray<FEntrance> Entrances;   // Sorted by cell
+		TArray<int32> IntraCosts;      // Entrances x Entrances, MAX_int32 where unconnected inside the cluster
+
+		int32 FindEntrance(int32 Cell) const;
+	};
+
+	/** Transition pairs (lower-side cell, upper-side cell) across one cluster border */
+	using FBorder = TArray<TPair<int32, int32>>;
+
+	struct FAbstractNode
+	{
+		int32 GCost = MAX_int32;
+		int32 Parent = INDEX_NONE;
+		bool bClosed = false;
+	};
+
+	/** Open-list entry; ordered by (F, H, Cell) so every search is fully deterministic */
+	struct FOpenEntry
+	{
+		int32 FCost = 0;
+		int32 HCost = 0;
+		int32 Index = 0;
+	};
+
+	FPathfindingGrid& Grid;
+	FStats Stats;
+
+	int32 ClusterSize = 0;
+	int32 ClustersX = 0;
+	int32 ClustersY = 0;
+	TArray<FCluster> Clusters;
+	TArray<FBorder> VerticalBorders;     // Between (CX, CY) and (CX + 1, CY), indexed CX + CY * (ClustersX - 1)
+	TArray<FBorder> HorizontalBorders;   // Between (CX, CY) and (CX, CY + 1), indexed CX + CY * ClustersX
+
+	// Walkability the graph was built from
+	TBitArray<> KnownWalkable;
+	uint32 KnownVersion = 0;
+	int32 PreparedWidth = 0;
+	int32 PreparedHeight = 0;
+
+	// Query scratch, kept across queries
+	TArray<int32> LocalCost;
+	TArray<int32> LocalParent;
+	TArray<int32> StartCosts;
+	TArray<int32> GoalCosts;
+	TArray<FOpenEntry> OpenHeap;
+	TMap<int32, FAbstractNode> AbstractNodes;
+	TArray<int32> AbstractPath;
+
+	void BuildLayout();
+	void BuildBorder(FBorder& OutBorder, int32 FirstLowCell, int32 Stride, int32 HighOffset, int32 Length) const;
+
+	/** Recompute the borders of a cluster; flags neighbors whose shared border changed */
+	void RebuildBorders(int32 ClusterIndex, TBitArray<>& InOutAffected);
+
+	/** Recompute a cluster's entrances from its borders, and the costs between them */
+	void RebuildCluster(int32 ClusterIndex);
+
+	/**
+	 * Search confined to one cluster from FromCell: A* to ToCell, or Dijkstra to every
+	 * cell when ToCell is INDEX_NONE. Costs land in OutCost by local index.
+	 */
+	bool SearchCluster(const FCluster& Cluster, int32 FromCell, int32 ToCell, TArray<int32>& OutCost, TArray<int32>* OutParent);
+
+	/** Append the refined leg FromCell -> ToCell (FromCell excluded) inside one cluster */
+	bool AppendLeg(int32 ClusterIndex, int32 FromCell, int32 ToCell, TArray<FVector2D>& OutPath);
+
+	bool SearchAbstract(int32 StartCell, int32 GoalCell);
+
+	int32 ClusterOf(int32 Cell) const;
+	int32 LocalIndex(const FCluster& Cluster, int32 Cell) const;
+	int32 OctileDistance(int32 CellA, int32 CellB) const;
+};
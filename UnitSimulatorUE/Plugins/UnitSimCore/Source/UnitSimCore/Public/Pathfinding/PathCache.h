@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameConstants.h"
+
+class FPathfindingGrid;
+
+/**
+ * LRU cache of found paths keyed by (start cell, goal cell, movement layer).
+ *
+ * Every entry belongs to one walkability version of the grid; the first lookup
+ * after the version moves drops them all. A search is a function of its two cells
+ * and the walkability, so an exact hit returns what a fresh search would.
+ *
+ * A miss can still be served by the tail of a path cached during the current
+ * frame (BeginFrame) that passes through the start cell toward the same goal.
+ * Only this frame's paths donate suffixes, so a simulation restored from a
+ * snapshot rebuilds the same donors and replays the same answers.
+ */
+class UNITSIMCORE_API FPathCache
+{
+public:
+	explicit FPathCache(const FPathfindingGrid& InGrid, int32 InCapacity = UnitSimConstants::PATH_CACHE_CAPACITY);
+
+	/** Start a new simulation frame: earlier paths stop donating suffixes */
+	void BeginFrame();
+
+	/** Tag for how paths are searched (e.g. the search mode); changing it drops every entry */
+	void SetSearchContext(uint8 Context);
+
+	/** Cached path for the query, in FAStarPathfinder::FindPath's form. False on a miss. */
+	bool Find(const FVector2D& Start, const FVector2D& Goal, EMovementLayer Layer, TArray<FVector2D>& OutPath);
+
+	/** Store a path just found for the query (start cell excluded, goal cell included) */
+	void Add(const FVector2D& Start, const FVector2D& Goal, EMovementLayer Layer, const TArray<FVector2D>& Path);
+
+	void Clear();
+
+	int32 Num() const { return Index.Num(); }
+
+	/** Lookups since the last ResetStats (harvested by the simulator's profiler each step) */
+	struct FStats
+	{
+		int32 Hits = 0;
+		int32 SuffixHits = 0;
+		int32 Misses = 0;
+		int32 Invalidations = 0;
+
+		float GetHitRate() const
+		{
+			const int32 Lookups = Hits + SuffixHits + Misses;
+			return Lookups > 0 ? static_cast<float>(Hits + SuffixHits) / Lookups : 0.f;
+		}
+	};
+
+	const FStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FStats(); }
+
+private:
+	struct FKey
+	{
+		int32 StartCell = INDEX_NONE;
+		int32 GoalCell = INDEX_NONE;
+		uint8 Layer = 0;
+
+		bool operator==(const FKey& Other) const
+		{
+			return StartCell == Other.StartCell && GoalCell == Other.GoalCell && Layer == Other.Layer;
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(HashCombine(::GetTypeHash(Key.StartCell), ::GetTypeHash(Key.GoalCell)), ::GetTypeHash(Key.Layer));
+		}
+	};
+
+	struct FEntry
+	{
+		FKey Key;
+		TArray<FVector2D> Path;
+		uint32 Frame = 0;      // Frame it was last used in
+		uint32 Stamp = 0;      // Unique per stored path, so stale suffix references can be told apart
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+	};
+
+	/** Where a cell sits on one of this frame's paths */
+	struct FSuffixRef
+	{
+		int32 Slot = INDEX_NONE;
+		int32 Offset = 0;
+		uint32 Stamp = 0;
+	};
+
+	const FPathfindingGrid& Grid;
+	int32 Capacity = 0;
+	FStats Stats;
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeSlots;
+	TMap<FKey, int32> Index;
+	TMap<FKey, FSuffixRef> Suffixes;   // Keyed by (cell on path, goal cell, layer)
+	int32 Head = INDEX_NONE;   // Most recently used
+	int32 Tail = INDEX_NONE;   // Least recently used
+
+	uint32 Frame = 1;
+	uint32 NextStamp = 1;
+	uint32 KnownVersion = 0;
+	uint8 SearchContext = 0;
+
+	/** Drop everything if the grid's walkability moved; true if the query cells are on the grid */
+	bool MakeKey(const FVector2D& Start, const FVector2D& Goal, EMovementLayer Layer, FKey& OutKey);
+
+	/** Mark the entry used this frame and offer its cells as suffix starts */
+	void UseThisFrame(int32 Slot);
+
+	void Unlink(int32 Slot);
+	void PushFront(int32 Slot);
+};
@@ -4,6 +4,15 @@
 
 struct FUnit;
 
+/** Which trigger asked for a replan */
+enum class EReplanReason : uint8
+{
+	None,
+	Stall,        // No waypoint progress
+	Avoidance,    // Detouring around a threat for too long
+	Periodic      // Refresh of a long-running path
+};
+
 /**
  * Monitors unit path progress and determines when replanning is needed.
  * Static utility functions (no state).
@@ -17,6 +26,9 @@ namespace PathProgressMonitor
 	 */
 	UNITSIMCORE_API bool ShouldReplan(const FUnit& Unit, int32 CurrentFrame);
 
+	/** First trigger that fires (same checks and cooldown as ShouldReplan), or None */
+	UNITSIMCORE_API EReplanReason GetReplanReason(const FUnit& Unit, int32 CurrentFrame);
+
 	/**
 	 * Update unit path progress tracking. Called each frame.
 	 * @param Unit         The unit to update
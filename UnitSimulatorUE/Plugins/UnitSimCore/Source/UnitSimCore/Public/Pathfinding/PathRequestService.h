@@ -0,0 +1,150 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameConstants.h"
+#include "Pathfinding/AStarPathfinder.h"
+#include "Pathfinding/PathfindingGrid.h"
+#include "Pathfinding/PathProgressMonitor.h"
+#include "Tasks/Task.h"
+
+class FHierarchicalPathfinder;
+
+/** How urgently a unit needs its new path; the search budget goes to the lowest value first */
+enum class EPathRequestPriority : uint8
+{
+	NewDestination,   // Heading somewhere else now
+	Stall,            // Stuck, or detouring around a threat for too long
+	Periodic          // Refresh of a path still being followed
+};
+
+/** A unit's replan, submitted during Phase 1 and applied at the end of the same step */
+struct FPathRequest
+{
+	EUnitFaction Faction = EUnitFaction::Friendly;
+	int32 UnitId = 0;
+	FVector2D Start = FVector2D::ZeroVector;
+	FVector2D Goal = FVector2D::ZeroVector;
+	EMovementLayer Layer = EMovementLayer::Ground;
+	EPathRequestPriority Priority = EPathRequestPriority::Periodic;
+	int32 LastReplanFrame = 0;   // Within a priority, the longest-waiting unit goes first
+
+	static EPathRequestPriority GetPriority(bool bDestChanged, EReplanReason Reason)
+	{
+		if (bDestChanged) return EPathRequestPriority::NewDestination;
+		return Reason == EReplanReason::Periodic ? EPathRequestPriority::Periodic : EPathRequestPriority::Stall;
+	}
+};
+
+/**
+ * One step's path requests, with their searches run off the simulation thread.
+ *
+ * Units Submit during Phase 1. The simulator then walks the requests in
+ * urgency order (priority, then oldest replan), answers what it can at once
+ * (flow fields, path cache) and hands the rest to QueueSearch, which grants at
+ * most PATH_REQUEST_BUDGET searches a frame and shares one search between
+ * identical queries. Requests left over are deferred: nothing is applied and the
+ * unit asks again next frame.
+ *
+ * Launch copies the grid into a snapshot (only when its walkability moved) and
+ * runs the searches on worker tasks that own their own pathfinders over it.
+ * Every search is a function of the snapshot and its endpoints, so which worker
+ * ran it, and when, cannot change a result. The simulator Waits at a fixed point
+ * of the step and applies results in submission order; nothing is in flight
+ * between steps, so snapshots and rollback never see a pending request.
+ */
+class UNITSIMCORE_API FPathRequestService
+{
+public:
+	explicit FPathRequestService(const FPathfindingGrid& InGrid, int32 InBudget = UnitSimConstants::PATH_REQUEST_BUDGET);
+	~FPathRequestService();
+
+	enum class EStatus : uint8
+	{
+		Deferred,   // Over budget (or not yet walked)
+		Answered,   // Resolved on the simulation thread
+		Searched    // Resolved by a worker, possibly shared with an identical request
+	};
+
+	struct FResult
+	{
+		EStatus Status = EStatus::Deferred;
+		bool bFound = false;
+		int32 SearchIndex = INDEX_NONE;
+		TArray<FVector2D> Path;
+	};
+
+	/** Queue a replan; a unit's second request in one step replaces its first */
+	void Submit(const FPathRequest& Request);
+
+	int32 Num() const { return Requests.Num(); }
+	const FPathRequest& GetRequest(int32 Index) const { return Requests[Index]; }
+	FResult& GetResult(int32 Index) { return Results[Index]; }
+	const FResult& GetResult(int32 Index) const { return Results[Index]; }
+
+	/** Request indices by priority, then oldest replan, then submission */
+	const TArray<int32>& SortByUrgency();
+
+	/** Grant a search to a request; false once the frame's budget is spent */
+	bool QueueSearch(int32 Index, bool bHierarchical);
+
+	/** Start the queued searches (on worker tasks, or inline when bAsync is false) */
+	void Launch(EPathSearchMode SearchMode, bool bAsync);
+
+	/** Block until the launched searches are done and copy their paths into the results */
+	void Wait();
+
+	/** Drop this step's requests (after they are applied) */
+	void Reset();
+
+	/** Work done since the last ResetStats (harvested by the simulator's profiler each step) */
+	struct FStats
+	{
+		int32 Searches = 0;
+		int32 SharedSearches = 0;
+		int32 Deferred = 0;
+		int32 NodesExpanded = 0;
+		int32 HierarchicalSearches = 0;
+		int32 ClustersRebuilt = 0;
+	};
+
+	const FStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FStats(); }
+
+private:
+	struct FSearch
+	{
+		int32 RequestIndex = INDEX_NONE;   // First request that asked for it
+		bool bHierarchical = false;
+		bool bFound = false;
+		TArray<FVector2D> Path;
+	};
+
+	struct FWorker
+	{
+		TUniquePtr<FAStarPathfinder> Pathfinder;
+		TArray<int32> Searches;
+	};
+
+	const FPathfindingGrid& Grid;
+	int32 Budget = 0;
+	FStats Stats;
+
+	TArray<FPathRequest> Requests;
+	TArray<FResult> Results;             // Pool: the first Requests.Num() entries are live
+	TArray<int32> UrgencyOrder;
+	TMap<uint64, int32> RequestByUnit;   // (faction, unit id) -> request index
+	TMap<uint64, int32> SearchByQuery;   // (start cell, goal cell, hierarchical) -> search index
+	TArray<FSearch> Searches;            // Pool: the first NumSearches entries are live
+	int32 NumSearches = 0;
+
+	// Immutable while searches run; copied from Grid when its walkability moves
+	FPathfindingGrid Snapshot;
+	bool bHasSnapshot = false;
+	TUniquePtr<FHierarchicalPathfinder> HierarchicalPathfinder;
+	TArray<int32> HierarchicalSearches;
+	TArray<FWorker> Workers;
+	TArray<UE::Tasks::FTask> Tasks;
+
+	void RefreshSnapshot();
+	void RunSearch(FAStarPathfinder* Pathfinder, int32 SearchIndex);
+};
@@ -23,6 +23,9 @@ public:
 	FPathNode* GetNode(int32 X, int32 Y);
 	const FPathNode* GetNode(int32 X, int32 Y) const;
 
+	/** All nodes, indexed X + Y * Width */
+	TConstArrayView<FPathNode> GetNodes() const { return Grid; }
+
 	/** Get node from world position. Returns nullptr if out of bounds. */
 	FPathNode* NodeFromWorldPoint(const FVector2D& WorldPosition);
 	const FPathNode* NodeFromWorldPoint(const FVector2D& WorldPosition) const;
@@ -45,13 +48,26 @@ public:
 	/** Reset all node costs (for A* reuse) */
 	void ResetAllNodes();
 
+	/** Make every node walkable again and reset costs (for reusing the grid in a new match) */
+	void ResetWalkability();
+
+	/**
+	 * Bumped whenever some node's walkability actually changes.
+	 * Caches derived from walkability (flow fields) compare it to know they are stale.
+	 */
+	uint32 GetWalkabilityVersion() const { return WalkabilityVersion; }
+
 private:
 	int32 Width = 0;
 	int32 Height = 0;
 	float NodeSize = 0.f;
+	uint32 WalkabilityVersion = 0;
 
 	/** Flat 1D array storing grid[x + y * Width] */
 	TArray<FPathNode> Grid;
 
 	FORCEINLINE int32 FlatIndex(int32 X, int32 Y) const { return X + Y * Width; }
+
+	/** Every walkability write goes through here so the version tracks real changes */
+	void WriteWalkable(FPathNode& Node, bool bIsWalkable);
 };
@@ -227,6 +227,10 @@ struct UNITSIMCORE_API FFrameData
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bMaxFramesReached = false;
 
+	/** FSimStateHash::Combined of the simulator after this frame (0 if hashing was off) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int64 StateHash = 0;
+
 	/**
 	 * Create a frame snapshot from live simulation state.
 	 */
@@ -239,9 +243,12 @@ struct UNITSIMCORE_API FFrameData
 		bool bHasMoreWaves,
 		const FSimGameSession* Session = nullptr);
 
-	/** Serialize to JSON string */
+	/**
+	 * Serialize to JSON string, unit and tower arrays included.
+	 * Readable fallback; per-frame export should use FrameDataBinary.
+	 */
 	FString ToJson() const;
 
-	/** Deserialize from JSON string */
+	/** Deserialize from JSON string (missing arrays read as empty) */
 	static bool FromJson(const FString& JsonString, FFrameData& OutFrameData);
 };
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "Simulation/FrameData.h"
+
+/**
+ * Versioned little-endian binary encoding of FFrameData.
+ *
+ * Layout: FHeaderRecord, then fixed-size unit records (friendly, enemy),
+ * tower records (friendly, enemy), then an extras blob holding each record's
+ * variable-length part (label, unit id, abilities). The enum-name string
+ * fields are stored as enum bytes; a name outside the enum is stored as
+ * EnumEscape plus the string in the extras, so Read returns exactly what was
+ * written.
+ *
+ * FFrameDataView reads the records in place, without decoding the buffer.
+ */
+namespace FrameDataBinary
+{
+	constexpr uint32 Magic = 0x42465355; // "USFB"
+	constexpr uint16 Version = 2;
+
+	/** Enum byte meaning "name is not an enum value, see extras" */
+	constexpr uint8 EnumEscape = 0xFF;
+
+	/** Append Frame to Out (existing contents kept) */
+	UNITSIMCORE_API void Write(const FFrameData& Frame, TArray<uint8>& Out);
+
+	/** Decode a buffer written by Write. Returns false on a malformed or foreign buffer. */
+	UNITSIMCORE_API bool Read(TArrayView<const uint8> Bytes, FFrameData& OutFrame);
+
+#pragma pack(push, 1)
+
+	struct FHeaderRecord
+	{
+		uint32 Magic;
+		uint16 Version;
+		uint8 GameResult;
+		uint8 WinConditionType;
+		int32 FrameNumber;
+		int32 CurrentWave;
+		int32 LivingFriendlyCount;
+		int32 LivingEnemyCount;
+		double MainTarget[2];
+		float ElapsedTime;
+		int32 FriendlyCrowns;
+		int32 EnemyCrowns;
+		uint8 Flags;
+		uint64 StateHash;
+		uint32 NumFriendlyUnits;
+		uint32 NumEnemyUnits;
+		uint32 NumFriendlyTowers;
+		uint32 NumEnemyTowers;
+		uint32 ExtrasSize;
+	};
+
+	struct FUnitRecord
+	{
+		int32 Id;
+		uint8 TargetPriority;
+		uint8 Role;
+		uint8 Faction;
+		uint8 Layer;
+		uint8 CanTarget;
+		uint8 Flags;
+		int32 HP;
+		int32 Damage;
+		int32 ShieldHP;
+		int32 MaxShieldHP;
+		int32 TargetId;
+		int32 TakenSlotIndex;
+		float Radius;
+		float Speed;
+		float TurnSpeed;
+		float AttackRange;
+		float AttackCooldown;
+		float RequiredChargeDistance;
+		double Position[2];
+		double Velocity[2];
+		double Forward[2];
+		double CurrentDestination[2];
+		double AvoidanceTarget[2];
+		uint32 ExtrasOffset;
+		uint32 ExtrasSize;
+	};
+
+	struct FTowerRecord
+	{
+		int32 Id;
+		uint8 Type;
+		uint8 Faction;
+		uint8 Flags;
+		double Position[2];
+		float Radius;
+		float AttackRange;
+		float AttackCooldown;
+		int32 MaxHP;
+		int32 CurrentHP;
+		uint32 ExtrasOffset;
+		uint32 ExtrasSize;
+	};
+
+#pragma pack(pop)
+
+	/** FHeaderRecord::Flags */
+	enum EFrameFlags : uint8
+	{
+		FrameOvertime = 1 << 0,
+		FrameAllWavesCleared = 1 << 1,
+		FrameMaxFramesReached = 1 << 2
+	};
+
+	/** FUnitRecord::Flags and FTowerRecord::Flags */
+	enum ERecordFlags : uint8
+	{
+		UnitDead = 1 << 0,
+		UnitHasChargeState = 1 << 1,
+		UnitCharging = 1 << 2,
+		UnitCharged = 1 << 3,
+		UnitHasAvoidanceTarget = 1 << 4,
+		UnitMoving = 1 << 5,
+		UnitInAttackRange = 1 << 6,
+
+		TowerActivated = 1 << 0
+	};
+}
+
+/**
+ * Read-only view of one unit record inside an encoded frame.
+ * Valid while the buffer it was taken from is alive and unchanged.
+ */
+class UNITSIMCORE_API FUnitStateView
+{
+public:
+	FUnitStateView(const FrameDataBinary::FUnitRecord* InRecord, TArrayView<const uint8> InExtras)
+		: Record(InRecord), Extras(InExtras) {}
+
+	/** All fixed-size fields; enum names are enum bytes (EnumEscape = name only in the extras) */
+	const FrameDataBinary::FUnitRecord& GetRecord() const { return *Record; }
+
+	int32 GetId() const { return Record->Id; }
+	int32 GetHP() const { return Record->HP; }
+	int32 GetTargetId() const { return Record->TargetId; }
+	bool IsDead() const { return (Record->Flags & FrameDataBinary::UnitDead) != 0; }
+
+	// Enum getters assume the name was an enum value (always true for FromUnit output)
+	EUnitFaction GetFaction() const { return static_cast<EUnitFaction>(Record->Faction); }
+	EUnitRole GetRole() const { return static_cast<EUnitRole>(Record->Role); }
+	FVector2D GetPosition() const { return FVector2D(Record->Position[0], Record->Position[1]); }
+	FVector2D GetVelocity() const { return FVector2D(Record->Velocity[0], Record->Velocity[1]); }
+	FVector2D GetForward() const { return FVector2D(Record->Forward[0], Record->Forward[1]); }
+
+	/** UTF-8 label and unit id, pointing into the buffer */
+	FUtf8StringView GetLabel() const;
+	FUtf8StringView GetUnitId() const;
+
+	/** Abilities in order; an out-of-range Index reads as the first ability type */
+	int32 GetNumAbilities() const;
+	EAbilityType GetAbility(int32 Index) const;
+
+	/** Decode into a full FUnitStateData. Returns false if the extras are malformed. */
+	bool ToStateData(FUnitStateData& Out) const;
+
+private:
+	const FrameDataBinary::FUnitRecord* Record;
+	TArrayView<const uint8> Extras;
+};
+
+/**
+ * Read-only view of one tower record inside an encoded frame.
+ */
+class UNITSIMCORE_API FTowerStateView
+{
+public:
+	FTowerStateView(const FrameDataBinary::FTowerRecord* InRecord, TArrayView<const uint8> InExtras)
+		: Record(InRecord), Extras(InExtras) {}
+
+	const FrameDataBinary::FTowerRecord& GetRecord() const { return *Record; }
+
+	int32 GetId() const { return Record->Id; }
+	int32 GetCurrentHP() const { return Record->CurrentHP; }
+	int32 GetMaxHP() const { return Record->MaxHP; }
+	bool IsActivated() const { return (Record->Flags & FrameDataBinary::TowerActivated) != 0; }
+	ETowerType GetType() const { return static_cast<ETowerType>(Record->Type); }
+	EUnitFaction GetFaction() const { return static_cast<EUnitFaction>(Record->Faction); }
+	FVector2D GetPosition() const { return FVector2D(Record->Position[0], Record->Position[1]); }
+
+	bool ToStateData(FTowerStateData& Out) const;
+
+private:
+	const FrameDataBinary::FTowerRecord* Record;
+	TArrayView<const uint8> Extras;
+};
+
+/**
+ * Zero-copy view over a buffer written by FrameDataBinary::Write.
+ * Open validates the layout once; the accessors then read records in place.
+ */
+class UNITSIMCORE_API FFrameDataView
+{
+public:
+	/** Validate Bytes and point the view at it. Returns false (view left empty) if malformed. */
+	bool Open(TArrayView<const uint8> Bytes);
+
+	bool IsValid() const { return Header != nullptr; }
+
+	/** Header fields (Open must have succeeded) */
+	const FrameDataBinary::FHeaderRecord& GetHeader() const { return *Header; }
+	int32 GetFrameNumber() const { return Header->FrameNumber; }
+	EGameResult GetGameResult() const { return static_cast<EGameResult>(Header->GameResult); }
+	uint64 GetStateHash() const { return Header->StateHash; }
+
+	int32 NumFriendlyUnits() const { return static_cast<int32>(Header->NumFriendlyUnits); }
+	int32 NumEnemyUnits() const { return static_cast<int32>(Header->NumEnemyUnits); }
+	int32 NumFriendlyTowers() const { return static_cast<int32>(Header->NumFriendlyTowers); }
+	int32 NumEnemyTowers() const { return static_cast<int32>(Header->NumEnemyTowers); }
+
+	FUnitStateView GetFriendlyUnit(int32 Index) const { return FUnitStateView(Units + Index, Extras); }
+	FUnitStateView GetEnemyUnit(int32 Index) const { return FUnitStateView(Units + NumFriendlyUnits() + Index, Extras); }
+	FTowerStateView GetFriendlyTower(int32 Index) const { return FTowerStateView(Towers + Index, Extras); }
+	FTowerStateView GetEnemyTower(int32 Index) const { return FTowerStateView(Towers + NumFriendlyTowers() + Index, Extras); }
+
+	/** Decode the whole frame. Returns false if a record's extras are malformed. */
+	bool ToFrameData(FFrameData& Out) const;
+
+private:
+	const FrameDataBinary::FHeaderRecord* Header = nullptr;
+	const FrameDataBinary::FUnitRecord* Units = nullptr;
+	const FrameDataBinary::FTowerRecord* Towers = nullptr;
+	TArrayView<const uint8> Extras;
+};
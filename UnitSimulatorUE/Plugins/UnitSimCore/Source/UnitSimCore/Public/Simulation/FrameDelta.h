@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameConstants.h"
+#include "Simulation/FrameData.h"
+
+/**
+ * Encoder-side settings of a frame delta stream.
+ * The decoder needs none: keyframes carry the vector step.
+ */
+struct UNITSIMCORE_API FFrameDeltaSettings
+{
+	/** Frames between keyframes (self-contained packets a decoder can join at) */
+	int32 KeyframeInterval = UnitSimConstants::FRAME_DELTA_KEYFRAME_INTERVAL;
+
+	/** Grid for FVector2D fields on the wire; 0 sends exact doubles */
+	double VectorStep = UnitSimConstants::FRAME_DELTA_VECTOR_STEP;
+};
+
+/**
+ * Delta encoder for a stream of FFrameData.
+ *
+ * Each packet is either a keyframe or a diff against the previous packet.
+ * Every record (frame header, unit, tower) is a bit mask of changed fields
+ * followed by only those fields: integers as varint deltas, floats as raw
+ * bits, bools as toggles, strings only when they change. Units and towers
+ * are matched by Id, so slot reuse and compaction cost only an Id list.
+ * Vector fields are sent as quantized steps. The encoder tracks what the
+ * decoder will hold rather than the true values, so quantization error never
+ * accumulates: it stays within VectorStep / 2 per axis. With VectorStep = 0
+ * the decoded frames are bit-exact copies of the input.
+ */
+class UNITSIMCORE_API FFrameDeltaEncoder
+{
+public:
+	explicit FFrameDeltaEncoder(const FFrameDeltaSettings& InSettings = FFrameDeltaSettings());
+
+	/** Encode Frame into OutPacket (contents replaced, allocation kept) */
+	void Encode(const FFrameData& Frame, TArray<uint8>& OutPacket);
+
+	/** Make the next packet a keyframe (a consumer joined or lost a packet) */
+	void RequestKeyframe() { FramesSinceKeyframe = INDEX_NONE; }
+
+	/** The frame a decoder reconstructs from the packets so far */
+	const FFrameData& GetReference() const { return Reference; }
+
+private:
+	FFrameDeltaSettings Settings;
+	FFrameData Reference;
+
+	/** Frames since the last keyframe (INDEX_NONE = next one is a keyframe) */
+	int32 FramesSinceKeyframe = INDEX_NONE;
+
+	// Scratch reused across packets
+	TArray<uint8> FieldBytes;
+	TArray<int32> Ids;
+};
+
+/**
+ * Decoder matching FFrameDeltaEncoder. Starts at the first keyframe; a
+ * corrupt packet drops it back to waiting for the next keyframe.
+ */
+class UNITSIMCORE_API FFrameDeltaDecoder
+{
+public:
+	/** Apply one packet. Returns false (and waits for a keyframe) if it can't be applied. */
+	bool Decode(const TArray<uint8>& Packet);
+
+	/** Frame reconstructed by the last successful Decode */
+	const FFrameData& GetFrame() const { return Frame; }
+
+	bool HasKeyframe() const { return bHasKeyframe; }
+
+private:
+	FFrameData Frame;
+	double VectorStep = 0.0;
+	bool bHasKeyframe = false;
+
+	TArray<int32> Ids;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "GameConstants.h"
+#include "Combat/FrameEvents.h"
+
+/**
+ * Phase 1 fan-out with a deterministic event merge.
+ *
+ * [0, Count) is cut into contiguous batches of PHASE1_PARALLEL_BATCH_SIZE and
+ * each batch collects into its own FFrameEvents. The batch buffers are appended
+ * to OutEvents in batch order, so OutEvents lists events in index order however
+ * many workers ran and in whatever order they finished. Body(Index, BatchEvents)
+ * must only write state owned by Index.
+ */
+namespace ParallelCollect
+{
+	template <typename BodyType>
+	void ForEachOrdered(
+		int32 Count,
+		TArray<FFrameEvents>& BatchEvents,
+		FFrameEvents& OutEvents,
+		bool bParallel,
+		BodyType&& Body)
+	{
+		if (Count <= 0) return;
+
+		const int32 BatchSize = UnitSimConstants::PHASE1_PARALLEL_BATCH_SIZE;
+		const int32 NumBatches = FMath::DivideAndRoundUp(Count, BatchSize);
+		if (BatchEvents.Num() < NumBatches)
+		{
+			BatchEvents.SetNum(NumBatches);
+		}
+
+		ParallelFor(NumBatches, [&](int32 Batch)
+		{
+			FFrameEvents& Events = BatchEvents[Batch];
+			Events.Clear();
+
+			const int32 End = FMath::Min(Count, (Batch + 1) * BatchSize);
+			for (int32 i = Batch * BatchSize; i < End; ++i)
+			{
+				Body(i, Events);
+			}
+		}, !bParallel);
+
+		for (int32 Batch = 0; Batch < NumBatches; ++Batch)
+		{
+			OutEvents.Append(BatchEvents[Batch]);
+		}
+	}
+}
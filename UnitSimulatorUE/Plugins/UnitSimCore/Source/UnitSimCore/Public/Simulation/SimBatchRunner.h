@@ -0,0 +1,173 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameState/GameResult.h"
+#include "GameState/InitialSetup.h"
+#include "SimBatchRunner.generated.h"
+
+class FSimulatorCore;
+
+/** One headless match to run */
+USTRUCT(BlueprintType)
+struct UNITSIMCORE_API FSimBatchJob
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FInitialSetup Setup;
+
+	/** Seeds the FRandomStream handed to the runner's PrepareMatch hook; recorded in the result */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Seed = 0;
+
+	/** Keep the match going after the enemy squad is wiped (waves injected by PrepareMatch) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bHasMoreWaves = false;
+};
+
+/** Outcome of one batch match */
+USTRUCT(BlueprintType)
+struct UNITSIMCORE_API FSimMatchResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 JobIndex = -1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Seed = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGameResult Result = EGameResult::InProgress;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EWinCondition WinCondition = EWinCondition::None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 FriendlyCrowns = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 EnemyCrowns = 0;
+
+	/** Frames simulated before the match ended */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 FrameCount = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float FriendlyTowerHPRatio = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float EnemyTowerHPRatio = 1.f;
+
+	/** Wall time spent on this match (setup + run) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double Seconds = 0.0;
+};
+
+/** Aggregate over a batch, plus throughput */
+USTRUCT(BlueprintType)
+struct UNITSIMCORE_API FSimBatchSummary
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Matches = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 FriendlyWins = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 EnemyWins = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Draws = 0;
+
+	/** Matches that hit MAX_FRAMES (or ran out of enemies) with no result */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Unfinished = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double AvgFrames = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double AvgFriendlyCrowns = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double AvgEnemyCrowns = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double AvgFriendlyTowerHPRatio = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double AvgEnemyTowerHPRatio = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumWorkers = 0;
+
+	/** Wall time of the whole batch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double WallSeconds = 0.0;
+
+	/** Sum of per-match times across workers */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double BusySeconds = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double MatchesPerSecond = 0.0;
+
+	/** Matches per busy core-second (independent of how many workers were idle) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double MatchesPerSecondPerCore = 0.0;
+
+	/** Fold Results into the outcome columns; timing fields are left to the caller */
+	static FSimBatchSummary Aggregate(const TArray<FSimMatchResult>& Results);
+
+	/** Fixed-width text table, one row per line */
+	FString ToTable() const;
+};
+
+/**
+ * Runs many independent matches headless, one FSimulatorCore per worker.
+ *
+ * Workers pull the next job from a shared atomic cursor, so a worker stuck on
+ * a long match never holds up short ones. Each worker keeps its simulator
+ * between matches and restarts it in place (FSimulatorCore::Restart), reusing
+ * the pathfinding grid and frame buffers. Results land at their job index, so
+ * the output is independent of scheduling. Phase 1 inside each match runs
+ * single-threaded: the batch already keeps every core busy.
+ */
+class UNITSIMCORE_API FSimBatchRunner
+{
+public:
+	/** Per-match hook run after the simulator is restarted and before it runs (enqueue commands, waves...) */
+	using FPrepareMatch = TFunction<void(FSimulatorCore& Sim, const FSimBatchJob& Job, FRandomStream& Stream)>;
+
+	/** @param InNumWorkers  Worker count (0 = one per task graph worker plus the calling thread) */
+	explicit FSimBatchRunner(int32 InNumWorkers = 0);
+	~FSimBatchRunner();
+
+	void SetPrepareMatch(FPrepareMatch InPrepareMatch) { PrepareMatch = MoveTemp(InPrepareMatch); }
+
+	int32 GetNumWorkers() const { return NumWorkers; }
+
+	/**
+	 * Run every job to completion.
+	 * @param Jobs        Matches to run
+	 * @param OutResults  One result per job, in job order
+	 * @return            Aggregated outcomes and throughput
+	 */
+	FSimBatchSummary Run(const TArray<FSimBatchJob>& Jobs, TArray<FSimMatchResult>& OutResults);
+
+	/** Standard towers plus UnitsPerSide random unit groups per faction, drawn from Seed */
+	static FSimBatchJob MakeRandomSkirmish(int32 Seed, int32 UnitsPerSide);
+
+private:
+	int32 NumWorkers = 1;
+
+	/** One simulator per worker, kept across Run calls */
+	TArray<TUniquePtr<FSimulatorCore>> Instances;
+
+	FPrepareMatch PrepareMatch;
+
+	void RunMatch(FSimulatorCore& Sim, const FSimBatchJob& Job, int32 JobIndex, FSimMatchResult& OutResult) const;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameConstants.h"
+#include "GameState/SimGameSession.h"
+#include "Simulation/FrameData.h"
+#include "Units/Unit.h"
+
+/**
+ * Read-only view of the simulator's live state at one frame.
+ *
+ * Units and towers are read straight from simulator storage: nothing is
+ * copied and no labels or enum names are formatted. The view is valid until
+ * the simulator next changes (step, command, restore); call ToFrameData for
+ * a snapshot that outlives it.
+ */
+class UNITSIMCORE_API FSimFrameView
+{
+public:
+	FSimFrameView(
+		int32 InFrameNumber,
+		const TArray<FUnit>& InFriendlies,
+		const TArray<FUnit>& InEnemies,
+		const FSimGameSession& InSession,
+		const FVector2D& InMainTarget,
+		int32 InCurrentWave,
+		bool bInHasMoreWaves,
+		uint64 InStateHash = 0)
+		: FrameNumber(InFrameNumber)
+		, Friendlies(InFriendlies)
+		, Enemies(InEnemies)
+		, Session(InSession)
+		, MainTarget(InMainTarget)
+		, CurrentWave(InCurrentWave)
+		, bHasMoreWaves(bInHasMoreWaves)
+		, StateHash(InStateHash)
+	{
+	}
+
+	int32 GetFrameNumber() const { return FrameNumber; }
+	int32 GetCurrentWave() const { return CurrentWave; }
+	const FVector2D& GetMainTarget() const { return MainTarget; }
+
+	/** Combined state hash after this frame (0 if hashing was off) */
+	uint64 GetStateHash() const { return StateHash; }
+
+	/** Squads in slot order, dead units included (same order as FFrameData's arrays) */
+	TConstArrayView<FUnit> GetFriendlyUnits() const { return Friendlies; }
+	TConstArrayView<FUnit> GetEnemyUnits() const { return Enemies; }
+	TConstArrayView<FTower> GetFriendlyTowers() const { return Session.FriendlyTowers; }
+	TConstArrayView<FTower> GetEnemyTowers() const { return Session.EnemyTowers; }
+
+	/** Living units (counted on each call) */
+	int32 GetLivingFriendlyCount() const;
+	int32 GetLivingEnemyCount() const;
+
+	float GetElapsedTime() const { return Session.ElapsedTime; }
+	int32 GetFriendlyCrowns() const { return Session.FriendlyCrowns; }
+	int32 GetEnemyCrowns() const { return Session.EnemyCrowns; }
+	EGameResult GetGameResult() const { return Session.Result; }
+	EWinCondition GetWinConditionType() const { return Session.WinConditionType; }
+	bool IsOvertime() const { return Session.bIsOvertime; }
+
+	/** Same meaning as FFrameData::bAllWavesCleared / bMaxFramesReached */
+	bool AllWavesCleared() const { return !bHasMoreWaves && GetLivingEnemyCount() == 0; }
+	bool MaxFramesReached() const { return FrameNumber >= UnitSimConstants::MAX_FRAMES - 1; }
+
+	/** Materialize a full snapshot (what Step returns for this frame) */
+	FFrameData ToFrameData() const;
+
+private:
+	int32 FrameNumber;
+	const TArray<FUnit>& Friendlies;
+	const TArray<FUnit>& Enemies;
+	const FSimGameSession& Session;
+	const FVector2D& MainTarget;
+	int32 CurrentWave;
+	bool bHasMoreWaves;
+	uint64 StateHash;
+};
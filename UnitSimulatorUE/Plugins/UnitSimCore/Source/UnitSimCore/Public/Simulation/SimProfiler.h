@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameConstants.h"
+#include "Stats/Stats.h"
+#include <atomic>
+
+DECLARE_STATS_GROUP(TEXT("UnitSim"), STATGROUP_UnitSim, STATCAT_Advanced);
+
+/** Timed sections of one simulator step, in the order they run */
+enum class ESimPhase : uint8
+{
+	Prepare,             // Slot reclaim and hot stream rebuild
+	Commands,
+	DynamicObstacles,
+	EnemyUpdate,
+	FriendlyUpdate,
+	TowerUpdate,
+	PathDispatch,        // Replan requests answered, budgeted and handed to workers
+	Collisions,
+	ApplyDamage,
+	ApplyTowerDamage,
+	ApplyDamageToTowers,
+	Deaths,
+	Spawns,
+	Session,             // Crowns, king activation, win conditions
+	PathApply,           // Wait for path workers, apply results in request order
+	StateHash,           // Per-frame determinism hash
+	Callbacks,           // Batched unit event / state change delivery
+	Snapshot,            // FFrameData built for Step or bound listeners
+
+	Count
+};
+
+/** Work counted during one simulator step */
+enum class ESimCounter : uint8
+{
+	PathRequests,        // A* searches
+	PathNodesExpanded,   // Nodes taken off the A* open list
+	AvoidanceRisks,      // Neighbours tested by predictive avoidance
+	CollisionPairs,      // Broadphase pairs given a narrowphase test
+	CombatEvents,        // Damage, tower damage and spawn events from Phase 1
+	UnitEvents,          // Unit events recorded by the callbacks
+	FlowFieldBuilds,     // Flow fields (re)built after a walkability change
+	FlowFieldRepairs,    // Flow fields repaired in place around toggled dynamic obstacle cells
+	FlowFieldPaths,      // Paths traced from a cached flow field instead of A*
+	HierarchicalPaths,   // Long queries answered by the HPA* abstract graph
+	ClusterRebuilds,     // HPA* clusters rebuilt after a walkability change
+	PathCacheHits,       // Path queries answered from the path cache (whole path or suffix)
+	PathCacheMisses,     // Path queries the cache could not answer
+	PathsDeferred,       // Replan requests over the frame's search budget (resubmitted next frame)
+
+	Count
+};
+
+/** Per-phase time and counters of one step */
+struct UNITSIMCORE_API FSimFrameProfile
+{
+	static constexpr int32 NumPhases = static_cast<int32>(ESimPhase::Count);
+	static constexpr int32 NumCounters = static_cast<int32>(ESimCounter::Count);
+
+	int32 FrameNumber = INDEX_NONE;
+
+	/** Whole step, including time outside the named phases */
+	double TotalSeconds = 0.0;
+
+	double PhaseSeconds[NumPhases] = {};
+	int32 Counters[NumCounters] = {};
+
+	double GetPhaseSeconds(ESimPhase Phase) const { return PhaseSeconds[static_cast<int32>(Phase)]; }
+	int32 GetCounter(ESimCounter Counter) const { return Counters[static_cast<int32>(Counter)]; }
+
+	/** One line: total, then every phase in microseconds, then every counter */
+	FString ToString() const;
+};
+
+/**
+ * Per-phase step profiler owned by FSimulatorCore.
+ *
+ * Phases are timed into the current frame's FSimFrameProfile (alongside the
+ * "stat UnitSim" cycle counters and Insights scopes) and counters are summed
+ * from any thread. EndFrame files the frame in a fixed ring of the last
+ * PROFILER_HISTORY_FRAMES steps, so headless runs can read the breakdown
+ * back without a stats capture.
+ */
+class UNITSIMCORE_API FSimProfiler
+{
+public:
+	explicit FSimProfiler(int32 InHistoryFrames = UnitSimConstants::PROFILER_HISTORY_FRAMES);
+
+	FSimProfiler(const FSimProfiler&) = delete;
+	FSimProfiler& operator=(const FSimProfiler&) = delete;
+
+	void BeginFrame(int32 FrameNumber);
+	void EndFrame();
+
+	/** Any thread */
+	void AddCount(ESimCounter Counter, int32 Amount)
+	{
+		PendingCounters[static_cast<int32>(Counter)].fetch_add(Amount, std::memory_order_relaxed);
+	}
+
+	void AddPhaseSeconds(ESimPhase Phase, double Seconds)
+	{
+		Current.PhaseSeconds[static_cast<int32>(Phase)] += Seconds;
+	}
+
+	/** Up to MaxFrames most recent profiles, oldest first */
+	TArray<FSimFrameProfile> GetRecentFrames(int32 MaxFrames = MAX_int32) const;
+
+	/** Most recent completed frame, or nullptr before the first */
+	const FSimFrameProfile* GetLastFrame() const;
+
+	/** Forget the history (e.g. after the simulator was re-initialized) */
+	void Reset();
+
+	static const TCHAR* GetPhaseName(ESimPhase Phase);
+	static const TCHAR* GetCounterName(ESimCounter Counter);
+
+	/** Adds the time from construction to destruction to one phase */
+	class FPhaseScope
+	{
+	public:
+		FPhaseScope(FSimProfiler& InProfiler, ESimPhase InPhase);
+		~FPhaseScope();
+
+	private:
+		FSimProfiler& Profiler;
+		ESimPhase Phase;
+		uint64 StartCycles;
+	};
+
+private:
+	TArray<FSimFrameProfile> History;
+	int32 NumRecorded = 0;
+
+	FSimFrameProfile Current;
+	uint64 FrameStartCycles = 0;
+
+	// Filled from ParallelFor tasks, moved into Current by EndFrame
+	std::atomic<int32> PendingCounters[FSimFrameProfile::NumCounters] = {};
+};
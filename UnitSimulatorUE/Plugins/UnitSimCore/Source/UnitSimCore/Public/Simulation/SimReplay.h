@@ -0,0 +1,161 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameConstants.h"
+#include "Commands/SimCommand.h"
+#include "GameState/InitialSetup.h"
+#include "Simulation/FrameData.h"
+#include "Simulation/SimStateHash.h"
+
+class FSimulatorCore;
+class FUnitRegistry;
+
+/**
+ * A recorded match: what it started from, every command and when it was
+ * submitted, and full-state keyframes to seek from.
+ *
+ * Commands are filed at the frame they were submitted on (before that frame's
+ * step), not at their FrameNumber, so replaying them reproduces the simulator's
+ * command queue exactly, including commands waiting for a later frame.
+ */
+struct UNITSIMCORE_API FSimReplay
+{
+	struct FCommandEntry
+	{
+		int32 Frame = 0;
+		FSimCommand Command;
+	};
+
+	struct FKeyframe
+	{
+		int32 Frame = 0;
+		TArray<uint8> Snapshot;
+	};
+
+	/** Setup the simulator was initialized with */
+	FInitialSetup Setup;
+
+	/** HashDataSet of the recording simulator; playback refuses a different data set */
+	uint32 DataSetHash = 0;
+
+	int32 KeyframeInterval = UnitSimConstants::REPLAY_KEYFRAME_INTERVAL;
+
+	/** Simulator frame after the last recorded step (the recording covers Keyframes[0].Frame up to here) */
+	int32 EndFrame = 0;
+
+	/** By frame, submission order within a frame */
+	TArray<FCommandEntry> Commands;
+
+	/** By frame; the first one is the state recording started from */
+	TArray<FKeyframe> Keyframes;
+
+	/** State hash after each recorded step, from Keyframes[0].Frame on (zero where hashing was off) */
+	TArray<FSimStateHash> FrameHashes;
+
+	/** Recorded hash after stepping Frame, or nullptr if none was recorded */
+	const FSimStateHash* FindFrameHash(int32 Frame) const;
+
+	/** Write to OutData (contents replaced) */
+	void Save(TArray<uint8>& OutData);
+
+	/** Read data written by Save. Returns false (replay left empty) for another version or truncated data. */
+	bool Load(const TArray<uint8>& Data);
+
+	/** Discard everything recorded */
+	void Reset();
+
+	/**
+	 * Hash of everything outside the snapshot that decides how a match plays out:
+	 * the unit definitions and the simulation math backend.
+	 */
+	static uint32 HashDataSet(const FUnitRegistry& Registry);
+
+private:
+	void Serialize(FArchive& Ar);
+};
+
+/**
+ * Records a match as FSimReplay while it runs.
+ *
+ * Initialize and configure the simulator, call Begin, then route every
+ * command through SubmitCommand and advance with Tick. Commands enqueued on
+ * the simulator directly are not recorded.
+ */
+class UNITSIMCORE_API FSimReplayRecorder
+{
+public:
+	explicit FSimReplayRecorder(FSimulatorCore& InSim);
+
+	/**
+	 * Start a new recording from the simulator's current state.
+	 * @param Setup             Setup the simulator was initialized with (stored for playback)
+	 * @param KeyframeInterval  Frames between keyframes (0 = only the starting one)
+	 */
+	void Begin(const FInitialSetup& Setup, int32 KeyframeInterval = UnitSimConstants::REPLAY_KEYFRAME_INTERVAL);
+
+	/** Enqueue Command and log it at the current frame. Returns false (nothing logged) if the queue was full. */
+	bool SubmitCommand(const FSimCommand& Command);
+
+	/** Step the simulator, log its state hash, then write a keyframe if one is due */
+	FFrameData Tick();
+
+	const FSimReplay& GetReplay() const { return Replay; }
+	FSimReplay& GetReplay() { return Replay; }
+
+private:
+	FSimulatorCore& Sim;
+	FSimReplay Replay;
+
+	void WriteKeyframe();
+};
+
+/**
+ * Plays an FSimReplay back on a simulator and seeks within it.
+ *
+ * Seek restores the nearest keyframe at or before the target (or continues
+ * from the current frame if that is closer) and re-simulates forward with
+ * StepSilent, so no callbacks fire for skipped frames. Step then plays one
+ * frame normally.
+ */
+class UNITSIMCORE_API FSimReplayPlayer
+{
+public:
+	FSimReplayPlayer(FSimulatorCore& InSim, const FSimReplay& InReplay);
+
+	/**
+	 * Initialize the simulator from the replay and seek to its first frame.
+	 * Returns false if the simulator's data set differs from the recording's
+	 * or the replay has no starting keyframe.
+	 */
+	bool Start();
+
+	/** Put the simulator at the start of Frame (clamped to the recording). Returns false if a keyframe failed to restore. */
+	bool Seek(int32 Frame);
+
+	/** Play the current frame with its recorded commands (callbacks fire as usual) */
+	FFrameData Step();
+
+	/** The recording has been played to its last frame */
+	bool IsAtEnd() const;
+
+	/** Frames re-simulated by the last Seek */
+	int32 GetLastSeekFrames() const { return LastSeekFrames; }
+
+	/** First played frame whose state hash differed from the recording's (since Start) */
+	const FSimDivergence& GetDivergence() const { return Divergence; }
+
+private:
+	FSimulatorCore& Sim;
+	const FSimReplay& Replay;
+	int32 LastSeekFrames = 0;
+	FSimDivergence Divergence;
+
+	/** The simulator holds a state of this replay (false until the first keyframe is restored) */
+	bool bInSync = false;
+
+	/** Enqueue the commands recorded at the current frame */
+	void FeedCommands();
+
+	/** Compare the hash of the frame just stepped with the recording's */
+	void CheckFrameHash();
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameConstants.h"
+#include "Commands/SimCommand.h"
+#include "Simulation/FrameData.h"
+
+class FSimulatorCore;
+
+/**
+ * Rollback layer over FSimulatorCore for commands that arrive after their frame.
+ *
+ * Every command goes through SubmitCommand and is logged at its FrameNumber.
+ * Each Tick snapshots the frame about to run into a ring of the last
+ * MaxRollbackFrames frames, feeds in the commands logged for that frame and
+ * steps. A command for a frame already simulated is filed at that frame; the
+ * next Tick restores the frame's snapshot, re-simulates up to the present with
+ * StepSilent and then steps the present frame normally, so observers only see
+ * the corrected timeline. Commands older than the ring are applied at the
+ * oldest frame still held.
+ *
+ * Commands for the same frame run in submission order. Commands enqueued on
+ * the simulator directly bypass the log and are not replayed correctly.
+ */
+class UNITSIMCORE_API FSimRollback
+{
+public:
+	explicit FSimRollback(FSimulatorCore& InSim, int32 InMaxRollbackFrames = UnitSimConstants::ROLLBACK_MAX_FRAMES);
+
+	/** Log a command at its FrameNumber; one for an already simulated frame schedules a rollback */
+	void SubmitCommand(const FSimCommand& Command);
+
+	/** Roll back and re-simulate if a late command arrived, then step the present frame */
+	FFrameData Tick();
+
+	/** Forget snapshots and logged commands (call after the simulator was restarted or restored externally) */
+	void Reset();
+
+	int32 GetMaxRollbackFrames() const { return Ring.Num(); }
+
+	/** Frames re-simulated by the last Tick (0 = no rollback) */
+	int32 GetLastRollbackFrames() const { return LastRollbackFrames; }
+
+	/** Commands that arrived too late for the ring and were applied at its oldest frame */
+	int32 GetNumClampedCommands() const { return NumClampedCommands; }
+
+	/**
+	 * Deepest rollback that fits in BudgetSeconds next to the present frame's own
+	 * step, from running averages of step, re-simulation, snapshot save and
+	 * restore times. Not capped at the ring size, so it can be used to size it.
+	 * Returns 0 until a Tick has been timed.
+	 */
+	int32 EstimateRollbackBound(double BudgetSeconds = UnitSimConstants::FRAME_TIME_SECONDS) const;
+
+private:
+	struct FLoggedCommand
+	{
+		int32 Frame = 0;
+		FSimCommand Command;
+	};
+
+	struct FSnapshotSlot
+	{
+		int32 Frame = INDEX_NONE;
+		TArray<uint8> Data;
+	};
+
+	FSimulatorCore& Sim;
+
+	/** Snapshot of frame F (taken before its commands are fed) lives in Ring[F % Ring.Num()] */
+	TArray<FSnapshotSlot> Ring;
+
+	/** Commands by frame, submission order within a frame; pruned as frames leave the ring */
+	TArray<FLoggedCommand> CommandLog;
+
+	/** Earliest frame a late command landed in since the last Tick (MAX_int32 = none) */
+	int32 RollbackFrame = MAX_int32;
+
+	int32 LastRollbackFrames = 0;
+	int32 NumClampedCommands = 0;
+
+	// Running averages (seconds)
+	double AvgStepSeconds = 0.0;
+	double AvgSilentStepSeconds = 0.0;
+	double AvgSaveSeconds = 0.0;
+	double AvgRestoreSeconds = 0.0;
+
+	/** Oldest frame with a snapshot, or the current frame if none is held */
+	int32 GetOldestHeldFrame() const;
+
+	/** Snapshot the current frame, then enqueue its logged commands */
+	void BeginFrame();
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/SimStateHash.h"
+
+class FSimulatorCore;
+struct FSimReplay;
+
+/**
+ * Finds where two runs of the same match stop agreeing.
+ *
+ * Every step carries its state hash, so the first diverging frame is a
+ * linear scan over the two hash streams; the domain split names the
+ * subsystem, and with both states at hand the slot as well.
+ */
+namespace SimStateBisect
+{
+	/**
+	 * First frame at which two hash streams differ.
+	 * @param FirstFrame  Frame of A[0] and B[0]
+	 * A stream that ends early diverges where it ends. Zero hashes (hashing off) are skipped.
+	 */
+	UNITSIMCORE_API FSimDivergence CompareHashes(TConstArrayView<FSimStateHash> A, TConstArrayView<FSimStateHash> B, int32 FirstFrame);
+
+	/** First diverging frame of two recordings of the same match (e.g. from two machines) */
+	UNITSIMCORE_API FSimDivergence CompareReplays(const FSimReplay& A, const FSimReplay& B);
+
+	/** First differing domain and slot between two simulators' current states (Frame = last frame stepped) */
+	UNITSIMCORE_API FSimDivergence CompareStates(const FSimulatorCore& A, const FSimulatorCore& B);
+
+	/**
+	 * Play Replay on Sim to its end and report the first frame whose hash
+	 * differs from the recording's (not found if playback matches).
+	 */
+	UNITSIMCORE_API FSimDivergence VerifyReplay(FSimulatorCore& Sim, const FSimReplay& Replay);
+
+	/**
+	 * Play Replay on two simulators in lockstep (e.g. with different settings)
+	 * and report the first frame, domain and slot at which their states differ.
+	 */
+	UNITSIMCORE_API FSimDivergence CompareRuns(FSimulatorCore& SimA, FSimulatorCore& SimB, const FSimReplay& Replay);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FUnit;
+struct FTower;
+struct FUnitHandle;
+struct FSimGameSession;
+
+/** Subsystems the state hash is split into, so a mismatch can be traced to one */
+enum class ESimHashDomain : uint8
+{
+	FriendlyUnits,
+	EnemyUnits,
+	FriendlyTowers,
+	EnemyTowers,
+	Session,             // Clock, wave, id counters, time, crowns, result
+
+	Count
+};
+
+/**
+ * 64-bit hash of the canonical simulation state after a step.
+ *
+ * Covers what decides how the match continues: unit kinematics, HP, shields,
+ * cooldowns, targets, slots, charge and path progress; tower HP, cooldowns
+ * and targets; the session clock, crowns and result. Floats are hashed by
+ * bit pattern, units and towers in slot order. Display-only and derived data
+ * (labels, hot streams, spatial grids) is left out.
+ */
+struct UNITSIMCORE_API FSimStateHash
+{
+	static constexpr int32 NumDomains = static_cast<int32>(ESimHashDomain::Count);
+
+	/** Mix of every domain; what FFrameData and replays carry */
+	uint64 Combined = 0;
+
+	uint64 Domains[NumDomains] = {};
+
+	uint64 GetDomain(ESimHashDomain Domain) const { return Domains[static_cast<int32>(Domain)]; }
+
+	/** First domain that differs from Other (ESimHashDomain::Count if none) */
+	ESimHashDomain FindFirstDifference(const FSimStateHash& Other) const;
+
+	bool operator==(const FSimStateHash& Other) const;
+	bool operator!=(const FSimStateHash& Other) const { return !(*this == Other); }
+
+	friend FArchive& operator<<(FArchive& Ar, FSimStateHash& Hash);
+};
+
+/** Where two runs first disagree */
+struct UNITSIMCORE_API FSimDivergence
+{
+	/** First frame whose hashes differ (INDEX_NONE if the runs agree) */
+	int32 Frame = INDEX_NONE;
+
+	/** First differing domain of that frame */
+	ESimHashDomain Domain = ESimHashDomain::Count;
+
+	/** Unit or tower slot within Domain, if known (INDEX_NONE otherwise) */
+	int32 Index = INDEX_NONE;
+
+	bool IsFound() const { return Frame != INDEX_NONE; }
+	FString ToString() const;
+};
+
+/**
+ * Streaming hasher over fixed-width words. A multiply-xorshift per word, so
+ * hashing a full battle every frame costs about as much as one pass over it.
+ */
+class UNITSIMCORE_API FSimStateHasher
+{
+public:
+	void Add(uint64 Word)
+	{
+		State = (State ^ Word) * 0x9E3779B97F4A7C15ull;
+		State ^= State >> 29;
+	}
+
+	void Add(int32 Value) { Add(static_cast<uint64>(static_cast<uint32>(Value))); }
+	void Add(bool bValue) { Add(static_cast<uint64>(bValue ? 1 : 0)); }
+	void Add(float Value);
+	void Add(double Value);
+	void Add(const FVector2D& Value);
+	void Add(const FUnitHandle& Handle);
+
+	template<typename EnumType>
+	typename TEnableIf<TIsEnum<EnumType>::Value>::Type Add(EnumType Value)
+	{
+		Add(static_cast<uint64>(Value));
+	}
+
+	/** Finalized hash of everything added so far */
+	uint64 Get() const;
+
+private:
+	uint64 State = 0x84222325CBF29CE4ull;
+};
+
+namespace SimStateHash
+{
+	UNITSIMCORE_API uint64 HashUnit(const FUnit& Unit);
+	UNITSIMCORE_API uint64 HashTower(const FTower& Tower);
+
+	/** Squad or tower list in slot order (its count included) */
+	UNITSIMCORE_API uint64 HashUnits(TConstArrayView<FUnit> Units);
+	UNITSIMCORE_API uint64 HashTowers(TConstArrayView<FTower> Towers);
+
+	/** Session fields outside the towers; the simulator adds its clock and counters */
+	UNITSIMCORE_API void AddSession(FSimStateHasher& Hasher, const FSimGameSession& Session);
+
+	/** Fill Combined from Domains */
+	UNITSIMCORE_API void Combine(FSimStateHash& Hash);
+
+	UNITSIMCORE_API const TCHAR* GetDomainName(ESimHashDomain Domain);
+}
@@ -63,6 +63,47 @@ struct UNITSIMCORE_API FUnitEventData
 	bool bHasPosition = false;
 };
 
+/**
+ * What an FSimStateChange describes.
+ */
+enum class ESimStateChangeType : uint8
+{
+	UnitInjected,
+	UnitSpawned,
+	UnknownUnitType,
+	UnitRemoved,
+	UnitDamaged,
+	UnitKilled,
+	DestinationSet,
+	UnitRevived,
+	HealthSet,
+	StateLoaded
+};
+
+/**
+ * A state change as recorded by the simulator: the raw values, no text.
+ * Describe formats the human-readable line OnStateChanged carries.
+ */
+struct UNITSIMCORE_API FSimStateChange
+{
+	ESimStateChangeType Type = ESimStateChangeType::StateLoaded;
+	EUnitFaction Faction = EUnitFaction::Friendly;
+
+	/** Unit Id (-1 = none) */
+	int32 UnitId = -1;
+
+	/** Damage, HP or frame number, depending on Type */
+	int32 Value = 0;
+
+	FVector2D Position = FVector2D::ZeroVector;
+
+	/** Unit type (UnknownUnitType only) */
+	FName UnitType;
+
+	/** Format the description (allocates; only called for OnStateChanged listeners) */
+	FString Describe() const;
+};
+
 /**
  * Multicast delegate declarations for simulator callbacks.
  * Replaces C# ISimulatorCallbacks interface with UE5 delegate pattern.
@@ -81,6 +122,12 @@ DECLARE_MULTICAST_DELEGATE_OneParam(FOnUnitEvent, const FUnitEventData& /* Event
  * Container for all simulator callback delegates.
  * Equivalent to ISimulatorCallbacks interface in C#.
  * Ported from ISimulatorCallbacks.cs (176 lines)
+ *
+ * Unit events and state changes are recorded into typed per-frame buffers.
+ * During a step they are delivered to OnUnitEvent / OnStateChanged in one batch
+ * when the step's simulation work is done (before OnFrameGenerated); outside a
+ * step (injection, removal, state loading) they are delivered right away.
+ * Descriptions are only formatted when OnStateChanged has listeners.
  */
 struct UNITSIMCORE_API FSimulatorCallbacks
 {
@@ -89,15 +136,34 @@ struct UNITSIMCORE_API FSimulatorCallbacks
 	FOnStateChanged OnStateChanged;
 	FOnUnitEvent OnUnitEvent;
 
-	/** Broadcast a unit event */
-	void BroadcastUnitEvent(const FUnitEventData& EventData)
-	{
-		OnUnitEvent.Broadcast(EventData);
-	}
-
-	/** Broadcast state changed */
-	void BroadcastStateChanged(const FString& Description)
-	{
-		OnStateChanged.Broadcast(Description);
-	}
+	/** Record but don't deliver unit events and state changes (set while re-simulating frames observers already saw) */
+	bool bMuted = false;
+
+	/** Record a unit event */
+	void BroadcastUnitEvent(const FUnitEventData& EventData);
+
+	/** Record a state change */
+	void BroadcastStateChanged(const FSimStateChange& Change);
+
+	/** Events since the last step began, in the order they were recorded */
+	TConstArrayView<FUnitEventData> GetUnitEvents() const { return UnitEvents; }
+	TConstArrayView<FSimStateChange> GetStateChanges() const { return StateChanges; }
+
+	/** Start of a step: clear the buffers (keeping their capacity) and hold delivery until EndStep */
+	void BeginStep();
+
+	/** End of a step: deliver everything recorded during it */
+	void EndStep();
+
+private:
+	TArray<FUnitEventData> UnitEvents;
+	TArray<FSimStateChange> StateChanges;
+
+	/** Buffer entries already delivered (or dropped while muted) */
+	int32 NumDeliveredUnitEvents = 0;
+	int32 NumDeliveredStateChanges = 0;
+
+	bool bInStep = false;
+
+	void Deliver();
 };
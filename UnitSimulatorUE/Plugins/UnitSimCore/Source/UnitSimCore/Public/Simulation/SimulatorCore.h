@@ -4,10 +4,14 @@
 #include "GameConstants.h"
 #include "Simulation/SimulatorCallbacks.h"
 #include "Simulation/FrameData.h"
+#include "Simulation/SimFrameView.h"
+#include "Simulation/SimProfiler.h"
+#include "Simulation/SimStateHash.h"
 #include "Behaviors/SquadBehavior.h"
 #include "Behaviors/EnemyBehavior.h"
 #include "Combat/CombatSystem.h"
 #include "Combat/FrameEvents.h"
+#include "Combat/UnitSpatialGrid.h"
 #include "Towers/TowerBehavior.h"
 #include "GameState/SimGameSession.h"
 #include "GameState/GameResult.h"
@@ -15,119 +19,23 @@
 #include "GameState/InitialSetup.h"
 #include "Terrain/TerrainSystem.h"
 #include "Units/Unit.h"
+#include "Units/UnitHotStreams.h"
+#include "Units/UnitIdIndex.h"
 #include "Units/UnitRegistry.h"
-#include "Commands/ISimulationCommand.h"
-#include "Commands/SimulationCommands.h"
+#include "Commands/SimCommand.h"
+#include "Commands/SimCommandRing.h"
 
 // Forward declarations
 class FPathfindingGrid;
 class FAStarPathfinder;
+class FFlowFieldService;
+class FHierarchicalPathfinder;
+class FPathCache;
+class FPathRequestService;
+struct FPathRequest;
 class FDynamicObstacleSystem;
 class FPathSmoother;
 
-/**
- * Command type enum for tagged union dispatch.
- */
-enum class ESimCommandType : uint8
-{
-	Spawn,
-	Move,
-	Damage,
-	Kill,
-	Revive,
-	SetHealth,
-	Remove
-};
-
-/**
- * Concrete command wrapper implementing ISimulationCommand.
- * Uses tagged union pattern since USTRUCTs can't inherit from abstract classes.
- */
-class UNITSIMCORE_API FSimCommandWrapper : public ISimulationCommand
-{
-public:
-	ESimCommandType Type;
-
-	FSpawnUnitCommand SpawnCmd;
-	FMoveUnitCommand MoveCmd;
-	FDamageUnitCommand DamageCmd;
-	FKillUnitCommand KillCmd;
-	FReviveUnitCommand ReviveCmd;
-	FSetUnitHealthCommand SetHealthCmd;
-	FRemoveUnitCommand RemoveCmd;
-
-	virtual int32 GetFrameNumber() const override
-	{
-		switch (Type)
-		{
-		case ESimCommandType::Spawn:     return SpawnCmd.FrameNumber;
-		case ESimCommandType::Move:      return MoveCmd.FrameNumber;
-		case ESimCommandType::Damage:    return DamageCmd.FrameNumber;
-		case ESimCommandType::Kill:      return KillCmd.FrameNumber;
-		case ESimCommandType::Revive:    return ReviveCmd.FrameNumber;
-		case ESimCommandType::SetHealth: return SetHealthCmd.FrameNumber;
-		case ESimCommandType::Remove:    return RemoveCmd.FrameNumber;
-		default:                         return 0;
-		}
-	}
-
-	static TSharedPtr<FSimCommandWrapper> MakeSpawn(const FSpawnUnitCommand& Cmd)
-	{
-		auto W = MakeShared<FSimCommandWrapper>();
-		W->Type = ESimCommandType::Spawn;
-		W->SpawnCmd = Cmd;
-		return W;
-	}
-
-	static TSharedPtr<FSimCommandWrapper> MakeMove(const FMoveUnitCommand& Cmd)
-	{
-		auto W = MakeShared<FSimCommandWrapper>();
-		W->Type = ESimCommandType::Move;
-		W->MoveCmd = Cmd;
-		return W;
-	}
-
-	static TSharedPtr<FSimCommandWrapper> MakeDamage(const FDamageUnitCommand& Cmd)
-	{
-		auto W = MakeShared<FSimCommandWrapper>();
-		W->Type = ESimCommandType::Damage;
-		W->DamageCmd = Cmd;
-		return W;
-	}
-
-	static TSharedPtr<FSimCommandWrapper> MakeKill(const FKillUnitCommand& Cmd)
-	{
-		auto W = MakeShared<FSimCommandWrapper>();
-		W->Type = ESimCommandType::Kill;
-		W->KillCmd = Cmd;
-		return W;
-	}
-
-	static TSharedPtr<FSimCommandWrapper> MakeRevive(const FReviveUnitCommand& Cmd)
-	{
-		auto W = MakeShared<FSimCommandWrapper>();
-		W->Type = ESimCommandType::Revive;
-		W->ReviveCmd = Cmd;
-		return W;
-	}
-
-	static TSharedPtr<FSimCommandWrapper> MakeSetHealth(const FSetUnitHealthCommand& Cmd)
-	{
-		auto W = MakeShared<FSimCommandWrapper>();
-		W->Type = ESimCommandType::SetHealth;
-		W->SetHealthCmd = Cmd;
-		return W;
-	}
-
-	static TSharedPtr<FSimCommandWrapper> MakeRemove(const FRemoveUnitCommand& Cmd)
-	{
-		auto W = MakeShared<FSimCommandWrapper>();
-		W->Type = ESimCommandType::Remove;
-		W->RemoveCmd = Cmd;
-		return W;
-	}
-};
-
 /**
  * The core simulation engine.
  * Manages the simulation loop and state, providing a clean interface for
@@ -161,6 +69,13 @@ public:
 	/** Reset simulation state and re-initialize */
 	void Reset();
 
+	/**
+	 * Start a fresh match from Setup on this instance.
+	 * Unlike Reset, keeps the pathfinding grid and per-frame buffers allocated,
+	 * so one instance can run many matches back to back (batch runs).
+	 */
+	void Restart(const FInitialSetup& Setup);
+
 	// ════════════════════════════════════════════════════════════════════════
 	// Simulation Running
 	// ════════════════════════════════════════════════════════════════════════
@@ -178,6 +93,19 @@ public:
 	 */
 	FFrameData Step();
 
+	/**
+	 * Execute a single step like Step, but return a view of the resulting state
+	 * instead of a snapshot. Frame data is only built when OnFrameGenerated has
+	 * listeners, so an unobserved step formats and copies nothing.
+	 */
+	FSimFrameView Advance();
+
+	/**
+	 * Execute a single step without building frame data or firing any callback.
+	 * State advances exactly as with Step; used to re-simulate frames after a rollback.
+	 */
+	void StepSilent();
+
 	/** Stop a running simulation */
 	void Stop();
 
@@ -185,8 +113,21 @@ public:
 	// Command Queue
 	// ════════════════════════════════════════════════════════════════════════
 
-	/** Enqueue a simulation command */
-	void EnqueueCommand(TSharedPtr<ISimulationCommand> Command);
+	/**
+	 * Enqueue a command; safe from any thread (input, network). Commands run at
+	 * the start of their FrameNumber in frame order, in enqueue order within a
+	 * frame; ones for a frame already passed run at the next step. Returns false
+	 * if COMMAND_RING_CAPACITY commands are already waiting to be picked up.
+	 *
+	 * A dead unit stays addressable while a Revive or SetHealth for it is queued.
+	 * Once it is reclaimed (see ReclaimDeadUnits) its Id no longer resolves, so
+	 * revive a unit that died in an earlier frame by queuing the command before
+	 * the next step; a later one is ignored with a warning.
+	 */
+	bool EnqueueCommand(const FSimCommand& Command);
+
+	/** Enqueue many commands at once (e.g. a mass spawn), kept contiguous. All or nothing. */
+	bool EnqueueCommands(TConstArrayView<FSimCommand> Commands);
 
 	// ════════════════════════════════════════════════════════════════════════
 	// State Loading
@@ -198,6 +139,31 @@ public:
 	/** Get current frame data snapshot */
 	FFrameData GetCurrentFrameData() const;
 
+	/** Read-only view of the current state (no copies; see FSimFrameView) */
+	FSimFrameView GetFrameView() const { return MakeFrameView(CurrentFrame); }
+
+	// ════════════════════════════════════════════════════════════════════════
+	// Binary Snapshots
+	// ════════════════════════════════════════════════════════════════════════
+
+	/**
+	 * Write the complete simulation state to OutData, replacing its contents but
+	 * keeping its allocation: units (with paths, slots and cooldown counters),
+	 * towers, session, squad behavior, pending commands, Id counters, free slots
+	 * and dynamic obstacles. Configuration (callbacks, unit registry, parallel
+	 * flag) is not included. Non-const because commands still in the ring are
+	 * moved to the pending list first.
+	 */
+	void SaveSnapshot(TArray<uint8>& OutData);
+
+	/**
+	 * Restore a state written by SaveSnapshot, on this or another instance.
+	 * Stepping afterwards produces exactly the frames the saved simulator would
+	 * have produced. No callbacks fire. Returns false for data from another
+	 * snapshot version (state untouched) or truncated data (left uninitialized).
+	 */
+	bool RestoreSnapshot(const TArray<uint8>& Data);
+
 	// ════════════════════════════════════════════════════════════════════════
 	// Unit Injection / Removal
 	// ════════════════════════════════════════════════════════════════════════
@@ -211,7 +177,7 @@ public:
 		float Speed = -1.f,
 		float TurnSpeed = -1.f);
 
-	/** Remove a unit by ID and faction */
+	/** Remove a unit by ID and faction. Handles to units in later slots are re-pointed. */
 	bool RemoveUnit(int32 UnitId, EUnitFaction Faction);
 
 	/** Clear all attack slots on friendly units */
@@ -228,6 +194,20 @@ public:
 	const TArray<FUnit>& GetEnemyUnits() const { return EnemySquad; }
 	TArray<FUnit>& GetFriendlyUnitsRef() { return FriendlySquad; }
 	TArray<FUnit>& GetEnemyUnitsRef() { return EnemySquad; }
+
+	/** O(1) lookup of a unit by Id (nullptr if not present) */
+	FUnit* FindUnit(EUnitFaction Faction, int32 UnitId);
+	const FUnit* FindUnit(EUnitFaction Faction, int32 UnitId) const;
+
+	/** Hot kinematic streams aligned with a squad (valid during Phase 1) */
+	FUnitHotStreams& GetHotStreams(EUnitFaction Faction)
+	{
+		return Faction == EUnitFaction::Friendly ? FriendlyHotStreams : EnemyHotStreams;
+	}
+	const FUnitHotStreams& GetHotStreams(EUnitFaction Faction) const
+	{
+		return Faction == EUnitFaction::Friendly ? FriendlyHotStreams : EnemyHotStreams;
+	}
 	const FVector2D& GetMainTarget() const { return MainTarget; }
 	FSimGameSession& GetGameSession() { return GameSession; }
 	const FSimGameSession& GetGameSession() const { return GameSession; }
@@ -235,6 +215,29 @@ public:
 	const FTerrainSystem& GetTerrainSystem() const { return TerrainSystem; }
 	FAStarPathfinder* GetPathfinder() const { return Pathfinder.Get(); }
 	FPathfindingGrid* GetPathfindingGrid() const { return PathfindingGrid.Get(); }
+	FFlowFieldService* GetFlowFields() const { return FlowFields.Get(); }
+	FHierarchicalPathfinder* GetHierarchicalPathfinder() const { return HierarchicalPathfinder.Get(); }
+
+	FPathCache* GetPathCache() const { return PathCache.Get(); }
+	FPathRequestService* GetPathRequests() const { return PathRequests.Get(); }
+
+	/**
+	 * Path between two world positions. A goal registered with the flow fields
+	 * (a tower, a bridge center, the main target) is traced from its cached field.
+	 * Other queries are answered from the path cache when possible, else searched:
+	 * HPA* when the cells are far apart, A* otherwise.
+	 * Serial callers only: all of these share scratch.
+	 */
+	bool FindPath(const FVector2D& Start, const FVector2D& Goal, TArray<FVector2D>& OutPath,
+		EMovementLayer Layer = EMovementLayer::Ground);
+
+	/**
+	 * Queue a unit's replan for this step (serial callers only). Answered like
+	 * FindPath, under the per-frame search budget; the result is applied to the unit
+	 * (path, CurrentDestination, OnReplan) at the end of the step, and a deferred
+	 * request leaves the unit untouched so it asks again next frame.
+	 */
+	void RequestPath(const FPathRequest& Request);
 	FUnitRegistry& GetUnitRegistry() { return UnitRegistry; }
 
 	int32 GetCurrentWave() const { return CurrentWave; }
@@ -243,6 +246,28 @@ public:
 	void SetHasMoreWaves(bool bValue) { bHasMoreWaves = bValue; }
 	bool AllEnemiesDead() const;
 
+	/** Run Phase 1 enemy and tower updates under ParallelFor (results are identical either way) */
+	bool GetParallelPhase1() const { return bParallelPhase1; }
+	void SetParallelPhase1(bool bValue) { bParallelPhase1 = bValue; }
+
+	/** Run the step's path searches on worker tasks (results are identical either way) */
+	bool GetAsyncPathRequests() const { return bAsyncPathRequests; }
+	void SetAsyncPathRequests(bool bValue) { bAsyncPathRequests = bValue; }
+
+	/** Per-phase timings and work counters of recent steps */
+	FSimProfiler& GetProfiler() { return Profiler; }
+	const FSimProfiler& GetProfiler() const { return Profiler; }
+
+	/** Hash of the state after the last step, Initialize or RestoreSnapshot */
+	const FSimStateHash& GetStateHash() const { return StateHash; }
+
+	/** Hash the current state now (what GetStateHash holds right after a step) */
+	FSimStateHash ComputeStateHash() const;
+
+	/** Hash the state at the end of every step (on by default; one pass over units and towers). Off, steps zero the hash. */
+	bool IsStateHashEnabled() const { return bStateHashEnabled; }
+	void SetStateHashEnabled(bool bValue) { bStateHashEnabled = bValue; }
+
 	/** Callback delegates container */
 	FSimulatorCallbacks Callbacks;
 
@@ -259,6 +284,21 @@ private:
 	TArray<FUnit> FriendlySquad;
 	TArray<FUnit> EnemySquad;
 
+	// SoA mirrors of the squads' hot fields; FUnit records remain the cold side table
+	FUnitHotStreams FriendlyHotStreams;
+	FUnitHotStreams EnemyHotStreams;
+
+	// Id -> slot lookups, updated on append and rebuilt when slots move
+	FUnitIdIndex FriendlyIdIndex;
+	FUnitIdIndex EnemyIdIndex;
+
+	// Dead slots available for reuse this frame, highest first so Pop() yields the lowest
+	TArray<int32> FriendlyFreeSlots;
+	TArray<int32> EnemyFreeSlots;
+
+	// Ids of dead units queued Revive/SetHealth commands name (ReclaimDeadUnits scratch)
+	TArray<int32> ReviveTargets;
+
 	FSquadBehavior SquadBehavior;
 	FEnemyBehavior EnemyBehavior;
 	FCombatSystem CombatSystem;
@@ -271,14 +311,45 @@ private:
 	// Pathfinding (heap-allocated for forward-declared types)
 	TUniquePtr<FPathfindingGrid> PathfindingGrid;
 	TUniquePtr<FAStarPathfinder> Pathfinder;
+	TUniquePtr<FFlowFieldService> FlowFields;
+	TUniquePtr<FHierarchicalPathfinder> HierarchicalPathfinder;
+	TUniquePtr<FPathCache> PathCache;
+	TUniquePtr<FPathRequestService> PathRequests;
 	TUniquePtr<FDynamicObstacleSystem> DynamicObstacleSystem;
 	TUniquePtr<FPathSmoother> PathSmoother;
 
-	// Command queue
-	TQueue<TSharedPtr<ISimulationCommand>> CommandQueue;
+	// Collision broadphase (reused across frames to keep its buffers)
+	FUnitSpatialGrid CollisionGrid;
+	TArray<FUnit*> CollisionUnits;
+	TArray<int32> CollisionCandidates;
+
+	// Death processing scratch, reset at the start of each ProcessDeaths (not simulation state)
+	TArray<int32> FriendlyDeathQueue;
+	TArray<int32> EnemyDeathQueue;
+	TSet<int32> ProcessedFriendly;
+	TSet<int32> ProcessedEnemy;
+	TArray<FUnitSpawnRequest> DeathSpawns;
+	TArray<int32> NewlyDead;
+
+	// Phase 1 event buffer, cleared at the start of each frame (not simulation state)
+	FFrameEvents FrameEvents;
+
+	// Commands from any thread land in the ring; the simulation thread moves them
+	// into PendingCommands, kept sorted by frame (stable)
+	FSimCommandRing CommandRing;
+	TArray<FSimCommand> PendingCommands;
+
+	// Diagnostics only; not part of the snapshot
+	FSimProfiler Profiler;
+
+	// Derived from the state, so recomputed on restore rather than saved
+	FSimStateHash StateHash;
+	bool bStateHashEnabled = true;
 
 	int32 CurrentWave = 0;
 	bool bHasMoreWaves = true;
+	bool bParallelPhase1 = true;
+	bool bAsyncPathRequests = true;
 	bool bIsInitialized = false;
 	bool bIsRunning = false;
 
@@ -287,7 +358,19 @@ private:
 	// ════════════════════════════════════════════════════════════════════════
 
 	void ProcessCommands();
-	void ExecuteCommand(const TSharedPtr<ISimulationCommand>& Cmd);
+	void ExecuteCommand(const FSimCommand& Cmd);
+
+	/** Move everything published to the ring into PendingCommands */
+	void DrainCommandRing();
+
+	/** Commands, Phase 1, collisions and Phase 2 of the current frame (shared by Step, Advance and StepSilent) */
+	void AdvanceFrame();
+
+	FSimFrameView MakeFrameView(int32 FrameNumber) const
+	{
+		return FSimFrameView(FrameNumber, FriendlySquad, EnemySquad, GameSession, MainTarget, CurrentWave, bHasMoreWaves,
+			StateHash.Combined);
+	}
 
 	// ════════════════════════════════════════════════════════════════════════
 	// Phase 2: Apply Events
@@ -299,6 +382,9 @@ private:
 	void ProcessDeaths(FFrameEvents& Events);
 	void ApplySpawnEvents(const FFrameEvents& Events);
 
+	/** Target of a damage event, or nullptr if the slot no longer holds the unit it was aimed at */
+	FUnit* FindEventTarget(EUnitFaction Faction, int32 TargetIndex, int32 TargetId);
+
 	// ════════════════════════════════════════════════════════════════════════
 	// Collision Resolution
 	// ════════════════════════════════════════════════════════════════════════
@@ -310,6 +396,25 @@ private:
 	// ════════════════════════════════════════════════════════════════════════
 
 	void ConfigureStaticObstacles();
+
+	/** Create the pathfinding grid and the systems sharing it if missing. Returns true if it was created. */
+	bool EnsurePathfinding();
+
+	/**
+	 * Flow field or path cache answer for a query, or an invalid endpoint (true,
+	 * with bOutFound set). False when it needs a search; bOutHierarchical says which.
+	 */
+	bool AnswerPathQuery(const FVector2D& Start, const FVector2D& Goal, EMovementLayer Layer,
+		TArray<FVector2D>& OutPath, bool& bOutFound, bool& bOutHierarchical);
+
+	/** Answer or budget this step's path requests and launch their searches */
+	void DispatchPathRequests();
+
+	/** Wait for the searches and apply every granted request in submission order */
+	void ApplyPathRequests();
+
+	/** Shared body of SaveSnapshot / RestoreSnapshot; the field order is the snapshot layout */
+	void SerializeState(FArchive& Ar);
 	void SpawnInitialUnits(const TArray<FUnitSpawnSetup>& UnitSetups);
 	static FVector2D CalculateSpreadPosition(const FVector2D& Center, float Radius, int32 Index, int32 Total);
 	void SpawnUnitFromSetup(const FName& UnitId, EUnitFaction Faction, const FVector2D& Position, int32 HPOverride);
@@ -318,6 +423,31 @@ private:
 	int32 GetNextFriendlyId() { return ++NextFriendlyId; }
 	int32 GetNextEnemyId() { return ++NextEnemyId; }
 
+	TArray<FUnit>& GetSquad(EUnitFaction Faction) { return Faction == EUnitFaction::Friendly ? FriendlySquad : EnemySquad; }
+	FUnitIdIndex& GetIdIndex(EUnitFaction Faction) { return Faction == EUnitFaction::Friendly ? FriendlyIdIndex : EnemyIdIndex; }
+	TArray<int32>& GetFreeSlots(EUnitFaction Faction) { return Faction == EUnitFaction::Friendly ? FriendlyFreeSlots : EnemyFreeSlots; }
+
+	/** Place a unit in a recycled dead slot of its faction's squad (or append) and index its Id */
+	void AddUnitToSquad(const FUnit& Unit);
+
+	/** Rebuild both Id indices and drop queued free slots after the squads were replaced */
+	void ReindexSquads();
+
+	/**
+	 * Run at the start of a frame. A squad whose dead slots reach
+	 * max(SQUAD_COMPACTION_MIN_DEAD, living count) is compacted in order and its
+	 * handles remapped; otherwise its dead slots are queued for reuse by spawns.
+	 * Units dead at this point were already reported dead in an earlier frame.
+	 * Dead units named by a queued Revive/SetHealth are kept in place.
+	 */
+	void ReclaimDeadUnits(EUnitFaction Faction);
+
+	/** Warn that a Revive/SetHealth found no unit (never existed, removed, or reclaimed) */
+	void LogReclaimedTarget(const TCHAR* CommandName, EUnitFaction Faction, int32 UnitId) const;
+
+	/** Re-point every handle into Faction's squad after its slots moved */
+	void RebindHandles(EUnitFaction Faction);
+
 	/** Get living units combined from both squads */
 	void GetAllLivingUnits(TArray<FUnit*>& OutUnits);
 
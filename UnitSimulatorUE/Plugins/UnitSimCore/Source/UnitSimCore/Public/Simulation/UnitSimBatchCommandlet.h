@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnitSimBatchCommandlet.generated.h"
+
+/**
+ * Headless batch of random skirmishes, no game mode or world required.
+ * Usage: UnrealEditor-Cmd <Project> -run=UnitSimBatch [-Matches=N] [-Workers=N] [-Seed=N] [-Units=N]
+ * Prints the FSimBatchSummary table (outcomes, crowns, tower HP, matches/sec/core).
+ */
+UCLASS()
+class UNITSIMCORE_API UUnitSimBatchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUnitSimBatchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
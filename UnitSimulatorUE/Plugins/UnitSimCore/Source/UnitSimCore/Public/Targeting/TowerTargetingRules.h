@@ -5,6 +5,7 @@
 
 struct FUnit;
 struct FTower;
+class FUnitHotStreams;
 
 /**
  * Static targeting rules for units selecting tower/unit targets.
@@ -28,6 +29,11 @@ namespace TowerTargetingRules
 		const FUnit& Unit,
 		const TArray<FUnit>& Enemies);
 
+	/** SelectUnitTarget over a squad's hot streams (same result, no cold data touched) */
+	UNITSIMCORE_API int32 SelectUnitTarget(
+		const FUnit& Unit,
+		const FUnitHotStreams& Enemies);
+
 	/**
 	 * Select the best target (unit or tower) based on target priority.
 	 * @param OutUnitTargetIndex    Index of selected unit target (-1 if none)
@@ -39,4 +45,12 @@ namespace TowerTargetingRules
 		const TArray<FTower>& Towers,
 		int32& OutUnitTargetIndex,
 		int32& OutTowerTargetIndex);
+
+	/** SelectTarget over a squad's hot streams */
+	UNITSIMCORE_API void SelectTarget(
+		const FUnit& Unit,
+		const FUnitHotStreams& Enemies,
+		const TArray<FTower>& Towers,
+		int32& OutUnitTargetIndex,
+		int32& OutTowerTargetIndex);
 }
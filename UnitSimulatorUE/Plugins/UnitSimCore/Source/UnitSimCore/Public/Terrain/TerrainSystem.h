@@ -18,6 +18,9 @@ public:
 	/** Adjust destination for ground units (route through bridge if crossing river) */
 	FVector2D GetAdjustedDestination(const FUnit& Unit, const FVector2D& Destination) const;
 
+	/** Centers of the left and right bridges (the crossing points GetAdjustedDestination routes to) */
+	static TArray<FVector2D> GetBridgeCenters();
+
 private:
 	static bool IsCrossingRiver(const FVector2D& From, const FVector2D& To);
 	static FVector2D GetNearestBridgeCenter(const FVector2D& Position);
@@ -3,10 +3,12 @@
 #include "CoreMinimal.h"
 #include "GameConstants.h"
 #include "Towers/TowerStats.h"
+#include "Units/UnitHandle.h"
 #include "Tower.generated.h"
 
 // Forward declaration
 struct FUnit;
+class FUnitHotStreams;
 
 /**
  * Game tower state.
@@ -73,9 +75,9 @@ struct UNITSIMCORE_API FTower
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float AttackCooldown = 0.f;
 
-	/** Index of current target unit (-1 = none) */
+	/** Current target unit in the opposing squad (unset = none) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	int32 CurrentTargetIndex = -1;
+	FUnitHandle CurrentTarget;
 
 	// ════════════════════════════════════════════════════════════════════════
 	// Computed
@@ -90,6 +92,7 @@ struct UNITSIMCORE_API FTower
 
 	void TakeDamage(int32 Amount);
 	bool CanAttackUnit(const FUnit& InTarget) const;
+	bool CanAttackUnit(const FUnitHotStreams& Units, int32 Index) const;
 	void OnAttackPerformed();
 	void UpdateCooldown(float DeltaTime);
 
@@ -1,14 +1,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Combat/FrameEvents.h"
 
 struct FTower;
-struct FUnit;
-struct FFrameEvents;
 struct FSimGameSession;
+class FUnitHotStreams;
 
 /**
  * Tower behavior: targeting, attack, cooldown.
+ * Targeting only needs unit kinematics, so towers scan the squads' hot streams.
  * Ported from Towers/TowerBehavior.cs (128 lines)
  */
 class UNITSIMCORE_API FTowerBehavior
@@ -17,47 +18,52 @@ public:
 	/**
 	 * Update a list of towers against enemy units.
 	 * @param Towers       Tower array (modified: cooldown, target)
-	 * @param TowerCount   Number of towers
-	 * @param Enemies      Enemy unit array
-	 * @param EnemyCount   Number of enemies
+	 * @param Enemies      Hot streams of the enemy squad
 	 * @param Events       Frame events to collect attack events into
 	 * @param DeltaTime    Frame time in seconds
+	 * @param bParallel    Update towers under ParallelFor (events still land in tower order)
 	 */
 	void UpdateTowers(
 		TArray<FTower>& Towers,
-		const TArray<FUnit>& Enemies,
+		const FUnitHotStreams& Enemies,
 		FFrameEvents& Events,
-		float DeltaTime);
+		float DeltaTime,
+		bool bParallel = false);
 
 	/**
 	 * Update all towers for both factions.
 	 * @param Session          Game session with tower lists
-	 * @param FriendlyUnits    Friendly units (targets for enemy towers)
-	 * @param EnemyUnits       Enemy units (targets for friendly towers)
+	 * @param FriendlyUnits    Friendly hot streams (targets for enemy towers)
+	 * @param EnemyUnits       Enemy hot streams (targets for friendly towers)
 	 * @param Events           Frame events collector
 	 * @param DeltaTime        Frame time in seconds
+	 * @param bParallel        Update towers under ParallelFor
 	 */
 	void UpdateAllTowers(
 		FSimGameSession& Session,
-		const TArray<FUnit>& FriendlyUnits,
-		const TArray<FUnit>& EnemyUnits,
+		const FUnitHotStreams& FriendlyUnits,
+		const FUnitHotStreams& EnemyUnits,
 		FFrameEvents& Events,
-		float DeltaTime);
+		float DeltaTime,
+		bool bParallel = false);
 
 private:
+	/** Per-batch event buffers for the parallel update (kept across frames) */
+	TArray<FFrameEvents> BatchEvents;
+
 	/** Update a single tower */
 	void UpdateTower(
 		FTower& Tower,
 		int32 TowerIndex,
-		const TArray<FUnit>& Enemies,
+		const FUnitHotStreams& Enemies,
 		FFrameEvents& Events,
 		float DeltaTime);
 
 	/** Validate current target and select new one if needed */
-	void ValidateAndUpdateTarget(FTower& Tower, const TArray<FUnit>& Enemies);
+	void ValidateAndUpdateTarget(FTower& Tower, const FUnitHotStreams& Enemies);
 
 	/** Find nearest valid target unit for this tower */
-	int32 FindNearestTarget(const FTower& Tower, const TArray<FUnit>& Enemies);
+	int32 FindNearestTarget(const FTower& Tower, const FUnitHotStreams& Enemies);
 
 	/** Process tower attack */
 	void ProcessAttack(FTower& Tower, int32 TowerIndex, FFrameEvents& Events);
@@ -4,6 +4,7 @@
 #include "GameConstants.h"
 #include "Abilities/AbilityTypes.h"
 #include "Units/ChargeState.h"
+#include "Units/UnitHandle.h"
 #include "Unit.generated.h"
 
 // Forward declarations
@@ -88,9 +89,9 @@ struct UNITSIMCORE_API FUnit
 	// Targeting
 	// ════════════════════════════════════════════════════════════════════════
 
-	/** Index of the target unit in the unit array (-1 = none) */
+	/** Target unit in the opposing squad (unset = none) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	int32 TargetIndex = -1;
+	FUnitHandle Target;
 
 	/** Index of the target tower in the tower array (-1 = none) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
@@ -113,7 +114,7 @@ struct UNITSIMCORE_API FUnit
 	// Attack Slots
 	// ════════════════════════════════════════════════════════════════════════
 
-	/** Attack slot occupants (unit indices, -1 = empty) */
+	/** Attack slot occupants (attacker unit Ids, -1 = empty) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<int32> AttackSlots;
 
@@ -177,7 +178,7 @@ struct UNITSIMCORE_API FUnit
 	bool bHasStatusEffect = false;
 
 	// ════════════════════════════════════════════════════════════════════════
-	// Avoidance / Movement Paths (runtime, not serialized)
+	// Avoidance / Movement Paths (runtime, not reflected)
 	// ════════════════════════════════════════════════════════════════════════
 
 	TArray<FVector2D> AvoidancePath;
@@ -223,15 +224,18 @@ struct UNITSIMCORE_API FUnit
 	FVector2D GetSlotPosition(int32 SlotIndex, float AttackerRadius) const;
 
 	/** Try to claim an empty attack slot. Returns slot index or -1 */
-	int32 TryClaimSlot(int32 AttackerIndex);
+	int32 TryClaimSlot(int32 AttackerId);
+
+	/** Best (nearest) slot ClaimBestSlot would take, without claiming it. Returns slot index or -1 */
+	int32 FindBestSlot(int32 AttackerId, const FVector2D& AttackerPosition, float AttackerRadius) const;
 
 	/** Claim the best (nearest) attack slot. Returns slot index or -1 */
-	int32 ClaimBestSlot(int32 AttackerIndex, const FVector2D& AttackerPosition, float AttackerRadius);
+	int32 ClaimBestSlot(int32 AttackerId, const FVector2D& AttackerPosition, float AttackerRadius);
 
 	/** Release a slot previously occupied by attacker */
-	void ReleaseSlot(int32 AttackerIndex, int32 SlotIdx);
+	void ReleaseSlot(int32 AttackerId, int32 SlotIdx);
 
-	// Path management
+	// Path management (set/clear keep the buffers' capacity for the next path)
 	void SetAvoidancePath(const TArray<FVector2D>& Waypoints);
 	bool TryGetNextAvoidanceWaypoint(FVector2D& OutWaypoint) const;
 	void ClearAvoidancePath();
@@ -257,4 +261,7 @@ struct UNITSIMCORE_API FUnit
 
 	/** Called after an attack is performed (consumes charge, etc.) */
 	void OnAttackPerformed();
+
+	/** Binary round trip of the full unit, including ability caches and paths (simulator snapshots) */
+	void Serialize(FArchive& Ar);
 };
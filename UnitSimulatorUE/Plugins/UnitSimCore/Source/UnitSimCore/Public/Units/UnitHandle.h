@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnitHandle.generated.h"
+
+struct FUnit;
+class FUnitHotStreams;
+
+/**
+ * Generational reference to a unit slot in a squad array.
+ *
+ * Index is the slot; Generation is the Id of the unit that occupied the slot
+ * when the handle was made. Unit Ids are never reused within a faction, so a
+ * handle whose slot now holds a different unit (or no unit) resolves to
+ * INDEX_NONE instead of silently pointing at the wrong unit.
+ */
+USTRUCT(BlueprintType)
+struct UNITSIMCORE_API FUnitHandle
+{
+	GENERATED_BODY()
+
+	/** Slot in the owning squad array (INDEX_NONE = unset) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Index = INDEX_NONE;
+
+	/** Id of the unit the handle refers to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Generation = INDEX_NONE;
+
+	/** Handle to the unit currently in Squad[InIndex] (unset if out of range) */
+	static FUnitHandle Make(const TArray<FUnit>& Squad, int32 InIndex);
+	static FUnitHandle Make(const FUnitHotStreams& Streams, int32 InIndex);
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+	void Reset() { Index = INDEX_NONE; Generation = INDEX_NONE; }
+
+	/** Current slot of the referenced unit, or INDEX_NONE if the handle is stale. O(1). */
+	int32 Resolve(const TArray<FUnit>& Squad) const;
+	int32 Resolve(const FUnitHotStreams& Streams) const;
+
+	bool operator==(const FUnitHandle& Other) const
+	{
+		return Index == Other.Index && Generation == Other.Generation;
+	}
+	bool operator!=(const FUnitHandle& Other) const { return !(*this == Other); }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameConstants.h"
+
+struct FUnit;
+
+/**
+ * Structure-of-arrays store for a squad's hot kinematic fields
+ * (Position, Velocity, Forward, Radius, bIsDead, Layer).
+ *
+ * Index i always aligns with slot i of the owning TArray<FUnit>, which acts as
+ * the cold side table (identity, stats, ability caches, paths, attack slots).
+ * Distance scans read these dense streams instead of whole FUnit records.
+ * Unit Ids are mirrored too so FUnitHandle can validate against the streams.
+ * Coordinates keep FVector2D precision so scans produce the same results as
+ * the equivalent FUnit loops.
+ */
+class UNITSIMCORE_API FUnitHotStreams
+{
+public:
+	using FReal = FVector2D::FReal;
+
+	/** Rebuild all streams from a squad */
+	void Build(const TArray<FUnit>& Units);
+
+	/** Write one unit's hot fields back into the streams (slot must exist) */
+	void Sync(int32 Index, const FUnit& Unit);
+
+	/** Number of slots mirrored */
+	int32 Num() const { return PosX.Num(); }
+
+	// ════════════════════════════════════════════════════════════════════════
+	// FUnit-style Accessors
+	// ════════════════════════════════════════════════════════════════════════
+
+	FVector2D GetPosition(int32 Index) const { return FVector2D(PosX[Index], PosY[Index]); }
+	FVector2D GetVelocity(int32 Index) const { return FVector2D(VelX[Index], VelY[Index]); }
+	FVector2D GetForward(int32 Index) const { return FVector2D(FwdX[Index], FwdY[Index]); }
+	float GetRadius(int32 Index) const { return Radius[Index]; }
+	int32 GetId(int32 Index) const { return Ids[Index]; }
+	bool IsDead(int32 Index) const { return (Flags[Index] & FlagDead) != 0; }
+	EMovementLayer GetLayer(int32 Index) const
+	{
+		return (Flags[Index] & FlagAir) != 0 ? EMovementLayer::Air : EMovementLayer::Ground;
+	}
+
+	/** Living and on a layer covered by CanTarget (mirrors FUnit::CanAttackUnit) */
+	bool IsTargetableBy(int32 Index, ETargetType CanTarget) const
+	{
+		if (IsDead(Index)) return false;
+		const ETargetType TargetLayer = (Flags[Index] & FlagAir) != 0 ? ETargetType::Air : ETargetType::Ground;
+		return (CanTarget & TargetLayer) != ETargetType::None;
+	}
+
+	/** Same result as FVector2D::Distance(From, GetPosition(Index)) */
+	FReal DistanceTo(int32 Index, const FVector2D& From) const
+	{
+		return FMath::Sqrt(FMath::Square(PosX[Index] - From.X) + FMath::Square(PosY[Index] - From.Y));
+	}
+
+	/** Index of the nearest slot targetable by CanTarget, or -1 (lowest index wins ties) */
+	int32 FindNearestTargetable(const FVector2D& From, ETargetType CanTarget, float& OutDistance) const;
+
+private:
+	static constexpr uint8 FlagDead = 1 << 0;
+	static constexpr uint8 FlagAir = 1 << 1;
+
+	TArray<FReal> PosX;
+	TArray<FReal> PosY;
+	TArray<FReal> VelX;
+	TArray<FReal> VelY;
+	TArray<FReal> FwdX;
+	TArray<FReal> FwdY;
+	TArray<float> Radius;
+	TArray<uint8> Flags;
+	TArray<int32> Ids;
+};
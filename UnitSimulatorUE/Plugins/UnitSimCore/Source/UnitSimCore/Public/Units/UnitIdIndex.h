@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FUnit;
+struct FUnitHandle;
+
+/**
+ * Unit Id -> squad slot lookup for one faction.
+ * Kept in step with the squad array by the owner: Add on append, Rebuild after
+ * anything that moves slots. Find validates the slot so a missed update
+ * degrades to "not found" rather than returning the wrong unit.
+ */
+class UNITSIMCORE_API FUnitIdIndex
+{
+public:
+	/** Re-index every slot of Squad */
+	void Rebuild(const TArray<FUnit>& Squad);
+
+	/** Record that UnitId now lives at Slot */
+	void Add(int32 UnitId, int32 Slot) { SlotById.Add(UnitId, Slot); }
+
+	void Remove(int32 UnitId) { SlotById.Remove(UnitId); }
+	void Reset() { SlotById.Reset(); }
+
+	/** Slot of UnitId in Squad, or INDEX_NONE. O(1). */
+	int32 Find(const TArray<FUnit>& Squad, int32 UnitId) const;
+
+	/** Point Handle at the current slot of its unit, or reset it if the unit is gone */
+	void Rebind(FUnitHandle& Handle, const TArray<FUnit>& Squad) const;
+
+	int32 Num() const { return SlotById.Num(); }
+
+private:
+	TMap<int32, int32> SlotById;
+};
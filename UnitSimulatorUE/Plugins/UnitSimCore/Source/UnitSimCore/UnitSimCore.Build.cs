@@ -14,5 +14,9 @@ public class UnitSimCore : ModuleRules
 			"Json",
 			"JsonUtilities"
 		});
+
+		// Q16.16 fixed-point simulation math: bit-exact lockstep and replay across machines (see Math/SimMath.h)
+		bool bUseFixedPointMath = false;
+		PublicDefinitions.Add("UNITSIM_FIXED_POINT=" + (bUseFixedPointMath ? "1" : "0"));
 	}
 }
@@ -1,6 +1,7 @@
 #include "Misc/AutomationTest.h"
 #include "Combat/CombatSystem.h"
 #include "Combat/FrameEvents.h"
+#include "Combat/UnitSpatialGrid.h"
 #include "Units/Unit.h"
 
 // ============================================================================
@@ -115,7 +116,8 @@ bool FCombatDeathSpawn::RunTest(const FString& Parameters)
 	DeadUnit.DeathSpawnAbility.SpawnUnitHP = 0;
 
 	// Act
-	TArray<FUnitSpawnRequest> Spawns = Combat.CreateDeathSpawnRequests(DeadUnit);
+	TArray<FUnitSpawnRequest> Spawns;
+	Combat.CreateDeathSpawnRequests(DeadUnit, Spawns);
 
 	// Assert
 	TestEqual(TEXT("Spawn count"), Spawns.Num(), 3);
@@ -147,7 +149,8 @@ bool FCombatDeathSpawnNoAbility::RunTest(const FString& Parameters)
 	DeadUnit.bIsDead = true;
 
 	// Act
-	TArray<FUnitSpawnRequest> Spawns = Combat.CreateDeathSpawnRequests(DeadUnit);
+	TArray<FUnitSpawnRequest> Spawns;
+	Combat.CreateDeathSpawnRequests(DeadUnit, Spawns);
 
 	// Assert
 	TestEqual(TEXT("No spawns"), Spawns.Num(), 0);
@@ -207,13 +210,19 @@ bool FFrameEventsClear::RunTest(const FString& Parameters)
 {
 	// Arrange
 	FFrameEvents Events;
-	Events.AddDamage(0, 1, 10);
-	Events.AddTowerDamage(0, 1, 20);
+	FUnitHandle Target;
+	Target.Index = 1;
+	Target.Generation = 7;
+	Events.AddDamage(0, EUnitFaction::Enemy, Target, 10);
+	Events.AddTowerDamage(0, EUnitFaction::Enemy, Target, 20);
 	Events.AddDamageToTower(0, 1, 30);
 	FUnitSpawnRequest Req;
 	Req.UnitId = FName(TEXT("test"));
 	Events.AddSpawn(Req);
 
+	TestEqual(TEXT("Damage carries the target's Id"), Events.Damages[0].TargetId, 7);
+	TestEqual(TEXT("Tower damage carries the target's Id"), Events.TowerDamages[0].TargetId, 7);
+
 	// Act
 	Events.Clear();
 
@@ -251,7 +260,8 @@ bool FCombatDeathDamage::RunTest(const FString& Parameters)
 	TArray<FUnit> Enemies = { NearEnemy, FarEnemy };
 
 	// Act
-	TArray<int32> NewlyDead = Combat.ApplyDeathDamage(DeadUnit, Enemies);
+	TArray<int32> NewlyDead;
+	Combat.ApplyDeathDamage(DeadUnit, Enemies, NewlyDead);
 
 	// Assert
 	TestTrue(TEXT("Near enemy killed"), Enemies[0].bIsDead);
@@ -262,3 +272,54 @@ bool FCombatDeathDamage::RunTest(const FString& Parameters)
 
 	return true;
 }
+
+// ============================================================================
+// Collision Broadphase
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatSpatialGridNeighbors,
+	"UnitSimCore.Combat.SpatialGrid.GathersSameLayerNeighborsInOrder",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCombatSpatialGridNeighbors::RunTest(const FString& Parameters)
+{
+	// Arrange: 0..2 clustered on the ground, 3 clustered in the air, 4 far away
+	TArray<FUnit> Units = {
+		CreateCombatUnit(1, EUnitFaction::Friendly, FVector2D(100.0, 100.0)),
+		CreateCombatUnit(2, EUnitFaction::Enemy, FVector2D(115.0, 100.0)),
+		CreateCombatUnit(3, EUnitFaction::Enemy, FVector2D(100.0, 118.0)),
+		CreateCombatUnit(4, EUnitFaction::Enemy, FVector2D(105.0, 105.0)),
+		CreateCombatUnit(5, EUnitFaction::Enemy, FVector2D(900.0, 900.0))
+	};
+	Units[3].Layer = EMovementLayer::Air;
+
+	TArray<FUnit*> UnitPtrs;
+	for (FUnit& Unit : Units)
+	{
+		UnitPtrs.Add(&Unit);
+	}
+
+	FUnitSpatialGrid Grid;
+	TArray<int32> Neighbors;
+
+	// Act
+	Grid.Build(UnitPtrs, 30.0, 5.0);
+	Grid.GatherNeighbors(0, 0, Neighbors);
+
+	// Assert: only later same-layer units nearby, ascending
+	TestEqual(TEXT("Neighbor count"), Neighbors.Num(), 2);
+	if (Neighbors.Num() == 2)
+	{
+		TestEqual(TEXT("First neighbor"), Neighbors[0], 1);
+		TestEqual(TEXT("Second neighbor"), Neighbors[1], 2);
+	}
+
+	// Act: drift detection relative to the built position
+	Units[0].Position.X += 10.0;
+
+	// Assert
+	TestTrue(TEXT("Drift beyond slack reported"), Grid.HasDrifted(0, Units[0].Position));
+	TestFalse(TEXT("Unmoved unit not drifted"), Grid.HasDrifted(1, Units[1].Position));
+
+	return true;
+}
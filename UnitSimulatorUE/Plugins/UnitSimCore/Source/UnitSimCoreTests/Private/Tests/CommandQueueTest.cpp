@@ -0,0 +1,276 @@
+#include "Misc/AutomationTest.h"
+#include "Commands/SimCommandRing.h"
+#include "Simulation/SimulatorCore.h"
+#include "GameConstants.h"
+#include "Async/Async.h"
+#include "HAL/PlatformProcess.h"
+
+namespace
+{
+	/** A command whose UnitId tags who sent it: Producer * 100000 + Sequence */
+	FSimCommand MakeTagged(int32 Producer, int32 Sequence)
+	{
+		FMoveUnitCommand Move;
+		Move.FrameNumber = Producer;
+		Move.UnitId = Producer * 100000 + Sequence;
+		return FSimCommand::MakeMove(Move);
+	}
+
+	FSimCommand MakeEnemySpawn(int32 Frame, int32 HP)
+	{
+		FSpawnUnitCommand Spawn;
+		Spawn.FrameNumber = Frame;
+		Spawn.Position = FVector2D(1600.0, 2550.0);
+		Spawn.Role = EUnitRole::Melee;
+		Spawn.Faction = EUnitFaction::Enemy;
+		Spawn.HP = HP;
+		return FSimCommand::MakeSpawn(Spawn);
+	}
+}
+
+// ============================================================================
+// Ordering
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommandQueueFrameOrder,
+	"UnitSimCore.Commands.Order.ByFrameThenEnqueueOrder",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCommandQueueFrameOrder::RunTest(const FString& Parameters)
+{
+	// Arrange: A command for a late frame enqueued before one for an early frame
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	Sim.SetHasMoreWaves(false);
+
+	Sim.EnqueueCommand(MakeEnemySpawn(50, 100));
+	Sim.EnqueueCommand(MakeEnemySpawn(1, 100));
+
+	// Act & Assert: The early one does not wait for the late one
+	Sim.Step();
+	Sim.Step();
+	TestEqual(TEXT("Frame 1 spawn ran on time"), Sim.GetEnemyUnits().Num(), 1);
+	const int32 UnitId = Sim.GetEnemyUnits()[0].Id;
+
+	// Within a frame enqueue order holds: kill, then revive
+	FMoveUnitCommand Move;
+	Move.FrameNumber = 4;
+	Move.UnitId = UnitId;
+	Move.Faction = EUnitFaction::Enemy;
+	FKillUnitCommand Kill;
+	Kill.FrameNumber = 3;
+	Kill.UnitId = UnitId;
+	Kill.Faction = EUnitFaction::Enemy;
+	FReviveUnitCommand Revive;
+	Revive.FrameNumber = 3;
+	Revive.UnitId = UnitId;
+	Revive.Faction = EUnitFaction::Enemy;
+	Revive.HP = 40;
+
+	Sim.EnqueueCommand(FSimCommand::MakeMove(Move));
+	Sim.EnqueueCommand(FSimCommand::MakeKill(Kill));
+	Sim.EnqueueCommand(FSimCommand::MakeRevive(Revive));
+	Sim.Step();
+	Sim.Step();
+
+	const FUnit* Unit = Sim.FindUnit(EUnitFaction::Enemy, UnitId);
+	TestTrue(TEXT("Revive ran after kill"), Unit && !Unit->bIsDead);
+	TestEqual(TEXT("Frame 50 spawn still waiting"), Sim.GetEnemyUnits().Num(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommandQueueReviveAfterCompaction,
+	"UnitSimCore.Commands.Order.ReviveAfterCompaction",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCommandQueueReviveAfterCompaction::RunTest(const FString& Parameters)
+{
+	// Arrange: Enough enemies that killing them all compacts the squad
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	Sim.SetHasMoreWaves(false);
+
+	const int32 NumEnemies = UnitSimConstants::SQUAD_COMPACTION_MIN_DEAD + 1;
+	for (int32 i = 0; i < NumEnemies; ++i)
+	{
+		Sim.EnqueueCommand(MakeEnemySpawn(0, 100));
+	}
+	Sim.Step();
+	const int32 RevivedId = Sim.GetEnemyUnits()[0].Id;
+	const int32 ReclaimedId = Sim.GetEnemyUnits()[1].Id;
+
+	for (const FUnit& Enemy : Sim.GetEnemyUnits())
+	{
+		FKillUnitCommand Kill;
+		Kill.FrameNumber = 2;
+		Kill.UnitId = Enemy.Id;
+		Kill.Faction = EUnitFaction::Enemy;
+		Sim.EnqueueCommand(FSimCommand::MakeKill(Kill));
+	}
+
+	// Queued before the reclaim: its target survives compaction
+	FReviveUnitCommand Revive;
+	Revive.FrameNumber = 6;
+	Revive.UnitId = RevivedId;
+	Revive.Faction = EUnitFaction::Enemy;
+	Revive.HP = 40;
+	Sim.EnqueueCommand(FSimCommand::MakeRevive(Revive));
+
+	// Act
+	for (int32 i = 0; i < 6; ++i)
+	{
+		Sim.Step();
+	}
+
+	// Assert
+	TestEqual(TEXT("Dead squad compacted down to the revive target"), Sim.GetEnemyUnits().Num(), 1);
+	const FUnit* Unit = Sim.FindUnit(EUnitFaction::Enemy, RevivedId);
+	TestTrue(TEXT("Unit killed frames earlier was revived"), Unit && !Unit->bIsDead && Unit->HP == 40);
+
+	// A revive queued after its target was reclaimed is reported and ignored
+	AddExpectedError(TEXT("was reclaimed before the command was queued"), EAutomationExpectedErrorFlags::Contains, 1);
+	FReviveUnitCommand Late;
+	Late.FrameNumber = Sim.GetCurrentFrame();
+	Late.UnitId = ReclaimedId;
+	Late.Faction = EUnitFaction::Enemy;
+	Late.HP = 40;
+	Sim.EnqueueCommand(FSimCommand::MakeRevive(Late));
+	Sim.Step();
+	TestNull(TEXT("Reclaimed unit stays gone"), Sim.FindUnit(EUnitFaction::Enemy, ReclaimedId));
+
+	return true;
+}
+
+// ============================================================================
+// Bulk Enqueue
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommandQueueBulkSpawn,
+	"UnitSimCore.Commands.Bulk.SpawnsInOneCall",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCommandQueueBulkSpawn::RunTest(const FString& Parameters)
+{
+	// Arrange
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	Sim.SetHasMoreWaves(false);
+
+	TArray<FSimCommand> Spawns;
+	for (int32 i = 0; i < 300; ++i)
+	{
+		FSimCommand Spawn = MakeEnemySpawn(0, 100);
+		FSpawnUnitCommand& Cmd = Spawn.Payload.Get<FSpawnUnitCommand>();
+		Cmd.Position.X = 200.0 + (i % 30) * 90.0;
+		Cmd.Position.Y = 2000.0 + (i / 30) * 90.0;
+		Spawns.Add(Spawn);
+	}
+
+	// Act
+	const bool bQueued = Sim.EnqueueCommands(Spawns);
+	Sim.Step();
+
+	// Assert
+	TestTrue(TEXT("Bulk enqueue accepted"), bQueued);
+	TestEqual(TEXT("Every unit spawned in one step"), Sim.GetEnemyUnits().Num(), 300);
+
+	// More than the ring holds is refused as a whole
+	TArray<FSimCommand> TooMany;
+	TooMany.Init(MakeEnemySpawn(0, 100), UnitSimConstants::COMMAND_RING_CAPACITY + 1);
+	AddExpectedError(TEXT("Command queue full"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Oversized bulk enqueue refused"), Sim.EnqueueCommands(TooMany));
+	Sim.Step();
+	TestEqual(TEXT("Nothing of the refused batch spawned"), Sim.GetEnemyUnits().Num(), 300);
+
+	return true;
+}
+
+// ============================================================================
+// Ring
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommandRingConcurrentProducers,
+	"UnitSimCore.Commands.Ring.ConcurrentProducers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCommandRingConcurrentProducers::RunTest(const FString& Parameters)
+{
+	// Arrange: A ring much smaller than the traffic, so producers hit it full
+	constexpr int32 NumProducers = 4;
+	constexpr int32 BulkSize = 16;
+	constexpr int32 PerProducer = 20000;
+	FSimCommandRing Ring(256);
+
+	// Act: Producers alternate single and bulk pushes while this thread consumes
+	TArray<TFuture<void>> Producers;
+	for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+	{
+		Producers.Add(Async(EAsyncExecution::Thread, [&Ring, Producer]()
+		{
+			TArray<FSimCommand> Bulk;
+			for (int32 Sequence = 0; Sequence < PerProducer; )
+			{
+				if ((Sequence / BulkSize) % 2 == 0)
+				{
+					while (!Ring.Push(MakeTagged(Producer, Sequence))) FPlatformProcess::Yield();
+					Sequence++;
+				}
+				else
+				{
+					Bulk.Reset();
+					for (int32 i = 0; i < BulkSize; ++i)
+					{
+						Bulk.Add(MakeTagged(Producer, Sequence + i));
+					}
+					while (!Ring.PushBulk(Bulk)) FPlatformProcess::Yield();
+					Sequence += BulkSize;
+				}
+			}
+		}));
+	}
+
+	TArray<int32> NextExpected;
+	NextExpected.Init(0, NumProducers);
+	int32 Received = 0;
+	int32 OutOfOrder = 0;
+	int32 BrokenBulks = 0;
+	int32 BulkProducer = INDEX_NONE;
+	FSimCommand Cmd;
+	while (Received < NumProducers * PerProducer)
+	{
+		if (!Ring.Pop(Cmd))
+		{
+			FPlatformProcess::Yield();
+			continue;
+		}
+		const int32 Tag = Cmd.Get<FMoveUnitCommand>().UnitId;
+		const int32 Producer = Tag / 100000;
+		const int32 Sequence = Tag % 100000;
+
+		OutOfOrder += (Sequence != NextExpected[Producer]) ? 1 : 0;
+		NextExpected[Producer] = Sequence + 1;
+
+		// Inside a bulk, the next command must come from the same producer
+		const bool bInBulk = (Sequence / BulkSize) % 2 == 1;
+		BrokenBulks += (BulkProducer != INDEX_NONE && BulkProducer != Producer) ? 1 : 0;
+		BulkProducer = (bInBulk && Sequence % BulkSize != BulkSize - 1) ? Producer : INDEX_NONE;
+		Received++;
+	}
+	for (TFuture<void>& Future : Producers)
+	{
+		Future.Wait();
+	}
+
+	// Assert
+	TestEqual(TEXT("Each producer's commands arrive in order"), OutOfOrder, 0);
+	TestEqual(TEXT("Bulk pushes stay contiguous"), BrokenBulks, 0);
+	TestFalse(TEXT("Ring is drained"), Ring.Pop(Cmd));
+
+	// A bulk push larger than the ring never fits
+	TArray<FSimCommand> TooMany;
+	TooMany.Init(MakeTagged(0, 0), Ring.GetCapacity() + 1);
+	TestFalse(TEXT("Oversized bulk refused"), Ring.PushBulk(TooMany));
+
+	return true;
+}
@@ -0,0 +1,130 @@
+#include "Misc/AutomationTest.h"
+#include "Math/FixedPoint.h"
+#include "HAL/PlatformTime.h"
+
+// ============================================================================
+// FFixed Arithmetic
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFixedArithmetic,
+	"UnitSimCore.Math.FixedPoint.Arithmetic",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFixedArithmetic::RunTest(const FString& Parameters)
+{
+	// Arrange
+	const FFixed A = FFixed::FromDouble(3.5);
+	const FFixed B = FFixed::FromDouble(-1.25);
+
+	// Act & Assert: Values with short binary fractions are exact
+	TestEqual(TEXT("Round trip"), A.ToDouble(), 3.5);
+	TestEqual(TEXT("Add"), (A + B).ToDouble(), 2.25);
+	TestEqual(TEXT("Mul"), (A * B).ToDouble(), -4.375);
+	TestEqual(TEXT("Div"), (A / B).ToDouble(), -2.8);
+	TestEqual(TEXT("Sqrt"), FixedMath::Sqrt(FFixed::FromInt(16)).ToDouble(), 4.0);
+	TestEqual(TEXT("Length 3-4-5 at map scale"),
+		FixedMath::Length(FFixed::FromInt(3000), FFixed::FromInt(4000)).ToDouble(), 5000.0);
+
+	FFixed X = FFixed::FromInt(0);
+	FFixed Y = FFixed::FromInt(0);
+	FixedMath::Normalize(X, Y);
+	TestEqual(TEXT("Zero vector stays zero"), X.Raw + Y.Raw, 0);
+
+	// Out of range saturates instead of wrapping
+	TestEqual(TEXT("Above range saturates"), FFixed::FromDouble(40000.0).Raw, MAX_int32);
+	TestEqual(TEXT("Below range saturates"), FFixed::FromDouble(-40000.0).Raw, MIN_int32);
+	TestEqual(TEXT("Range edge still exact"), FFixed::FromDouble(-32768.0).ToDouble(), -32768.0);
+
+	return true;
+}
+
+// ============================================================================
+// Table Trig
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFixedTrig,
+	"UnitSimCore.Math.FixedPoint.TrigMatchesReference",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFixedTrig::RunTest(const FString& Parameters)
+{
+	// Arrange & Act: Sweep several turns in both directions
+	double MaxSinCosError = 0.0;
+	for (double Angle = -10.0; Angle <= 10.0; Angle += 0.0137)
+	{
+		const FFixed F = FFixed::FromDouble(Angle);
+		MaxSinCosError = FMath::Max(MaxSinCosError, FMath::Abs(FixedMath::Sin(F).ToDouble() - FMath::Sin(F.ToDouble())));
+		MaxSinCosError = FMath::Max(MaxSinCosError, FMath::Abs(FixedMath::Cos(F).ToDouble() - FMath::Cos(F.ToDouble())));
+	}
+
+	double MaxAtanError = 0.0;
+	for (double Y = -50.0; Y <= 50.0; Y += 1.7)
+	{
+		for (double X = -50.0; X <= 50.0; X += 1.3)
+		{
+			const FFixed FY = FFixed::FromDouble(Y);
+			const FFixed FX = FFixed::FromDouble(X);
+			const double Reference = FMath::Atan2(FY.ToDouble(), FX.ToDouble());
+			MaxAtanError = FMath::Max(MaxAtanError, FMath::Abs(FixedMath::Atan2(FY, FX).ToDouble() - Reference));
+		}
+	}
+
+	// Assert
+	TestTrue(FString::Printf(TEXT("Sin/Cos error %g below 1e-4"), MaxSinCosError), MaxSinCosError < 1e-4);
+	TestTrue(FString::Printf(TEXT("Atan2 error %g below 1e-4"), MaxAtanError), MaxAtanError < 1e-4);
+	TestEqual(TEXT("Atan2 of zero vector"), FixedMath::Atan2(FFixed(), FFixed()).Raw, 0);
+
+	return true;
+}
+
+// ============================================================================
+// Integer vs Double Throughput
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFixedBenchmark,
+	"UnitSimCore.Math.FixedPoint.BenchmarkAgainstDouble",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FFixedBenchmark::RunTest(const FString& Parameters)
+{
+	// Arrange: The per-unit kernel of UpdateRotation + SafeNormalize on map-scale vectors
+	constexpr int32 Count = 1 << 16;
+	TArray<FVector2D> Inputs;
+	Inputs.Reserve(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Inputs.Add(FVector2D((i * 37 % 3200) - 1600.0 + 0.5, (i * 91 % 5100) - 2550.0 + 0.25));
+	}
+
+	// Act: Double path
+	double DoubleSum = 0.0;
+	const double DoubleStart = FPlatformTime::Seconds();
+	for (const FVector2D& V : Inputs)
+	{
+		const double Angle = FMath::Atan2(V.Y, V.X);
+		const double Len = V.Size();
+		DoubleSum += FMath::Cos(Angle) + FMath::Sin(Angle) + V.X / Len;
+	}
+	const double DoubleSeconds = FPlatformTime::Seconds() - DoubleStart;
+
+	// Act: Fixed path
+	double FixedSum = 0.0;
+	const double FixedStart = FPlatformTime::Seconds();
+	for (const FVector2D& V : Inputs)
+	{
+		FFixed X = FFixed::FromDouble(V.X);
+		FFixed Y = FFixed::FromDouble(V.Y);
+		const FFixed Angle = FixedMath::Atan2(Y, X);
+		FixedMath::Normalize(X, Y);
+		FixedSum += (FixedMath::Cos(Angle) + FixedMath::Sin(Angle) + X).ToDouble();
+	}
+	const double FixedSeconds = FPlatformTime::Seconds() - FixedStart;
+
+	AddInfo(FString::Printf(TEXT("double: %.1f ns/op, Q16.16: %.1f ns/op (%d ops)"),
+		DoubleSeconds * 1e9 / Count, FixedSeconds * 1e9 / Count, Count));
+
+	// Assert: Both paths compute the same thing to within table accuracy
+	TestTrue(TEXT("Fixed path tracks double path"), FMath::Abs(FixedSum - DoubleSum) / Count < 1e-3);
+
+	return true;
+}
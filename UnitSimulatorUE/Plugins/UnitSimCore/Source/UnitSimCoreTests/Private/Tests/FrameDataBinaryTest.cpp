@@ -0,0 +1,182 @@
+#include "Misc/AutomationTest.h"
+#include "Simulation/FrameDataBinary.h"
+#include "Simulation/SimulatorCore.h"
+#include "Simulation/SimBatchRunner.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	bool FramesIdentical(const FFrameData& A, const FFrameData& B)
+	{
+		return FFrameData::StaticStruct()->CompareScriptStruct(&A, &B, PPF_None);
+	}
+
+	/** A mid-battle frame with units, towers and some deaths */
+	FFrameData MakeBattleFrame(int32 Seed, int32 UnitsPerSide, int32 Frames)
+	{
+		FSimulatorCore Sim;
+		Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(Seed, UnitsPerSide).Setup);
+		Sim.SetHasMoreWaves(false);
+
+		FFrameData Frame;
+		for (int32 i = 0; i < Frames; ++i)
+		{
+			Frame = Sim.Step();
+		}
+		return Frame;
+	}
+}
+
+// ============================================================================
+// Round Trip
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameDataBinaryRoundTrip,
+	"UnitSimCore.FrameData.RoundTrip.BinaryMatchesInput",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFrameDataBinaryRoundTrip::RunTest(const FString& Parameters)
+{
+	// Arrange: A name outside the enum must survive too
+	FFrameData Frame = MakeBattleFrame(21, 20, 90);
+	TestTrue(TEXT("Frame has units and towers"), Frame.FriendlyUnits.Num() > 0 && Frame.EnemyTowers.Num() > 0);
+	Frame.EnemyUnits[0].Role = TEXT("Custom");
+
+	// Act
+	TArray<uint8> Bytes;
+	FrameDataBinary::Write(Frame, Bytes);
+
+	FFrameData Decoded;
+	const bool bRead = FrameDataBinary::Read(Bytes, Decoded);
+
+	FFrameDataView View;
+	const bool bOpened = View.Open(Bytes);
+
+	// Assert
+	TestTrue(TEXT("Read succeeded"), bRead);
+	TestTrue(TEXT("Decoded frame is identical"), FramesIdentical(Decoded, Frame));
+
+	TestTrue(TEXT("View opened"), bOpened);
+	if (bOpened)
+	{
+		const FUnitStateData& First = Frame.FriendlyUnits[0];
+		const FUnitStateView FirstView = View.GetFriendlyUnit(0);
+		TestEqual(TEXT("View unit count"), View.NumEnemyUnits(), Frame.EnemyUnits.Num());
+		TestEqual(TEXT("View id"), FirstView.GetId(), First.Id);
+		TestTrue(TEXT("View position"), FirstView.GetPosition() == First.Position);
+		const FUtf8StringView Label = FirstView.GetLabel();
+		const FUTF8ToTCHAR LabelChars(Label.GetData(), Label.Len());
+		TestEqual(TEXT("View label"), FString(LabelChars.Length(), LabelChars.Get()), First.Label);
+		TestEqual(TEXT("View abilities"), FirstView.GetNumAbilities(), First.Abilities.Num());
+		TestEqual(TEXT("View tower HP"), View.GetEnemyTower(0).GetCurrentHP(), Frame.EnemyTowers[0].CurrentHP);
+	}
+
+	// Malformed buffers are refused
+	TArray<uint8> Truncated = Bytes;
+	Truncated.SetNum(Bytes.Num() - 1);
+	TestFalse(TEXT("Truncated buffer refused"), FrameDataBinary::Read(Truncated, Decoded));
+
+	TArray<uint8> Foreign = Bytes;
+	Foreign[0] ^= 0xFF;
+	TestFalse(TEXT("Wrong magic refused"), FrameDataBinary::Read(Foreign, Decoded));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameDataJsonRoundTrip,
+	"UnitSimCore.FrameData.RoundTrip.JsonIncludesArrays",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFrameDataJsonRoundTrip::RunTest(const FString& Parameters)
+{
+	// Arrange
+	const FFrameData Frame = MakeBattleFrame(22, 10, 60);
+
+	// Act
+	FFrameData Decoded;
+	const bool bParsed = FFrameData::FromJson(Frame.ToJson(), Decoded);
+
+	// Assert
+	TestTrue(TEXT("JSON parsed"), bParsed);
+	TestEqual(TEXT("Friendly units kept"), Decoded.FriendlyUnits.Num(), Frame.FriendlyUnits.Num());
+	TestEqual(TEXT("Enemy towers kept"), Decoded.EnemyTowers.Num(), Frame.EnemyTowers.Num());
+	TestTrue(TEXT("Decoded frame is identical"), FramesIdentical(Decoded, Frame));
+
+	return true;
+}
+
+// ============================================================================
+// Throughput
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameDataBinaryBenchmark,
+	"UnitSimCore.FrameData.Benchmark.BinaryVsJson",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FFrameDataBinaryBenchmark::RunTest(const FString& Parameters)
+{
+	// Arrange: 300 units
+	const FFrameData Frame = MakeBattleFrame(23, 150, 30);
+	constexpr int32 Iterations = 20;
+
+	// Act
+	FString Json;
+	FFrameData JsonFrame;
+	double Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		Json = Frame.ToJson();
+	}
+	const double JsonEncode = (FPlatformTime::Seconds() - Start) / Iterations;
+
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		FFrameData::FromJson(Json, JsonFrame);
+	}
+	const double JsonDecode = (FPlatformTime::Seconds() - Start) / Iterations;
+
+	TArray<uint8> Bytes;
+	FFrameData FromBinary;
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		Bytes.Reset();
+		FrameDataBinary::Write(Frame, Bytes);
+	}
+	const double BinaryEncode = (FPlatformTime::Seconds() - Start) / Iterations;
+
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		FrameDataBinary::Read(Bytes, FromBinary);
+	}
+	const double BinaryDecode = (FPlatformTime::Seconds() - Start) / Iterations;
+
+	// Reading a few fields of every unit through the view touches no allocator
+	FFrameDataView View;
+	int64 HPSum = 0;
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		View.Open(Bytes);
+		for (int32 u = 0; u < View.NumFriendlyUnits(); ++u)
+		{
+			HPSum += View.GetFriendlyUnit(u).GetHP();
+		}
+	}
+	const double ViewScan = (FPlatformTime::Seconds() - Start) / Iterations;
+
+	const int32 JsonBytes = FTCHARToUTF8(*Json).Length();
+	AddInfo(FString::Printf(TEXT("300 units: JSON %d B, encode %.0f us, decode %.0f us"),
+		JsonBytes, JsonEncode * 1e6, JsonDecode * 1e6));
+	AddInfo(FString::Printf(TEXT("300 units: binary %d B, encode %.0f us, decode %.0f us, view scan %.1f us"),
+		Bytes.Num(), BinaryEncode * 1e6, BinaryDecode * 1e6, ViewScan * 1e6));
+
+	// Assert
+	TestTrue(TEXT("Binary decodes to the same frame"), FramesIdentical(FromBinary, Frame));
+	TestTrue(TEXT("Binary is smaller than JSON"), Bytes.Num() < JsonBytes);
+	TestTrue(TEXT("View read every unit"), HPSum != 0 || View.NumFriendlyUnits() == 0);
+
+	return true;
+}
@@ -0,0 +1,169 @@
+#include "Misc/AutomationTest.h"
+#include "Simulation/FrameDelta.h"
+#include "Simulation/SimulatorCore.h"
+#include "Simulation/SimBatchRunner.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	bool FramesIdentical(const FFrameData& A, const FFrameData& B)
+	{
+		return FFrameData::StaticStruct()->CompareScriptStruct(&A, &B, PPF_None);
+	}
+}
+
+// ============================================================================
+// Round Trip
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameDeltaLossless,
+	"UnitSimCore.FrameDelta.RoundTrip.LosslessMatchesInput",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFrameDeltaLossless::RunTest(const FString& Parameters)
+{
+	// Arrange: Exact vectors, short keyframe interval so keyframes and deltas both occur
+	FSimulatorCore Sim;
+	Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(11, 20).Setup);
+	Sim.SetHasMoreWaves(false);
+
+	FFrameDeltaSettings Settings;
+	Settings.KeyframeInterval = 10;
+	Settings.VectorStep = 0.0;
+	FFrameDeltaEncoder Encoder(Settings);
+	FFrameDeltaDecoder Decoder;
+	FFrameDeltaDecoder LateJoiner;
+	TArray<uint8> Packet;
+
+	// Act & Assert
+	int32 Mismatches = 0;
+	int32 LateJoinerRejected = 0;
+	for (int32 i = 0; i < 120; ++i)
+	{
+		const FFrameData Frame = Sim.Step();
+		Encoder.Encode(Frame, Packet);
+
+		if (!Decoder.Decode(Packet) || !FramesIdentical(Decoder.GetFrame(), Frame))
+		{
+			Mismatches++;
+		}
+
+		// Joins at frame 5: deltas are refused until the keyframe at frame 10
+		if (i >= 5 && !LateJoiner.Decode(Packet))
+		{
+			LateJoinerRejected++;
+		}
+	}
+
+	TestEqual(TEXT("Every frame decodes to the input"), Mismatches, 0);
+	TestEqual(TEXT("Late joiner waits for the next keyframe"), LateJoinerRejected, 5);
+	TestTrue(TEXT("Late joiner caught up"), FramesIdentical(LateJoiner.GetFrame(), Decoder.GetFrame()));
+
+	// A truncated packet is refused and the decoder waits for a keyframe
+	Packet.SetNum(Packet.Num() / 2);
+	TestFalse(TEXT("Truncated packet refused"), Decoder.Decode(Packet));
+	TestFalse(TEXT("Decoder waits for a keyframe"), Decoder.HasKeyframe());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameDeltaQuantized,
+	"UnitSimCore.FrameDelta.RoundTrip.QuantizedErrorBounded",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFrameDeltaQuantized::RunTest(const FString& Parameters)
+{
+	// Arrange
+	FSimulatorCore Sim;
+	Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(12, 20).Setup);
+	Sim.SetHasMoreWaves(false);
+
+	FFrameDeltaEncoder Encoder;
+	FFrameDeltaDecoder Decoder;
+	TArray<uint8> Packet;
+
+	// Act
+	int32 Mismatches = 0;
+	double MaxPositionError = 0.0;
+	for (int32 i = 0; i < 120; ++i)
+	{
+		const FFrameData Frame = Sim.Step();
+		Encoder.Encode(Frame, Packet);
+		Decoder.Decode(Packet);
+
+		const FFrameData& Decoded = Decoder.GetFrame();
+		if (!FramesIdentical(Decoded, Encoder.GetReference()) || Decoded.FriendlyUnits.Num() != Frame.FriendlyUnits.Num())
+		{
+			Mismatches++;
+			continue;
+		}
+		for (int32 u = 0; u < Frame.FriendlyUnits.Num(); ++u)
+		{
+			const FVector2D Error = Decoded.FriendlyUnits[u].Position - Frame.FriendlyUnits[u].Position;
+			MaxPositionError = FMath::Max(MaxPositionError, FMath::Max(FMath::Abs(Error.X), FMath::Abs(Error.Y)));
+			if (Decoded.FriendlyUnits[u].HP != Frame.FriendlyUnits[u].HP) Mismatches++;
+		}
+	}
+
+	// Assert: Decoder tracks the encoder's reference exactly; positions within half a step
+	TestEqual(TEXT("Decoder matches encoder reference"), Mismatches, 0);
+	TestTrue(FString::Printf(TEXT("Position error %g within half a step"), MaxPositionError),
+		MaxPositionError <= UnitSimConstants::FRAME_DELTA_VECTOR_STEP * 0.5 + 1e-9);
+
+	return true;
+}
+
+// ============================================================================
+// Stream Size
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameDeltaBenchmark,
+	"UnitSimCore.FrameDelta.Benchmark.BytesPerFrame300Units",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FFrameDeltaBenchmark::RunTest(const FString& Parameters)
+{
+	// Arrange: 150 units per side
+	FSimulatorCore Sim;
+	Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(13, 150).Setup);
+	Sim.SetHasMoreWaves(false);
+
+	FFrameDeltaEncoder Encoder;
+	TArray<uint8> Packet;
+
+	// Act
+	int64 KeyBytes = 0;
+	int64 DeltaBytes = 0;
+	int32 KeyFrames = 0;
+	int32 DeltaFrames = 0;
+	double EncodeSeconds = 0.0;
+	for (int32 i = 0; i < 300; ++i)
+	{
+		const FFrameData Frame = Sim.Step();
+
+		const double Start = FPlatformTime::Seconds();
+		Encoder.Encode(Frame, Packet);
+		EncodeSeconds += FPlatformTime::Seconds() - Start;
+
+		if (i % UnitSimConstants::FRAME_DELTA_KEYFRAME_INTERVAL == 0)
+		{
+			KeyBytes += Packet.Num();
+			KeyFrames++;
+		}
+		else
+		{
+			DeltaBytes += Packet.Num();
+			DeltaFrames++;
+		}
+	}
+
+	const double AvgKey = static_cast<double>(KeyBytes) / FMath::Max(1, KeyFrames);
+	const double AvgDelta = static_cast<double>(DeltaBytes) / FMath::Max(1, DeltaFrames);
+	AddInfo(FString::Printf(TEXT("300 units: keyframe %.0f B, delta %.0f B, stream %.0f B/frame, encode %.1f us/frame"),
+		AvgKey, AvgDelta, static_cast<double>(KeyBytes + DeltaBytes) / 300.0, EncodeSeconds * 1e6 / 300.0));
+
+	// Assert
+	TestTrue(TEXT("Deltas are smaller than keyframes"), AvgDelta < AvgKey);
+
+	return true;
+}
@@ -3,7 +3,173 @@
 #include "Pathfinding/AStarPathfinder.h"
 #include "Pathfinding/PathSmoother.h"
 #include "Pathfinding/DynamicObstacleSystem.h"
+#include "Pathfinding/FlowFieldService.h"
+#include "Pathfinding/HierarchicalPathfinder.h"
+#include "Pathfinding/PathCache.h"
+#include "Pathfinding/PathRequestService.h"
+#include "Simulation/SimBatchRunner.h"
+#include "Terrain/TerrainSystem.h"
 #include "Units/Unit.h"
+#include "Simulation/SimulatorCore.h"
+#include "GameConstants.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/**
+	 * The linear-scan A* FAStarPathfinder replaced (open list scanned for the
+	 * lowest F then H, TSet closed set, full grid reset per query), kept as
+	 * the reference its output must match.
+	 */
+	bool FindPathLinearScan(FPathfindingGrid& Grid, const FVector2D& StartWorldPos, const FVector2D& EndWorldPos, TArray<FVector2D>& OutPath)
+	{
+		OutPath.Empty();
+		FPathNode* StartNode = Grid.NodeFromWorldPoint(StartWorldPos);
+		FPathNode* EndNode = Grid.NodeFromWorldPoint(EndWorldPos);
+		if (!StartNode || !EndNode || !StartNode->bIsWalkable || !EndNode->bIsWalkable) return false;
+
+		const int32 Width = Grid.GetWidth();
+		auto NodeAt = [&Grid, Width](int32 Index) { return Grid.GetNode(Index % Width, Index / Width); };
+		auto Distance = [](const FPathNode& A, const FPathNode& B)
+		{
+			const int32 XDistance = FMath::Abs(A.X - B.X);
+			const int32 YDistance = FMath::Abs(A.Y - B.Y);
+			return 14 * FMath::Min(XDistance, YDistance) + 10 * FMath::Abs(XDistance - YDistance);
+		};
+
+		const int32 StartIndex = StartNode->X + StartNode->Y * Width;
+		const int32 EndIndex = EndNode->X + EndNode->Y * Width;
+		TArray<int32> OpenList;
+		TSet<int32> ClosedSet;
+		Grid.ResetAllNodes();
+		StartNode->GCost = 0;
+		StartNode->HCost = Distance(*StartNode, *EndNode);
+		OpenList.Add(StartIndex);
+
+		while (OpenList.Num() > 0)
+		{
+			int32 BestOpenIdx = 0;
+			for (int32 i = 1; i < OpenList.Num(); ++i)
+			{
+				const FPathNode* Candidate = NodeAt(OpenList[i]);
+				const FPathNode* Best = NodeAt(OpenList[BestOpenIdx]);
+				if (Candidate->GetFCost() < Best->GetFCost() ||
+					(Candidate->GetFCost() == Best->GetFCost() && Candidate->HCost < Best->HCost))
+				{
+					BestOpenIdx = i;
+				}
+			}
+
+			const int32 CurrentIndex = OpenList[BestOpenIdx];
+			if (CurrentIndex == EndIndex)
+			{
+				for (int32 Index = EndIndex; Index != -1 && Index != StartIndex; Index = NodeAt(Index)->CameFromNodeIndex)
+				{
+					OutPath.Insert(NodeAt(Index)->WorldPosition, 0);
+				}
+				return true;
+			}
+			OpenList.RemoveAt(BestOpenIdx);
+			ClosedSet.Add(CurrentIndex);
+
+			const FPathNode* Current = NodeAt(CurrentIndex);
+			for (int32 DX = -1; DX <= 1; ++DX)
+			{
+				for (int32 DY = -1; DY <= 1; ++DY)
+				{
+					if (DX == 0 && DY == 0) continue;
+					FPathNode* Neighbor = Grid.GetNode(Current->X + DX, Current->Y + DY);
+					if (!Neighbor) continue;
+					if (DX != 0 && DY != 0 &&
+						(!Grid.GetNode(Current->X + DX, Current->Y)->bIsWalkable || !Grid.GetNode(Current->X, Current->Y + DY)->bIsWalkable))
+					{
+						continue;
+					}
+
+					const int32 NeighborIndex = Neighbor->X + Neighbor->Y * Width;
+					if (!Neighbor->bIsWalkable || ClosedSet.Contains(NeighborIndex)) continue;
+
+					const int32 TentativeGCost = Current->GCost + Distance(*Current, *Neighbor);
+					if (TentativeGCost < Neighbor->GCost)
+					{
+						Neighbor->CameFromNodeIndex = CurrentIndex;
+						Neighbor->GCost = TentativeGCost;
+						Neighbor->HCost = Distance(*Neighbor, *EndNode);
+						OpenList.AddUnique(NeighborIndex);
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	/** Grid cost (10 straight, 14 diagonal) of walking Path from Start's cell */
+	int32 PathCost(const FPathfindingGrid& Grid, const FVector2D& Start, const TArray<FVector2D>& Path)
+	{
+		int32 Cost = 0;
+		const FPathNode* Previous = Grid.NodeFromWorldPoint(Start);
+		for (const FVector2D& Waypoint : Path)
+		{
+			const FPathNode* Node = Grid.NodeFromWorldPoint(Waypoint);
+			Cost += (Node->X != Previous->X && Node->Y != Previous->Y) ? 14 : 10;
+			Previous = Node;
+		}
+		return Cost;
+	}
+
+	/** Path walks single steps over walkable cells, never cutting a corner, and ends on End's cell */
+	bool IsValidGridPath(const FPathfindingGrid& Grid, const FVector2D& Start, const FVector2D& End, const TArray<FVector2D>& Path)
+	{
+		const FPathNode* Previous = Grid.NodeFromWorldPoint(Start);
+		for (const FVector2D& Waypoint : Path)
+		{
+			const FPathNode* Node = Grid.NodeFromWorldPoint(Waypoint);
+			const int32 DX = Node->X - Previous->X;
+			const int32 DY = Node->Y - Previous->Y;
+			if (!Node->bIsWalkable || FMath::Abs(DX) > 1 || FMath::Abs(DY) > 1 || (DX == 0 && DY == 0)) return false;
+			if (DX != 0 && DY != 0 &&
+				(!Grid.GetNode(Previous->X + DX, Previous->Y)->bIsWalkable || !Grid.GetNode(Previous->X, Previous->Y + DY)->bIsWalkable))
+			{
+				return false;
+			}
+			Previous = Node;
+		}
+		return Previous == Grid.NodeFromWorldPoint(End);
+	}
+
+	/** Random points anywhere on the arena */
+	TArray<FVector2D> MakeRandomStarts(int32 Seed, int32 NumStarts)
+	{
+		constexpr float MapWidth = static_cast<float>(UnitSimConstants::SIMULATION_WIDTH);
+		constexpr float MapHeight = static_cast<float>(UnitSimConstants::SIMULATION_HEIGHT);
+		FRandomStream Random(Seed);
+		TArray<FVector2D> Starts;
+		for (int32 i = 0; i < NumStarts; ++i)
+		{
+			Starts.Emplace(Random.FRandRange(0.f, MapWidth), Random.FRandRange(0.f, MapHeight));
+		}
+		return Starts;
+	}
+
+	/** Random endpoint pairs at least MinDistance apart */
+	TArray<TPair<FVector2D, FVector2D>> MakeLongQueries(int32 Seed, int32 NumQueries, float MinDistance)
+	{
+		constexpr float MapWidth = static_cast<float>(UnitSimConstants::SIMULATION_WIDTH);
+		constexpr float MapHeight = static_cast<float>(UnitSimConstants::SIMULATION_HEIGHT);
+		FRandomStream Random(Seed);
+		TArray<TPair<FVector2D, FVector2D>> Queries;
+		while (Queries.Num() < NumQueries)
+		{
+			const FVector2D Start(Random.FRandRange(0.f, MapWidth), Random.FRandRange(0.f, MapHeight));
+			const FVector2D End(Random.FRandRange(0.f, MapWidth), Random.FRandRange(0.f, MapHeight));
+			if (FVector2D::Distance(Start, End) >= MinDistance)
+			{
+				Queries.Emplace(Start, End);
+			}
+		}
+		return Queries;
+	}
+}
 
 // ============================================================================
 // FPathfindingGrid Creation & Obstacle Setting
@@ -70,6 +236,8 @@ bool FAStarStraightPath::RunTest(const FString& Parameters)
 	// Assert
 	TestTrue(TEXT("Path found"), bFound);
 	TestTrue(TEXT("Path has waypoints"), Path.Num() > 0);
+	TestEqual(TEXT("One search counted"), Pathfinder.GetStats().Searches, 1);
+	TestTrue(TEXT("Expanded at least the path"), Pathfinder.GetStats().NodesExpanded >= Path.Num());
 
 	// All path waypoints should be on walkable nodes
 	for (const FVector2D& Waypoint : Path)
@@ -85,6 +253,857 @@ bool FAStarStraightPath::RunTest(const FString& Parameters)
 	return true;
 }
 
+// ============================================================================
+// A* Reference Match
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAStarMatchesLinearScan,
+	"UnitSimCore.Pathfinding.AStar.MatchesLinearScanOnArena",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAStarMatchesLinearScan::RunTest(const FString& Parameters)
+{
+	// Arrange: The arena grid with towers and terrain, and random endpoints across it
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	FPathfindingGrid& Grid = *Sim.GetPathfindingGrid();
+	FAStarPathfinder Pathfinder(Grid);
+
+	constexpr int32 NumQueries = 200;
+	const TArray<TPair<FVector2D, FVector2D>> Queries = MakeLongQueries(19, NumQueries, 0.f);
+
+	// Act
+	TArray<FVector2D> Path;
+	TArray<FVector2D> Reference;
+	int32 Found = 0;
+	int32 Mismatches = 0;
+	for (const TPair<FVector2D, FVector2D>& Query : Queries)
+	{
+		Found += Pathfinder.FindPath(Query.Key, Query.Value, Path) ? 1 : 0;
+		FindPathLinearScan(Grid, Query.Key, Query.Value, Reference);
+		Mismatches += Reference == Path ? 0 : 1;
+	}
+
+	// Assert
+	TestTrue(TEXT("Most queries find a path"), Found > NumQueries / 2);
+	TestEqual(TEXT("Every path identical to the linear scan's"), Mismatches, 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAStarBenchmark,
+	"UnitSimCore.Pathfinding.AStar.Benchmark.HeapVsLinearScan",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FAStarBenchmark::RunTest(const FString& Parameters)
+{
+	// Arrange
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	FPathfindingGrid& Grid = *Sim.GetPathfindingGrid();
+	FAStarPathfinder Pathfinder(Grid);
+
+	constexpr int32 NumQueries = 2000;
+	const TArray<TPair<FVector2D, FVector2D>> Queries = MakeLongQueries(19, NumQueries, 0.f);
+
+	// Act
+	TArray<FVector2D> Path;
+	int32 Found = 0;
+	const double HeapStart = FPlatformTime::Seconds();
+	for (const TPair<FVector2D, FVector2D>& Query : Queries)
+	{
+		Found += Pathfinder.FindPath(Query.Key, Query.Value, Path) ? 1 : 0;
+	}
+	const double ScanStart = FPlatformTime::Seconds();
+	for (const TPair<FVector2D, FVector2D>& Query : Queries)
+	{
+		FindPathLinearScan(Grid, Query.Key, Query.Value, Path);
+	}
+	const double ScanSeconds = FPlatformTime::Seconds() - ScanStart;
+	const double HeapSeconds = ScanStart - HeapStart;
+
+	// Assert
+	AddInfo(FString::Printf(TEXT("%d queries (%d found, %d nodes expanded): heap %.2f ms, linear scan %.2f ms (%.1fx)"),
+		NumQueries, Found, Pathfinder.GetStats().NodesExpanded, HeapSeconds * 1000.0, ScanSeconds * 1000.0,
+		HeapSeconds > 0.0 ? ScanSeconds / HeapSeconds : 0.0));
+	TestTrue(TEXT("Heap search beats the linear scan"), HeapSeconds < ScanSeconds);
+
+	return true;
+}
+
+// ============================================================================
+// Flow Field vs A*
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowFieldMatchesAStar,
+	"UnitSimCore.Pathfinding.FlowField.MatchesAStarCostOnArena",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFlowFieldMatchesAStar::RunTest(const FString& Parameters)
+{
+	// Arrange: The arena grid, its bridge centers and a tower as goals, random starts
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	FPathfindingGrid& Grid = *Sim.GetPathfindingGrid();
+	FAStarPathfinder Pathfinder(Grid);
+	FFlowFieldService FlowFields(Grid);
+
+	const TArray<FVector2D> Bridges = FTerrainSystem::GetBridgeCenters();
+	const FVector2D TowerPosition = Sim.GetGameSession().EnemyTowers[0].Position;
+	const int32 TowerGoal = FlowFields.AddGoal(TowerPosition);
+	for (const FVector2D& Bridge : Bridges)
+	{
+		FlowFields.AddGoal(Bridge);
+	}
+	TestEqual(TEXT("Goals are deduplicated"), FlowFields.AddGoal(Bridges[0]), 1);
+
+	constexpr int32 NumQueries = 200;
+	const TArray<FVector2D> Starts = MakeRandomStarts(20, NumQueries);
+
+	// Act & Assert: Bridge goals are walkable, so both must find equally short paths
+	TArray<FVector2D> AStarPath;
+	TArray<FVector2D> FlowPath;
+	int32 Found = 0;
+	int32 Mismatches = 0;
+	for (int32 GoalId = 1; GoalId <= Bridges.Num(); ++GoalId)
+	{
+		for (const FVector2D& Start : Starts)
+		{
+			const bool bAStar = Pathfinder.FindPath(Start, FlowFields.GetGoalPosition(GoalId), AStarPath);
+			const bool bFlow = FlowFields.FindPath(GoalId, Start, FlowPath);
+
+			Found += bAStar ? 1 : 0;
+			const bool bSameCost = !bAStar ||
+				(PathCost(Grid, Start, AStarPath) == PathCost(Grid, Start, FlowPath) &&
+				PathCost(Grid, Start, FlowPath) == FlowFields.GetCost(GoalId, Start));
+			Mismatches += (bAStar != bFlow || !bSameCost) ? 1 : 0;
+		}
+	}
+	TestTrue(TEXT("Most queries find a path"), Found > NumQueries);
+	TestEqual(TEXT("Flow field agrees with A* on reachability and cost"), Mismatches, 0);
+
+	// A tower sits on blocked cells: A* cannot end there, the field stops at its edge
+	TestFalse(TEXT("A* cannot reach a tower center"), Pathfinder.FindPath(Starts[0], TowerPosition, AStarPath));
+	int32 TowerPaths = 0;
+	for (const FVector2D& Start : Starts)
+	{
+		if (FlowFields.FindPath(TowerGoal, Start, FlowPath) && FlowPath.Num() > 0)
+		{
+			TowerPaths++;
+			TestTrue(TEXT("Tower path ends by the tower"),
+				FVector2D::Distance(FlowPath.Last(), TowerPosition) <=
+				UnitSimConstants::FLOW_FIELD_GOAL_SEED_RADIUS + 2.f * Grid.GetNodeSize());
+		}
+	}
+	TestTrue(TEXT("Most starts reach the tower"), TowerPaths > NumQueries / 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowFieldBenchmark,
+	"UnitSimCore.Pathfinding.FlowField.Benchmark.BridgeQueriesVsAStar",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FFlowFieldBenchmark::RunTest(const FString& Parameters)
+{
+	// Arrange: Fields toward every bridge, built before timing starts
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	FPathfindingGrid& Grid = *Sim.GetPathfindingGrid();
+	FAStarPathfinder Pathfinder(Grid);
+	FFlowFieldService FlowFields(Grid);
+
+	const TArray<FVector2D> Bridges = FTerrainSystem::GetBridgeCenters();
+	for (const FVector2D& Bridge : Bridges)
+	{
+		FlowFields.EnsureField(FlowFields.AddGoal(Bridge));
+	}
+
+	constexpr int32 NumQueries = 1000;
+	const TArray<FVector2D> Starts = MakeRandomStarts(20, NumQueries);
+
+	// Act
+	TArray<FVector2D> Path;
+	int32 Found = 0;
+	const double AStarStart = FPlatformTime::Seconds();
+	for (int32 GoalId = 0; GoalId < Bridges.Num(); ++GoalId)
+	{
+		for (const FVector2D& Start : Starts)
+		{
+			Found += Pathfinder.FindPath(Start, FlowFields.GetGoalPosition(GoalId), Path) ? 1 : 0;
+		}
+	}
+	const double FlowStart = FPlatformTime::Seconds();
+	for (int32 GoalId = 0; GoalId < Bridges.Num(); ++GoalId)
+	{
+		for (const FVector2D& Start : Starts)
+		{
+			FlowFields.FindPath(GoalId, Start, Path);
+		}
+	}
+	const double FlowSeconds = FPlatformTime::Seconds() - FlowStart;
+	const double AStarSeconds = FlowStart - AStarStart;
+
+	// Assert
+	AddInfo(FString::Printf(TEXT("%d bridge queries (%d found): A* %.2f ms, flow field %.2f ms (%.1fx), %d field builds"),
+		NumQueries * Bridges.Num(), Found, AStarSeconds * 1000.0, FlowSeconds * 1000.0,
+		FlowSeconds > 0.0 ? AStarSeconds / FlowSeconds : 0.0, FlowFields.GetStats().FieldBuilds));
+	TestEqual(TEXT("Timed queries built no fields"), FlowFields.GetStats().FieldBuilds, Bridges.Num());
+	TestTrue(TEXT("Flow field lookups beat A* searches"), FlowSeconds < AStarSeconds);
+
+	return true;
+}
+
+// ============================================================================
+// Flow Field Invalidation
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowFieldInvalidation,
+	"UnitSimCore.Pathfinding.FlowField.RebuildsOnlyOnWalkabilityChange",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFlowFieldInvalidation::RunTest(const FString& Parameters)
+{
+	// Arrange
+	FPathfindingGrid Grid(100.f, 100.f, 10.f);
+	FDynamicObstacleSystem DynObstacle(Grid);
+	FFlowFieldService FlowFields(Grid);
+	const int32 Goal = FlowFields.AddGoal(FVector2D(95.0, 95.0));
+
+	TArray<FUnit> Crowd;
+	for (int32 i = 0; i < 5; ++i)
+	{
+		FUnit U;
+		U.Initialize(i, FName(TEXT("test")), EUnitFaction::Friendly,
+			FVector2D(55.0, 55.0), 10.f, 4.f, 0.1f, EUnitRole::Melee, 100, 1);
+		U.Layer = EMovementLayer::Ground;
+		Crowd.Add(U);
+	}
+
+	// Act & Assert: Many queries, one build
+	TArray<FVector2D> Path;
+	for (int32 i = 0; i < 10; ++i)
+	{
+		TestTrue(TEXT("Path found"), FlowFields.FindPath(Goal, FVector2D(5.0 + i, 5.0), Path));
+	}
+	TestEqual(TEXT("Built once"), FlowFields.GetStats().FieldBuilds, 1);
+
+	// Writes that change nothing keep the field
+	Grid.SetWalkable(5, 5, true);
+	FlowFields.EnsureField(Goal);
+	TestEqual(TEXT("No-op write keeps the field"), FlowFields.GetStats().FieldBuilds, 1);
+
+	// A crowd blocks its cell once; standing still does not touch the grid again
+	DynObstacle.UpdateDynamicObstacles(Crowd.GetData(), Crowd.Num());
+	const uint32 CrowdVersion = Grid.GetWalkabilityVersion();
+	DynObstacle.UpdateDynamicObstacles(Crowd.GetData(), Crowd.Num());
+	TestEqual(TEXT("Unchanged crowd keeps the version"), Grid.GetWalkabilityVersion(), CrowdVersion);
+
+	FlowFields.FindPath(Goal, FVector2D(5.0, 5.0), Path);
+	TestEqual(TEXT("Crowd cell forces one rebuild"), FlowFields.GetStats().FieldBuilds, 2);
+	for (const FVector2D& Waypoint : Path)
+	{
+		TestTrue(TEXT("Path avoids the crowd cell"), Grid.NodeFromWorldPoint(Waypoint)->bIsWalkable);
+	}
+	TestTrue(TEXT("Direction sampled toward the goal"),
+		FlowFields.SampleDirection(Goal, FVector2D(5.0, 5.0)).X > 0.0);
+
+	return true;
+}
+
+// ============================================================================
+// Flow Field Repair
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowFieldRepair,
+	"UnitSimCore.Pathfinding.FlowField.RepairMatchesRebuild",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFlowFieldRepair::RunTest(const FString& Parameters)
+{
+	// Arrange: Arena fields toward a tower (blocked goal), a bridge and the main target
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	FPathfindingGrid& Grid = *Sim.GetPathfindingGrid();
+	const FVector2D TowerPosition = Sim.GetGameSession().EnemyTowers[0].Position;
+	const TArray<FVector2D> GoalPositions = { TowerPosition, FTerrainSystem::GetBridgeCenters()[0], Sim.GetMainTarget() };
+
+	FFlowFieldService Repaired(Grid);
+	for (const FVector2D& Position : GoalPositions)
+	{
+		Repaired.EnsureField(Repaired.AddGoal(Position));
+	}
+
+	// Cells a crowd may take: walkable now, so the static obstacles are never touched
+	TArray<FIntPoint> Candidates;
+	for (const FPathNode& Node : Grid.GetNodes())
+	{
+		if (Node.bIsWalkable)
+		{
+			Candidates.Emplace(Node.X, Node.Y);
+		}
+	}
+	const FPathNode* TowerNode = Grid.NodeFromWorldPoint(TowerPosition);
+
+	// Act & Assert: Churn like the dynamic obstacle update, some of it against the tower footprint
+	FRandomStream Random(25);
+	TSet<FIntPoint> Blocked;
+	int32 Mismatches = 0;
+	int32 CellsRepaired = 0;
+	constexpr int32 NumRounds = 8;
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		const uint32 PreviousVersion = Grid.GetWalkabilityVersion();
+		TArray<FIntPoint> Changed;
+		for (const FIntPoint& Cell : Blocked.Array())
+		{
+			if (Random.FRand() < 0.5f)
+			{
+				Grid.SetWalkable(Cell.X, Cell.Y, true);
+				Blocked.Remove(Cell);
+				Changed.Add(Cell);
+			}
+		}
+		for (int32 i = 0; i < 40; ++i)
+		{
+			FIntPoint Cell = Candidates[Random.RandHelper(Candidates.Num())];
+			if (i % 4 == 0)
+			{
+				Cell = FIntPoint(TowerNode->X + Random.RandRange(-6, 6), TowerNode->Y + Random.RandRange(-6, 6));
+				const FPathNode* Node = Grid.GetNode(Cell.X, Cell.Y);
+				if (Node == nullptr || (!Node->bIsWalkable && !Blocked.Contains(Cell))) continue;
+			}
+			if (Blocked.Contains(Cell)) continue;
+
+			Grid.SetWalkable(Cell.X, Cell.Y, false);
+			Blocked.Add(Cell);
+			Changed.Add(Cell);
+		}
+
+		Repaired.RepairFields(Changed, PreviousVersion);
+		CellsRepaired = Repaired.GetStats().CellsRepaired;
+
+		FFlowFieldService Rebuilt(Grid);
+		for (int32 GoalId = 0; GoalId < GoalPositions.Num(); ++GoalId)
+		{
+			Rebuilt.AddGoal(GoalPositions[GoalId]);
+			for (const FPathNode& Node : Grid.GetNodes())
+			{
+				const bool bSame =
+					Repaired.GetCost(GoalId, Node.WorldPosition) == Rebuilt.GetCost(GoalId, Node.WorldPosition) &&
+					Repaired.SampleDirection(GoalId, Node.WorldPosition) == Rebuilt.SampleDirection(GoalId, Node.WorldPosition);
+				Mismatches += bSame ? 0 : 1;
+			}
+		}
+	}
+
+	const int32 CellsPerBuild = Grid.GetWidth() * Grid.GetHeight() * GoalPositions.Num();
+	AddInfo(FString::Printf(TEXT("%d repairs expanded %d cells (%.1f%% of rebuilding every field each round)"),
+		Repaired.GetStats().FieldRepairs, CellsRepaired, 100.0 * CellsRepaired / (CellsPerBuild * NumRounds)));
+	TestEqual(TEXT("Repaired fields match rebuilt ones"), Mismatches, 0);
+	TestEqual(TEXT("Fields were never rebuilt"), Repaired.GetStats().FieldBuilds, GoalPositions.Num());
+	TestEqual(TEXT("Every field repaired each round"), Repaired.GetStats().FieldRepairs, GoalPositions.Num() * NumRounds);
+
+	return true;
+}
+
+// ============================================================================
+// HPA* vs A*
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHierarchicalMatchesAStar,
+	"UnitSimCore.Pathfinding.Hierarchical.MatchesAStarReachabilityOnArena",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FHierarchicalMatchesAStar::RunTest(const FString& Parameters)
+{
+	// Arrange: The arena grid and long random queries across it
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	FPathfindingGrid& Grid = *Sim.GetPathfindingGrid();
+	FAStarPathfinder Pathfinder(Grid);
+	FHierarchicalPathfinder Hierarchical(Grid);
+	Hierarchical.Refresh();
+
+	constexpr int32 NumQueries = 300;
+	const TArray<TPair<FVector2D, FVector2D>> Queries = MakeLongQueries(21, NumQueries, UnitSimConstants::HPA_MIN_QUERY_DISTANCE);
+
+	// Act
+	TArray<FVector2D> AStarPath;
+	TArray<FVector2D> HierarchicalPath;
+	int32 Found = 0;
+	int32 Mismatches = 0;
+	int32 InvalidPaths = 0;
+	double CostRatioSum = 0.0;
+	for (const TPair<FVector2D, FVector2D>& Query : Queries)
+	{
+		const bool bAStar = Pathfinder.FindPath(Query.Key, Query.Value, AStarPath);
+		const bool bHierarchical = Hierarchical.FindPath(Query.Key, Query.Value, HierarchicalPath);
+
+		Mismatches += bAStar != bHierarchical ? 1 : 0;
+		if (bAStar && bHierarchical)
+		{
+			Found++;
+			InvalidPaths += IsValidGridPath(Grid, Query.Key, Query.Value, HierarchicalPath) ? 0 : 1;
+			CostRatioSum += static_cast<double>(PathCost(Grid, Query.Key, HierarchicalPath)) /
+				FMath::Max(1, PathCost(Grid, Query.Key, AStarPath));
+		}
+	}
+
+	// Assert
+	const double MeanCostRatio = Found > 0 ? CostRatioSum / Found : 0.0;
+	AddInfo(FString::Printf(TEXT("%d clusters, %d entrances, %d long queries, cost x%.3f"),
+		Hierarchical.GetNumClusters(), Hierarchical.GetNumEntrances(), NumQueries, MeanCostRatio));
+	TestTrue(TEXT("Most queries find a path"), Found > NumQueries / 2);
+	TestEqual(TEXT("HPA* finds a path exactly when A* does"), Mismatches, 0);
+	TestEqual(TEXT("Every HPA* path is walkable step by step"), InvalidPaths, 0);
+	TestTrue(TEXT("HPA* paths stay close to optimal"), MeanCostRatio < 1.2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHierarchicalBenchmark,
+	"UnitSimCore.Pathfinding.Hierarchical.Benchmark.LongQueryBudget",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FHierarchicalBenchmark::RunTest(const FString& Parameters)
+{
+	// Arrange
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	FPathfindingGrid& Grid = *Sim.GetPathfindingGrid();
+	FAStarPathfinder Pathfinder(Grid);
+	FHierarchicalPathfinder Hierarchical(Grid);
+
+	const double BuildStart = FPlatformTime::Seconds();
+	Hierarchical.Refresh();
+	const double BuildSeconds = FPlatformTime::Seconds() - BuildStart;
+
+	constexpr int32 NumQueries = 1000;
+	const TArray<TPair<FVector2D, FVector2D>> Queries = MakeLongQueries(21, NumQueries, UnitSimConstants::HPA_MIN_QUERY_DISTANCE);
+
+	// Act: Each HPA* query timed on its own, A* in bulk for comparison
+	TArray<FVector2D> Path;
+	TArray<double> QueryUs;
+	QueryUs.Reserve(NumQueries);
+	for (const TPair<FVector2D, FVector2D>& Query : Queries)
+	{
+		const uint64 Start = FPlatformTime::Cycles64();
+		Hierarchical.FindPath(Query.Key, Query.Value, Path);
+		QueryUs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0);
+	}
+	const double AStarStart = FPlatformTime::Seconds();
+	for (const TPair<FVector2D, FVector2D>& Query : Queries)
+	{
+		Pathfinder.FindPath(Query.Key, Query.Value, Path);
+	}
+	const double AStarSeconds = FPlatformTime::Seconds() - AStarStart;
+
+	double TotalUs = 0.0;
+	for (const double Us : QueryUs)
+	{
+		TotalUs += Us;
+	}
+	QueryUs.Sort();
+	const double P95Us = QueryUs[FMath::Min(NumQueries - 1, FMath::FloorToInt(NumQueries * 0.95))];
+
+	// Assert
+	AddInfo(FString::Printf(TEXT("%d clusters, %d entrances, built in %.2f ms"),
+		Hierarchical.GetNumClusters(), Hierarchical.GetNumEntrances(), BuildSeconds * 1000.0));
+	AddInfo(FString::Printf(TEXT("%d long queries: A* %.1f us (%d nodes), HPA* mean %.1f us, p95 %.1f us, max %.1f us (%d abstract + %d local nodes)"),
+		NumQueries, AStarSeconds * 1e6 / NumQueries, Pathfinder.GetStats().NodesExpanded / NumQueries,
+		TotalUs / NumQueries, P95Us, QueryUs.Last(), Hierarchical.GetStats().AbstractNodesExpanded / NumQueries,
+		Hierarchical.GetStats().LocalNodesExpanded / NumQueries));
+	TestTrue(FString::Printf(TEXT("HPA* p95 %.1f us within the %.0f us budget"), P95Us, UnitSimConstants::HPA_QUERY_BUDGET_US),
+		P95Us <= UnitSimConstants::HPA_QUERY_BUDGET_US);
+
+	return true;
+}
+
+// ============================================================================
+// HPA* Incremental Update
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHierarchicalIncremental,
+	"UnitSimCore.Pathfinding.Hierarchical.IncrementalUpdateMatchesRebuild",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FHierarchicalIncremental::RunTest(const FString& Parameters)
+{
+	// Arrange: An up-to-date graph over the arena
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	FPathfindingGrid& Grid = *Sim.GetPathfindingGrid();
+	FHierarchicalPathfinder Incremental(Grid);
+	Incremental.Refresh();
+	Incremental.ResetStats();
+
+	// Act: Crowds block a few spots, as the dynamic obstacle system would
+	FRandomStream Random(210);
+	for (int32 i = 0; i < 12; ++i)
+	{
+		const FVector2D Min(Random.FRandRange(0.f, 3000.f), Random.FRandRange(0.f, 4900.f));
+		Grid.SetWalkableRect(Min, Min + FVector2D(100.0, 60.0), false);
+	}
+	Incremental.Refresh();
+	const int32 Rebuilt = Incremental.GetStats().ClustersRebuilt;
+
+	// Assert: Only the touched clusters (and their neighbors) were rebuilt...
+	TestTrue(TEXT("Some clusters rebuilt"), Rebuilt > 0);
+	TestTrue(TEXT("Not every cluster rebuilt"), Rebuilt < Incremental.GetNumClusters());
+	AddInfo(FString::Printf(TEXT("%d of %d clusters rebuilt"), Rebuilt, Incremental.GetNumClusters()));
+
+	// ...and the result answers exactly like a graph built from scratch
+	FHierarchicalPathfinder Fresh(Grid);
+	TArray<FVector2D> IncrementalPath;
+	TArray<FVector2D> FreshPath;
+	int32 Mismatches = 0;
+	for (const TPair<FVector2D, FVector2D>& Query : MakeLongQueries(211, 300, UnitSimConstants::HPA_MIN_QUERY_DISTANCE))
+	{
+		const bool bIncremental = Incremental.FindPath(Query.Key, Query.Value, IncrementalPath);
+		const bool bFresh = Fresh.FindPath(Query.Key, Query.Value, FreshPath);
+		Mismatches += (bIncremental != bFresh || IncrementalPath != FreshPath) ? 1 : 0;
+	}
+	TestEqual(TEXT("Incremental graph matches a fresh one"), Mismatches, 0);
+	TestEqual(TEXT("Same entrances"), Incremental.GetNumEntrances(), Fresh.GetNumEntrances());
+
+	// No walkability change, no rebuild
+	Incremental.ResetStats();
+	Grid.SetWalkable(0, 0, Grid.GetNode(0, 0)->bIsWalkable);
+	Incremental.Refresh();
+	TestEqual(TEXT("Unchanged grid rebuilds nothing"), Incremental.GetStats().ClustersRebuilt, 0);
+
+	return true;
+}
+
+// ============================================================================
+// Jump Point Search
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJumpPointMatchesAStar,
+	"UnitSimCore.Pathfinding.JumpPoint.MatchesAStarCost",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FJumpPointMatchesAStar::RunTest(const FString& Parameters)
+{
+	// Arrange: The arena grid, with a scatter of crowd-sized blocks for forced neighbors
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	FPathfindingGrid& Grid = *Sim.GetPathfindingGrid();
+	FRandomStream Random(22);
+	for (int32 i = 0; i < 200; ++i)
+	{
+		Grid.SetWalkable(Random.RandRange(0, Grid.GetWidth() - 1), Random.RandRange(0, Grid.GetHeight() - 1), false);
+	}
+
+	FAStarPathfinder AStar(Grid);
+	FAStarPathfinder JumpPoint(Grid);
+	JumpPoint.SetSearchMode(EPathSearchMode::JumpPoint);
+
+	// Act
+	constexpr int32 NumQueries = 2000;
+	TArray<FVector2D> AStarPath;
+	TArray<FVector2D> JumpPath;
+	int32 Found = 0;
+	int32 Mismatches = 0;
+	int32 InvalidPaths = 0;
+	for (const TPair<FVector2D, FVector2D>& Query : MakeLongQueries(220, NumQueries, 0.f))
+	{
+		const bool bAStar = AStar.FindPath(Query.Key, Query.Value, AStarPath);
+		const bool bJump = JumpPoint.FindPath(Query.Key, Query.Value, JumpPath);
+		Found += bAStar ? 1 : 0;
+		Mismatches += (bAStar != bJump || (bAStar && PathCost(Grid, Query.Key, AStarPath) != PathCost(Grid, Query.Key, JumpPath))) ? 1 : 0;
+		InvalidPaths += (bJump && !IsValidGridPath(Grid, Query.Key, Query.Value, JumpPath)) ? 1 : 0;
+	}
+
+	// Assert
+	AddInfo(FString::Printf(TEXT("%d arena queries: A* %d nodes, JPS %d nodes"),
+		NumQueries, AStar.GetStats().NodesExpanded, JumpPoint.GetStats().NodesExpanded));
+	TestTrue(TEXT("Most queries find a path"), Found > NumQueries / 2);
+	TestEqual(TEXT("JPS agrees with A* on reachability and cost"), Mismatches, 0);
+	TestEqual(TEXT("Every JPS path is walkable step by step"), InvalidPaths, 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJumpPointOpenField,
+	"UnitSimCore.Pathfinding.JumpPoint.ExpandsFewerNodesOnOpenField",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FJumpPointOpenField::RunTest(const FString& Parameters)
+{
+	// Arrange: A grid of the arena's size with nothing on it
+	FPathfindingGrid Grid(
+		static_cast<float>(UnitSimConstants::SIMULATION_WIDTH),
+		static_cast<float>(UnitSimConstants::SIMULATION_HEIGHT),
+		UnitSimConstants::UNIT_RADIUS);
+	FAStarPathfinder AStar(Grid);
+	FAStarPathfinder JumpPoint(Grid);
+	JumpPoint.SetSearchMode(EPathSearchMode::JumpPoint);
+
+	constexpr int32 NumQueries = 100;
+
+	// Act
+	TArray<FVector2D> Path;
+	for (const TPair<FVector2D, FVector2D>& Query : MakeLongQueries(221, NumQueries, UnitSimConstants::HPA_MIN_QUERY_DISTANCE))
+	{
+		AStar.FindPath(Query.Key, Query.Value, Path);
+		JumpPoint.FindPath(Query.Key, Query.Value, Path);
+	}
+
+	// Assert
+	const int32 AStarNodes = AStar.GetStats().NodesExpanded;
+	const int32 JumpNodes = JumpPoint.GetStats().NodesExpanded;
+	AddInfo(FString::Printf(TEXT("%d open-field queries: A* %d nodes, JPS %d nodes"), NumQueries, AStarNodes, JumpNodes));
+	TestTrue(TEXT("JPS expands an order of magnitude fewer nodes"), JumpNodes * 10 <= AStarNodes);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJumpPointBenchmark,
+	"UnitSimCore.Pathfinding.JumpPoint.Benchmark.OpenFieldVsAStar",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FJumpPointBenchmark::RunTest(const FString& Parameters)
+{
+	// Arrange
+	FPathfindingGrid Grid(
+		static_cast<float>(UnitSimConstants::SIMULATION_WIDTH),
+		static_cast<float>(UnitSimConstants::SIMULATION_HEIGHT),
+		UnitSimConstants::UNIT_RADIUS);
+	FAStarPathfinder AStar(Grid);
+	FAStarPathfinder JumpPoint(Grid);
+	JumpPoint.SetSearchMode(EPathSearchMode::JumpPoint);
+
+	constexpr int32 NumQueries = 500;
+	const TArray<TPair<FVector2D, FVector2D>> Queries = MakeLongQueries(221, NumQueries, UnitSimConstants::HPA_MIN_QUERY_DISTANCE);
+
+	// Act
+	TArray<FVector2D> Path;
+	const double AStarStart = FPlatformTime::Seconds();
+	for (const TPair<FVector2D, FVector2D>& Query : Queries)
+	{
+		AStar.FindPath(Query.Key, Query.Value, Path);
+	}
+	const double JumpStart = FPlatformTime::Seconds();
+	for (const TPair<FVector2D, FVector2D>& Query : Queries)
+	{
+		JumpPoint.FindPath(Query.Key, Query.Value, Path);
+	}
+	const double JumpSeconds = FPlatformTime::Seconds() - JumpStart;
+	const double AStarSeconds = JumpStart - AStarStart;
+
+	// Assert
+	AddInfo(FString::Printf(TEXT("%d open-field queries: A* %d nodes %.1f us, JPS %d nodes %.1f us"),
+		NumQueries, AStar.GetStats().NodesExpanded, AStarSeconds * 1e6 / NumQueries,
+		JumpPoint.GetStats().NodesExpanded, JumpSeconds * 1e6 / NumQueries));
+	TestTrue(TEXT("JPS beats A* on open ground"), JumpSeconds < AStarSeconds);
+
+	return true;
+}
+
+// ============================================================================
+// Path Cache
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathCacheLookup,
+	"UnitSimCore.Pathfinding.PathCache.HitsSuffixesAndInvalidates",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FPathCacheLookup::RunTest(const FString& Parameters)
+{
+	// Arrange: One path stored this frame
+	FPathfindingGrid Grid(100.f, 100.f, 10.f);
+	FAStarPathfinder Pathfinder(Grid);
+	FPathCache Cache(Grid, 2);
+	const FVector2D Start(5.0, 5.0);
+	const FVector2D Goal(95.0, 75.0);
+
+	TArray<FVector2D> Path;
+	TestTrue(TEXT("Path found"), Pathfinder.FindPath(Start, Goal, Path));
+	Cache.BeginFrame();
+	Cache.Add(Start, Goal, EMovementLayer::Ground, Path);
+
+	// Act & Assert: Exact hit, from anywhere in the same cells
+	TArray<FVector2D> Cached;
+	TestTrue(TEXT("Exact hit"), Cache.Find(Start + FVector2D(3.0, 2.0), Goal, EMovementLayer::Ground, Cached));
+	TestTrue(TEXT("Same path"), Cached == Path);
+	TestFalse(TEXT("Layers are kept apart"), Cache.Find(Start, Goal, EMovementLayer::Air, Cached));
+
+	// A start on the cached path reuses its tail
+	TestTrue(TEXT("Suffix hit"), Cache.Find(Path[2], Goal, EMovementLayer::Ground, Cached));
+	TestEqual(TEXT("Suffix length"), Cached.Num(), Path.Num() - 3);
+	TArray<FVector2D> Searched;
+	Pathfinder.FindPath(Path[2], Goal, Searched);
+	TestEqual(TEXT("Suffix is as short as a search"), PathCost(Grid, Path[2], Cached), PathCost(Grid, Path[2], Searched));
+
+	// Next frame: the tail is lent only once the path has been used again
+	Cache.BeginFrame();
+	TestFalse(TEXT("Last frame's path lends no tail"), Cache.Find(Path[2], Goal, EMovementLayer::Ground, Cached));
+	TestTrue(TEXT("Last frame's path still hits exactly"), Cache.Find(Start, Goal, EMovementLayer::Ground, Cached));
+	TestTrue(TEXT("And lends its tail again"), Cache.Find(Path[2], Goal, EMovementLayer::Ground, Cached));
+
+	// Least recently used goes first
+	Cache.Add(FVector2D(15.0, 5.0), Goal, EMovementLayer::Ground, Path);
+	Cache.Find(Start, Goal, EMovementLayer::Ground, Cached);
+	Cache.Add(FVector2D(25.0, 5.0), Goal, EMovementLayer::Ground, Path);
+	TestEqual(TEXT("Capacity kept"), Cache.Num(), 2);
+	TestTrue(TEXT("Recently used path kept"), Cache.Find(Start, Goal, EMovementLayer::Ground, Cached));
+	TestFalse(TEXT("Least recently used path evicted"), Cache.Find(FVector2D(15.0, 5.0), Goal, EMovementLayer::Ground, Cached));
+
+	// Walkability change drops everything; a no-op write does not
+	Grid.SetWalkable(0, 9, true);
+	TestTrue(TEXT("No-op write keeps the cache"), Cache.Find(Start, Goal, EMovementLayer::Ground, Cached));
+	Grid.SetWalkable(0, 9, false);
+	TestFalse(TEXT("Walkability change invalidates"), Cache.Find(Start, Goal, EMovementLayer::Ground, Cached));
+	TestEqual(TEXT("One invalidation"), Cache.GetStats().Invalidations, 1);
+	AddInfo(FString::Printf(TEXT("Hit rate %.2f"), Cache.GetStats().GetHitRate()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathCacheRestoredRun,
+	"UnitSimCore.Pathfinding.PathCache.RestoredRunMatches",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FPathCacheRestoredRun::RunTest(const FString& Parameters)
+{
+	// Arrange: A match with a warm cache, snapshotted part way
+	FSimulatorCore Warm;
+	Warm.Initialize(FSimBatchRunner::MakeRandomSkirmish(23, 30).Setup);
+	Warm.SetHasMoreWaves(false);
+	for (int32 i = 0; i < 60; ++i)
+	{
+		Warm.Step();
+	}
+	TArray<uint8> Snapshot;
+	Warm.SaveSnapshot(Snapshot);
+
+	// Act: Continue it, and replay the same frames from the snapshot with a cold cache
+	FSimulatorCore Cold;
+	TestTrue(TEXT("Snapshot restores"), Cold.RestoreSnapshot(Snapshot));
+
+	int32 Hits = 0;
+	int32 Misses = 0;
+	int32 Mismatches = 0;
+	for (int32 i = 0; i < 120; ++i)
+	{
+		Warm.Step();
+		Cold.Step();
+		Mismatches += Warm.GetStateHash() != Cold.GetStateHash() ? 1 : 0;
+		Hits += Warm.GetProfiler().GetLastFrame()->GetCounter(ESimCounter::PathCacheHits);
+		Misses += Warm.GetProfiler().GetLastFrame()->GetCounter(ESimCounter::PathCacheMisses);
+	}
+
+	// Assert
+	AddInfo(FString::Printf(TEXT("Path cache: %d hits, %d misses (%.0f%%)"),
+		Hits, Misses, Hits + Misses > 0 ? 100.0 * Hits / (Hits + Misses) : 0.0));
+	TestEqual(TEXT("Warm and cold caches give the same match"), Mismatches, 0);
+
+	return true;
+}
+
+// ============================================================================
+// Path Requests
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathRequestBudget,
+	"UnitSimCore.Pathfinding.PathRequests.BudgetGoesToMostUrgent",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FPathRequestBudget::RunTest(const FString& Parameters)
+{
+	// Arrange: Budget of two searches, four units; two of them ask the same query
+	FPathfindingGrid Grid(100.f, 100.f, 10.f);
+	FPathRequestService Requests(Grid, 2);
+
+	auto MakeRequest = [](int32 UnitId, const FVector2D& Goal, EPathRequestPriority Priority, int32 LastReplanFrame)
+	{
+		FPathRequest Request;
+		Request.UnitId = UnitId;
+		Request.Start = FVector2D(5.0, 5.0);
+		Request.Goal = Goal;
+		Request.Priority = Priority;
+		Request.LastReplanFrame = LastReplanFrame;
+		return Request;
+	};
+	Requests.Submit(MakeRequest(1, FVector2D(95.0, 5.0), EPathRequestPriority::Periodic, 0));
+	Requests.Submit(MakeRequest(2, FVector2D(95.0, 95.0), EPathRequestPriority::NewDestination, 50));
+	Requests.Submit(MakeRequest(3, FVector2D(5.0, 95.0), EPathRequestPriority::Periodic, 10));
+	Requests.Submit(MakeRequest(4, FVector2D(95.0, 95.0), EPathRequestPriority::NewDestination, 50));
+	Requests.Submit(MakeRequest(3, FVector2D(5.0, 95.0), EPathRequestPriority::Stall, 10));
+
+	// Act
+	const TArray<int32> Order = Requests.SortByUrgency();
+	TArray<bool> Granted;
+	for (const int32 Index : Order)
+	{
+		Granted.Add(Requests.QueueSearch(Index, false));
+	}
+	Requests.Launch(EPathSearchMode::AStar, false);
+	Requests.Wait();
+
+	// Assert
+	TestEqual(TEXT("A unit's second request replaces its first"), Requests.Num(), 4);
+	TestTrue(TEXT("Urgency order"), Order == TArray<int32>({ 1, 3, 2, 0 }));
+	TestTrue(TEXT("Only the periodic request is deferred"), Granted == TArray<bool>({ true, true, true, false }));
+
+	const FPathRequestService::FResult& First = Requests.GetResult(1);
+	const FPathRequestService::FResult& Shared = Requests.GetResult(3);
+	TestTrue(TEXT("Searched"), First.Status == FPathRequestService::EStatus::Searched && First.bFound);
+	TestEqual(TEXT("Identical query shares the search"), Shared.SearchIndex, First.SearchIndex);
+	TestTrue(TEXT("Shared result"), Shared.Path == First.Path);
+	TestTrue(TEXT("Stall request searched"), Requests.GetResult(2).bFound);
+	TestTrue(TEXT("Deferred request untouched"), Requests.GetResult(0).Status == FPathRequestService::EStatus::Deferred);
+
+	const FPathRequestService::FStats& Stats = Requests.GetStats();
+	TestEqual(TEXT("Searches run"), Stats.Searches, 2);
+	TestEqual(TEXT("Searches shared"), Stats.SharedSearches, 1);
+	TestEqual(TEXT("Requests deferred"), Stats.Deferred, 1);
+
+	Requests.Reset();
+	TestEqual(TEXT("Reset drops the step's requests"), Requests.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathRequestAsyncMatchesInline,
+	"UnitSimCore.Pathfinding.PathRequests.AsyncMatchesInline",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FPathRequestAsyncMatchesInline::RunTest(const FString& Parameters)
+{
+	// Arrange: The same skirmish with searches on worker tasks and on the simulation thread
+	const FSimBatchJob Job = FSimBatchRunner::MakeRandomSkirmish(29, 40);
+	FSimulatorCore Async;
+	Async.Initialize(Job.Setup);
+	Async.SetHasMoreWaves(false);
+	FSimulatorCore Inline;
+	Inline.Initialize(Job.Setup);
+	Inline.SetHasMoreWaves(false);
+	Inline.SetAsyncPathRequests(false);
+
+	// Act
+	int32 Mismatches = 0;
+	int32 Searches = 0;
+	int32 Deferred = 0;
+	for (int32 i = 0; i < 180; ++i)
+	{
+		Async.Step();
+		Inline.Step();
+		Mismatches += Async.GetStateHash() != Inline.GetStateHash() ? 1 : 0;
+		Searches += Async.GetProfiler().GetLastFrame()->GetCounter(ESimCounter::PathRequests)
+			+ Async.GetProfiler().GetLastFrame()->GetCounter(ESimCounter::HierarchicalPaths);
+		Deferred += Async.GetProfiler().GetLastFrame()->GetCounter(ESimCounter::PathsDeferred);
+	}
+
+	// Assert
+	AddInfo(FString::Printf(TEXT("Path requests: %d searches, %d deferred over budget"), Searches, Deferred));
+	TestEqual(TEXT("Worker searches give the same match"), Mismatches, 0);
+
+	return true;
+}
+
 // ============================================================================
 // A* Obstacle Avoidance
 // ============================================================================
@@ -0,0 +1,186 @@
+#include "Misc/AutomationTest.h"
+#include "Simulation/SimReplay.h"
+#include "Simulation/SimulatorCore.h"
+#include "Simulation/SimBatchRunner.h"
+#include "Commands/SimulationCommands.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	constexpr int32 RecordedFrames = 240;
+	constexpr int32 TestKeyframeInterval = 60;
+
+	FSimCommand MakeSpawn(int32 Frame, EUnitFaction Faction)
+	{
+		FSpawnUnitCommand Spawn;
+		Spawn.FrameNumber = Frame;
+		Spawn.Position = FVector2D(1600.0, Faction == EUnitFaction::Friendly ? 1200.0 : 3800.0);
+		Spawn.Role = EUnitRole::Ranged;
+		Spawn.Faction = Faction;
+		return FSimCommand::MakeSpawn(Spawn);
+	}
+
+	/**
+	 * Record a skirmish with commands on time, early (waiting in the queue) and
+	 * for a unit that is already engaged. OutStates gets a snapshot at each frame
+	 * in CaptureFrames, taken where a seek to that frame lands.
+	 */
+	void RecordMatch(FSimReplay& OutReplay, const TArray<int32>& CaptureFrames, TMap<int32, TArray<uint8>>& OutStates)
+	{
+		const FSimBatchJob Job = FSimBatchRunner::MakeRandomSkirmish(31, 12);
+		FSimulatorCore Sim;
+		Sim.Initialize(Job.Setup);
+		Sim.SetHasMoreWaves(false);
+
+		FSimReplayRecorder Recorder(Sim);
+		Recorder.Begin(Job.Setup, TestKeyframeInterval);
+
+		FKillUnitCommand Kill;
+		Kill.FrameNumber = 50;
+		Kill.UnitId = 1;
+		Kill.Faction = EUnitFaction::Friendly;
+
+		for (int32 Frame = 0; Frame < RecordedFrames; ++Frame)
+		{
+			if (CaptureFrames.Contains(Frame))
+			{
+				Sim.SaveSnapshot(OutStates.Add(Frame));
+			}
+			if (Frame == 10) Recorder.SubmitCommand(MakeSpawn(10, EUnitFaction::Enemy));
+			if (Frame == 20) Recorder.SubmitCommand(MakeSpawn(90, EUnitFaction::Friendly));
+			if (Frame == 21) Recorder.SubmitCommand(MakeSpawn(25, EUnitFaction::Enemy));
+			if (Frame == 50) Recorder.SubmitCommand(FSimCommand::MakeKill(Kill));
+			Recorder.Tick();
+		}
+		Sim.SaveSnapshot(OutStates.Add(RecordedFrames));
+
+		OutReplay = Recorder.GetReplay();
+	}
+}
+
+// ============================================================================
+// Playback
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReplayPlayback,
+	"UnitSimCore.Replay.Playback.MatchesRecording",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FReplayPlayback::RunTest(const FString& Parameters)
+{
+	// Arrange: Record, then round-trip the replay through bytes
+	FSimReplay Recorded;
+	TMap<int32, TArray<uint8>> States;
+	RecordMatch(Recorded, {}, States);
+
+	TArray<uint8> Bytes;
+	Recorded.Save(Bytes);
+	FSimReplay Loaded;
+	TestTrue(TEXT("Replay loads"), Loaded.Load(Bytes));
+
+	// Act
+	FSimulatorCore Sim;
+	FSimReplayPlayer Player(Sim, Loaded);
+	TestTrue(TEXT("Player starts"), Player.Start());
+	int32 FramesPlayed = 0;
+	while (!Player.IsAtEnd())
+	{
+		Player.Step();
+		FramesPlayed++;
+	}
+
+	// Assert
+	TArray<uint8> FinalState;
+	Sim.SaveSnapshot(FinalState);
+
+	AddInfo(FString::Printf(TEXT("%d frames: replay %d B (%d keyframes, %d commands)"),
+		RecordedFrames, Bytes.Num(), Loaded.Keyframes.Num(), Loaded.Commands.Num()));
+	TestEqual(TEXT("Every frame played"), FramesPlayed, RecordedFrames);
+	TestEqual(TEXT("Keyframes at 0, 60, ..., 240"), Loaded.Keyframes.Num(), RecordedFrames / TestKeyframeInterval + 1);
+	TestTrue(TEXT("Playback ends in the recorded state"), FinalState == States[RecordedFrames]);
+
+	// A truncated replay is refused
+	Bytes.SetNum(Bytes.Num() / 2);
+	AddExpectedError(TEXT("Replay rejected"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Truncated replay refused"), Loaded.Load(Bytes));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReplayDataSetMismatch,
+	"UnitSimCore.Replay.Playback.RejectsOtherDataSet",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FReplayDataSetMismatch::RunTest(const FString& Parameters)
+{
+	// Arrange: A player whose golemite hits harder than the recording's
+	FSimReplay Recorded;
+	TMap<int32, TArray<uint8>> States;
+	RecordMatch(Recorded, {}, States);
+
+	FSimulatorCore Sim;
+	FUnitDefinition Changed = *Sim.GetUnitRegistry().GetDefinition(FName(TEXT("golemite")));
+	Changed.Damage += 1;
+	Sim.GetUnitRegistry().Register(Changed);
+
+	// Act
+	FSimReplayPlayer Player(Sim, Recorded);
+	AddExpectedError(TEXT("Data set mismatch"), EAutomationExpectedErrorFlags::Contains, 1);
+	const bool bStarted = Player.Start();
+
+	// Assert
+	TestFalse(TEXT("Player refuses another data set"), bStarted);
+
+	return true;
+}
+
+// ============================================================================
+// Seeking
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReplaySeek,
+	"UnitSimCore.Replay.Seek.RestoresExactState",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FReplaySeek::RunTest(const FString& Parameters)
+{
+	// Arrange
+	FSimReplay Recorded;
+	TMap<int32, TArray<uint8>> States;
+	RecordMatch(Recorded, { 30, 50, 137, RecordedFrames - 1 }, States);
+
+	FSimulatorCore Sim;
+	FSimReplayPlayer Player(Sim, Recorded);
+	Player.Start();
+	TArray<uint8> State;
+
+	// Act & Assert: Forward from a keyframe
+	Player.Seek(137);
+	Sim.SaveSnapshot(State);
+	TestTrue(TEXT("Seek to 137 matches"), State == States[137]);
+	TestEqual(TEXT("Seek to 137 re-simulates from keyframe 120"), Player.GetLastSeekFrames(), 17);
+
+	// Backward, while the early commands still wait in the queue
+	Player.Seek(30);
+	Sim.SaveSnapshot(State);
+	TestTrue(TEXT("Seek back to 30 matches"), State == States[30]);
+
+	// Forward with no keyframe in between continues from the current frame
+	Player.Seek(50);
+	Sim.SaveSnapshot(State);
+	TestTrue(TEXT("Seek to 50 matches"), State == States[50]);
+	TestEqual(TEXT("Seek to 50 continues from 30"), Player.GetLastSeekFrames(), 20);
+
+	// Longest seek (a full keyframe interval) against real time
+	const double Start = FPlatformTime::Seconds();
+	Player.Seek(RecordedFrames - 1);
+	const double SeekSeconds = FPlatformTime::Seconds() - Start;
+	Sim.SaveSnapshot(State);
+	TestTrue(TEXT("Seek to the last frame matches"), State == States[RecordedFrames - 1]);
+
+	const double RealSeconds = Player.GetLastSeekFrames() * UnitSimConstants::FRAME_TIME_SECONDS;
+	AddInfo(FString::Printf(TEXT("Seek over %d frames: %.1f ms for %.1f s of match (%.0fx real time)"),
+		Player.GetLastSeekFrames(), SeekSeconds * 1000.0, RealSeconds, SeekSeconds > 0.0 ? RealSeconds / SeekSeconds : 0.0));
+
+	return true;
+}
@@ -0,0 +1,153 @@
+#include "Misc/AutomationTest.h"
+#include "Simulation/SimRollback.h"
+#include "Simulation/SimulatorCore.h"
+#include "Simulation/SimBatchRunner.h"
+#include "Commands/SimulationCommands.h"
+#include "GameConstants.h"
+
+namespace
+{
+	void InitSkirmish(FSimulatorCore& Sim, int32 UnitsPerSide)
+	{
+		Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(3, UnitsPerSide).Setup);
+		Sim.SetHasMoreWaves(false);
+	}
+
+	FSimCommand MakeLateSpawn(int32 Frame)
+	{
+		FSpawnUnitCommand Spawn;
+		Spawn.FrameNumber = Frame;
+		Spawn.Position = FVector2D(1600.0, 1800.0);
+		Spawn.Role = EUnitRole::Ranged;
+		Spawn.Faction = EUnitFaction::Enemy;
+		return FSimCommand::MakeSpawn(Spawn);
+	}
+}
+
+// ============================================================================
+// Late Commands
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRollbackLateCommand,
+	"UnitSimCore.Rollback.LateCommand.MatchesOnTimeDelivery",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRollbackLateCommand::RunTest(const FString& Parameters)
+{
+	// Arrange: Two identical matches; one gets its commands on time, the other five frames late
+	FSimulatorCore OnTimeSim;
+	FSimulatorCore LateSim;
+	InitSkirmish(OnTimeSim, 4);
+	InitSkirmish(LateSim, 4);
+	FSimRollback OnTime(OnTimeSim);
+	FSimRollback Late(LateSim);
+
+	FKillUnitCommand Kill;
+	Kill.FrameNumber = 22;
+	Kill.UnitId = 1;
+	Kill.Faction = EUnitFaction::Friendly;
+
+	int32 LateFramesBroadcast = 0;
+	LateSim.Callbacks.OnFrameGenerated.AddLambda([&LateFramesBroadcast](const FFrameData&) { LateFramesBroadcast++; });
+
+	// Act
+	OnTime.SubmitCommand(MakeLateSpawn(20));
+	OnTime.SubmitCommand(FSimCommand::MakeKill(Kill));
+	for (int32 i = 0; i < 40; ++i)
+	{
+		OnTime.Tick();
+	}
+
+	for (int32 i = 0; i < 25; ++i)
+	{
+		Late.Tick();
+	}
+	Late.SubmitCommand(MakeLateSpawn(20));
+	Late.SubmitCommand(FSimCommand::MakeKill(Kill));
+	Late.Tick();
+	const int32 RolledBack = Late.GetLastRollbackFrames();
+	for (int32 i = 26; i < 40; ++i)
+	{
+		Late.Tick();
+	}
+
+	// Assert: Same state byte for byte, and observers saw each frame once
+	TArray<uint8> OnTimeState;
+	TArray<uint8> LateState;
+	OnTimeSim.SaveSnapshot(OnTimeState);
+	LateSim.SaveSnapshot(LateState);
+
+	TestEqual(TEXT("Rolled back to frame 20 from frame 25"), RolledBack, 5);
+	TestEqual(TEXT("Nothing clamped"), Late.GetNumClampedCommands(), 0);
+	TestTrue(TEXT("Late delivery converges to the on-time state"), OnTimeState == LateState);
+	TestEqual(TEXT("Re-simulated frames are not broadcast"), LateFramesBroadcast, 40);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRollbackClamp,
+	"UnitSimCore.Rollback.LateCommand.OlderThanWindowIsClamped",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRollbackClamp::RunTest(const FString& Parameters)
+{
+	// Arrange
+	FSimulatorCore Sim;
+	InitSkirmish(Sim, 2);
+	FSimRollback Rollback(Sim, 4);
+	for (int32 i = 0; i < 20; ++i)
+	{
+		Rollback.Tick();
+	}
+	const int32 EnemiesBefore = Sim.GetEnemyUnits().Num();
+
+	// Act: Frame 2 left the four-frame window long ago
+	Rollback.SubmitCommand(MakeLateSpawn(2));
+	Rollback.Tick();
+
+	// Assert
+	TestEqual(TEXT("Command clamped"), Rollback.GetNumClampedCommands(), 1);
+	TestEqual(TEXT("Rolled back the whole window"), Rollback.GetLastRollbackFrames(), 4);
+	TestTrue(TEXT("Command still applied"), Sim.GetEnemyUnits().Num() > EnemiesBefore);
+
+	return true;
+}
+
+// ============================================================================
+// Frame Budget
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRollbackBudget,
+	"UnitSimCore.Rollback.Budget.FramesPerFrameTime",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRollbackBudget::RunTest(const FString& Parameters)
+{
+	// Arrange: A crowded match with a full-window rollback every few frames
+	FSimulatorCore Sim;
+	InitSkirmish(Sim, 40);
+	FSimRollback Rollback(Sim);
+
+	// Act
+	int32 Rollbacks = 0;
+	for (int32 i = 0; i < 90; ++i)
+	{
+		if (i > UnitSimConstants::ROLLBACK_MAX_FRAMES && i % 5 == 0)
+		{
+			Rollback.SubmitCommand(MakeLateSpawn(Sim.GetCurrentFrame() - UnitSimConstants::ROLLBACK_MAX_FRAMES));
+		}
+		Rollback.Tick();
+		Rollbacks += Rollback.GetLastRollbackFrames() > 0 ? 1 : 0;
+	}
+
+	const int32 Bound = Rollback.EstimateRollbackBound();
+	AddInfo(FString::Printf(TEXT("%d units: %d rollback frames fit in %.1f ms (ring holds %d)"),
+		Sim.GetFriendlyUnits().Num() + Sim.GetEnemyUnits().Num(), Bound,
+		UnitSimConstants::FRAME_TIME_SECONDS * 1000.0, Rollback.GetMaxRollbackFrames()));
+
+	// Assert
+	TestTrue(TEXT("Rollbacks ran"), Rollbacks > 0);
+	TestTrue(TEXT("Bound is measured"), Bound >= 0);
+
+	return true;
+}
@@ -0,0 +1,440 @@
+#include "Misc/AutomationTest.h"
+#include "Simulation/SimulatorCore.h"
+#include "Terrain/MapLayout.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "TestAllocationCounter.h"
+
+namespace
+{
+	// ========================================================================
+	// Scenarios
+	// ========================================================================
+
+	/** Ground-unit band on the friendly half, clear of the river */
+	constexpr double FieldYMin = 300.0;
+	constexpr double FieldYMax = MapLayout::RIVER_Y_MIN - 60.0;
+
+	void AddUnit(FInitialSetup& Setup, const TCHAR* UnitId, EUnitFaction Faction, const FVector2D& Position)
+	{
+		FUnitSpawnSetup& Spawn = Setup.InitialUnits.AddDefaulted_GetRef();
+		Spawn.UnitId = FName(UnitId);
+		Spawn.Faction = Faction;
+		Spawn.Position = Position;
+	}
+
+	/** Every role and layer, the two sides facing off across the middle of the friendly half */
+	FInitialSetup MakeBrawl(int32 Units, FRandomStream& Stream)
+	{
+		static const TCHAR* Mix[] = { TEXT("skeleton"), TEXT("guard"), TEXT("golemite"), TEXT("minion"), TEXT("bat"), TEXT("lava_pup") };
+
+		FInitialSetup Setup = FInitialSetup::CreateClashRoyaleStandard();
+		for (int32 i = 0; i < Units; ++i)
+		{
+			const bool bFriendly = i % 2 == 0;
+			const double X = bFriendly ? Stream.FRandRange(100.0, 1500.0) : Stream.FRandRange(1700.0, 3100.0);
+			AddUnit(Setup, Mix[Stream.RandRange(0, UE_ARRAY_COUNT(Mix) - 1)],
+				bFriendly ? EUnitFaction::Friendly : EUnitFaction::Enemy,
+				FVector2D(X, Stream.FRandRange(FieldYMin, FieldYMax)));
+		}
+		return Setup;
+	}
+
+	/** Ground units only, massed at both ends of the left bridge */
+	FInitialSetup MakeChokepoint(int32 Units, FRandomStream& Stream)
+	{
+		static const TCHAR* Mix[] = { TEXT("skeleton"), TEXT("guard"), TEXT("golemite") };
+		const double BridgeCenter = (MapLayout::LEFT_BRIDGE_X_MIN + MapLayout::LEFT_BRIDGE_X_MAX) * 0.5;
+
+		FInitialSetup Setup = FInitialSetup::CreateClashRoyaleStandard();
+		for (int32 i = 0; i < Units; ++i)
+		{
+			const bool bFriendly = i % 2 == 0;
+			const double Depth = Stream.FRandRange(60.0, 1200.0);
+			const double Y = bFriendly ? MapLayout::RIVER_Y_MIN - Depth : MapLayout::RIVER_Y_MAX + Depth;
+			AddUnit(Setup, Mix[Stream.RandRange(0, UE_ARRAY_COUNT(Mix) - 1)],
+				bFriendly ? EUnitFaction::Friendly : EUnitFaction::Enemy,
+				FVector2D(BridgeCenter + Stream.FRandRange(-350.0, 350.0), Y));
+		}
+		return Setup;
+	}
+
+	/** Attackers ringed around the friendly princess towers, a small garrison by the king */
+	FInitialSetup MakeSiege(int32 Units, FRandomStream& Stream)
+	{
+		static const TCHAR* Mix[] = { TEXT("skeleton"), TEXT("guard"), TEXT("minion"), TEXT("lava_pup") };
+		const FVector2D Towers[] = { MapLayout::FriendlyPrincessLeftPosition(), MapLayout::FriendlyPrincessRightPosition() };
+
+		FInitialSetup Setup = FInitialSetup::CreateClashRoyaleStandard();
+		const int32 Garrison = FMath::Max(1, Units / 10);
+		for (int32 i = 0; i < Units; ++i)
+		{
+			const TCHAR* UnitId = Mix[Stream.RandRange(0, UE_ARRAY_COUNT(Mix) - 1)];
+			if (i < Garrison)
+			{
+				const FVector2D Offset(Stream.FRandRange(-500.0, 500.0), Stream.FRandRange(-200.0, 300.0));
+				AddUnit(Setup, UnitId, EUnitFaction::Friendly, MapLayout::FriendlyKingPosition() + Offset);
+			}
+			else
+			{
+				const double Angle = Stream.FRandRange(0.0, 2.0 * UE_DOUBLE_PI);
+				const double Radius = Stream.FRandRange(200.0, 900.0);
+				const FVector2D Position = Towers[i % 2] + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius;
+				AddUnit(Setup, UnitId, EUnitFaction::Enemy, MapLayout::ClampToBounds(Position));
+			}
+		}
+		return Setup;
+	}
+
+	/** Death-spawning golemites in contact, so every kill adds two more units to the fight */
+	FInitialSetup MakeDeathChains(int32 Units, FRandomStream& Stream)
+	{
+		FInitialSetup Setup = FInitialSetup::CreateClashRoyaleStandard();
+		for (int32 i = 0; i < Units; ++i)
+		{
+			const bool bFriendly = i % 2 == 0;
+			const double X = bFriendly ? Stream.FRandRange(300.0, 1600.0) : Stream.FRandRange(1600.0, 2900.0);
+			AddUnit(Setup, TEXT("elixir_golemite"), bFriendly ? EUnitFaction::Friendly : EUnitFaction::Enemy,
+				FVector2D(X, Stream.FRandRange(FieldYMin, FieldYMax)));
+		}
+		return Setup;
+	}
+
+	struct FScenario
+	{
+		const TCHAR* Name;
+		FInitialSetup (*Build)(int32 Units, FRandomStream& Stream);
+	};
+
+	const FScenario Scenarios[] =
+	{
+		{ TEXT("Brawl"), &MakeBrawl },
+		{ TEXT("Chokepoint"), &MakeChokepoint },
+		{ TEXT("Siege"), &MakeSiege },
+		{ TEXT("DeathChains"), &MakeDeathChains },
+	};
+
+	/**
+	 * Steps and fallback budgets per unit count. The fallbacks apply until a
+	 * baseline is recorded for the case. Step() builds an FFrameData snapshot,
+	 * about seven allocations per unit (five strings, the ability list, the
+	 * unit itself), so the allocation fallback is nine per unit; the serial p95
+	 * fallback is the budget the parallel run must also meet.
+	 */
+	struct FBenchmarkSize
+	{
+		int32 Units;
+		int32 Steps;
+		double FallbackP95Ms;
+		double FallbackAllocsPerStep;
+	};
+
+	const FBenchmarkSize Sizes[] =
+	{
+		{ 100, 300, 3.0, 900.0 },
+		{ 1000, 120, 30.0, 9000.0 },
+		{ 5000, 30, 200.0, 45000.0 },
+		{ 10000, 20, 500.0, 90000.0 },
+	};
+
+	/** Steps before measuring, so first-frame pathing and buffer growth are not counted */
+	constexpr int32 WarmupSteps = 3;
+
+	/**
+	 * Budgets are a recorded baseline plus a fixed margin. Allocation counts are
+	 * deterministic (one thread, fixed inputs), so their margin only absorbs
+	 * engine-side drift; step time gets room for machine noise.
+	 */
+	constexpr double P95MarginFraction = 0.25;
+	constexpr double AllocsMarginFraction = 0.05;
+	constexpr double AllocsMarginPerStep = 2.0;
+
+	// ========================================================================
+	// Results
+	// ========================================================================
+
+	struct FBenchmarkResult
+	{
+		FString Scenario;
+		int32 Units = 0;
+		int32 Steps = 0;
+		int32 FinalUnits = 0;
+		double P50Ms = 0.0;
+		double P95Ms = 0.0;
+		double P99Ms = 0.0;
+		double MeanMs = 0.0;
+		double ParallelP50Ms = 0.0;
+		double ParallelP95Ms = 0.0;
+		double ParallelP99Ms = 0.0;
+		double AllocsPerStep = 0.0;
+		uint64 PeakUsedPhysical = 0;
+		int64 PeakGrowth = 0;
+	};
+
+	/** Nearest-rank percentile of an ascending array */
+	double Percentile(const TArray<double>& Sorted, double Fraction)
+	{
+		if (Sorted.Num() == 0) return 0.0;
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt32(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Rank];
+	}
+
+	FString ToJson(const FBenchmarkResult& Result)
+	{
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetStringField(TEXT("scenario"), Result.Scenario);
+		Json->SetNumberField(TEXT("units"), Result.Units);
+		Json->SetNumberField(TEXT("steps"), Result.Steps);
+		Json->SetNumberField(TEXT("finalUnits"), Result.FinalUnits);
+		Json->SetNumberField(TEXT("p50Ms"), Result.P50Ms);
+		Json->SetNumberField(TEXT("p95Ms"), Result.P95Ms);
+		Json->SetNumberField(TEXT("p99Ms"), Result.P99Ms);
+		Json->SetNumberField(TEXT("meanMs"), Result.MeanMs);
+		Json->SetNumberField(TEXT("parallelP50Ms"), Result.ParallelP50Ms);
+		Json->SetNumberField(TEXT("parallelP95Ms"), Result.ParallelP95Ms);
+		Json->SetNumberField(TEXT("parallelP99Ms"), Result.ParallelP99Ms);
+		Json->SetNumberField(TEXT("allocsPerStep"), Result.AllocsPerStep);
+		Json->SetNumberField(TEXT("peakUsedPhysicalBytes"), static_cast<double>(Result.PeakUsedPhysical));
+		Json->SetNumberField(TEXT("peakGrowthBytes"), static_cast<double>(Result.PeakGrowth));
+
+		FString Text;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Text);
+		FJsonSerializer::Serialize(Json, Writer);
+		return Text;
+	}
+
+	/** Checked-in baseline for a case: a result file recorded with -UnitSimRecordBaselines */
+	FString GetBaselinePath(const FScenario& Scenario, const FBenchmarkSize& Size)
+	{
+		return FPaths::Combine(FPaths::ProjectPluginsDir(), TEXT("UnitSimCore"), TEXT("Benchmarks"), TEXT("Baselines"),
+			FString::Printf(TEXT("%s_%d.json"), Scenario.Name, Size.Units));
+	}
+
+	/** What a case is held to: its recorded baseline, or the size's fallback */
+	struct FBaseline
+	{
+		double P95Ms = 0.0;
+		double ParallelP95Ms = 0.0;
+		double AllocsPerStep = 0.0;
+		bool bRecorded = false;
+	};
+
+	bool LoadBaseline(const FString& Path, FBaseline& OutBaseline)
+	{
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *Path))
+		{
+			return false;
+		}
+
+		TSharedPtr<FJsonObject> Json;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+		OutBaseline.bRecorded = FJsonSerializer::Deserialize(Reader, Json) && Json.IsValid()
+			&& Json->TryGetNumberField(TEXT("p95Ms"), OutBaseline.P95Ms)
+			&& Json->TryGetNumberField(TEXT("parallelP95Ms"), OutBaseline.ParallelP95Ms)
+			&& Json->TryGetNumberField(TEXT("allocsPerStep"), OutBaseline.AllocsPerStep);
+		return OutBaseline.bRecorded;
+	}
+
+	/**
+	 * Serial runs are timed and counted: the counter only sees this thread, so
+	 * nothing may be handed to workers. Parallel runs (Phase 1 fan-out and async
+	 * path searches, the shipping configuration) are timed only.
+	 */
+	FBenchmarkResult RunScenario(const FScenario& Scenario, const FBenchmarkSize& Size, bool bParallel)
+	{
+		FRandomStream Stream(Size.Units);
+		FSimulatorCore Sim;
+		Sim.Initialize(Scenario.Build(Size.Units, Stream));
+		Sim.SetHasMoreWaves(false);
+		Sim.SetParallelPhase1(bParallel);
+		Sim.SetAsyncPathRequests(bParallel);
+
+		for (int32 i = 0; i < WarmupSteps; ++i)
+		{
+			Sim.Step();
+		}
+
+		FBenchmarkResult Result;
+		Result.Scenario = Scenario.Name;
+		Result.Units = Size.Units;
+		Result.Steps = Size.Steps;
+
+		const uint64 BaselineUsed = FPlatformMemory::GetStats().UsedPhysical;
+		Result.PeakUsedPhysical = BaselineUsed;
+
+		TArray<double> StepMs;
+		StepMs.Reserve(Size.Steps);
+
+		int64 StepAllocations = 0;
+		for (int32 i = 0; i < Size.Steps; ++i)
+		{
+			if (bParallel)
+			{
+				const uint64 Start = FPlatformTime::Cycles64();
+				Sim.Step();
+				StepMs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start));
+			}
+			else
+			{
+				UnitSimTest::FScopedAllocationCounter Counter;
+				const uint64 Start = FPlatformTime::Cycles64();
+				Sim.Step();
+				StepMs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start));
+				StepAllocations += Counter.GetCount();
+			}
+
+			// Outside the timed and counted span; on most platforms this reads OS counters
+			Result.PeakUsedPhysical = FMath::Max<uint64>(Result.PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+		}
+
+		double SumMs = 0.0;
+		for (const double Ms : StepMs)
+		{
+			SumMs += Ms;
+		}
+		StepMs.Sort();
+
+		Result.AllocsPerStep = static_cast<double>(StepAllocations) / Size.Steps;
+		Result.MeanMs = SumMs / Size.Steps;
+		Result.P50Ms = Percentile(StepMs, 0.50);
+		Result.P95Ms = Percentile(StepMs, 0.95);
+		Result.P99Ms = Percentile(StepMs, 0.99);
+		Result.PeakGrowth = static_cast<int64>(Result.PeakUsedPhysical) - static_cast<int64>(BaselineUsed);
+		Result.FinalUnits = Sim.GetFriendlyUnits().Num() + Sim.GetEnemyUnits().Num();
+		return Result;
+	}
+}
+
+// ============================================================================
+// Scenario Benchmarks
+// ============================================================================
+
+/**
+ * One case per scenario and unit count, e.g. UnitSimCore.Benchmark.Scenario.Siege.5000.
+ * Perf filter, so the regular product test pass skips them. Each case writes its
+ * result to Saved/Automation/UnitSimBenchmarks/<Scenario>_<Units>.json. The
+ * scenario runs twice: serial (timed, allocations counted) and with Phase 1
+ * workers and async paths on (timed). It fails if either p95 step time or the
+ * serial allocations per step exceed the budget plus the margin. The budget is
+ * the recorded baseline (plugin Benchmarks/Baselines/<Scenario>_<Units>.json)
+ * when there is one, else the fallback in Sizes. Running with
+ * -UnitSimRecordBaselines writes the results there instead of checking them.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FScenarioBenchmark,
+	"UnitSimCore.Benchmark.Scenario",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FScenarioBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const FScenario& Scenario : Scenarios)
+	{
+		for (const FBenchmarkSize& Size : Sizes)
+		{
+			OutBeautifiedNames.Add(FString::Printf(TEXT("%s.%d"), Scenario.Name, Size.Units));
+			OutTestCommands.Add(FString::Printf(TEXT("%s %d"), Scenario.Name, Size.Units));
+		}
+	}
+}
+
+bool FScenarioBenchmark::RunTest(const FString& Parameters)
+{
+	// Arrange
+	FString ScenarioName;
+	FString UnitsText;
+	if (!Parameters.Split(TEXT(" "), &ScenarioName, &UnitsText))
+	{
+		AddError(FString::Printf(TEXT("Bad benchmark parameters '%s'"), *Parameters));
+		return false;
+	}
+	const int32 Units = FCString::Atoi(*UnitsText);
+
+	const FScenario* Scenario = nullptr;
+	for (const FScenario& Candidate : Scenarios)
+	{
+		Scenario = ScenarioName == Candidate.Name ? &Candidate : Scenario;
+	}
+	const FBenchmarkSize* Size = nullptr;
+	for (const FBenchmarkSize& Candidate : Sizes)
+	{
+		Size = Units == Candidate.Units ? &Candidate : Size;
+	}
+	if (Scenario == nullptr || Size == nullptr)
+	{
+		AddError(FString::Printf(TEXT("Unknown benchmark '%s'"), *Parameters));
+		return false;
+	}
+
+	// Act
+	FBenchmarkResult Result = RunScenario(*Scenario, *Size, false);
+	const FBenchmarkResult Parallel = RunScenario(*Scenario, *Size, true);
+	Result.ParallelP50Ms = Parallel.P50Ms;
+	Result.ParallelP95Ms = Parallel.P95Ms;
+	Result.ParallelP99Ms = Parallel.P99Ms;
+
+	const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("UnitSimBenchmarks"),
+		FString::Printf(TEXT("%s_%d.json"), Scenario->Name, Size->Units));
+	const bool bSaved = FFileHelper::SaveStringToFile(ToJson(Result), *Path);
+
+	AddInfo(FString::Printf(TEXT("%s %d units (%d at end), %d steps: serial p50 %.2f ms, p95 %.2f ms, p99 %.2f ms; parallel p50 %.2f ms, p95 %.2f ms, p99 %.2f ms; %.0f allocs/step, peak %.1f MB (+%.1f MB)"),
+		Scenario->Name, Size->Units, Result.FinalUnits, Size->Steps, Result.P50Ms, Result.P95Ms, Result.P99Ms,
+		Result.ParallelP50Ms, Result.ParallelP95Ms, Result.ParallelP99Ms, Result.AllocsPerStep, Result.PeakUsedPhysical / (1024.0 * 1024.0), Result.PeakGrowth / (1024.0 * 1024.0)));
+
+	// Assert
+	TestTrue(TEXT("Result written"), bSaved);
+
+	const FString BaselinePath = GetBaselinePath(*Scenario, *Size);
+	if (FParse::Param(FCommandLine::Get(), TEXT("UnitSimRecordBaselines")))
+	{
+		TestTrue(TEXT("Baseline recorded"), FFileHelper::SaveStringToFile(ToJson(Result), *BaselinePath));
+		return true;
+	}
+
+	// Budgets always apply: a recorded baseline replaces the size's fallback
+	FBaseline Baseline;
+	if (IFileManager::Get().FileExists(*BaselinePath))
+	{
+		if (!LoadBaseline(BaselinePath, Baseline))
+		{
+			AddError(FString::Printf(TEXT("Baseline at %s is unreadable; re-record it with -UnitSimRecordBaselines"), *BaselinePath));
+			return false;
+		}
+	}
+	else
+	{
+		Baseline.P95Ms = Size->FallbackP95Ms;
+		Baseline.ParallelP95Ms = Size->FallbackP95Ms;
+		Baseline.AllocsPerStep = Size->FallbackAllocsPerStep;
+	}
+	const TCHAR* BaselineSource = Baseline.bRecorded ? TEXT("baseline") : TEXT("fallback");
+
+	const double P95BudgetMs = Baseline.P95Ms * (1.0 + P95MarginFraction);
+	const double ParallelP95BudgetMs = Baseline.ParallelP95Ms * (1.0 + P95MarginFraction);
+	const double AllocsPerStepBudget = Baseline.AllocsPerStep * (1.0 + AllocsMarginFraction) + AllocsMarginPerStep;
+	if (Result.P95Ms > P95BudgetMs)
+	{
+		AddError(FString::Printf(TEXT("Serial p95 step %.2f ms over the %.2f ms budget (%s %.2f ms)"),
+			Result.P95Ms, P95BudgetMs, BaselineSource, Baseline.P95Ms));
+	}
+	if (Result.ParallelP95Ms > ParallelP95BudgetMs)
+	{
+		AddError(FString::Printf(TEXT("Parallel p95 step %.2f ms over the %.2f ms budget (%s %.2f ms)"),
+			Result.ParallelP95Ms, ParallelP95BudgetMs, BaselineSource, Baseline.ParallelP95Ms));
+	}
+	if (Result.AllocsPerStep > AllocsPerStepBudget)
+	{
+		AddError(FString::Printf(TEXT("%.1f allocations per step over the %.1f budget (%s %.1f)"),
+			Result.AllocsPerStep, AllocsPerStepBudget, BaselineSource, Baseline.AllocsPerStep));
+	}
+
+	return true;
+}
@@ -1,8 +1,11 @@
 #include "Misc/AutomationTest.h"
 #include "Simulation/SimulatorCore.h"
 #include "Simulation/FrameData.h"
+#include "Simulation/SimBatchRunner.h"
 #include "Commands/SimulationCommands.h"
 #include "GameConstants.h"
+#include "HAL/PlatformTime.h"
+#include "TestAllocationCounter.h"
 
 // ============================================================================
 // FSimulatorCore Initialization
@@ -79,7 +82,7 @@ bool FSimCoreSpawnCommand::RunTest(const FString& Parameters)
 	SpawnCmd.Faction = EUnitFaction::Enemy;
 	SpawnCmd.HP = 50;
 
-	Sim.EnqueueCommand(FSimCommandWrapper::MakeSpawn(SpawnCmd));
+	Sim.EnqueueCommand(FSimCommand::MakeSpawn(SpawnCmd));
 
 	// Act
 	FFrameData Frame = Sim.Step();
@@ -119,7 +122,7 @@ bool FSimCoreMoveCommand::RunTest(const FString& Parameters)
 	MoveCmd.Faction = EUnitFaction::Friendly;
 	MoveCmd.Destination = FVector2D(1600.0, 3000.0);
 
-	Sim.EnqueueCommand(FSimCommandWrapper::MakeMove(MoveCmd));
+	Sim.EnqueueCommand(FSimCommand::MakeMove(MoveCmd));
 
 	// Step multiple frames to allow movement
 	for (int32 i = 0; i < 10; ++i)
@@ -158,7 +161,7 @@ bool FSimCoreDeterminism::RunTest(const FString& Parameters)
 		Spawn1.Role = EUnitRole::Melee;
 		Spawn1.Faction = EUnitFaction::Enemy;
 		Spawn1.HP = 10;
-		Sim.EnqueueCommand(FSimCommandWrapper::MakeSpawn(Spawn1));
+		Sim.EnqueueCommand(FSimCommand::MakeSpawn(Spawn1));
 
 		FSpawnUnitCommand Spawn2;
 		Spawn2.FrameNumber = 2;
@@ -166,14 +169,14 @@ bool FSimCoreDeterminism::RunTest(const FString& Parameters)
 		Spawn2.Role = EUnitRole::Ranged;
 		Spawn2.Faction = EUnitFaction::Enemy;
 		Spawn2.HP = 8;
-		Sim.EnqueueCommand(FSimCommandWrapper::MakeSpawn(Spawn2));
+		Sim.EnqueueCommand(FSimCommand::MakeSpawn(Spawn2));
 
 		FDamageUnitCommand Dmg;
 		Dmg.FrameNumber = 5;
 		Dmg.UnitId = 1;
 		Dmg.Faction = EUnitFaction::Enemy;
 		Dmg.Damage = 3;
-		Sim.EnqueueCommand(FSimCommandWrapper::MakeDamage(Dmg));
+		Sim.EnqueueCommand(FSimCommand::MakeDamage(Dmg));
 	};
 
 	FSimulatorCore Sim1;
@@ -204,6 +207,259 @@ bool FSimCoreDeterminism::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreParallelPhase1,
+	"UnitSimCore.SimulatorCore.Determinism.ParallelMatchesSerial",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreParallelPhase1::RunTest(const FString& Parameters)
+{
+	// Arrange: Enough enemies to span several Phase 1 batches, one run forced single-threaded
+	auto CreateAndSetup = [](FSimulatorCore& Sim, bool bParallel)
+	{
+		Sim.Initialize();
+		Sim.SetHasMoreWaves(false);
+		Sim.SetParallelPhase1(bParallel);
+
+		const int32 NumEnemies = UnitSimConstants::PHASE1_PARALLEL_BATCH_SIZE * 3 + 5;
+		for (int32 i = 0; i < NumEnemies; ++i)
+		{
+			FSpawnUnitCommand Spawn;
+			Spawn.FrameNumber = 0;
+			Spawn.Position = FVector2D(1400.0 + (i % 16) * 40.0, 300.0 + (i / 16) * 40.0);
+			Spawn.Role = (i % 3 == 0) ? EUnitRole::Ranged : EUnitRole::Melee;
+			Spawn.Faction = EUnitFaction::Enemy;
+			Spawn.HP = 10;
+			Sim.EnqueueCommand(FSimCommand::MakeSpawn(Spawn));
+		}
+	};
+
+	FSimulatorCore Serial;
+	FSimulatorCore Parallel;
+	CreateAndSetup(Serial, false);
+	CreateAndSetup(Parallel, true);
+
+	// Act & Assert: The full state (every unit and tower field, bit for bit) must hash the same each frame
+	bool bAllMatch = true;
+	for (int32 i = 0; i < 200; ++i)
+	{
+		Serial.Step();
+		Parallel.Step();
+
+		const FSimStateHash& SerialHash = Serial.GetStateHash();
+		const FSimStateHash& ParallelHash = Parallel.GetStateHash();
+		if (SerialHash != ParallelHash)
+		{
+			FSimDivergence Divergence;
+			Divergence.Frame = Serial.GetCurrentFrame();
+			Divergence.Domain = SerialHash.FindFirstDifference(ParallelHash);
+			AddError(FString::Printf(TEXT("Serial and parallel Phase 1 differ: %s"), *Divergence.ToString()));
+			bAllMatch = false;
+			break;
+		}
+	}
+
+	TestTrue(TEXT("State hashing is on"), Serial.GetStateHash().Combined != 0);
+	TestTrue(TEXT("200 frames identical across thread counts"), bAllMatch);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreBatchRunner,
+	"UnitSimCore.SimulatorCore.Determinism.BatchIndependentOfWorkers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreBatchRunner::RunTest(const FString& Parameters)
+{
+	// Arrange: A handful of seeded skirmishes
+	TArray<FSimBatchJob> Jobs;
+	for (int32 Seed = 1; Seed <= 4; ++Seed)
+	{
+		Jobs.Add(FSimBatchRunner::MakeRandomSkirmish(Seed, 3));
+	}
+
+	// Act: One worker restarts a single simulator for every match; three share them out
+	FSimBatchRunner SingleWorker(1);
+	FSimBatchRunner ThreeWorkers(3);
+	TArray<FSimMatchResult> SingleResults;
+	TArray<FSimMatchResult> ThreeResults;
+	const FSimBatchSummary SingleSummary = SingleWorker.Run(Jobs, SingleResults);
+	ThreeWorkers.Run(Jobs, ThreeResults);
+
+	// Assert
+	TestEqual(TEXT("Every job has a result"), SingleResults.Num(), Jobs.Num());
+	TestEqual(TEXT("Summary counts every match"), SingleSummary.Matches, Jobs.Num());
+	TestEqual(TEXT("Outcomes add up"),
+		SingleSummary.FriendlyWins + SingleSummary.EnemyWins + SingleSummary.Draws + SingleSummary.Unfinished, Jobs.Num());
+
+	for (int32 i = 0; i < Jobs.Num() && i < ThreeResults.Num(); ++i)
+	{
+		const FSimMatchResult& A = SingleResults[i];
+		const FSimMatchResult& B = ThreeResults[i];
+		TestEqual(FString::Printf(TEXT("Job %d seed"), i), B.Seed, Jobs[i].Seed);
+		TestTrue(FString::Printf(TEXT("Job %d result matches"), i), A.Result == B.Result);
+		TestEqual(FString::Printf(TEXT("Job %d frames match"), i), A.FrameCount, B.FrameCount);
+		TestEqual(FString::Printf(TEXT("Job %d friendly crowns match"), i), A.FriendlyCrowns, B.FriendlyCrowns);
+		TestEqual(FString::Printf(TEXT("Job %d enemy crowns match"), i), A.EnemyCrowns, B.EnemyCrowns);
+		TestEqual(FString::Printf(TEXT("Job %d enemy tower HP matches"), i), A.EnemyTowerHPRatio, B.EnemyTowerHPRatio);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreBatchGameTime,
+	"UnitSimCore.SimulatorCore.Determinism.BatchGameTimeDoesNotLeak",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreBatchGameTime::RunTest(const FString& Parameters)
+{
+	// Arrange: A short custom game time, then matches that set none and get the default
+	TArray<FSimBatchJob> Jobs;
+	for (int32 Seed = 1; Seed <= 3; ++Seed)
+	{
+		FSimBatchJob Job = FSimBatchRunner::MakeRandomSkirmish(Seed, 3);
+		Job.Setup.bHasGameTime = false;
+		Jobs.Add(Job);
+	}
+	Jobs[0].Setup.bHasGameTime = true;
+	Jobs[0].Setup.GameTime.MaxGameTime = 5.f;
+
+	// Act: One worker restarts the same simulator for every job
+	FSimBatchRunner SingleWorker(1);
+	TArray<FSimMatchResult> BatchResults;
+	SingleWorker.Run(Jobs, BatchResults);
+
+	// Assert: Each job ends exactly as it does run alone on a fresh simulator
+	TestEqual(TEXT("Every job has a result"), BatchResults.Num(), Jobs.Num());
+	for (int32 i = 0; i < Jobs.Num() && i < BatchResults.Num(); ++i)
+	{
+		TArray<FSimMatchResult> FreshResults;
+		FSimBatchRunner(1).Run({ Jobs[i] }, FreshResults);
+		if (FreshResults.Num() != 1)
+		{
+			AddError(FString::Printf(TEXT("Job %d produced no fresh result"), i));
+			continue;
+		}
+
+		const FSimMatchResult& A = BatchResults[i];
+		const FSimMatchResult& B = FreshResults[0];
+		TestTrue(FString::Printf(TEXT("Job %d result matches"), i), A.Result == B.Result);
+		TestTrue(FString::Printf(TEXT("Job %d win condition matches"), i), A.WinCondition == B.WinCondition);
+		TestEqual(FString::Printf(TEXT("Job %d frames match"), i), A.FrameCount, B.FrameCount);
+		TestEqual(FString::Printf(TEXT("Job %d friendly crowns match"), i), A.FriendlyCrowns, B.FriendlyCrowns);
+		TestEqual(FString::Printf(TEXT("Job %d enemy crowns match"), i), A.EnemyCrowns, B.EnemyCrowns);
+		TestEqual(FString::Printf(TEXT("Job %d enemy tower HP matches"), i), A.EnemyTowerHPRatio, B.EnemyTowerHPRatio);
+	}
+	TestTrue(TEXT("Custom game time cut the first match short"),
+		BatchResults.Num() == Jobs.Num() && BatchResults[0].FrameCount < BatchResults[1].FrameCount);
+
+	return true;
+}
+
+// ============================================================================
+// Binary Snapshots
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreSnapshotRoundTrip,
+	"UnitSimCore.SimulatorCore.Snapshot.RestoreReplaysExactly",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreSnapshotRoundTrip::RunTest(const FString& Parameters)
+{
+	// Arrange: A skirmish already in progress, with a command still queued past the snapshot
+	FSimulatorCore Sim;
+	Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(7, 4).Setup);
+	Sim.SetHasMoreWaves(false);
+	for (int32 i = 0; i < 60; ++i)
+	{
+		Sim.Step();
+	}
+
+	FSpawnUnitCommand Spawn;
+	Spawn.FrameNumber = 90;
+	Spawn.Position = FVector2D(1600.0, 1200.0);
+	Spawn.Role = EUnitRole::Ranged;
+	Spawn.Faction = EUnitFaction::Enemy;
+	Sim.EnqueueCommand(FSimCommand::MakeSpawn(Spawn));
+
+	TArray<uint8> Snapshot;
+	Sim.SaveSnapshot(Snapshot);
+
+	TArray<FString> Expected;
+	for (int32 i = 0; i < 120; ++i)
+	{
+		Expected.Add(Sim.Step().ToJson());
+	}
+
+	// Act: Roll the same instance back, and fork into a fresh one
+	const bool bRestored = Sim.RestoreSnapshot(Snapshot);
+	FSimulatorCore Fork;
+	const bool bForked = Fork.RestoreSnapshot(Snapshot);
+
+	// Assert
+	TestTrue(TEXT("Snapshot is non-empty"), Snapshot.Num() > 0);
+	TestTrue(TEXT("Restore succeeds"), bRestored);
+	TestTrue(TEXT("Fork succeeds"), bForked);
+	TestEqual(TEXT("Restored frame"), Sim.GetCurrentFrame(), 60);
+
+	for (int32 i = 0; i < Expected.Num(); ++i)
+	{
+		if (Sim.Step().ToJson() != Expected[i] || Fork.Step().ToJson() != Expected[i])
+		{
+			AddError(FString::Printf(TEXT("Frame %d differs after restore"), 60 + i));
+			break;
+		}
+	}
+
+	TArray<uint8> Truncated(Snapshot.GetData(), Snapshot.Num() / 2);
+	TestFalse(TEXT("Truncated snapshot is rejected"), Fork.RestoreSnapshot(Truncated));
+	TestFalse(TEXT("Rejected restore leaves the simulator uninitialized"), Fork.GetIsInitialized());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreLoadStateSnapshot,
+	"UnitSimCore.SimulatorCore.Snapshot.LoadStateIntoFreshCore",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreLoadStateSnapshot::RunTest(const FString& Parameters)
+{
+	// Arrange: Frame data from a skirmish in progress
+	FSimulatorCore Source;
+	Source.Initialize(FSimBatchRunner::MakeRandomSkirmish(8, 4).Setup);
+	Source.SetHasMoreWaves(false);
+	for (int32 i = 0; i < 30; ++i)
+	{
+		Source.Step();
+	}
+	const FFrameData FrameData = Source.GetCurrentFrameData();
+
+	// Act: Load it into a core that was never initialized, then snapshot and fork it
+	FSimulatorCore Loaded;
+	Loaded.LoadState(FrameData);
+	Loaded.SetHasMoreWaves(false);
+	TArray<uint8> Snapshot;
+	Loaded.SaveSnapshot(Snapshot);
+	FSimulatorCore Fork;
+	const bool bForked = Fork.RestoreSnapshot(Snapshot);
+
+	// Assert
+	TestNotNull(TEXT("Loading built the pathfinding grid"), Loaded.GetPathfindingGrid());
+	TestTrue(TEXT("Snapshot is non-empty"), Snapshot.Num() > 0);
+	TestTrue(TEXT("Fork succeeds"), bForked);
+	TestTrue(TEXT("Fork hashes like the loaded core"), Fork.GetStateHash() == Loaded.ComputeStateHash());
+
+	for (int32 i = 0; i < 60; ++i)
+	{
+		if (Loaded.Step().ToJson() != Fork.Step().ToJson())
+		{
+			AddError(FString::Printf(TEXT("Frame %d differs between the loaded core and its fork"), FrameData.FrameNumber + i + 1));
+			break;
+		}
+	}
+
+	return true;
+}
+
 // ============================================================================
 // InjectUnit and RemoveUnit
 // ============================================================================
@@ -239,6 +495,98 @@ bool FSimCoreInjectRemove::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreRemoveRebindsHandles,
+	"UnitSimCore.SimulatorCore.Units.RemoveRebindsHandles",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreRemoveRebindsHandles::RunTest(const FString& Parameters)
+{
+	// Arrange: one friendly targeting the last of three enemies
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	Sim.SetHasMoreWaves(false);
+
+	const int32 FriendlyId = Sim.InjectUnit(FVector2D(1000.0, 1500.0), EUnitRole::Melee, EUnitFaction::Friendly, 100);
+	const int32 FirstEnemyId = Sim.InjectUnit(FVector2D(1400.0, 1500.0), EUnitRole::Melee, EUnitFaction::Enemy, 100);
+	Sim.InjectUnit(FVector2D(1500.0, 1500.0), EUnitRole::Melee, EUnitFaction::Enemy, 100);
+	const int32 TargetEnemyId = Sim.InjectUnit(FVector2D(1600.0, 1500.0), EUnitRole::Melee, EUnitFaction::Enemy, 100);
+
+	const TArray<FUnit>& Enemies = Sim.GetEnemyUnits();
+	const int32 TargetSlot = Enemies.Num() - 1;
+	FUnit* Friendly = Sim.FindUnit(EUnitFaction::Friendly, FriendlyId);
+	TestNotNull(TEXT("Friendly found by Id"), Friendly);
+	if (!Friendly) return false;
+	Friendly->Target = FUnitHandle::Make(Enemies, TargetSlot);
+
+	// Act: removing an earlier enemy shifts the target down one slot
+	Sim.RemoveUnit(FirstEnemyId, EUnitFaction::Enemy);
+
+	// Assert: handle follows its unit
+	Friendly = Sim.FindUnit(EUnitFaction::Friendly, FriendlyId);
+	TestEqual(TEXT("Handle re-pointed"), Friendly->Target.Index, TargetSlot - 1);
+	TestEqual(TEXT("Resolves to same unit"), Enemies[Friendly->Target.Resolve(Enemies)].Id, TargetEnemyId);
+	TestNull(TEXT("Removed unit not found"), Sim.FindUnit(EUnitFaction::Enemy, FirstEnemyId));
+
+	// Act: removing the target clears the handle
+	Sim.RemoveUnit(TargetEnemyId, EUnitFaction::Enemy);
+	TestFalse(TEXT("Handle cleared"), Friendly->Target.IsSet());
+
+	return true;
+}
+
+// ============================================================================
+// Dead Slot Reuse and Compaction
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreDeadSlotReuse,
+	"UnitSimCore.SimulatorCore.Units.DeadSlotReuseAndCompaction",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreDeadSlotReuse::RunTest(const FString& Parameters)
+{
+	// Arrange: high HP so tower fire cannot add corpses mid-test
+	FSimulatorCore Sim;
+	Sim.Initialize();
+	Sim.SetHasMoreWaves(false);
+
+	const int32 Total = UnitSimConstants::SQUAD_COMPACTION_MIN_DEAD + 8;
+	for (int32 i = 0; i < Total; i++)
+	{
+		Sim.InjectUnit(FVector2D(1600.0 + i * 50.0, 1500.0), EUnitRole::Melee, EUnitFaction::Enemy, 1000);
+	}
+	const int32 BaseCount = Sim.GetEnemyUnits().Num();
+
+	// Act: one corpse is below the compaction threshold, so its slot is queued for reuse
+	TArray<FUnit>& Enemies = Sim.GetEnemyUnitsRef();
+	Enemies[0].HP = 0;
+	Enemies[0].bIsDead = true;
+	Sim.Step();
+	const int32 NewId = Sim.InjectUnit(FVector2D(1600.0, 1600.0), EUnitRole::Melee, EUnitFaction::Enemy, 1000);
+
+	// Assert: spawn took the dead slot instead of growing the squad
+	TestEqual(TEXT("Squad did not grow"), Sim.GetEnemyUnits().Num(), BaseCount);
+	TestEqual(TEXT("Dead slot reused"), Sim.GetEnemyUnits()[0].Id, NewId);
+	TestNotNull(TEXT("New unit indexed"), Sim.FindUnit(EUnitFaction::Enemy, NewId));
+
+	// Act: enough corpses to trigger compaction on the next frame
+	const int32 Survivors = 8;
+	for (int32 i = 0; i < BaseCount - Survivors; i++)
+	{
+		Enemies[i].HP = 0;
+		Enemies[i].bIsDead = true;
+	}
+	const int32 FirstSurvivorId = Enemies[BaseCount - Survivors].Id;
+	Sim.Step();
+
+	// Assert: only living units remain, in their original order
+	TestEqual(TEXT("Squad compacted"), Sim.GetEnemyUnits().Num(), Survivors);
+	TestEqual(TEXT("Order preserved"), Sim.GetEnemyUnits()[0].Id, FirstSurvivorId);
+	const FUnit* Survivor = Sim.FindUnit(EUnitFaction::Enemy, FirstSurvivorId);
+	TestTrue(TEXT("Id index remapped"), Survivor == &Sim.GetEnemyUnits()[0]);
+
+	return true;
+}
+
 // ============================================================================
 // Custom InitialSetup
 // ============================================================================
@@ -300,3 +648,383 @@ bool FSimCoreFrameDataSnapshot::RunTest(const FString& Parameters)
 
 	return true;
 }
+
+// ============================================================================
+// FSimFrameView
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreFrameViewMatchesStep,
+	"UnitSimCore.SimulatorCore.FrameView.MatchesStepFrameData",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreFrameViewMatchesStep::RunTest(const FString& Parameters)
+{
+	// Arrange: One simulator advanced through views, one through Step
+	const FInitialSetup Setup = FSimBatchRunner::MakeRandomSkirmish(41, 20).Setup;
+	FSimulatorCore Viewed;
+	FSimulatorCore Stepped;
+	for (FSimulatorCore* Sim : { &Viewed, &Stepped })
+	{
+		Sim->Initialize(Setup);
+		Sim->SetHasMoreWaves(false);
+	}
+
+	int32 FramesGenerated = 0;
+	FFrameData Broadcast;
+
+	// Act & Assert
+	for (int32 i = 0; i < 60; ++i)
+	{
+		// Listen for the second half only: the view must not depend on subscribers
+		if (i == 30)
+		{
+			Viewed.Callbacks.OnFrameGenerated.AddLambda([&](const FFrameData& Frame)
+			{
+				FramesGenerated++;
+				Broadcast = Frame;
+			});
+		}
+
+		const FSimFrameView View = Viewed.Advance();
+		const FFrameData Expected = Stepped.Step();
+		const FFrameData Materialized = View.ToFrameData();
+
+		if (!FFrameData::StaticStruct()->CompareScriptStruct(&Materialized, &Expected, PPF_None))
+		{
+			AddError(FString::Printf(TEXT("View differs from Step at frame %d"), Expected.FrameNumber));
+			return true;
+		}
+		if (View.GetLivingEnemyCount() != Expected.LivingEnemyCount || View.AllWavesCleared() != Expected.bAllWavesCleared)
+		{
+			AddError(FString::Printf(TEXT("View counts differ at frame %d"), Expected.FrameNumber));
+			return true;
+		}
+		if (i >= 30 && !FFrameData::StaticStruct()->CompareScriptStruct(&Broadcast, &Expected, PPF_None))
+		{
+			AddError(FString::Printf(TEXT("Broadcast differs from Step at frame %d"), Expected.FrameNumber));
+			return true;
+		}
+	}
+
+	TestEqual(TEXT("Frames built only while subscribed"), FramesGenerated, 30);
+	TestTrue(TEXT("View reads simulator storage"),
+		Viewed.GetFrameView().GetFriendlyUnits().GetData() == Viewed.GetFriendlyUnits().GetData());
+
+	TArray<uint8> ViewedState;
+	TArray<uint8> SteppedState;
+	Viewed.SaveSnapshot(ViewedState);
+	Stepped.SaveSnapshot(SteppedState);
+	TestTrue(TEXT("Advance and Step leave the same state"), ViewedState == SteppedState);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreFrameViewAllocations,
+	"UnitSimCore.SimulatorCore.FrameView.AdvanceAllocatesNothing",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreFrameViewAllocations::RunTest(const FString& Parameters)
+{
+	// Arrange: No subscribers, everything on this thread so the counter sees all of it
+	FSimulatorCore Sim;
+	Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(43, 20).Setup);
+	Sim.SetHasMoreWaves(false);
+	Sim.SetParallelPhase1(false);
+	Sim.SetAsyncPathRequests(false);
+
+	// Warm up: first paths, flow fields and scratch buffers grow to their working size
+	for (int32 i = 0; i < 90; ++i)
+	{
+		Sim.Advance();
+	}
+
+	// Act
+	int64 Allocations = 0;
+	{
+		UnitSimTest::FScopedAllocationCounter Counter;
+		for (int32 i = 0; i < 30; ++i)
+		{
+			Sim.Advance();
+		}
+		Allocations = Counter.GetCount();
+	}
+
+	// Assert
+	TestEqual(TEXT("Steady-state Advance allocates nothing"), Allocations, static_cast<int64>(0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreFrameViewBenchmark,
+	"UnitSimCore.SimulatorCore.Benchmark.AdvanceVsStep",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FSimCoreFrameViewBenchmark::RunTest(const FString& Parameters)
+{
+	// Arrange: 300 units, no subscribers
+	const FInitialSetup Setup = FSimBatchRunner::MakeRandomSkirmish(42, 150).Setup;
+	constexpr int32 Frames = 120;
+
+	FSimulatorCore Stepped;
+	FSimulatorCore Viewed;
+	for (FSimulatorCore* Sim : { &Stepped, &Viewed })
+	{
+		Sim->Initialize(Setup);
+		Sim->SetHasMoreWaves(false);
+	}
+
+	// Act
+	double Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Frames; ++i)
+	{
+		Stepped.Step();
+	}
+	const double StepSeconds = FPlatformTime::Seconds() - Start;
+
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Frames; ++i)
+	{
+		Viewed.Advance();
+	}
+	const double AdvanceSeconds = FPlatformTime::Seconds() - Start;
+
+	AddInfo(FString::Printf(TEXT("300 units, %d frames: Step %.1f us/frame, Advance %.1f us/frame"),
+		Frames, StepSeconds * 1e6 / Frames, AdvanceSeconds * 1e6 / Frames));
+
+	// Assert
+	TArray<uint8> SteppedState;
+	TArray<uint8> ViewedState;
+	Stepped.SaveSnapshot(SteppedState);
+	Viewed.SaveSnapshot(ViewedState);
+	TestTrue(TEXT("Both simulators end in the same state"), SteppedState == ViewedState);
+
+	return true;
+}
+
+// ============================================================================
+// Event Buffer
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreEventBuffer,
+	"UnitSimCore.SimulatorCore.Events.BufferMatchesDelivery",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreEventBuffer::RunTest(const FString& Parameters)
+{
+	// Arrange: A battle with deaths, listened to on both delegates
+	FSimulatorCore Sim;
+	Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(51, 30).Setup);
+	Sim.SetHasMoreWaves(false);
+
+	TArray<FUnitEventData> Delivered;
+	TArray<FString> Descriptions;
+	Sim.Callbacks.OnUnitEvent.AddLambda([&Delivered](const FUnitEventData& Event) { Delivered.Add(Event); });
+	Sim.Callbacks.OnStateChanged.AddLambda([&Descriptions](const FString& Text) { Descriptions.Add(Text); });
+
+	// Act & Assert: Each step delivers exactly what its buffer holds
+	int32 Deaths = 0;
+	for (int32 Frame = 0; Frame < 240; ++Frame)
+	{
+		Delivered.Reset();
+		Descriptions.Reset();
+		Sim.Advance();
+
+		const TConstArrayView<FUnitEventData> Buffered = Sim.Callbacks.GetUnitEvents();
+		if (Buffered.Num() != Delivered.Num())
+		{
+			AddError(FString::Printf(TEXT("Frame %d: %d events buffered, %d delivered"), Frame, Buffered.Num(), Delivered.Num()));
+			return true;
+		}
+		for (int32 i = 0; i < Buffered.Num(); ++i)
+		{
+			if (Buffered[i].EventType != Delivered[i].EventType || Buffered[i].UnitId != Delivered[i].UnitId)
+			{
+				AddError(FString::Printf(TEXT("Frame %d: event %d delivered out of order"), Frame, i));
+				return true;
+			}
+			Deaths += Buffered[i].EventType == EUnitEventType::Died ? 1 : 0;
+		}
+		TestEqual(TEXT("One description per state change"), Descriptions.Num(), Sim.Callbacks.GetStateChanges().Num());
+	}
+	TestTrue(TEXT("Battle produced deaths"), Deaths > 0);
+
+	// Outside a step, events are delivered at once
+	Delivered.Reset();
+	Descriptions.Reset();
+	const int32 Id = Sim.InjectUnit(FVector2D(1600.0, 2550.0), EUnitRole::Melee, EUnitFaction::Enemy);
+	TestEqual(TEXT("Injection delivered immediately"), Delivered.Num(), 1);
+	TestEqual(TEXT("Description formatted on delivery"), Descriptions.Num() == 1 ? Descriptions[0] : FString(),
+		FString::Printf(TEXT("Unit E%d injected at (1600, 2550)"), Id));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreEventBufferUnbound,
+	"UnitSimCore.SimulatorCore.Events.UnboundStepsReuseBuffers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreEventBufferUnbound::RunTest(const FString& Parameters)
+{
+	// Arrange: Two identical battles, one with listeners, everything on this thread
+	const FInitialSetup Setup = FSimBatchRunner::MakeRandomSkirmish(52, 30).Setup;
+	constexpr int32 WarmupFrames = 90;
+	constexpr int32 CountedFrames = 60;
+
+	FSimulatorCore Unbound;
+	FSimulatorCore Bound;
+	for (FSimulatorCore* Sim : { &Unbound, &Bound })
+	{
+		Sim->Initialize(Setup);
+		Sim->SetHasMoreWaves(false);
+		Sim->SetParallelPhase1(false);
+		Sim->SetAsyncPathRequests(false);
+	}
+	int32 DescriptionChars = 0;
+	Bound.Callbacks.OnUnitEvent.AddLambda([](const FUnitEventData&) {});
+	Bound.Callbacks.OnStateChanged.AddLambda([&DescriptionChars](const FString& Text) { DescriptionChars += Text.Len(); });
+
+	// Warm up: the event buffers grow to their working size
+	for (int32 i = 0; i < WarmupFrames; ++i)
+	{
+		Unbound.Advance();
+		Bound.Advance();
+	}
+
+	// Act: Record events with nobody listening; no description is formatted, nothing allocated
+	int32 Recorded = 0;
+	int64 Allocations = 0;
+	{
+		UnitSimTest::FScopedAllocationCounter Counter;
+		for (int32 i = 0; i < CountedFrames; ++i)
+		{
+			Unbound.Advance();
+			Recorded += Unbound.Callbacks.GetUnitEvents().Num();
+		}
+		Allocations = Counter.GetCount();
+	}
+	for (int32 i = 0; i < CountedFrames; ++i)
+	{
+		Bound.Advance();
+	}
+
+	// Assert: Listeners change nothing but who hears about it
+	TArray<uint8> UnboundState;
+	TArray<uint8> BoundState;
+	Unbound.SaveSnapshot(UnboundState);
+	Bound.SaveSnapshot(BoundState);
+	TestTrue(TEXT("Events were recorded without listeners"), Recorded > 0);
+	TestEqual(TEXT("Unbound steps allocate nothing"), Allocations, static_cast<int64>(0));
+	TestTrue(TEXT("Descriptions were only formatted for the listener"), DescriptionChars > 0);
+	TestTrue(TEXT("Same state with and without listeners"), UnboundState == BoundState);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreEventBufferBenchmark,
+	"UnitSimCore.SimulatorCore.Events.Benchmark.UnboundVsBound",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FSimCoreEventBufferBenchmark::RunTest(const FString& Parameters)
+{
+	// Arrange: Two identical battles, one with listeners
+	const FInitialSetup Setup = FSimBatchRunner::MakeRandomSkirmish(52, 60).Setup;
+	constexpr int32 Frames = 240;
+
+	FSimulatorCore Unbound;
+	FSimulatorCore Bound;
+	for (FSimulatorCore* Sim : { &Unbound, &Bound })
+	{
+		Sim->Initialize(Setup);
+		Sim->SetHasMoreWaves(false);
+	}
+	Bound.Callbacks.OnUnitEvent.AddLambda([](const FUnitEventData&) {});
+	Bound.Callbacks.OnStateChanged.AddLambda([](const FString&) {});
+
+	// Act
+	int32 Recorded = 0;
+	double Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Frames; ++i)
+	{
+		Unbound.Advance();
+		Recorded += Unbound.Callbacks.GetUnitEvents().Num();
+	}
+	const double UnboundSeconds = FPlatformTime::Seconds() - Start;
+
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Frames; ++i)
+	{
+		Bound.Advance();
+	}
+	const double BoundSeconds = FPlatformTime::Seconds() - Start;
+
+	// Assert
+	AddInfo(FString::Printf(TEXT("120 units, %d frames, %d unit events: unbound %.1f us/frame, bound %.1f us/frame"),
+		Frames, Recorded, UnboundSeconds * 1e6 / Frames, BoundSeconds * 1e6 / Frames));
+	TestTrue(TEXT("Events were recorded without listeners"), Recorded > 0);
+
+	return true;
+}
+
+// ============================================================================
+// Profiler
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimCoreProfilerRecentFrames,
+	"UnitSimCore.SimulatorCore.Profiler.RecentFramesBreakdown",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimCoreProfilerRecentFrames::RunTest(const FString& Parameters)
+{
+	// Arrange
+	FSimulatorCore Sim;
+	Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(53, 30).Setup);
+	Sim.SetHasMoreWaves(false);
+
+	// Act: A mix of stepping styles, all of which are profiled
+	constexpr int32 Frames = 90;
+	for (int32 i = 0; i < Frames; ++i)
+	{
+		if (i % 3 == 0) Sim.Step();
+		else if (i % 3 == 1) Sim.Advance();
+		else Sim.StepSilent();
+	}
+
+	// Assert
+	const TArray<FSimFrameProfile> Recent = Sim.GetProfiler().GetRecentFrames(30);
+	TestEqual(TEXT("Asked-for history returned"), Recent.Num(), 30);
+	TestEqual(TEXT("Every frame kept so far"), Sim.GetProfiler().GetRecentFrames().Num(), Frames);
+	TestEqual(TEXT("Newest frame last"), Recent.Last().FrameNumber, Frames - 1);
+
+	int64 Totals[FSimFrameProfile::NumCounters] = {};
+	bool bConsecutive = true;
+	bool bPhasesWithinTotal = true;
+	for (int32 i = 0; i < Recent.Num(); ++i)
+	{
+		const FSimFrameProfile& Profile = Recent[i];
+		bConsecutive &= Profile.FrameNumber == Recent[0].FrameNumber + i;
+
+		double PhaseSum = 0.0;
+		for (const double Seconds : Profile.PhaseSeconds)
+		{
+			PhaseSum += Seconds;
+		}
+		bPhasesWithinTotal &= PhaseSum <= Profile.TotalSeconds;
+
+		for (int32 c = 0; c < FSimFrameProfile::NumCounters; ++c)
+		{
+			Totals[c] += Profile.Counters[c];
+		}
+	}
+	TestTrue(TEXT("Frames are consecutive"), bConsecutive);
+	TestTrue(TEXT("Phases fit in the step"), bPhasesWithinTotal);
+	TestTrue(TEXT("Collision pairs counted"), Totals[static_cast<int32>(ESimCounter::CollisionPairs)] > 0);
+	TestTrue(TEXT("Avoidance risks counted"), Totals[static_cast<int32>(ESimCounter::AvoidanceRisks)] > 0);
+	TestTrue(TEXT("Snapshot timed only for Step"), Recent.Last().GetPhaseSeconds(ESimPhase::Snapshot) == 0.0);
+	AddInfo(Sim.GetProfiler().GetLastFrame()->ToString());
+
+	// Re-initializing starts a fresh history
+	Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(53, 30).Setup);
+	TestNull(TEXT("History cleared"), Sim.GetProfiler().GetLastFrame());
+
+	return true;
+}
@@ -0,0 +1,190 @@
+#include "Misc/AutomationTest.h"
+#include "Simulation/SimStateHash.h"
+#include "Simulation/SimStateBisect.h"
+#include "Simulation/SimReplay.h"
+#include "Simulation/SimulatorCore.h"
+#include "Simulation/SimBatchRunner.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	constexpr int32 RecordedFrames = 150;
+
+	void InitSkirmish(FSimulatorCore& Sim, int32 UnitsPerSide)
+	{
+		Sim.Initialize(FSimBatchRunner::MakeRandomSkirmish(17, UnitsPerSide).Setup);
+		Sim.SetHasMoreWaves(false);
+	}
+
+	void RecordMatch(FSimReplay& OutReplay)
+	{
+		const FSimBatchJob Job = FSimBatchRunner::MakeRandomSkirmish(17, 12);
+		FSimulatorCore Sim;
+		Sim.Initialize(Job.Setup);
+		Sim.SetHasMoreWaves(false);
+
+		FSimReplayRecorder Recorder(Sim);
+		Recorder.Begin(Job.Setup, 50);
+		for (int32 Frame = 0; Frame < RecordedFrames; ++Frame)
+		{
+			Recorder.Tick();
+		}
+		OutReplay = Recorder.GetReplay();
+	}
+}
+
+// ============================================================================
+// Determinism
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStateHashParallelMatchesSerial,
+	"UnitSimCore.StateHash.Determinism.ParallelMatchesSerial",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStateHashParallelMatchesSerial::RunTest(const FString& Parameters)
+{
+	// Arrange: The same match with Phase 1 run in parallel and serially
+	FSimulatorCore Parallel;
+	FSimulatorCore Serial;
+	InitSkirmish(Parallel, 30);
+	InitSkirmish(Serial, 30);
+	Serial.SetParallelPhase1(false);
+
+	// Act
+	int32 Mismatches = 0;
+	int32 FrameHashMismatches = 0;
+	for (int32 i = 0; i < 120; ++i)
+	{
+		const FFrameData Frame = Parallel.Step();
+		Serial.Step();
+		Mismatches += Parallel.GetStateHash() != Serial.GetStateHash() ? 1 : 0;
+		FrameHashMismatches += Frame.StateHash != static_cast<int64>(Parallel.GetStateHash().Combined) ? 1 : 0;
+	}
+
+	// Assert
+	TestEqual(TEXT("Every step hashes equal"), Mismatches, 0);
+	TestEqual(TEXT("FFrameData carries the hash"), FrameHashMismatches, 0);
+	TestTrue(TEXT("Recomputing gives the stored hash"), Parallel.ComputeStateHash() == Parallel.GetStateHash());
+
+	// A restored snapshot hashes like the state it was taken from
+	TArray<uint8> Snapshot;
+	Parallel.SaveSnapshot(Snapshot);
+	const FSimStateHash Saved = Parallel.GetStateHash();
+	Parallel.Step();
+	TestTrue(TEXT("Stepping changes the hash"), Parallel.GetStateHash() != Saved);
+	Parallel.RestoreSnapshot(Snapshot);
+	TestTrue(TEXT("Restore brings the hash back"), Parallel.GetStateHash() == Saved);
+
+	// Cost of hashing one step's state
+	constexpr int32 Repeats = 200;
+	const double Start = FPlatformTime::Seconds();
+	uint64 Sink = 0;
+	for (int32 i = 0; i < Repeats; ++i)
+	{
+		Sink ^= Parallel.ComputeStateHash().Combined;
+	}
+	const double Seconds = FPlatformTime::Seconds() - Start;
+	AddInfo(FString::Printf(TEXT("%d units: %.1f us per state hash (%llx)"),
+		Parallel.GetFriendlyUnits().Num() + Parallel.GetEnemyUnits().Num(), Seconds * 1e6 / Repeats, Sink));
+
+	return true;
+}
+
+// ============================================================================
+// Replay Verification
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStateHashReplayVerify,
+	"UnitSimCore.StateHash.Replay.FindsFirstDivergentFrame",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStateHashReplayVerify::RunTest(const FString& Parameters)
+{
+	// Arrange: A recording round-tripped through bytes
+	FSimReplay Recorded;
+	RecordMatch(Recorded);
+	TArray<uint8> Bytes;
+	Recorded.Save(Bytes);
+	FSimReplay Loaded;
+	TestTrue(TEXT("Replay loads"), Loaded.Load(Bytes));
+	TestEqual(TEXT("One hash per recorded step"), Loaded.FrameHashes.Num(), RecordedFrames);
+
+	// Act & Assert: Clean playback verifies
+	FSimulatorCore Sim;
+	const FSimDivergence Clean = SimStateBisect::VerifyReplay(Sim, Loaded);
+	TestFalse(TEXT("Playback matches the recording"), Clean.IsFound());
+
+	// As if the recording machine had computed a different enemy squad at frame 70
+	FSimReplay Tampered = Loaded;
+	const int32 StartFrame = Tampered.Keyframes[0].Frame;
+	FSimStateHash& Hash = Tampered.FrameHashes[70];
+	Hash.Domains[static_cast<int32>(ESimHashDomain::EnemyUnits)] ^= 1;
+	SimStateHash::Combine(Hash);
+
+	AddExpectedError(TEXT("Playback diverged"), EAutomationExpectedErrorFlags::Contains, 1);
+	const FSimDivergence Found = SimStateBisect::VerifyReplay(Sim, Tampered);
+	TestEqual(TEXT("Divergent frame found"), Found.Frame, StartFrame + 70);
+	TestTrue(TEXT("Enemy squad named"), Found.Domain == ESimHashDomain::EnemyUnits);
+
+	// The same from the two hash streams alone
+	const FSimDivergence Streams = SimStateBisect::CompareReplays(Loaded, Tampered);
+	TestEqual(TEXT("Streams diverge at the same frame"), Streams.Frame, StartFrame + 70);
+
+	return true;
+}
+
+// ============================================================================
+// Bisect
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStateHashBisectRuns,
+	"UnitSimCore.StateHash.Bisect.FindsDivergentUnit",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStateHashBisectRuns::RunTest(const FString& Parameters)
+{
+	// Arrange: Two copies of a match; one unit of B loses a hit point before frame 40
+	FSimulatorCore A;
+	FSimulatorCore B;
+	InitSkirmish(A, 10);
+	InitSkirmish(B, 10);
+
+	TArray<FSimStateHash> HashesA;
+	TArray<FSimStateHash> HashesB;
+	for (int32 i = 0; i < 60; ++i)
+	{
+		if (i == 40)
+		{
+			B.GetEnemyUnitsRef()[3].HP -= 1;
+		}
+		A.Step();
+		B.Step();
+		HashesA.Add(A.GetStateHash());
+		HashesB.Add(B.GetStateHash());
+	}
+
+	// Act
+	const FSimDivergence Frame = SimStateBisect::CompareHashes(HashesA, HashesB, 0);
+
+	// Assert
+	TestEqual(TEXT("First divergent frame"), Frame.Frame, 40);
+	TestTrue(TEXT("Enemy squad named"), Frame.Domain == ESimHashDomain::EnemyUnits);
+	AddInfo(Frame.ToString());
+
+	// Lockstep runs of one replay under different settings agree
+	FSimReplay Recorded;
+	RecordMatch(Recorded);
+	FSimulatorCore SimA;
+	FSimulatorCore SimB;
+	SimB.SetParallelPhase1(false);
+	const FSimDivergence Runs = SimStateBisect::CompareRuns(SimA, SimB, Recorded);
+	TestFalse(TEXT("Parallel and serial playback agree"), Runs.IsFound());
+
+	// With both states at hand the slot is pinpointed
+	SimB.GetEnemyUnitsRef()[3].HP -= 1;
+	const FSimDivergence Slot = SimStateBisect::CompareStates(SimA, SimB);
+	TestTrue(TEXT("Enemy squad named"), Slot.Domain == ESimHashDomain::EnemyUnits);
+	TestEqual(TEXT("Unit slot named"), Slot.Index, 3);
+
+	return true;
+}
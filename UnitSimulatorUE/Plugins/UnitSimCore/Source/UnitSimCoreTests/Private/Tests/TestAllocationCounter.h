@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+
+/**
+ * Heap allocation counting for tests and benchmarks.
+ *
+ * A forwarding FMalloc is swapped into GMalloc on first use and left there, so
+ * no thread can ever call through a pointer that is being torn down. It only
+ * counts allocations made by a thread with an FScopedAllocationCounter open;
+ * every other thread (editor, task graph, workers) passes straight through.
+ * Work a measured call hands to other threads is not seen, so callers keep the
+ * simulator inline (SetParallelPhase1(false), SetAsyncPathRequests(false))
+ * for the measured window.
+ */
+namespace UnitSimTest
+{
+	class FScopedAllocationCounter;
+
+	/** Innermost open counter on this thread (null when nothing is being measured) */
+	inline thread_local FScopedAllocationCounter* GActiveAllocationCounter = nullptr;
+
+	class FScopedAllocationCounter
+	{
+	public:
+		FScopedAllocationCounter();
+		~FScopedAllocationCounter();
+
+		FScopedAllocationCounter(const FScopedAllocationCounter&) = delete;
+		FScopedAllocationCounter& operator=(const FScopedAllocationCounter&) = delete;
+
+		/** Allocations (and growing reallocations) made on this thread since the scope opened */
+		int64 GetCount() const { return Count; }
+
+	private:
+		friend class FCountingMalloc;
+
+		int64 Count = 0;
+		FScopedAllocationCounter* Outer = nullptr;
+	};
+
+	/** Forwards to the allocator it replaced, noting allocations for the open counter */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Note();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Note();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0) Note();
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0) Note();
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("UnitSimCountingMalloc"); }
+
+		/** Wrap GMalloc the first time it is needed; never unwrapped */
+		static void Install()
+		{
+			static FCountingMalloc* Instance = []()
+			{
+				FCountingMalloc* Counting = new FCountingMalloc(GMalloc);
+				FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), Counting);
+				return Counting;
+			}();
+			(void)Instance;
+		}
+
+	private:
+		FMalloc* Inner = nullptr;
+
+		static void Note()
+		{
+			if (FScopedAllocationCounter* Counter = GActiveAllocationCounter)
+			{
+				Counter->Count++;
+			}
+		}
+	};
+
+	inline FScopedAllocationCounter::FScopedAllocationCounter()
+	{
+		FCountingMalloc::Install();
+		Outer = GActiveAllocationCounter;
+		GActiveAllocationCounter = this;
+	}
+
+	inline FScopedAllocationCounter::~FScopedAllocationCounter()
+	{
+		GActiveAllocationCounter = Outer;
+		if (Outer != nullptr)
+		{
+			Outer->Count += Count;
+		}
+	}
+}
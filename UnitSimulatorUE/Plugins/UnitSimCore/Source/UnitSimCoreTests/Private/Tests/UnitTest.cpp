@@ -1,5 +1,7 @@
 #include "Misc/AutomationTest.h"
 #include "Units/Unit.h"
+#include "Units/UnitHandle.h"
+#include "Units/UnitHotStreams.h"
 #include "GameConstants.h"
 
 // ============================================================================
@@ -42,7 +44,7 @@ bool FUnitCreation::RunTest(const FString& Parameters)
 	TestEqual(TEXT("Role"), Unit.Role, EUnitRole::Melee);
 	TestFalse(TEXT("bIsDead"), Unit.bIsDead);
 	TestEqual(TEXT("Velocity is zero"), Unit.Velocity, FVector2D::ZeroVector);
-	TestEqual(TEXT("TargetIndex"), Unit.TargetIndex, -1);
+	TestFalse(TEXT("Target unset"), Unit.Target.IsSet());
 	TestEqual(TEXT("TargetTowerIndex"), Unit.TargetTowerIndex, -1);
 	TestEqual(TEXT("AttackCooldown"), Unit.AttackCooldown, 0.f);
 
@@ -264,6 +266,40 @@ bool FUnitAttackSlotClaim::RunTest(const FString& Parameters)
 	return true;
 }
 
+// ============================================================================
+// Generational Handles
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnitHandleStaleSlot,
+	"UnitSimCore.Unit.Handle.DetectsReplacedSlot",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnitHandleStaleSlot::RunTest(const FString& Parameters)
+{
+	// Arrange
+	TArray<FUnit> Squad;
+	Squad.Add(CreateTestUnit(1, EUnitFaction::Enemy, FVector2D(0.0, 0.0)));
+	Squad.Add(CreateTestUnit(2, EUnitFaction::Enemy, FVector2D(50.0, 0.0)));
+	const FUnitHandle Handle = FUnitHandle::Make(Squad, 1);
+
+	// Assert: live handle resolves to its slot
+	TestTrue(TEXT("Handle set"), Handle.IsSet());
+	TestEqual(TEXT("Resolves to slot"), Handle.Resolve(Squad), 1);
+	TestFalse(TEXT("Out of range is unset"), FUnitHandle::Make(Squad, 5).IsSet());
+
+	// Act: a different unit takes over the slot
+	Squad[1] = CreateTestUnit(3, EUnitFaction::Enemy, FVector2D(50.0, 0.0));
+
+	// Assert: stale handle no longer resolves
+	TestEqual(TEXT("Stale handle"), Handle.Resolve(Squad), static_cast<int32>(INDEX_NONE));
+
+	// Act: slot disappears entirely
+	Squad.RemoveAt(1);
+	TestEqual(TEXT("Missing slot"), Handle.Resolve(Squad), static_cast<int32>(INDEX_NONE));
+
+	return true;
+}
+
 // ============================================================================
 // FUnit CanAttackUnit
 // ============================================================================
@@ -360,3 +396,123 @@ bool FUnitChargeEffectiveDamage::RunTest(const FString& Parameters)
 
 	return true;
 }
+
+// ============================================================================
+// Hot Streams (SoA)
+// ============================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnitHotStreamsMirror,
+	"UnitSimCore.Unit.HotStreams.MirrorsHotFields",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnitHotStreamsMirror::RunTest(const FString& Parameters)
+{
+	// Arrange
+	TArray<FUnit> Units = {
+		CreateTestUnit(1, EUnitFaction::Enemy, FVector2D(100.0, 0.0)),
+		CreateTestUnit(2, EUnitFaction::Enemy, FVector2D(50.0, 0.0)),
+		CreateTestUnit(3, EUnitFaction::Enemy, FVector2D(10.0, 0.0))
+	};
+	Units[1].Layer = EMovementLayer::Air;
+	Units[1].Velocity = FVector2D(1.0, -2.0);
+	Units[2].bIsDead = true;
+
+	FUnitHotStreams Streams;
+
+	// Act
+	Streams.Build(Units);
+
+	// Assert: accessors mirror the FUnit fields
+	TestEqual(TEXT("Num"), Streams.Num(), 3);
+	TestEqual(TEXT("Position"), Streams.GetPosition(1), Units[1].Position);
+	TestEqual(TEXT("Velocity"), Streams.GetVelocity(1), Units[1].Velocity);
+	TestEqual(TEXT("Radius"), Streams.GetRadius(1), Units[1].Radius);
+	TestEqual(TEXT("Layer"), Streams.GetLayer(1), EMovementLayer::Air);
+	TestTrue(TEXT("Dead flag"), Streams.IsDead(2));
+
+	// Assert: ground-only attackers skip the air unit and the dead unit
+	float Distance = 0.f;
+	TestEqual(TEXT("Nearest ground target"),
+		Streams.FindNearestTargetable(FVector2D::ZeroVector, ETargetType::Ground, Distance), 0);
+	TestEqual(TEXT("Nearest ground distance"), Distance, 100.f);
+
+	// Act: sync after the unit moves
+	Units[0].Position = FVector2D(5.0, 0.0);
+	Streams.Sync(0, Units[0]);
+
+	// Assert
+	TestEqual(TEXT("Synced position"), Streams.GetPosition(0), FVector2D(5.0, 0.0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnitHotStreamsScanBenchmark,
+	"UnitSimCore.Unit.HotStreams.NearestScanBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FUnitHotStreamsScanBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 UnitCounts[] = { 1000, 5000 };
+	const int32 Queries = 256;
+
+	for (const int32 Count : UnitCounts)
+	{
+		// Arrange: deterministic spread over the map
+		FRandomStream Random(Count);
+		TArray<FUnit> Units;
+		Units.Reserve(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const FVector2D Position(
+				Random.FRandRange(0.f, static_cast<float>(UnitSimConstants::SIMULATION_WIDTH)),
+				Random.FRandRange(0.f, static_cast<float>(UnitSimConstants::SIMULATION_HEIGHT)));
+			Units.Add(CreateTestUnit(i + 1, EUnitFaction::Enemy, Position));
+			Units.Last().bIsDead = (i % 7) == 0;
+		}
+
+		FUnitHotStreams Streams;
+		Streams.Build(Units);
+
+		// Act: the same nearest-target scan over FUnit records and over the streams
+		int32 AoSChecksum = 0;
+		const double AoSStart = FPlatformTime::Seconds();
+		for (int32 q = 0; q < Queries; ++q)
+		{
+			const FVector2D From(q * 12.5, q * 19.9);
+			int32 BestIndex = -1;
+			float BestDistance = TNumericLimits<float>::Max();
+			for (int32 i = 0; i < Units.Num(); ++i)
+			{
+				if (Units[i].bIsDead) continue;
+				const float Dist = FVector2D::Distance(From, Units[i].Position);
+				if (Dist < BestDistance)
+				{
+					BestDistance = Dist;
+					BestIndex = i;
+				}
+			}
+			AoSChecksum += BestIndex;
+		}
+		const double AoSSeconds = FPlatformTime::Seconds() - AoSStart;
+
+		int32 SoAChecksum = 0;
+		const double SoAStart = FPlatformTime::Seconds();
+		for (int32 q = 0; q < Queries; ++q)
+		{
+			const FVector2D From(q * 12.5, q * 19.9);
+			float BestDistance = 0.f;
+			SoAChecksum += Streams.FindNearestTargetable(From, ETargetType::Ground, BestDistance);
+		}
+		const double SoASeconds = FPlatformTime::Seconds() - SoAStart;
+
+		// Assert: identical picks; report the bandwidth win
+		TestEqual(FString::Printf(TEXT("Same targets at %d units"), Count), SoAChecksum, AoSChecksum);
+		AddInfo(FString::Printf(TEXT("%d units: AoS %.3f ms, SoA %.3f ms (%.2fx), %d vs %d bytes/unit touched"),
+			Count, AoSSeconds * 1000.0, SoASeconds * 1000.0,
+			SoASeconds > 0.0 ? AoSSeconds / SoASeconds : 0.0,
+			static_cast<int32>(sizeof(FUnit)),
+			static_cast<int32>(2 * sizeof(FVector2D::FReal) + sizeof(uint8))));
+	}
+
+	return true;
+}
@@ -76,7 +76,7 @@ void USimDebugDrawer::DrawDebugUnits(const UWorld* World, const FSimulatorCore*
 				DrawDebugString(World, Center + FVector(0, 0, 45.f), Label, nullptr, Color, -1.f, true, TextScale * 0.8f);
 
 				// Draw target line if targeting something
-				if (Unit.TargetIndex >= 0)
+				if (Unit.Target.IsSet())
 				{
 					// Indicate targeting with a thin line (target position lookup omitted for simplicity)
 					DrawDebugPoint(World, Center + FVector(0, 0, 20.f), 5.f, FColor::Red, false, -1.f);
@@ -62,7 +62,7 @@ void ASimGameMode::Tick(float DeltaSeconds)
 	while (TimeAccumulator >= FixedTimeStep)
 	{
 		TimeAccumulator -= FixedTimeStep;
-		SimulatorCore->Step();
+		AdvanceSimulator();
 
 		// Check if simulation ended after this step
 		if (!SimulatorCore->GetIsRunning())
@@ -142,7 +142,7 @@ void ASimGameMode::StepSimulation()
 		return;
 	}
 
-	SimulatorCore->Step();
+	AdvanceSimulator();
 }
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -173,6 +173,11 @@ FFrameData ASimGameMode::GetCurrentFrameData() const
 	return SimulatorCore.IsValid() ? SimulatorCore->GetCurrentFrameData() : FFrameData();
 }
 
+FSimFrameView ASimGameMode::GetFrameView() const
+{
+	return SimulatorCore->GetFrameView();
+}
+
 // ════════════════════════════════════════════════════════════════════════════
 // Data Loading
 // ════════════════════════════════════════════════════════════════════════════
@@ -263,9 +268,6 @@ void ASimGameMode::BindSimulatorCallbacks()
 
 	FSimulatorCallbacks& Callbacks = SimulatorCore->Callbacks;
 
-	FrameGeneratedHandle = Callbacks.OnFrameGenerated.AddUObject(
-		this, &ASimGameMode::HandleFrameGenerated);
-
 	SimCompleteHandle = Callbacks.OnSimulationComplete.AddUObject(
 		this, &ASimGameMode::HandleSimulationComplete);
 
@@ -273,9 +275,15 @@ void ASimGameMode::BindSimulatorCallbacks()
 		this, &ASimGameMode::HandleUnitEvent);
 }
 
-void ASimGameMode::HandleFrameGenerated(const FFrameData& FrameData)
+void ASimGameMode::AdvanceSimulator()
 {
-	OnSimFrameCompleted.Broadcast(FrameData);
+	const FSimFrameView Frame = SimulatorCore->Advance();
+
+	// Frame data is only built for Blueprint listeners; unobserved steps copy nothing
+	if (OnSimFrameCompleted.IsBound())
+	{
+		OnSimFrameCompleted.Broadcast(Frame.ToFrameData());
+	}
 }
 
 void ASimGameMode::HandleSimulationComplete(int32 FinalFrame, const FString& Reason)
@@ -86,6 +86,9 @@ void ASimPlayerController::IssueMoveCommand(const FVector2D& Destination)
 	FSimulatorCore* Sim = GM->GetSimulatorCore();
 	const int32 CurrentFrame = Sim->GetCurrentFrame();
 
+	// One bulk enqueue keeps the group's orders together
+	TArray<FSimCommand> MoveCommands;
+	MoveCommands.Reserve(SelectedUnitIds.Num());
 	for (int32 UnitId : SelectedUnitIds)
 	{
 		FMoveUnitCommand MoveCmd;
@@ -94,8 +97,9 @@ void ASimPlayerController::IssueMoveCommand(const FVector2D& Destination)
 		MoveCmd.Faction = EUnitFaction::Friendly;
 		MoveCmd.Destination = Destination;
 
-		Sim->EnqueueCommand(FSimCommandWrapper::MakeMove(MoveCmd));
+		MoveCommands.Add(FSimCommand::MakeMove(MoveCmd));
 	}
+	Sim->EnqueueCommands(MoveCommands);
 }
 
 void ASimPlayerController::IssueSpawnCommand(const FVector2D& Position, FName UnitId)
@@ -113,7 +117,7 @@ void ASimPlayerController::IssueSpawnCommand(const FVector2D& Position, FName Un
 	SpawnCmd.Position = Position;
 	SpawnCmd.Faction = EUnitFaction::Friendly;
 
-	Sim->EnqueueCommand(FSimCommandWrapper::MakeSpawn(SpawnCmd));
+	Sim->EnqueueCommand(FSimCommand::MakeSpawn(SpawnCmd));
 }
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -3,7 +3,7 @@
 #include "GameModes/SimGameMode.h"
 #include "Player/SimPlayerController.h"
 #include "Simulation/SimulatorCore.h"
-#include "Simulation/FrameData.h"
+#include "Simulation/SimFrameView.h"
 #include "Units/Unit.h"
 #include "Engine/Canvas.h"
 #include "Engine/Font.h"
@@ -101,34 +101,34 @@ void ASimHUD::DrawSimulationInfo()
 		return;
 	}
 
-	// Frame info
-	FFrameData FrameData = GM->GetCurrentFrameData();
+	// Frame info (read in place; nothing is copied per draw)
+	const FSimFrameView Frame = GM->GetFrameView();
 
-	DrawTextWithBackground(FString::Printf(TEXT("Frame: %d"), FrameData.FrameNumber), X, Y);
+	DrawTextWithBackground(FString::Printf(TEXT("Frame: %d"), Frame.GetFrameNumber()), X, Y);
 	Y += LineHeight;
 
-	DrawTextWithBackground(FString::Printf(TEXT("Wave: %d"), FrameData.CurrentWave), X, Y);
+	DrawTextWithBackground(FString::Printf(TEXT("Wave: %d"), Frame.GetCurrentWave()), X, Y);
 	Y += LineHeight;
 
 	// Unit counts
 	DrawTextWithBackground(
 		FString::Printf(TEXT("Friendly: %d  Enemy: %d"),
-			FrameData.LivingFriendlyCount, FrameData.LivingEnemyCount),
+			Frame.GetLivingFriendlyCount(), Frame.GetLivingEnemyCount()),
 		X, Y);
 	Y += LineHeight;
 
 	// Crowns
 	DrawTextWithBackground(
 		FString::Printf(TEXT("Crowns: %d - %d"),
-			FrameData.FriendlyCrowns, FrameData.EnemyCrowns),
+			Frame.GetFriendlyCrowns(), Frame.GetEnemyCrowns()),
 		X, Y);
 	Y += LineHeight;
 
 	// Game result
-	if (FrameData.GameResult != EGameResult::InProgress)
+	if (Frame.GetGameResult() != EGameResult::InProgress)
 	{
 		FString ResultText;
-		switch (FrameData.GameResult)
+		switch (Frame.GetGameResult())
 		{
 		case EGameResult::FriendlyWin: ResultText = TEXT("WIN"); break;
 		case EGameResult::EnemyWin:    ResultText = TEXT("LOSS"); break;
@@ -233,7 +233,7 @@ void ASimHUD::DrawSelectedUnitInfo()
 		Y += LineHeight;
 
 		FString StateText = FoundUnit->bIsDead ? TEXT("DEAD") :
-			(FoundUnit->TargetIndex >= 0 ? TEXT("IN COMBAT") : TEXT("MOVING"));
+			(FoundUnit->Target.IsSet() ? TEXT("IN COMBAT") : TEXT("MOVING"));
 		DrawTextWithBackground(FString::Printf(TEXT("State: %s"), *StateText), X, Y);
 	}
 	else
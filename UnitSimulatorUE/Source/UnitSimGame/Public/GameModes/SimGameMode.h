@@ -87,9 +87,13 @@ public:
 	UFUNCTION(BlueprintPure, Category = "UnitSim|Simulation")
 	int32 GetCurrentFrame() const;
 
+	/** Full snapshot of the current frame (allocates; C++ readers should prefer GetFrameView) */
 	UFUNCTION(BlueprintPure, Category = "UnitSim|Simulation")
 	FFrameData GetCurrentFrameData() const;
 
+	/** Read-only view of the current frame (C++ only, simulator must exist) */
+	FSimFrameView GetFrameView() const;
+
 	// ════════════════════════════════════════════════════════════════════════
 	// Data Access
 	// ════════════════════════════════════════════════════════════════════════
@@ -168,7 +172,6 @@ private:
 	bool bDataLoaded = false;
 
 	/** Handles for FSimulatorCallbacks delegate bindings */
-	FDelegateHandle FrameGeneratedHandle;
 	FDelegateHandle SimCompleteHandle;
 	FDelegateHandle UnitEventHandle;
 
@@ -176,7 +179,8 @@ private:
 	// Callback handlers (bridge from FSimulatorCallbacks to dynamic delegates)
 	// ════════════════════════════════════════════════════════════════════════
 
-	void HandleFrameGenerated(const FFrameData& FrameData);
+	/** Step the simulator and forward the frame to Blueprint listeners, if any */
+	void AdvanceSimulator();
 	void HandleSimulationComplete(int32 FinalFrame, const FString& Reason);
 	void HandleUnitEvent(const FUnitEventData& EventData);
 };
@@ -15,7 +15,7 @@ class UInputMappingContext;
  * - Camera control: WASD pan, mouse wheel zoom, edge scrolling
  * - Unit selection: click select, box selection
  * - Unit commands: right-click move, spawn commands
- * - Converts player input into ISimulationCommand and enqueues into SimulatorCore
+ * - Converts player input into FSimCommand and enqueues into SimulatorCore
  */
 UCLASS()
 class UNITSIMGAME_API ASimPlayerController : public APlayerController